@@ -23,6 +23,8 @@
 #import "KuiklyRenderUIScheduler.h"
 #import "NSObject+KR.h"
 #import "KuiklyTurboDisplayRenderLayerHandler.h"
+#import "KRFPSMonitor.h"
+#import "KRTraceRecorder.h"
 
 // 注：args固定参数个数，不会存在数组访问越界
 #define FISRT_ARG args[0]
@@ -64,6 +66,7 @@ NSString *const kKuiklyFatalExceptionNotification = @"KuiklyFatalExceptionNotifi
                           params:(NSDictionary *)params
                         delegate:(id<KuiklyRenderCoreDelegate>)delegate {
     if (self = [super init]) {
+        [KRLogModule openBinaryLogIfNeeded];
         _instanceId = [NSString stringWithFormat:@"%ld", (long)++gInstanceId];
         _delegate = delegate;
         _contextParam = contextParam;
@@ -237,10 +240,26 @@ NSString *const kKuiklyFatalExceptionNotification = @"KuiklyFatalExceptionNotifi
         [KuiklyRenderThreadManager assertContextQueue];
         // 如果是moduleMethod的话，直接回调，在内部切线程
         if ([self p_shouldSyncCallWithWithMethod:method args:args]) {
-            return methodCallback(method, args);
+            if (!KRTraceIsEnabled()) {
+                return methodCallback(method, args);
+            }
+            char traceName[32];
+            snprintf(traceName, sizeof(traceName), "nativeMethod.%ld", (long)method);
+            KRTraceBegin(traceName);
+            id result = methodCallback(method, args);
+            KRTraceEnd(traceName);
+            return result;
         } else {
             [self.uiScheduler addTaskToMainQueueWithTask:^{  // 异步批量处理
+              if (!KRTraceIsEnabled()) {
+                  methodCallback(method, args);
+                  return;
+              }
+              char traceName[32];
+              snprintf(traceName, sizeof(traceName), "nativeMethod.%ld", (long)method);
+              KRTraceBegin(traceName);
               methodCallback(method, args);
+              KRTraceEnd(traceName);
             }];
         }
     }
@@ -296,6 +315,9 @@ NSString *const kKuiklyFatalExceptionNotification = @"KuiklyFatalExceptionNotifi
                                               BOOL shouldSync = sync;
                                               if (!sync && [result isKindOfClass:[NSDictionary class]] && result[KR_SYNC_CALLBACK_KEY]) {
                                                   shouldSync = [result[KR_SYNC_CALLBACK_KEY] boolValue];
+                                               } else if (!sync && [result isKindOfClass:[NSData class]] && [result length] >= 2) {
+                                                  const uint8_t *header = (const uint8_t *)[result bytes];
+                                                  shouldSync = header[0] == KR_BINARY_EVENT_MAGIC && (header[1] & KR_BINARY_EVENT_SYNC_FLAG);
                                                }
                                               // 正在主线程执行任务产生的同步事件->异步
                                               if (shouldSync && strongSelf.uiScheduler.performingMainQueueTask) {
@@ -368,12 +390,21 @@ NSString *const kKuiklyFatalExceptionNotification = @"KuiklyFatalExceptionNotifi
     [self p_registerNativeMethodWithMethod:KuiklyRenderNativeMethodCallModuleMethod
                                   callback:^id _Nullable(KuiklyRenderNativeMethod method, NSArray *_Nonnull args) {
                                     NSString *callbackId = FOUR_ARG;
-                                    return [weakSelf.renderLayerHandler callModuleMethodWithModuleName:FISRT_ARG
+                                    [KRFPSMonitor recordModuleCallWithModuleName:FISRT_ARG method:SECOND_ARG];
+                                    NSString *traceName = KRTraceIsEnabled() ? [NSString stringWithFormat:@"module.%@.%@", FISRT_ARG, SECOND_ARG] : nil;
+                                    if (traceName) {
+                                        KRTraceBegin(traceName.UTF8String);
+                                    }
+                                    id moduleResult = [weakSelf.renderLayerHandler callModuleMethodWithModuleName:FISRT_ARG
                                                                                                 method:SECOND_ARG
                                                                                                 params:THIRD_ARG
                                                                                               callback:^(id _Nullable result) {
                                                [weakSelf performCallback:callbackId instanceId:instanceId result:result];
                                            }];
+                                    if (traceName) {
+                                        KRTraceEnd(traceName.UTF8String);
+                                    }
+                                    return moduleResult;
     }];
     // 注册kotin调用TDFModule方法回调
     [self p_registerNativeMethodWithMethod:KuiklyRenderNativeMethodCallTDFModuleMethod
@@ -17,6 +17,8 @@
 #import "KuiklyRenderThreadManager.h"
 #import "KuiklyRenderUIScheduler.h"
 #import "KRComponentDefine.h"
+#import "KRFPSMonitor.h"
+#import "KRTraceRecorder.h"
 
 @interface KuiklyRenderUIScheduler ()
 /** 需要在主线程执行的闭包 */
@@ -122,9 +124,13 @@
                 [weakSelf.mainThreadTasks removeAllObjects];
             }];
             strongSelf.performingMainQueueTask = YES;
+            [KRFPSMonitor recordSchedulerBatchWithTaskCount:mainThreadTasks.count];
+            KRTraceCounter("UIScheduler.taskCount", mainThreadTasks.count);
+            KRTraceBegin("UIScheduler.batch");
             for (dispatch_block_t task in (mainThreadTasks ?: [NSArray new])) {
                 task();
             }
+            KRTraceEnd("UIScheduler.batch");
             strongSelf.performingMainQueueTask = NO;
             [strongSelf p_performTaskAfterViewDidLoadOnOnce];
           } sync:[NSThread isMainThread]];
@@ -0,0 +1,100 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class KRCanvasDisplayList;
+
+/// 命令流版本号，位于流的首字节
+#define KR_CANVAS_COMMAND_STREAM_VERSION 1
+
+/*
+ * Canvas批量命令流的操作码
+ * 流格式（小端）：[version:u8] 之后为若干条 [opcode:u8][参数...]
+ * f为float32，s为字符串（u16字节长度 + UTF-8），n为u16个数
+ */
+typedef NS_ENUM(uint8_t, KRCanvasStreamOp) {
+    KRCanvasStreamOpReset = 0,             // -
+    KRCanvasStreamOpBeginPath,             // -
+    KRCanvasStreamOpMoveTo,                // f x, f y
+    KRCanvasStreamOpLineTo,                // f x, f y
+    KRCanvasStreamOpArc,                   // f x, f y, f r, f sAngle, f eAngle, f counterclockwise(0/1)
+    KRCanvasStreamOpClosePath,             // -
+    KRCanvasStreamOpQuadraticCurveTo,      // f cpx, f cpy, f x, f y
+    KRCanvasStreamOpBezierCurveTo,         // f cp1x, f cp1y, f cp2x, f cp2y, f x, f y
+    KRCanvasStreamOpStroke,                // -
+    KRCanvasStreamOpFill,                  // -
+    KRCanvasStreamOpClip,                  // f intersect(0/1)
+    KRCanvasStreamOpFillStyle,             // s style
+    KRCanvasStreamOpStrokeStyle,           // s style
+    KRCanvasStreamOpLineWidth,             // f width
+    KRCanvasStreamOpLineDash,              // n count, f * count
+    KRCanvasStreamOpLineCap,               // f CGLineCap
+    KRCanvasStreamOpTextAlign,             // s align
+    KRCanvasStreamOpFont,                  // f size, s family, s style, s weight
+    KRCanvasStreamOpFillText,              // f x, f y, s text
+    KRCanvasStreamOpStrokeText,            // f x, f y, s text
+    KRCanvasStreamOpDrawImage,             // s cacheKey, f sx, f sy, f sWidth, f sHeight, f dx, f dy, f dWidth, f dHeight（缺省为NaN）
+    KRCanvasStreamOpLinearGradient,        // f x0, f y0, f x1, f y1, s colorStops
+    KRCanvasStreamOpRadialGradient,        // f x0, f y0, f r0, f x1, f y1, f r1, f alpha, s colors
+    KRCanvasStreamOpSave,                  // -
+    KRCanvasStreamOpRestore,               // -
+    KRCanvasStreamOpSaveLayer,             // f x, f y, f width, f height
+    KRCanvasStreamOpTranslate,             // f x, f y
+    KRCanvasStreamOpScale,                 // f x, f y
+    KRCanvasStreamOpRotate,                // f angle
+    KRCanvasStreamOpSkew,                  // f x, f y
+};
+
+typedef UIImage * _Nullable (^KRCanvasImageProvider)(NSString *cacheKey);
+
+/*
+ * @brief Canvas批量命令流，一帧的绘制命令一次跨桥提交，单次遍历解码写入显示列表
+ */
+@interface KRCanvasCommandStream : NSObject
+
+/*
+ * 解码命令流并追加到displayList
+ * @param imageProvider drawImage按cacheKey取图
+ * @return 解码的命令条数；流格式错误时停止解码，已解码的命令保留，error非空
+ */
++ (NSUInteger)decodeData:(NSData *)data
+           toDisplayList:(KRCanvasDisplayList *)displayList
+           imageProvider:(KRCanvasImageProvider _Nullable)imageProvider
+                   error:(NSError * _Nullable * _Nullable)error;
+
+@end
+
+/*
+ * @brief 命令流编码（Kotlin侧格式的参照实现，供基准测试等使用）
+ */
+@interface KRCanvasCommandStreamWriter : NSObject
+
+@property (nonatomic, strong, readonly) NSData *data;
+/// 已写入的命令条数
+@property (nonatomic, assign, readonly) NSUInteger commandCount;
+
+- (void)writeOp:(KRCanvasStreamOp)op;
+- (void)writeOp:(KRCanvasStreamOp)op floats:(const float *)floats count:(NSUInteger)count;
+/// 追加到上一条命令的参数
+- (void)writeFloat:(float)value;
+- (void)writeString:(nullable NSString *)string;
+- (void)writeCount:(uint16_t)count;
+
+@end
+
+NS_ASSUME_NONNULL_END
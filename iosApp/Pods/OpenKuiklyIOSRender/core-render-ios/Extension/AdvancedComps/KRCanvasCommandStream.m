@@ -0,0 +1,373 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRCanvasCommandStream.h"
+#import "KRCanvasDisplayList.h"
+
+static NSString *const KRCanvasCommandStreamErrorDomain = @"KRCanvasCommandStreamErrorDomain";
+
+/// 顺序读取命令流，越界后ok置为NO，之后的读取均返回0/nil
+typedef struct {
+    const uint8_t *bytes;
+    NSUInteger length;
+    NSUInteger offset;
+    BOOL ok;
+} KRCanvasStreamReader;
+
+static inline BOOL KRCanvasStreamCanRead(KRCanvasStreamReader *reader, NSUInteger size) {
+    if (!reader->ok || reader->length - reader->offset < size) {
+        reader->ok = NO;
+        return NO;
+    }
+    return YES;
+}
+
+static inline uint8_t KRCanvasStreamReadByte(KRCanvasStreamReader *reader) {
+    if (!KRCanvasStreamCanRead(reader, 1)) {
+        return 0;
+    }
+    return reader->bytes[reader->offset++];
+}
+
+static inline uint16_t KRCanvasStreamReadCount(KRCanvasStreamReader *reader) {
+    if (!KRCanvasStreamCanRead(reader, sizeof(uint16_t))) {
+        return 0;
+    }
+    uint16_t value;
+    memcpy(&value, reader->bytes + reader->offset, sizeof(value));
+    reader->offset += sizeof(value);
+    return CFSwapInt16LittleToHost(value);
+}
+
+static inline CGFloat KRCanvasStreamReadFloat(KRCanvasStreamReader *reader) {
+    if (!KRCanvasStreamCanRead(reader, sizeof(uint32_t))) {
+        return 0;
+    }
+    uint32_t bits;
+    memcpy(&bits, reader->bytes + reader->offset, sizeof(bits));
+    reader->offset += sizeof(bits);
+    bits = CFSwapInt32LittleToHost(bits);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static NSString *KRCanvasStreamReadString(KRCanvasStreamReader *reader) {
+    uint16_t length = KRCanvasStreamReadCount(reader);
+    if (!KRCanvasStreamCanRead(reader, length)) {
+        return nil;
+    }
+    NSString *string = [[NSString alloc] initWithBytes:reader->bytes + reader->offset
+                                                length:length
+                                              encoding:NSUTF8StringEncoding];
+    reader->offset += length;
+    return string;
+}
+
+@implementation KRCanvasCommandStream
+
++ (NSUInteger)decodeData:(NSData *)data
+           toDisplayList:(KRCanvasDisplayList *)displayList
+           imageProvider:(KRCanvasImageProvider)imageProvider
+                   error:(NSError **)error {
+    KRCanvasStreamReader reader = { (const uint8_t *)data.bytes, data.length, 0, YES };
+    uint8_t version = KRCanvasStreamReadByte(&reader);
+    if (!reader.ok || version != KR_CANVAS_COMMAND_STREAM_VERSION) {
+        if (error) {
+            *error = [self p_errorWithMessage:[NSString stringWithFormat:@"unsupported stream version: %d", version]];
+        }
+        return 0;
+    }
+    NSUInteger count = 0;
+    while (reader.ok && reader.offset < reader.length) {
+        KRCanvasStreamOp op = (KRCanvasStreamOp)KRCanvasStreamReadByte(&reader);
+        if (![self p_decodeOp:op reader:&reader displayList:displayList imageProvider:imageProvider]) {
+            if (error) {
+                NSString *message = reader.ok ? [NSString stringWithFormat:@"unknown opcode %d at offset %lu", op, (unsigned long)reader.offset - 1]
+                                              : [NSString stringWithFormat:@"truncated opcode %d", op];
+                *error = [self p_errorWithMessage:message];
+            }
+            return count;
+        }
+        count++;
+    }
+    return count;
+}
+
+#pragma mark - private
+
+/// 参数读取完整后才写入displayList，流被截断时不会追加半条命令
++ (BOOL)p_decodeOp:(KRCanvasStreamOp)op
+            reader:(KRCanvasStreamReader *)reader
+       displayList:(KRCanvasDisplayList *)displayList
+     imageProvider:(KRCanvasImageProvider)imageProvider {
+    CGFloat f[8];
+    switch (op) {
+        case KRCanvasStreamOpReset:
+            [displayList reset];
+            return YES;
+        case KRCanvasStreamOpBeginPath:
+            [displayList beginPath];
+            return YES;
+        case KRCanvasStreamOpMoveTo:
+        case KRCanvasStreamOpLineTo:
+        case KRCanvasStreamOpTranslate:
+        case KRCanvasStreamOpScale:
+        case KRCanvasStreamOpSkew:
+            if (![self p_readFloats:f count:2 reader:reader]) {
+                return NO;
+            }
+            if (op == KRCanvasStreamOpMoveTo) {
+                [displayList moveToX:f[0] y:f[1]];
+            } else if (op == KRCanvasStreamOpLineTo) {
+                [displayList lineToX:f[0] y:f[1]];
+            } else if (op == KRCanvasStreamOpTranslate) {
+                [displayList translateX:f[0] y:f[1]];
+            } else if (op == KRCanvasStreamOpScale) {
+                [displayList scaleX:f[0] y:f[1]];
+            } else {
+                [displayList skewX:f[0] y:f[1]];
+            }
+            return YES;
+        case KRCanvasStreamOpArc:
+            if (![self p_readFloats:f count:6 reader:reader]) {
+                return NO;
+            }
+            [displayList arcWithCenterX:f[0] y:f[1] radius:f[2] startAngle:f[3] endAngle:f[4] counterclockwise:f[5] != 0];
+            return YES;
+        case KRCanvasStreamOpClosePath:
+            [displayList closePath];
+            return YES;
+        case KRCanvasStreamOpQuadraticCurveTo:
+            if (![self p_readFloats:f count:4 reader:reader]) {
+                return NO;
+            }
+            [displayList quadraticCurveToCPX:f[0] cpy:f[1] x:f[2] y:f[3]];
+            return YES;
+        case KRCanvasStreamOpBezierCurveTo:
+            if (![self p_readFloats:f count:6 reader:reader]) {
+                return NO;
+            }
+            [displayList bezierCurveToCP1X:f[0] cp1y:f[1] cp2x:f[2] cp2y:f[3] x:f[4] y:f[5]];
+            return YES;
+        case KRCanvasStreamOpStroke:
+            [displayList stroke];
+            return YES;
+        case KRCanvasStreamOpFill:
+            [displayList fill];
+            return YES;
+        case KRCanvasStreamOpClip:
+            if (![self p_readFloats:f count:1 reader:reader]) {
+                return NO;
+            }
+            [displayList clipWithIntersect:f[0] != 0];
+            return YES;
+        case KRCanvasStreamOpFillStyle:
+        case KRCanvasStreamOpStrokeStyle:
+        case KRCanvasStreamOpTextAlign: {
+            NSString *string = KRCanvasStreamReadString(reader);
+            if (!reader->ok) {
+                return NO;
+            }
+            if (op == KRCanvasStreamOpFillStyle) {
+                [displayList setFillStyle:string];
+            } else if (op == KRCanvasStreamOpStrokeStyle) {
+                [displayList setStrokeStyle:string];
+            } else {
+                [displayList setTextAlign:string];
+            }
+            return YES;
+        }
+        case KRCanvasStreamOpLineWidth:
+            if (![self p_readFloats:f count:1 reader:reader]) {
+                return NO;
+            }
+            [displayList setLineWidth:f[0]];
+            return YES;
+        case KRCanvasStreamOpLineDash: {
+            uint16_t count = KRCanvasStreamReadCount(reader);
+            NSMutableArray<NSNumber *> *intervals = [NSMutableArray arrayWithCapacity:count];
+            for (uint16_t i = 0; i < count && reader->ok; i++) {
+                [intervals addObject:@(KRCanvasStreamReadFloat(reader))];
+            }
+            if (!reader->ok) {
+                return NO;
+            }
+            if (intervals.count) {
+                [displayList setLineDash:intervals];
+            }
+            return YES;
+        }
+        case KRCanvasStreamOpLineCap:
+            if (![self p_readFloats:f count:1 reader:reader]) {
+                return NO;
+            }
+            [displayList setLineCap:(CGLineCap)f[0]];
+            return YES;
+        case KRCanvasStreamOpFont: {
+            CGFloat size = KRCanvasStreamReadFloat(reader);
+            NSString *family = KRCanvasStreamReadString(reader);
+            NSString *style = KRCanvasStreamReadString(reader);
+            NSString *weight = KRCanvasStreamReadString(reader);
+            if (!reader->ok) {
+                return NO;
+            }
+            [displayList setFontWithFamily:family.length ? family : nil
+                                      size:@(size)
+                                     style:style.length ? style : nil
+                                    weight:weight.length ? weight : nil];
+            return YES;
+        }
+        case KRCanvasStreamOpFillText:
+        case KRCanvasStreamOpStrokeText: {
+            if (![self p_readFloats:f count:2 reader:reader]) {
+                return NO;
+            }
+            NSString *text = KRCanvasStreamReadString(reader);
+            if (!reader->ok) {
+                return NO;
+            }
+            if (op == KRCanvasStreamOpFillText) {
+                [displayList fillText:text ?: @"" x:f[0] y:f[1]];
+            } else {
+                [displayList strokeText:text ?: @"" x:f[0] y:f[1]];
+            }
+            return YES;
+        }
+        case KRCanvasStreamOpDrawImage: {
+            NSString *cacheKey = KRCanvasStreamReadString(reader);
+            if (![self p_readFloats:f count:8 reader:reader]) {
+                return NO;
+            }
+            UIImage *image = (cacheKey && imageProvider) ? imageProvider(cacheKey) : nil;
+            BOOL hasSource = !isnan(f[0]) && !isnan(f[1]) && !isnan(f[2]) && !isnan(f[3]);
+            BOOL hasDestSize = !isnan(f[6]) && !isnan(f[7]);
+            [displayList drawImage:image
+                        sourceRect:hasSource ? CGRectMake(f[0], f[1], f[2], f[3]) : CGRectNull
+                        destOrigin:CGPointMake(f[4], f[5])
+                          destSize:hasDestSize ? CGSizeMake(f[6], f[7]) : CGSizeZero];
+            return YES;
+        }
+        case KRCanvasStreamOpLinearGradient: {
+            if (![self p_readFloats:f count:4 reader:reader]) {
+                return NO;
+            }
+            NSString *colorStops = KRCanvasStreamReadString(reader);
+            if (!reader->ok) {
+                return NO;
+            }
+            [displayList drawLinearGradientFrom:CGPointMake(f[0], f[1]) to:CGPointMake(f[2], f[3]) colorStops:colorStops ?: @""];
+            return YES;
+        }
+        case KRCanvasStreamOpRadialGradient: {
+            if (![self p_readFloats:f count:7 reader:reader]) {
+                return NO;
+            }
+            NSString *colors = KRCanvasStreamReadString(reader);
+            if (!reader->ok) {
+                return NO;
+            }
+            [displayList drawRadialGradientFrom:CGPointMake(f[0], f[1]) radius:f[2]
+                                             to:CGPointMake(f[3], f[4]) radius:f[5]
+                                         colors:colors ?: @"" alpha:f[6]];
+            return YES;
+        }
+        case KRCanvasStreamOpSave:
+            [displayList save];
+            return YES;
+        case KRCanvasStreamOpRestore:
+            [displayList restore];
+            return YES;
+        case KRCanvasStreamOpSaveLayer:
+            if (![self p_readFloats:f count:4 reader:reader]) {
+                return NO;
+            }
+            [displayList saveLayerWithRect:CGRectMake(f[0], f[1], f[2], f[3])];
+            return YES;
+        case KRCanvasStreamOpRotate:
+            if (![self p_readFloats:f count:1 reader:reader]) {
+                return NO;
+            }
+            [displayList rotate:f[0]];
+            return YES;
+    }
+    return NO;
+}
+
++ (BOOL)p_readFloats:(CGFloat *)floats count:(NSUInteger)count reader:(KRCanvasStreamReader *)reader {
+    if (!KRCanvasStreamCanRead(reader, count * sizeof(uint32_t))) {
+        return NO;
+    }
+    for (NSUInteger i = 0; i < count; i++) {
+        floats[i] = KRCanvasStreamReadFloat(reader);
+    }
+    return YES;
+}
+
++ (NSError *)p_errorWithMessage:(NSString *)message {
+    return [NSError errorWithDomain:KRCanvasCommandStreamErrorDomain code:-1 userInfo:@{NSLocalizedDescriptionKey: message}];
+}
+
+@end
+
+@implementation KRCanvasCommandStreamWriter {
+    NSMutableData *_data;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        uint8_t version = KR_CANVAS_COMMAND_STREAM_VERSION;
+        _data = [NSMutableData dataWithBytes:&version length:1];
+    }
+    return self;
+}
+
+- (NSData *)data {
+    return [_data copy];
+}
+
+- (void)writeOp:(KRCanvasStreamOp)op {
+    uint8_t byte = op;
+    [_data appendBytes:&byte length:1];
+    _commandCount++;
+}
+
+- (void)writeOp:(KRCanvasStreamOp)op floats:(const float *)floats count:(NSUInteger)count {
+    [self writeOp:op];
+    for (NSUInteger i = 0; i < count; i++) {
+        [self writeFloat:floats[i]];
+    }
+}
+
+- (void)writeFloat:(float)value {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bits = CFSwapInt32HostToLittle(bits);
+    [_data appendBytes:&bits length:sizeof(bits)];
+}
+
+- (void)writeString:(NSString *)string {
+    NSData *utf8 = [string ?: @"" dataUsingEncoding:NSUTF8StringEncoding];
+    NSUInteger length = MIN(utf8.length, UINT16_MAX);
+    [self writeCount:(uint16_t)length];
+    [_data appendBytes:utf8.bytes length:length];
+}
+
+- (void)writeCount:(uint16_t)count {
+    uint16_t swapped = CFSwapInt16HostToLittle(count);
+    [_data appendBytes:&swapped length:sizeof(swapped)];
+}
+
+@end
@@ -0,0 +1,94 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class KuiklyContextParam;
+
+/*
+ * @brief Canvas的保留绘制列表
+ * 录制时即按当前状态解析好颜色/渐变/文本，路径操作累积到当前路径，stroke/fill/clip时缓存为不可变CGPath，
+ * 绘制命令为定长记录（操作码+参数下标+对象下标+绘制区域），重放时只需执行CG调用，
+ * 并可跳过与重绘区域不相交的绘制命令。录制仅在主线程，copy得到的快照可在任意线程重放。
+ */
+@interface KRCanvasDisplayList : NSObject<NSCopying>
+
+/// 文本字体缩放等所需的页面参数
+@property (nonatomic, strong, nullable) KuiklyContextParam *contextParam;
+/// 绘制命令个数（路径操作不单独成命令）
+@property (nonatomic, assign, readonly) NSUInteger commandCount;
+/// 上次clearDirtyRect以来新增绘制命令的区域并集（view坐标），可能为CGRectInfinite
+@property (nonatomic, assign, readonly) CGRect dirtyRect;
+
+- (void)reset;
+- (void)clearDirtyRect;
+
+#pragma mark - path
+
+- (void)beginPath;
+- (void)moveToX:(CGFloat)x y:(CGFloat)y;
+- (void)lineToX:(CGFloat)x y:(CGFloat)y;
+- (void)arcWithCenterX:(CGFloat)x y:(CGFloat)y radius:(CGFloat)radius
+            startAngle:(CGFloat)startAngle endAngle:(CGFloat)endAngle counterclockwise:(BOOL)counterclockwise;
+- (void)closePath;
+- (void)quadraticCurveToCPX:(CGFloat)cpx cpy:(CGFloat)cpy x:(CGFloat)x y:(CGFloat)y;
+- (void)bezierCurveToCP1X:(CGFloat)cp1x cp1y:(CGFloat)cp1y cp2x:(CGFloat)cp2x cp2y:(CGFloat)cp2y x:(CGFloat)x y:(CGFloat)y;
+- (void)stroke;
+- (void)fill;
+- (void)clipWithIntersect:(BOOL)intersect;
+
+#pragma mark - style
+
+- (void)setFillStyle:(nullable NSString *)style;
+- (void)setStrokeStyle:(nullable NSString *)style;
+- (void)setLineWidth:(CGFloat)lineWidth;
+- (void)setLineDash:(NSArray<NSNumber *> *)intervals;
+- (void)setLineCap:(CGLineCap)lineCap;
+- (void)setTextAlign:(nullable NSString *)textAlign;
+- (void)setFontWithFamily:(nullable id)family size:(nullable NSNumber *)size style:(nullable NSString *)style weight:(nullable NSString *)weight;
+
+#pragma mark - draw
+
+- (void)fillText:(NSString *)text x:(CGFloat)x y:(CGFloat)y;
+- (void)strokeText:(NSString *)text x:(CGFloat)x y:(CGFloat)y;
+/// sourceRect为CGRectNull时绘制整张图片，destSize为CGSizeZero时取图片尺寸
+- (void)drawImage:(nullable UIImage *)image sourceRect:(CGRect)sourceRect destOrigin:(CGPoint)destOrigin destSize:(CGSize)destSize;
+- (void)drawLinearGradientFrom:(CGPoint)start to:(CGPoint)end colorStops:(NSString *)colorStops;
+- (void)drawRadialGradientFrom:(CGPoint)startCenter radius:(CGFloat)startRadius
+                            to:(CGPoint)endCenter radius:(CGFloat)endRadius
+                        colors:(NSString *)colors alpha:(CGFloat)alpha;
+
+#pragma mark - state
+
+- (void)save;
+- (void)restore;
+- (void)saveLayerWithRect:(CGRect)rect;
+- (void)translateX:(CGFloat)x y:(CGFloat)y;
+- (void)scaleX:(CGFloat)x y:(CGFloat)y;
+- (void)rotate:(CGFloat)angle;
+- (void)skewX:(CGFloat)x y:(CGFloat)y;
+
+#pragma mark - replay
+
+/// 重放到context，区域与clipRect不相交的绘制命令只保留其状态副作用
+- (void)replayInContext:(CGContextRef)context clipRect:(CGRect)clipRect;
+/// 同上，每隔若干条命令检查一次isCancelled，返回YES时中止重放并返回NO
+- (BOOL)replayInContext:(CGContextRef)context clipRect:(CGRect)clipRect isCancelled:(BOOL (^ _Nullable)(void))isCancelled;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,699 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRCanvasDisplayList.h"
+#import <CoreText/CoreText.h>
+#include <vector>
+
+#import "KRComponentDefine.h"
+#import "KRRichTextView.h"
+#import "NSObject+KR.h"
+
+namespace {
+
+enum class KRCanvasOpcode : uint8_t {
+    kBeginPath,
+    kStroke,            // object: path
+    kFill,              // object: path
+    kClip,              // object: path, args: intersect
+    kFillStyle,         // object: paint或NSNull
+    kStrokeStyle,       // object: paint或NSNull
+    kLineWidth,         // args: width
+    kLineDash,          // args: intervals
+    kLineCap,           // args: cap
+    kText,              // object: text
+    kImage,             // object: image, args: dest rect
+    kLinearGradient,    // object: gradient, args: x0 y0 x1 y1
+    kRadialGradient,    // object: gradient, args: x0 y0 r0 x1 y1 r1 alpha
+    kSave,
+    kRestore,
+    kSaveLayer,         // args: rect
+    kTranslate,         // args: x y
+    kScale,             // args: x y
+    kRotate,            // args: angle
+    kSkew,              // args: x y
+};
+
+struct KRCanvasCommand {
+    KRCanvasOpcode op;
+    uint32_t argIndex;
+    uint32_t argCount;
+    uint32_t objectIndex;
+    /// view坐标下的绘制区域，状态命令为CGRectNull
+    CGRect bounds;
+};
+
+constexpr uint32_t kKRCanvasNoObject = UINT32_MAX;
+/// stroke区域外扩：按默认miterLimit(10)估算的尖角长度
+constexpr CGFloat kKRCanvasMiterLimit = 10;
+/// drawText中为避免裁字额外扩大的绘制尺寸
+constexpr CGFloat kKRCanvasTextExtraSpace = 1;
+/// 重放时检查取消的命令间隔
+constexpr size_t kKRCanvasCancelCheckInterval = 64;
+
+}  // namespace
+
+/// 填充/描边样式，录制时解析
+@interface KRCanvasPaint : NSObject {
+@public
+    UIColor *_color;
+    id _gradient;   // CGGradientRef
+    CGPoint _start;
+    CGPoint _end;
+}
+@end
+
+@implementation KRCanvasPaint
+@end
+
+/// 录制时排版好的文本
+@interface KRCanvasText : NSObject {
+@public
+    id _frame;      // CTFrameRef
+    CGPoint _origin;
+}
+@end
+
+@implementation KRCanvasText
+@end
+
+static CGGradientRef KRCanvasCreateGradient(NSArray *colors, const CGFloat *locations) {
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGGradientRef gradient = CGGradientCreateWithColors(colorSpace, (__bridge CFArrayRef)colors, locations);
+    CGColorSpaceRelease(colorSpace);
+    return gradient;
+}
+
+/// "color stop,color stop,..."
+static CGGradientRef KRCanvasCreateGradientWithColorStops(NSString *colorStopStr) {
+    NSArray<NSString *> *splits = [colorStopStr componentsSeparatedByString:@","];
+    NSMutableArray *colors = [NSMutableArray new];
+    std::vector<CGFloat> locations;
+    for (NSString *colorStop in splits) {
+        if (!colorStop.length) {
+            continue;
+        }
+        NSArray<NSString *> *colorAndStop = [colorStop componentsSeparatedByString:@" "];
+        UIColor *color = [UIView css_color:(NSString *)colorAndStop.firstObject];
+        [colors addObject:(__bridge id)color.CGColor];
+        locations.push_back([colorAndStop.lastObject floatValue]);
+    }
+    return KRCanvasCreateGradient(colors, locations.empty() ? NULL : locations.data());
+}
+
+@implementation KRCanvasDisplayList {
+    std::vector<KRCanvasCommand> _commands;
+    std::vector<CGFloat> _args;
+    /// 命令引用的对象（CGPath、paint、文本、图片、渐变）
+    NSMutableArray *_objects;
+
+    // 以下为录制时状态，重放不需要
+    CGMutablePathRef _path;
+    /// 当前路径的不可变快照，路径变化后失效
+    CGPathRef _pathSnapshot;
+    uint32_t _pathSnapshotIndex;
+    /// 解析过的样式，key为样式字符串
+    NSMutableDictionary<NSString *, KRCanvasPaint *> *_paintCache;
+    NSString *_fillStyle;
+    NSString *_strokeStyle;
+    CGFloat _lineWidth;
+    NSString *_textAlign;
+    id _fontFamily;
+    NSNumber *_fontSize;
+    NSString *_fontStyle;
+    NSString *_fontWeight;
+    CGAffineTransform _ctm;
+    std::vector<CGAffineTransform> _ctmStack;
+    CGRect _dirtyRect;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _objects = [NSMutableArray new];
+        _paintCache = [NSMutableDictionary new];
+        [self reset];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_path) {
+        CGPathRelease(_path);
+    }
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    // 快照只用于重放，不复制录制状态
+    KRCanvasDisplayList *copy = [[KRCanvasDisplayList alloc] init];
+    copy->_commands = _commands;
+    copy->_args = _args;
+    copy->_objects = [_objects mutableCopy];
+    return copy;
+}
+
+- (NSUInteger)commandCount {
+    return _commands.size();
+}
+
+- (void)reset {
+    _commands.clear();
+    _args.clear();
+    [_objects removeAllObjects];
+    if (_path) {
+        CGPathRelease(_path);
+    }
+    _path = CGPathCreateMutable();
+    _pathSnapshot = NULL;
+    _fillStyle = nil;
+    _strokeStyle = nil;
+    _lineWidth = 0;
+    _textAlign = nil;
+    _fontFamily = nil;
+    _fontSize = nil;
+    _fontStyle = nil;
+    _fontWeight = nil;
+    _ctm = CGAffineTransformIdentity;
+    _ctmStack.clear();
+    _dirtyRect = CGRectInfinite;
+}
+
+- (void)clearDirtyRect {
+    _dirtyRect = CGRectNull;
+}
+
+#pragma mark - path
+
+- (void)beginPath {
+    [self p_setPath:CGPathCreateMutable()];
+    [self p_appendCommand:KRCanvasOpcode::kBeginPath args:NULL count:0 object:nil bounds:CGRectNull];
+}
+
+- (void)moveToX:(CGFloat)x y:(CGFloat)y {
+    CGPathMoveToPoint(_path, NULL, x, y);
+    _pathSnapshot = NULL;
+}
+
+- (void)lineToX:(CGFloat)x y:(CGFloat)y {
+    [self p_moveToOriginIfNeeded];
+    CGPathAddLineToPoint(_path, NULL, x, y);
+    _pathSnapshot = NULL;
+}
+
+- (void)arcWithCenterX:(CGFloat)x y:(CGFloat)y radius:(CGFloat)radius
+            startAngle:(CGFloat)startAngle endAngle:(CGFloat)endAngle counterclockwise:(BOOL)counterclockwise {
+    CGPathAddArc(_path, NULL, x, y, radius, startAngle, endAngle, counterclockwise);
+    _pathSnapshot = NULL;
+}
+
+- (void)closePath {
+    CGPathCloseSubpath(_path);
+    _pathSnapshot = NULL;
+}
+
+- (void)quadraticCurveToCPX:(CGFloat)cpx cpy:(CGFloat)cpy x:(CGFloat)x y:(CGFloat)y {
+    [self p_moveToOriginIfNeeded];
+    CGPathAddQuadCurveToPoint(_path, NULL, cpx, cpy, x, y);
+    _pathSnapshot = NULL;
+}
+
+- (void)bezierCurveToCP1X:(CGFloat)cp1x cp1y:(CGFloat)cp1y cp2x:(CGFloat)cp2x cp2y:(CGFloat)cp2y x:(CGFloat)x y:(CGFloat)y {
+    [self p_moveToOriginIfNeeded];
+    CGPathAddCurveToPoint(_path, NULL, cp1x, cp1y, cp2x, cp2y, x, y);
+    _pathSnapshot = NULL;
+}
+
+- (void)stroke {
+    // 线宽在用户空间，按当前变换映射到视图空间：半径r的圆变换后外接矩形的半宽、半高分别为r*|(a,c)|、r*|(b,d)|
+    CGFloat radius = MAX(_lineWidth, 1) / 2 * kKRCanvasMiterLimit;
+    CGFloat outsetX = MAX(radius * hypot(_ctm.a, _ctm.c), 1);
+    CGFloat outsetY = MAX(radius * hypot(_ctm.b, _ctm.d), 1);
+    CGRect bounds = CGRectInset([self p_pathBoundingBox], -outsetX, -outsetY);
+    [self p_appendPathCommand:KRCanvasOpcode::kStroke args:NULL count:0 bounds:bounds];
+}
+
+- (void)fill {
+    CGRect bounds = CGRectInset([self p_pathBoundingBox], -1, -1);
+    [self p_appendPathCommand:KRCanvasOpcode::kFill args:NULL count:0 bounds:bounds];
+}
+
+- (void)clipWithIntersect:(BOOL)intersect {
+    CGFloat args[] = { intersect ? 1.0f : 0.0f };
+    [self p_appendPathCommand:KRCanvasOpcode::kClip args:args count:1 bounds:CGRectNull];
+}
+
+#pragma mark - style
+
+- (void)setFillStyle:(NSString *)style {
+    _fillStyle = style;
+    [self p_appendCommand:KRCanvasOpcode::kFillStyle args:NULL count:0 object:[self p_paintWithStyle:style] bounds:CGRectNull];
+}
+
+- (void)setStrokeStyle:(NSString *)style {
+    _strokeStyle = style;
+    [self p_appendCommand:KRCanvasOpcode::kStrokeStyle args:NULL count:0 object:[self p_paintWithStyle:style] bounds:CGRectNull];
+}
+
+- (void)setLineWidth:(CGFloat)lineWidth {
+    _lineWidth = lineWidth;
+    CGFloat args[] = { lineWidth };
+    [self p_appendCommand:KRCanvasOpcode::kLineWidth args:args count:1 object:nil bounds:CGRectNull];
+}
+
+- (void)setLineDash:(NSArray<NSNumber *> *)intervals {
+    std::vector<CGFloat> args;
+    args.reserve(intervals.count);
+    for (NSNumber *interval in intervals) {
+        args.push_back([interval floatValue]);
+    }
+    [self p_appendCommand:KRCanvasOpcode::kLineDash args:args.data() count:(uint32_t)args.size() object:nil bounds:CGRectNull];
+}
+
+- (void)setLineCap:(CGLineCap)lineCap {
+    CGFloat args[] = { (CGFloat)lineCap };
+    [self p_appendCommand:KRCanvasOpcode::kLineCap args:args count:1 object:nil bounds:CGRectNull];
+}
+
+- (void)setTextAlign:(NSString *)textAlign {
+    _textAlign = textAlign;
+}
+
+- (void)setFontWithFamily:(id)family size:(NSNumber *)size style:(NSString *)style weight:(NSString *)weight {
+    _fontFamily = family;
+    _fontSize = size;
+    _fontStyle = style;
+    _fontWeight = weight;
+}
+
+#pragma mark - draw
+
+- (void)fillText:(NSString *)text x:(CGFloat)x y:(CGFloat)y {
+    [self p_appendText:text x:x y:y isStroke:NO];
+}
+
+- (void)strokeText:(NSString *)text x:(CGFloat)x y:(CGFloat)y {
+    [self p_appendText:text x:x y:y isStroke:YES];
+}
+
+- (void)drawImage:(UIImage *)image sourceRect:(CGRect)sourceRect destOrigin:(CGPoint)destOrigin destSize:(CGSize)destSize {
+    UIImage *sourceImage = image;
+    if (!CGRectIsNull(sourceRect) && image.CGImage) {
+        CGImageRef cgImage = CGImageCreateWithImageInRect(image.CGImage, sourceRect);
+        sourceImage = [UIImage imageWithCGImage:cgImage];
+        CGImageRelease(cgImage);
+    }
+    if (CGSizeEqualToSize(destSize, CGSizeZero)) {
+        destSize = image.size;
+    }
+    CGFloat args[] = { destOrigin.x, destOrigin.y, destSize.width, destSize.height };
+    CGRect destRect = CGRectMake(destOrigin.x, destOrigin.y, destSize.width, destSize.height);
+    [self p_appendCommand:KRCanvasOpcode::kImage args:args count:4 object:sourceImage ?: [NSNull null]
+                   bounds:CGRectApplyAffineTransform(destRect, _ctm)];
+}
+
+- (void)drawLinearGradientFrom:(CGPoint)start to:(CGPoint)end colorStops:(NSString *)colorStops {
+    CGGradientRef gradient = KRCanvasCreateGradientWithColorStops(colorStops ?: @"");
+    CGFloat args[] = { start.x, start.y, end.x, end.y };
+    // 渐变铺满当前裁剪区域
+    [self p_appendCommand:KRCanvasOpcode::kLinearGradient args:args count:4 object:(__bridge id)gradient bounds:CGRectInfinite];
+    CGGradientRelease(gradient);
+}
+
+- (void)drawRadialGradientFrom:(CGPoint)startCenter radius:(CGFloat)startRadius
+                            to:(CGPoint)endCenter radius:(CGFloat)endRadius
+                        colors:(NSString *)colors alpha:(CGFloat)alpha {
+    NSMutableArray *cgColors = [NSMutableArray new];
+    for (NSString *colorStr in [colors ?: @"" componentsSeparatedByString:@","]) {
+        UIColor *color = [UIView css_color:colorStr];
+        [cgColors addObject:(__bridge id)color.CGColor];
+    }
+    CGGradientRef gradient = KRCanvasCreateGradient(cgColors, NULL);
+    CGFloat args[] = { startCenter.x, startCenter.y, startRadius, endCenter.x, endCenter.y, endRadius, alpha };
+    [self p_appendCommand:KRCanvasOpcode::kRadialGradient args:args count:7 object:(__bridge id)gradient bounds:CGRectInfinite];
+    CGGradientRelease(gradient);
+}
+
+#pragma mark - state
+
+- (void)save {
+    _ctmStack.push_back(_ctm);
+    [self p_appendCommand:KRCanvasOpcode::kSave args:NULL count:0 object:nil bounds:CGRectNull];
+}
+
+- (void)restore {
+    if (!_ctmStack.empty()) {
+        _ctm = _ctmStack.back();
+        _ctmStack.pop_back();
+    }
+    [self p_appendCommand:KRCanvasOpcode::kRestore args:NULL count:0 object:nil bounds:CGRectNull];
+}
+
+- (void)saveLayerWithRect:(CGRect)rect {
+    _ctmStack.push_back(_ctm);
+    CGFloat args[] = { rect.origin.x, rect.origin.y, rect.size.width, rect.size.height };
+    [self p_appendCommand:KRCanvasOpcode::kSaveLayer args:args count:4 object:nil bounds:CGRectNull];
+}
+
+- (void)translateX:(CGFloat)x y:(CGFloat)y {
+    _ctm = CGAffineTransformTranslate(_ctm, x, y);
+    CGFloat args[] = { x, y };
+    [self p_appendCommand:KRCanvasOpcode::kTranslate args:args count:2 object:nil bounds:CGRectNull];
+}
+
+- (void)scaleX:(CGFloat)x y:(CGFloat)y {
+    _ctm = CGAffineTransformScale(_ctm, x, y);
+    CGFloat args[] = { x, y };
+    [self p_appendCommand:KRCanvasOpcode::kScale args:args count:2 object:nil bounds:CGRectNull];
+}
+
+- (void)rotate:(CGFloat)angle {
+    _ctm = CGAffineTransformRotate(_ctm, angle);
+    CGFloat args[] = { angle };
+    [self p_appendCommand:KRCanvasOpcode::kRotate args:args count:1 object:nil bounds:CGRectNull];
+}
+
+- (void)skewX:(CGFloat)x y:(CGFloat)y {
+    _ctm = CGAffineTransformConcat(CGAffineTransformMake(1, y, x, 1, 0, 0), _ctm);
+    CGFloat args[] = { x, y };
+    [self p_appendCommand:KRCanvasOpcode::kSkew args:args count:2 object:nil bounds:CGRectNull];
+}
+
+#pragma mark - replay
+
+- (void)replayInContext:(CGContextRef)context clipRect:(CGRect)clipRect {
+    [self replayInContext:context clipRect:clipRect isCancelled:nil];
+}
+
+- (BOOL)replayInContext:(CGContextRef)context clipRect:(CGRect)clipRect isCancelled:(BOOL (^)(void))isCancelled {
+    KRCanvasPaint *fillPaint = nil;
+    KRCanvasPaint *strokePaint = nil;
+    CGFloat lineWidth = 0;
+    /// save栈，YES为saveLayer
+    std::vector<bool> saveStack;
+    // 补齐未配对的save，context复用时不残留状态
+    auto unwindSaveStack = [&saveStack, context]() {
+        for (auto it = saveStack.rbegin(); it != saveStack.rend(); ++it) {
+            if (*it) {
+                CGContextEndTransparencyLayer(context);
+            }
+            CGContextRestoreGState(context);
+        }
+        saveStack.clear();
+    };
+    const CGFloat *args = _args.data();
+    for (size_t i = 0; i < _commands.size(); i++) {
+        if (isCancelled && i % kKRCanvasCancelCheckInterval == 0 && isCancelled()) {
+            unwindSaveStack();
+            return NO;
+        }
+        const KRCanvasCommand &command = _commands[i];
+        const CGFloat *arg = args + command.argIndex;
+        id object = command.objectIndex == kKRCanvasNoObject ? nil : _objects[command.objectIndex];
+        BOOL visible = CGRectIsNull(command.bounds) || CGRectIntersectsRect(command.bounds, clipRect);
+        switch (command.op) {
+            case KRCanvasOpcode::kBeginPath:
+                CGContextBeginPath(context);
+                break;
+            case KRCanvasOpcode::kStroke:
+            case KRCanvasOpcode::kFill: {
+                CGPathRef path = (__bridge CGPathRef)object;
+                if (visible) {
+                    CGContextAddPath(context, path);
+                    if (command.op == KRCanvasOpcode::kStroke) {
+                        CGContextSetLineWidth(context, lineWidth);
+                        [self p_applyPaint:strokePaint stroke:YES context:context];
+                        CGContextDrawPath(context, kCGPathStroke);
+                    } else {
+                        [self p_applyPaint:fillPaint stroke:NO context:context];
+                        CGContextDrawPath(context, kCGPathFill);
+                    }
+                } else {
+                    CGContextBeginPath(context);
+                }
+                // 与逐条绘制时一致：绘制后context中保留当前路径
+                CGContextAddPath(context, path);
+                break;
+            }
+            case KRCanvasOpcode::kClip:
+                CGContextAddPath(context, (__bridge CGPathRef)object);
+                if (arg[0]) {
+                    CGContextClip(context);
+                } else {
+                    CGContextEOClip(context);
+                }
+                break;
+            case KRCanvasOpcode::kFillStyle:
+                fillPaint = [object isKindOfClass:[KRCanvasPaint class]] ? object : nil;
+                break;
+            case KRCanvasOpcode::kStrokeStyle:
+                strokePaint = [object isKindOfClass:[KRCanvasPaint class]] ? object : nil;
+                break;
+            case KRCanvasOpcode::kLineWidth:
+                lineWidth = arg[0];
+                break;
+            case KRCanvasOpcode::kLineDash:
+                CGContextSetLineDash(context, 0, arg, command.argCount);
+                break;
+            case KRCanvasOpcode::kLineCap:
+                CGContextSetLineCap(context, (CGLineCap)arg[0]);
+                break;
+            case KRCanvasOpcode::kText:
+                if (visible) {
+                    KRCanvasText *text = object;
+                    CGContextSaveGState(context);
+                    CGContextTranslateCTM(context, text->_origin.x, text->_origin.y);
+                    CGContextScaleCTM(context, 1.0, -1.0);
+                    CTFrameDraw((__bridge CTFrameRef)text->_frame, context);
+                    CGContextRestoreGState(context);
+                }
+                break;
+            case KRCanvasOpcode::kImage:
+                if (visible && [object isKindOfClass:[UIImage class]]) {
+                    UIGraphicsPushContext(context);
+                    [(UIImage *)object drawInRect:CGRectMake(arg[0], arg[1], arg[2], arg[3])];
+                    UIGraphicsPopContext();
+                }
+                break;
+            case KRCanvasOpcode::kLinearGradient:
+                if (visible) {
+                    CGContextDrawLinearGradient(context, (__bridge CGGradientRef)object,
+                                                CGPointMake(arg[0], arg[1]), CGPointMake(arg[2], arg[3]), 0);
+                }
+                break;
+            case KRCanvasOpcode::kRadialGradient:
+                CGContextSetAlpha(context, arg[6]);
+                if (visible) {
+                    CGContextDrawRadialGradient(context, (__bridge CGGradientRef)object,
+                                                CGPointMake(arg[0], arg[1]), arg[2], CGPointMake(arg[3], arg[4]), arg[5], 0);
+                }
+                break;
+            case KRCanvasOpcode::kSave:
+                CGContextSaveGState(context);
+                saveStack.push_back(false);
+                break;
+            case KRCanvasOpcode::kRestore:
+                if (!saveStack.empty()) {
+                    if (saveStack.back()) {
+                        CGContextEndTransparencyLayer(context);
+                    }
+                    CGContextRestoreGState(context);
+                    saveStack.pop_back();
+                }
+                break;
+            case KRCanvasOpcode::kSaveLayer:
+                CGContextSaveGState(context);
+                CGContextBeginTransparencyLayer(context, NULL);
+                CGContextClipToRect(context, CGRectMake(arg[0], arg[1], arg[2], arg[3]));
+                saveStack.push_back(true);
+                break;
+            case KRCanvasOpcode::kTranslate:
+                CGContextTranslateCTM(context, arg[0], arg[1]);
+                break;
+            case KRCanvasOpcode::kScale:
+                CGContextScaleCTM(context, arg[0], arg[1]);
+                break;
+            case KRCanvasOpcode::kRotate:
+                CGContextRotateCTM(context, arg[0]);
+                break;
+            case KRCanvasOpcode::kSkew:
+                CGContextConcatCTM(context, CGAffineTransformMake(1, arg[1], arg[0], 1, 0, 0));
+                break;
+        }
+    }
+    unwindSaveStack();
+    return YES;
+}
+
+#pragma mark - private
+
+- (void)p_appendCommand:(KRCanvasOpcode)op args:(const CGFloat *)args count:(uint32_t)count object:(id)object bounds:(CGRect)bounds {
+    KRCanvasCommand command;
+    command.op = op;
+    command.argIndex = (uint32_t)_args.size();
+    command.argCount = count;
+    command.objectIndex = kKRCanvasNoObject;
+    command.bounds = bounds;
+    if (count) {
+        _args.insert(_args.end(), args, args + count);
+    }
+    if (object) {
+        command.objectIndex = (uint32_t)_objects.count;
+        [_objects addObject:object];
+    }
+    _commands.push_back(command);
+    if (!CGRectIsNull(bounds)) {
+        _dirtyRect = CGRectUnion(_dirtyRect, bounds);
+    }
+}
+
+/// stroke/fill/clip引用当前路径的快照，路径未变化时复用同一个CGPath
+- (void)p_appendPathCommand:(KRCanvasOpcode)op args:(const CGFloat *)args count:(uint32_t)count bounds:(CGRect)bounds {
+    if (!_pathSnapshot) {
+        CGPathRef snapshot = CGPathCreateCopy(_path);
+        _pathSnapshotIndex = (uint32_t)_objects.count;
+        [_objects addObject:(__bridge id)snapshot];
+        CGPathRelease(snapshot);
+        _pathSnapshot = snapshot;
+    }
+    KRCanvasCommand command;
+    command.op = op;
+    command.argIndex = (uint32_t)_args.size();
+    command.argCount = count;
+    command.objectIndex = _pathSnapshotIndex;
+    command.bounds = bounds;
+    if (count) {
+        _args.insert(_args.end(), args, args + count);
+    }
+    _commands.push_back(command);
+    if (!CGRectIsNull(bounds)) {
+        _dirtyRect = CGRectUnion(_dirtyRect, bounds);
+    }
+}
+
+- (void)p_setPath:(CGMutablePathRef)path {
+    if (_path) {
+        CGPathRelease(_path);
+    }
+    _path = path;
+    _pathSnapshot = NULL;
+}
+
+- (CGRect)p_pathBoundingBox {
+    if (CGPathIsEmpty(_path)) {
+        return CGRectNull;
+    }
+    return CGRectApplyAffineTransform(CGPathGetBoundingBox(_path), _ctm);
+}
+
+// 在ios中，首次绘制图案，默认原点(0, 0)未生效，需要手动设置一次move到该原点，对齐安卓
+- (void)p_moveToOriginIfNeeded {
+    if (CGPointEqualToPoint(CGPathGetCurrentPoint(_path), CGPointZero)) {
+        CGPathMoveToPoint(_path, NULL, 0, 0);
+    }
+}
+
+- (id)p_paintWithStyle:(NSString *)style {
+    if (!style.length) {
+        return [NSNull null];
+    }
+    KRCanvasPaint *paint = _paintCache[style];
+    if (paint) {
+        return paint;
+    }
+    paint = [KRCanvasPaint new];
+    NSString *linearGradientPrefix = @"linear-gradient";
+    if ([style hasPrefix:linearGradientPrefix]) {
+        NSDictionary *params = [[style substringFromIndex:linearGradientPrefix.length] kr_stringToDictionary];
+        paint->_start = CGPointMake([params[@"x0"] doubleValue], [params[@"y0"] doubleValue]);
+        paint->_end = CGPointMake([params[@"x1"] doubleValue], [params[@"y1"] doubleValue]);
+        CGGradientRef gradient = KRCanvasCreateGradientWithColorStops(params[@"colorStops"] ?: @"");
+        paint->_gradient = (__bridge id)gradient;
+        CGGradientRelease(gradient);
+    } else {
+        paint->_color = [UIView css_color:style];
+    }
+    _paintCache[style] = paint;
+    return paint;
+}
+
+- (void)p_applyPaint:(KRCanvasPaint *)paint stroke:(BOOL)stroke context:(CGContextRef)context {
+    CGColorRef color = [UIColor clearColor].CGColor;
+    if (!paint) {
+        // 未设置样式时透明
+    } else if (paint->_gradient) {
+        // 渐变：裁剪为路径（描边时为描边轮廓）后绘制，原路径再以透明色绘制
+        CGContextSaveGState(context);
+        if (stroke) {
+            CGContextReplacePathWithStrokedPath(context);
+        }
+        CGContextClip(context);
+        CGContextDrawLinearGradient(context, (__bridge CGGradientRef)paint->_gradient, paint->_start, paint->_end, 0);
+        CGContextRestoreGState(context);
+    } else if (paint->_color) {
+        color = paint->_color.CGColor;
+    }
+    if (stroke) {
+        CGContextSetStrokeColorWithColor(context, color);
+    } else {
+        CGContextSetFillColorWithColor(context, color);
+    }
+}
+
+- (void)p_appendText:(NSString *)text x:(CGFloat)x y:(CGFloat)y isStroke:(BOOL)isStroke {
+    KRRichTextShadow *shadow = [[KRRichTextShadow alloc] init];
+    [shadow hrv_setPropWithKey:@"text" propValue:text ?: @""];
+    [shadow hrv_setPropWithKey:@"fontSize" propValue:_fontSize];
+    [shadow hrv_setPropWithKey:@"fontStyle" propValue:_fontStyle];
+    [shadow hrv_setPropWithKey:@"fontWeight" propValue:_fontWeight];
+    [shadow hrv_setPropWithKey:@"fontFamily" propValue:_fontFamily];
+    [shadow hrv_setPropWithKey:@"textAlign" propValue:_textAlign];
+    [shadow hrv_setPropWithKey:@"contextParam" propValue:_contextParam];
+    shadow.strokeAndFill = false;
+    if (isStroke) {
+        [shadow hrv_setPropWithKey:@"strokeColor" propValue:_strokeStyle];
+        [shadow hrv_setPropWithKey:@"strokeWidth" propValue:@(_lineWidth)];
+    } else {
+        [shadow hrv_setPropWithKey:@"color" propValue:_fillStyle];
+    }
+    CGSize size = [shadow hrv_calculateRenderViewSizeWithConstraintSize:CGSizeMake(CGFLOAT_MAX, CGFLOAT_MAX)];
+    CGFloat left = 0;
+    if ([_textAlign isEqualToString:@"center"]) {
+        left = size.width / 2;
+    } else if ([_textAlign isEqualToString:@"right"]) {
+        left = size.width;
+    }
+    CGFloat descent = (size.height - _fontSize.floatValue) / 2;
+    x -= left;
+    y += descent;
+    size.width += kKRCanvasTextExtraSpace;
+    size.height += kKRCanvasTextExtraSpace;
+
+    NSAttributedString *attributedString = [shadow buildAttributedString];
+    CTFramesetterRef frameSetter = CTFramesetterCreateWithAttributedString((__bridge CFAttributedStringRef)attributedString);
+    CGMutablePathRef framePath = CGPathCreateMutable();
+    CGPathAddRect(framePath, NULL, CGRectMake(0, 0, size.width, size.height));
+    CTFrameRef frame = CTFramesetterCreateFrame(frameSetter, CFRangeMake(0, attributedString.length), framePath, NULL);
+    KRCanvasText *record = [KRCanvasText new];
+    record->_frame = (__bridge id)frame;
+    record->_origin = CGPointMake(x, y + kKRCanvasTextExtraSpace);
+    CFRelease(frame);
+    CFRelease(framePath);
+    CFRelease(frameSetter);
+    // 翻转后向上绘制
+    CGRect textRect = CGRectMake(record->_origin.x, record->_origin.y - size.height, size.width, size.height);
+    [self p_appendCommand:KRCanvasOpcode::kText args:NULL count:0 object:record
+                   bounds:CGRectInset(CGRectApplyAffineTransform(textRect, _ctm), -1, -1)];
+}
+
+@end
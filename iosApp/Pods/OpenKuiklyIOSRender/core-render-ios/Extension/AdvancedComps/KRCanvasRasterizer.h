@@ -0,0 +1,45 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class KRCanvasDisplayList;
+
+typedef void (^KRCanvasRasterizeCompletion)(CGImageRef image);
+
+/*
+ * @brief Canvas后台光栅化
+ * 所有Canvas共用一个串行队列，每个rasterizer持有两块交替使用的位图：一块供上屏，一块用于下一帧绘制。
+ * 新的请求会使未完成的旧请求作废（未开始的直接跳过，进行中的在重放途中中止）。
+ */
+@interface KRCanvasRasterizer : NSObject
+
+/*
+ * 在后台重放displayList（调用方需传入快照），完成后在主线程回调（已被新请求作废时不回调）
+ * @param dirtyRect 需要重绘的区域（view坐标），位图尺寸未变时其余区域沿用上一帧
+ */
+- (void)rasterizeDisplayList:(KRCanvasDisplayList *)displayList
+                        size:(CGSize)size
+                       scale:(CGFloat)scale
+                   dirtyRect:(CGRect)dirtyRect
+                  completion:(KRCanvasRasterizeCompletion)completion;
+/// 作废未完成的请求（主线程调用）
+- (void)cancel;
+
+@end
+
+NS_ASSUME_NONNULL_END
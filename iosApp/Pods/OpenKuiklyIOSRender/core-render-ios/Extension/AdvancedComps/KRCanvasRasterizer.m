@@ -0,0 +1,147 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRCanvasRasterizer.h"
+#import <stdatomic.h>
+#import "KRCanvasDisplayList.h"
+#import "KuiklyRenderThreadManager.h"
+
+static dispatch_queue_t KRCanvasRasterizeQueue(void) {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        dispatch_queue_attr_t attr = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0);
+        queue = dispatch_queue_create("com.tencent.kuikly.canvas.rasterize", attr);
+    });
+    return queue;
+}
+
+@implementation KRCanvasRasterizer {
+    atomic_uint_fast64_t _generation;
+    // 以下仅在光栅化队列访问
+    CGContextRef _buffers[2];
+    /// 下一帧绘制使用的位图下标
+    NSUInteger _backIndex;
+    /// 上一帧的结果，用于局部重绘时保留脏区外的内容
+    CGImageRef _frontImage;
+}
+
+- (void)dealloc {
+    for (NSUInteger i = 0; i < 2; i++) {
+        CGContextRelease(_buffers[i]);
+    }
+    CGImageRelease(_frontImage);
+}
+
+- (void)rasterizeDisplayList:(KRCanvasDisplayList *)displayList
+                        size:(CGSize)size
+                       scale:(CGFloat)scale
+                   dirtyRect:(CGRect)dirtyRect
+                  completion:(KRCanvasRasterizeCompletion)completion {
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    uint_fast64_t generation = atomic_fetch_add(&_generation, 1) + 1;
+    dispatch_async(KRCanvasRasterizeQueue(), ^{
+        BOOL (^isCancelled)(void) = ^BOOL {
+            return atomic_load(&self->_generation) != generation;
+        };
+        if (isCancelled()) {
+            return;
+        }
+        CGImageRef image = [self p_rasterizeDisplayList:displayList size:size scale:scale dirtyRect:dirtyRect isCancelled:isCancelled];
+        if (!image) {
+            return;
+        }
+        [KuiklyRenderThreadManager performOnMainQueueWithTask:^{
+            if (!isCancelled()) {
+                completion(image);
+            }
+            CGImageRelease(image);
+        } sync:NO];
+    });
+}
+
+- (void)cancel {
+    atomic_fetch_add(&_generation, 1);
+}
+
+#pragma mark - private
+
+/// 返回+1的CGImage，被取消时返回NULL
+- (CGImageRef)p_rasterizeDisplayList:(KRCanvasDisplayList *)displayList
+                                size:(CGSize)size
+                               scale:(CGFloat)scale
+                           dirtyRect:(CGRect)dirtyRect
+                         isCancelled:(BOOL (^)(void))isCancelled CF_RETURNS_RETAINED {
+    size_t width = (size_t)ceil(size.width * scale);
+    size_t height = (size_t)ceil(size.height * scale);
+    if (!width || !height) {
+        return NULL;
+    }
+    CGContextRef context = [self p_bufferWithWidth:width height:height];
+    if (!context) {
+        return NULL;
+    }
+    CGRect bounds = CGRectMake(0, 0, size.width, size.height);
+    BOOL sameSize = _frontImage && CGImageGetWidth(_frontImage) == width && CGImageGetHeight(_frontImage) == height;
+    CGRect clipRect = sameSize ? CGRectIntersection(CGRectIntegral(dirtyRect), bounds) : bounds;
+    if (CGRectIsNull(clipRect) || CGRectIsEmpty(clipRect)) {
+        return NULL;
+    }
+
+    CGContextSaveGState(context);
+    // 翻转为UIKit坐标系，与drawRect一致
+    CGContextTranslateCTM(context, 0, height);
+    CGContextScaleCTM(context, scale, -scale);
+    if (sameSize && !CGRectEqualToRect(clipRect, bounds)) {
+        // 局部重绘：先铺上一帧，再只重放脏区
+        CGContextClearRect(context, bounds);
+        CGContextSaveGState(context);
+        CGContextTranslateCTM(context, 0, size.height);
+        CGContextScaleCTM(context, 1, -1);
+        CGContextDrawImage(context, bounds, _frontImage);
+        CGContextRestoreGState(context);
+    }
+    CGContextClipToRect(context, clipRect);
+    CGContextClearRect(context, clipRect);
+    UIGraphicsPushContext(context);
+    BOOL finished = [displayList replayInContext:context clipRect:clipRect isCancelled:isCancelled];
+    UIGraphicsPopContext();
+    CGContextRestoreGState(context);
+    if (!finished) {
+        return NULL;
+    }
+
+    CGImageRef image = CGBitmapContextCreateImage(context);
+    CGImageRelease(_frontImage);
+    _frontImage = CGImageRetain(image);
+    _backIndex = 1 - _backIndex;
+    return image;
+}
+
+- (CGContextRef)p_bufferWithWidth:(size_t)width height:(size_t)height {
+    CGContextRef buffer = _buffers[_backIndex];
+    if (buffer && CGBitmapContextGetWidth(buffer) == width && CGBitmapContextGetHeight(buffer) == height) {
+        return buffer;
+    }
+    CGContextRelease(buffer);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    buffer = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace,
+                                   kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host);
+    CGColorSpaceRelease(colorSpace);
+    _buffers[_backIndex] = buffer;
+    return buffer;
+}
+
+@end
@@ -20,6 +20,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface KRCanvasView : UIView<KuiklyRenderViewExportProtocol>
 
+/*
+ * 批量提交一帧的绘制命令，格式见KRCanvasCommandStream.h
+ * @param data 命令流
+ */
+- (void)drawCommandsWithData:(NSData *)data;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -13,49 +13,44 @@
  * limitations under the License.
  */
 
-#import <CoreText/CoreText.h>
-
 #import "KRCanvasView.h"
+#import "KRCanvasDisplayList.h"
+#import "KRCanvasCommandStream.h"
+#import "KRCanvasRasterizer.h"
 #import "KRComponentDefine.h"
 #import "KRConvertUtil.h"
 #import "NSObject+KR.h"
 #import "KuiklyRenderView.h"
-#import "NSObject+KR.h"
-#import "KRRichTextView.h"
 #import "KRMemoryCacheModule.h"
-
-#define HOT_HEAP_GRIDENT_WIDTH 100
-
-typedef void (^KRPathRenderAction)(CGContextRef context, CGMutablePathRef path);
-
-
+#import "KRLogModule.h"
 
 @interface KRCanvasView()
 
+/// 是否在后台线程光栅化（默认关闭），开启后不再走drawRect，结果绘制在asyncLayer上
+@property (nonatomic, strong) NSNumber *KUIKLY_PROP(asyncDraw);
+/// 保留绘制列表，css方法只录制，drawRect时重放
+@property (nonatomic, strong) KRCanvasDisplayList *displayList;
+/// 已提交setNeedsDisplayInRect但尚未绘制的区域，同一帧内的追加合并为一次重绘
+@property (nonatomic, assign) CGRect pendingDisplayRect;
 
-@property (nonatomic, strong) NSMutableArray<KRPathRenderAction> *renderActions;
-@property (nonatomic, assign) CGMutablePathRef path;
-@property (nonatomic, strong) NSString *fillStyle;
-@property (nonatomic, strong) NSString *strokeStyle;
-@property (nonatomic, assign) CGFloat lineWidth;
-
-
-@property (nonatomic, strong) NSString *fontStyle;
-@property (nonatomic, strong) NSString *fontWeight;
-@property (nonatomic, strong) NSNumber *fontSize;
-@property (nonatomic, strong) NSNumber *fontFamily;
-@property (nonatomic, strong) NSString *textAlign;
-@property (nonatomic, strong) NSMutableArray<NSString *> *saveStack;
 @end
 
-@implementation KRCanvasView
+@implementation KRCanvasView {
+    KRCanvasRasterizer *_rasterizer;
+    /// 承载后台光栅化结果
+    CALayer *_asyncLayer;
+    /// 已提交光栅化但未上屏的区域，新请求作废旧请求时需一并重绘
+    CGRect _asyncInFlightRect;
+    BOOL _asyncDisplayScheduled;
+}
 
 @synthesize hr_rootView;
 - (instancetype)initWithFrame:(CGRect)frame {
     if ([super initWithFrame:frame]) {
         self.backgroundColor = [UIColor clearColor];
-        _path = CGPathCreateMutable();
-        _saveStack = [NSMutableArray array];
+        _displayList = [[KRCanvasDisplayList alloc] init];
+        _pendingDisplayRect = CGRectNull;
+        _asyncInFlightRect = CGRectNull;
     }
     return self;
 }
@@ -63,6 +58,7 @@ typedef void (^KRPathRenderAction)(CGContextRef context, CGMutablePathRef path);
 
 - (void)hrv_callWithMethod:(NSString *)method params:(NSString *)params callback:(KuiklyRenderCallback)callback {
     KUIKLY_CALL_CSS_METHOD;
+    [self p_setNeedsDisplayForDirtyRect];
 }
 
 
@@ -70,9 +66,29 @@ typedef void (^KRPathRenderAction)(CGContextRef context, CGMutablePathRef path);
     KUIKLY_SET_CSS_COMMON_PROP;
 }
 
-- (void)addRenderAction:(KRPathRenderAction)action {
-    [self.renderActions addObject:action];
-    [self setNeedsDisplay];
+- (void)setCss_asyncDraw:(NSNumber *)css_asyncDraw {
+    BOOL enable = [css_asyncDraw boolValue];
+    if (enable == (_asyncLayer != nil)) {
+        _css_asyncDraw = css_asyncDraw;
+        return;
+    }
+    _css_asyncDraw = css_asyncDraw;
+    if (enable) {
+        _rasterizer = [[KRCanvasRasterizer alloc] init];
+        _asyncLayer = [CALayer layer];
+        _asyncLayer.contentsScale = [UIScreen mainScreen].scale;
+        _asyncLayer.frame = self.bounds;
+        [self.layer addSublayer:_asyncLayer];
+        // 清空drawRect已绘制的内容
+        [self setNeedsDisplay];
+    } else {
+        [_rasterizer cancel];
+        _rasterizer = nil;
+        [_asyncLayer removeFromSuperlayer];
+        _asyncLayer = nil;
+        _asyncInFlightRect = CGRectNull;
+    }
+    [self p_setNeedsFullDisplay];
 }
 
 #pragma mark - KRCanvasLayerDelegate
@@ -85,195 +101,73 @@ typedef void (^KRPathRenderAction)(CGContextRef context, CGMutablePathRef path);
 
 
 - (void)css_reset:(NSDictionary *)args {
-    self.renderActions = nil;
-    if (_path) {
-        CGPathRelease(_path);
-    }
-    _path = CGPathCreateMutable();
-    [self.saveStack removeAllObjects];
-    self.fillStyle = nil;
-    self.strokeStyle = nil;
-    self.lineWidth = 0;
-    [self setNeedsDisplay];
+    [self.displayList reset];
+    [self p_setNeedsFullDisplay];
 }
 
 - (void)css_beginPath:(NSDictionary *)args {
-    KR_WEAK_SELF;
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        CGPathRelease(path);
-        weakSelf.path = CGPathCreateMutable();
-        CGContextBeginPath(context);
-    }];
+    [self.displayList beginPath];
 }
 
 - (void)css_moveTo:(NSDictionary *)args {
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-        CGFloat x = [params[@"x"] doubleValue];
-        CGFloat y = [params[@"y"] doubleValue];
-        CGPathMoveToPoint(path, NULL, x, y);
-    }];
+    NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
+    [self.displayList moveToX:[params[@"x"] doubleValue] y:[params[@"y"] doubleValue]];
 }
 
 - (void)css_lineTo:(NSDictionary *)args {
-    KR_WEAK_SELF
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        [weakSelf initDefaultInitPointIfNeed:context path:path];
-        NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-        CGFloat x = [params[@"x"] doubleValue];
-        CGFloat y = [params[@"y"] doubleValue];
-        CGPathAddLineToPoint(path, NULL, x, y);
-    }];
+    NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
+    [self.displayList lineToX:[params[@"x"] doubleValue] y:[params[@"y"] doubleValue]];
 }
 
 - (void)css_arc:(NSDictionary *)args {
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-        CGFloat centerX = [params[@"x"] doubleValue];
-        CGFloat centerY = [params[@"y"] doubleValue];
-        CGFloat radius = [params[@"r"] doubleValue];
-        CGFloat startAngle = [params[@"sAngle"] doubleValue];
-        CGFloat endAngle = [params[@"eAngle"] doubleValue];
-        BOOL counterclockwise = [params[@"counterclockwise"] boolValue];
-        CGPathAddArc(path, NULL, centerX, centerY, radius, startAngle, endAngle, counterclockwise);
-    }];
+    NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
+    [self.displayList arcWithCenterX:[params[@"x"] doubleValue]
+                                   y:[params[@"y"] doubleValue]
+                              radius:[params[@"r"] doubleValue]
+                          startAngle:[params[@"sAngle"] doubleValue]
+                            endAngle:[params[@"eAngle"] doubleValue]
+                    counterclockwise:[params[@"counterclockwise"] boolValue]];
 }
 
 - (void)css_closePath:(NSDictionary *)args {
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        CGPathCloseSubpath(path);
-    }];
-   
+    [self.displayList closePath];
 }
 
 - (void)css_stroke:(NSDictionary *)args {
-    KR_WEAK_SELF
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-           CGContextAddPath(context, path);
-           CGContextSetLineWidth(context, weakSelf.lineWidth);
-           [weakSelf applyStrokeStyle:context path:path];
-           CGContextDrawPath(context, kCGPathStroke);
-           CGContextAddPath(context, path);
-    }];
+    [self.displayList stroke];
 }
 
 - (void)css_fill:(NSDictionary *)args {
-    KR_WEAK_SELF
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-           CGContextAddPath(context, path);
-           [weakSelf applyFillStyle:context path:path];
-           CGContextDrawPath(context, kCGPathFill);
-           CGContextAddPath(context, path);
-    }];
+    [self.displayList fill];
 }
 
 - (void)css_textAlign:(NSDictionary*)args{
-    NSString *params = args[KRC_PARAM_KEY];
-    KR_WEAK_SELF
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        KR_STRONG_SELF_RETURN_IF_NIL
-        strongSelf.textAlign = params;
-    }];
+    [self.displayList setTextAlign:args[KRC_PARAM_KEY]];
 }
 
 - (void)css_font:(NSDictionary*)args{
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-    KR_WEAK_SELF
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        KR_STRONG_SELF_RETURN_IF_NIL
-        strongSelf.fontFamily = params[@"family"];
-        strongSelf.fontSize = params[@"size"];
-        strongSelf.fontStyle = params[@"style"];
-        strongSelf.fontWeight = params[@"weight"];
-    }];
-}
-
-- (void)drawText:(NSDictionary*)params
-         context:(CGContextRef)context
-            path:(CGMutablePathRef)path isStroke:(bool)isStroke{
-    float x = ((NSNumber*)params[@"x"]).floatValue;
-    float y = ((NSNumber*)params[@"y"]).floatValue;
-
-    KRRichTextShadow* shadow = [[KRRichTextShadow alloc] init];
-    [shadow hrv_setPropWithKey:@"text" propValue:params[@"text"]];
-    [shadow hrv_setPropWithKey:@"fontSize" propValue:self.fontSize];
-    [shadow hrv_setPropWithKey:@"fontStyle" propValue:self.fontStyle];
-    [shadow hrv_setPropWithKey:@"fontWeight" propValue:self.fontWeight];
-    [shadow hrv_setPropWithKey:@"fontFamily" propValue:self.fontFamily];
-    [shadow hrv_setPropWithKey:@"textAlign" propValue:self.textAlign];
-    [shadow hrv_setPropWithKey:@"contextParam" propValue:self.hr_rootView.contextParam];
-    shadow.strokeAndFill = false;
-    
-    if(isStroke){
-        [shadow hrv_setPropWithKey:@"strokeColor" propValue:self.strokeStyle];
-        [shadow hrv_setPropWithKey:@"strokeWidth" propValue:@(self.lineWidth)];
-    }else{
-        [shadow hrv_setPropWithKey:@"color" propValue:self.fillStyle];
-    }
-    
-    float left;
-    float right;
-    
-    CGSize sz = [shadow hrv_calculateRenderViewSizeWithConstraintSize:CGSizeMake(CGFLOAT_MAX, CGFLOAT_MAX)];
-    if([self.textAlign isEqualToString:@"center"]){
-        left = sz.width / 2;
-        right = sz.width - left;
-    }else if([self.textAlign isEqualToString:@"right"]){
-        left = sz.width;
-        right = 0;
-    }else{
-        left = 0;
-        right = sz.width;
-    }
-    float descent = (sz.height - self.fontSize.floatValue) / 2;
-    //float ascent = sz.height - descent;
-    
-    x -= left;
-    y += descent;
-    
-    const int extraSpace = 1;
-    sz.width += extraSpace;
-    sz.height += extraSpace;
-    NSAttributedString* attributedString = [shadow buildAttributedString];
-    CGContextSaveGState(context);
-    CGContextTranslateCTM(context, x, y + extraSpace);
-    CGContextScaleCTM(context, 1.0, -1.0);
-    CTFramesetterRef frameSetter = CTFramesetterCreateWithAttributedString((__bridge CFAttributedStringRef)attributedString);
-    CGMutablePathRef framePath = CGPathCreateMutable();
-    CGPathAddRect(framePath, NULL, CGRectMake(0, 0, sz.width, sz.height));
-    CTFrameRef frame = CTFramesetterCreateFrame(frameSetter, CFRangeMake(0, attributedString.length), framePath, NULL);
-    CTFrameDraw(frame, context);
-    CFRelease(frame);
-    CFRelease(framePath);
-    CFRelease(frameSetter);
-    CGContextRestoreGState(context);
+    [self.displayList setFontWithFamily:params[@"family"]
+                                   size:params[@"size"]
+                                  style:params[@"style"]
+                                 weight:params[@"weight"]];
 }
 
 - (void)css_strokeText:(NSDictionary*)args{
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-    KR_WEAK_SELF
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        KR_STRONG_SELF_RETURN_IF_NIL
-        [strongSelf drawText:params context:context path:path isStroke:true];
-    }];
+    self.displayList.contextParam = self.hr_rootView.contextParam;
+    [self.displayList strokeText:params[@"text"] x:[params[@"x"] floatValue] y:[params[@"y"] floatValue]];
 }
 
 - (void)css_fillText:(NSDictionary*)args{
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-    KR_WEAK_SELF
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        KR_STRONG_SELF_RETURN_IF_NIL
-        
-        [strongSelf drawText:params context:context path:path isStroke:false];
-    }];
-
+    self.displayList.contextParam = self.hr_rootView.contextParam;
+    [self.displayList fillText:params[@"text"] x:[params[@"x"] floatValue] y:[params[@"y"] floatValue]];
 }
 
 - (void)css_drawImage:(NSDictionary*)args{
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
     NSString *imageCacheKey = params[@"cacheKey"];
-    float dx = [params[@"dx"] floatValue];
-    float dy = [params[@"dy"] floatValue];
     NSNumber* sx = params[@"sx"];
     NSNumber* sy = params[@"sy"];
     NSNumber* sWidth = params[@"sWidth"];
@@ -285,58 +179,37 @@ typedef void (^KRPathRenderAction)(CGContextRef context, CGMutablePathRef path);
     KRMemoryCacheModule *module = [rootView moduleWithName:NSStringFromClass([KRMemoryCacheModule class])];
     UIImage* image = [module imageWithKey:imageCacheKey];
     
-    KR_WEAK_SELF
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        KR_STRONG_SELF_RETURN_IF_NIL
-        
-        UIImage* sourceImage = image;
-        if(sx != nil && sy != nil && sWidth != nil && sHeight != nil){
-            CGRect sourceRect =  CGRectMake([sx floatValue], [sy floatValue],
-                                            [sWidth floatValue], [sHeight floatValue]);
-            CGImageRef cgImage = CGImageCreateWithImageInRect(image.CGImage, sourceRect);
-            sourceImage = [UIImage imageWithCGImage:cgImage];
-        }
-        
-        CGRect destRect;
-        if(dWidth != nil && dHeight != nil){
-            destRect = CGRectMake(dx, dy, [dWidth floatValue], [dHeight floatValue]);
-        }else{
-            CGSize imageSize = image.size;
-            destRect = CGRectMake(dx, dy, imageSize.width, imageSize.height);
-        }
-        
-        [sourceImage drawInRect:destRect];
-    }];
+    CGRect sourceRect = CGRectNull;
+    if(sx != nil && sy != nil && sWidth != nil && sHeight != nil){
+        sourceRect = CGRectMake([sx floatValue], [sy floatValue], [sWidth floatValue], [sHeight floatValue]);
+    }
+    CGSize destSize = CGSizeZero;
+    if(dWidth != nil && dHeight != nil){
+        destSize = CGSizeMake([dWidth floatValue], [dHeight floatValue]);
+    }
+    [self.displayList drawImage:image
+                     sourceRect:sourceRect
+                     destOrigin:CGPointMake([params[@"dx"] floatValue], [params[@"dy"] floatValue])
+                       destSize:destSize];
 }
 
 - (void)css_strokeStyle:(NSDictionary *)args {
-    KR_WEAK_SELF
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        weakSelf.strokeStyle = params[@"style"];
-    }];
+    [self.displayList setStrokeStyle:params[@"style"]];
 }
 
 - (void)css_fillStyle:(NSDictionary *)args {
-    KR_WEAK_SELF
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        weakSelf.fillStyle = params[@"style"];
-    }];
+    [self.displayList setFillStyle:params[@"style"]];
 }
 
 - (void)css_lineWidth:(NSDictionary *)args {
-    KR_WEAK_SELF
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-    CGFloat width = [params[@"width"] doubleValue];
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        weakSelf.lineWidth = width;
-    }];
+    [self.displayList setLineWidth:[params[@"width"] doubleValue]];
 }
 
 // 实现虚线效果
 - (void)css_lineDash:(NSDictionary *)args {
-    KR_WEAK_SELF
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
     NSArray < NSNumber * > *intervals = params[@"intervals"];
 
@@ -346,357 +219,225 @@ typedef void (^KRPathRenderAction)(CGContextRef context, CGMutablePathRef path);
         count] == 0) {
         return;
     }
-    // 基于参数绘制虚线
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        KR_STRONG_SELF_RETURN_IF_NIL
-
-        CGFloat *dashPattern = malloc(intervals.count * sizeof(CGFloat));
-        for (NSUInteger i = 0; i < intervals.count; i++) {
-            dashPattern[i] = [intervals[i] floatValue];
-
-        }
-        CGContextSetLineDash(context, 0, dashPattern, intervals.count);
-        free(dashPattern);
-    }];
+    [self.displayList setLineDash:intervals];
 }
 
 - (void)css_lineCap:(NSDictionary *)args {
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-       NSString *style = params[@"style"];
-       CGLineCap lineCap = kCGLineCapButt;
-       if ([style isEqualToString:@"round"]) {
-           lineCap = kCGLineCapRound;
-       } else if ([style isEqualToString:@"butt"]) {
-           lineCap = kCGLineCapButt;
-       } else if ([style isEqualToString:@"square"]) {
-           lineCap = kCGLineCapSquare;
-       }
-       [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-           CGContextSetLineCap(context, lineCap);
-       }];
+    NSString *style = params[@"style"];
+    CGLineCap lineCap = kCGLineCapButt;
+    if ([style isEqualToString:@"round"]) {
+        lineCap = kCGLineCapRound;
+    } else if ([style isEqualToString:@"butt"]) {
+        lineCap = kCGLineCapButt;
+    } else if ([style isEqualToString:@"square"]) {
+        lineCap = kCGLineCapSquare;
+    }
+    [self.displayList setLineCap:lineCap];
 }
 
 - (void)css_quadraticCurveTo:(NSDictionary *)args {
-    KR_WEAK_SELF;
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-       CGFloat cpx = [params[@"cpx"] doubleValue];
-       CGFloat cpy = [params[@"cpy"] doubleValue];
-       CGFloat x = [params[@"x"] doubleValue];
-       CGFloat y = [params[@"y"] doubleValue];
-       [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-           [weakSelf initDefaultInitPointIfNeed:context path:path];
-           CGPathAddQuadCurveToPoint(path, NULL, cpx, cpy, x, y);
-       }];
+    [self.displayList quadraticCurveToCPX:[params[@"cpx"] doubleValue]
+                                      cpy:[params[@"cpy"] doubleValue]
+                                        x:[params[@"x"] doubleValue]
+                                        y:[params[@"y"] doubleValue]];
 }
 
 - (void)css_bezierCurveTo:(NSDictionary *)args {
-    KR_WEAK_SELF;
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-       CGFloat cp1x = [params[@"cp1x"] doubleValue];
-       CGFloat cp1y = [params[@"cp1y"] doubleValue];
-       CGFloat cp2x = [params[@"cp2x"] doubleValue];
-       CGFloat cp2y = [params[@"cp2y"] doubleValue];
-       CGFloat x = [params[@"x"] doubleValue];
-       CGFloat y = [params[@"y"] doubleValue];
-       [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-           [weakSelf initDefaultInitPointIfNeed:context path:path];
-           CGPathAddCurveToPoint(path, NULL, cp1x, cp1y, cp2x, cp2y, x, y);
-       }];
+    [self.displayList bezierCurveToCP1X:[params[@"cp1x"] doubleValue]
+                                   cp1y:[params[@"cp1y"] doubleValue]
+                                   cp2x:[params[@"cp2x"] doubleValue]
+                                   cp2y:[params[@"cp2y"] doubleValue]
+                                      x:[params[@"x"] doubleValue]
+                                      y:[params[@"y"] doubleValue]];
 }
 
 - (void)css_clip:(NSDictionary *)args {
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-    BOOL intersect = [params[@"intersect"] boolValue];
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        CGContextAddPath(context, path);
-        if (intersect) {
-            CGContextClip(context);
-        } else {
-            CGContextEOClip(context);
-        }
-    }];
+    [self.displayList clipWithIntersect:[params[@"intersect"] boolValue]];
 }
 
 - (void)css_createLinearGradient:(NSDictionary *)args {
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-    CGFloat x0 = [params[@"x0"] doubleValue];
-    CGFloat y0 = [params[@"y0"] doubleValue];
-    CGFloat x1 = [params[@"x1"] doubleValue];
-    CGFloat y1 = [params[@"y1"] doubleValue];
-    NSString *colorStopStr = params[@"colorStops"] ?: @"";
-    NSArray<NSString *>* splits = [colorStopStr componentsSeparatedByString:@","];
-    NSMutableArray *colors = [NSMutableArray new];
-    NSMutableArray<NSNumber *> *locations = [NSMutableArray new];
-    for (int i = 0; i < splits.count; i++) {
-        NSString *colorStopStr = splits[i];
-        if (!colorStopStr.length) {
-            continue;
-        }
-        NSArray<NSString *> *colorAndStop = [colorStopStr componentsSeparatedByString:@" "];
-        UIColor *color = [UIView css_color:(NSString *)colorAndStop.firstObject];
-        [colors addObject:(__bridge id)color.CGColor];
-        [locations addObject:@([colorAndStop.lastObject floatValue])];
-    }
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
-        CGFloat locationsC[locations.count];
-        for (NSInteger i = 0; i < locations.count; i++) {
-            locationsC[i] = [locations[i] floatValue];
-        }
-        CGGradientRef gradient = CGGradientCreateWithColors(colorSpace, (__bridge CFArrayRef)colors, locations.count > 0 ? locationsC : NULL);
-        CGContextDrawLinearGradient(context, gradient, CGPointMake(x0, y0), CGPointMake(x1, y1), 0);
-        CGGradientRelease(gradient);
-        CGColorSpaceRelease(colorSpace);
-    }];
+    [self.displayList drawLinearGradientFrom:CGPointMake([params[@"x0"] doubleValue], [params[@"y0"] doubleValue])
+                                          to:CGPointMake([params[@"x1"] doubleValue], [params[@"y1"] doubleValue])
+                                  colorStops:params[@"colorStops"] ?: @""];
 }
 
 - (void)css_createRadialGradient:(NSDictionary *)args {
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-        CGFloat x0 = [params[@"x0"] doubleValue];
-        CGFloat y0 = [params[@"y0"] doubleValue];
-        CGFloat r0 = [params[@"r0"] doubleValue];
-        CGFloat x1 = [params[@"x1"] doubleValue];
-        CGFloat y1 = [params[@"y1"] doubleValue];
-        CGFloat r1 = [params[@"r1"] doubleValue];
-        CGFloat globalAlpha = [params[@"alpha"] doubleValue];
-        NSString *colorStopStr = params[@"colors"] ?: @"";
-        NSArray<NSString *>* splits = [colorStopStr componentsSeparatedByString:@","];
-        NSMutableArray *colors = [NSMutableArray new];
-        for (int i = 0; i < splits.count; i++) {
-            NSString *colorStr = splits[i];
-            UIColor *color = [UIView css_color:(NSString *)colorStr];
-            [colors addObject:(__bridge id)color.CGColor];
-        }
-        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
-        CGGradientRef gradient = CGGradientCreateWithColors(colorSpace, (__bridge CFArrayRef)colors, NULL);
-        CGContextSetAlpha(context, globalAlpha);
-        CGContextDrawRadialGradient(context, gradient, CGPointMake(x0, y0), r0, CGPointMake(x1, y1), r1, 0);
-      
-        CGGradientRelease(gradient);
-        CGColorSpaceRelease(colorSpace);
-    }];
-    [self.layer setNeedsDisplay];
+    NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
+    [self.displayList drawRadialGradientFrom:CGPointMake([params[@"x0"] doubleValue], [params[@"y0"] doubleValue])
+                                      radius:[params[@"r0"] doubleValue]
+                                          to:CGPointMake([params[@"x1"] doubleValue], [params[@"y1"] doubleValue])
+                                      radius:[params[@"r1"] doubleValue]
+                                      colors:params[@"colors"] ?: @""
+                                       alpha:[params[@"alpha"] doubleValue]];
 }
 
 - (void)css_save:(NSDictionary *)args {
-    __weak typeof(self) weakSelf = self;
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        __strong typeof(weakSelf) strongSelf = weakSelf;
-        if (!strongSelf) return;
-        CGContextSaveGState(context);
-        [strongSelf.saveStack addObject:@"gstate"];
-    }];
+    [self.displayList save];
 }
 
 - (void)css_restore:(NSDictionary *)args {
-    __weak typeof(self) weakSelf = self;
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        __strong typeof(weakSelf) strongSelf = weakSelf;
-        if (!strongSelf) return;
-        NSString *type = strongSelf.saveStack.lastObject;
-        if (type) {
-            [strongSelf.saveStack removeLastObject];
-            if ([type isEqualToString:@"layer"]) {
-                CGContextEndTransparencyLayer(context);
-                CGContextRestoreGState(context);
-            } else {
-                CGContextRestoreGState(context);
-            }
-        }
-    }];
+    [self.displayList restore];
 }
 
 - (void)css_saveLayer:(NSDictionary *)args {
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-    CGFloat x = [params[@"x"] floatValue];
-    CGFloat y = [params[@"y"] floatValue];
-    CGFloat width = [params[@"width"] floatValue];
-    CGFloat height = [params[@"height"] floatValue];
-    __weak typeof(self) weakSelf = self;
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        __strong typeof(weakSelf) strongSelf = weakSelf;
-        if (!strongSelf) return;
-        CGContextSaveGState(context);
-        CGContextBeginTransparencyLayer(context, NULL);
-        CGContextClipToRect(context, CGRectMake(x, y, width, height));
-        [strongSelf.saveStack addObject:@"layer"];
-    }];
+    [self.displayList saveLayerWithRect:CGRectMake([params[@"x"] floatValue], [params[@"y"] floatValue],
+                                                   [params[@"width"] floatValue], [params[@"height"] floatValue])];
 }
 
 - (void)css_translate:(NSDictionary *)args {
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-    CGFloat dx = [params[@"x"] floatValue];
-    CGFloat dy = [params[@"y"] floatValue];
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        CGContextTranslateCTM(context, dx, dy);
-    }];
+    [self.displayList translateX:[params[@"x"] floatValue] y:[params[@"y"] floatValue]];
 }
 
 - (void)css_scale:(NSDictionary *)args {
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-    CGFloat sx = [params[@"x"] floatValue];
-    CGFloat sy = [params[@"y"] floatValue];
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        CGContextScaleCTM(context, sx, sy);
-    }];
+    [self.displayList scaleX:[params[@"x"] floatValue] y:[params[@"y"] floatValue]];
 }
 
 - (void)css_rotate:(NSDictionary *)args {
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-    CGFloat angle = [params[@"angle"] floatValue];
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        CGContextRotateCTM(context, angle);
-    }];
+    [self.displayList rotate:[params[@"angle"] floatValue]];
 }
 
 - (void)css_skew:(NSDictionary *)args {
     NSDictionary *params = [args[KRC_PARAM_KEY] hr_stringToDictionary];
-    CGFloat sx = [params[@"x"] floatValue];
-    CGFloat sy = [params[@"y"] floatValue];
-    [self addRenderAction:^(CGContextRef context, CGMutablePathRef path) {
-        CGAffineTransform transform = CGAffineTransformMake(1, sy, sx, 1, 0, 0);
-        CGContextConcatCTM(context, transform);
-    }];
+    [self.displayList skewX:[params[@"x"] floatValue] y:[params[@"y"] floatValue]];
+}
+
+/*
+ * 批量提交一帧的绘制命令，参数为命令流（NSData，或其base64字符串），格式见KRCanvasCommandStream.h
+ */
+- (void)css_drawCommands:(NSDictionary *)args {
+    id params = args[KRC_PARAM_KEY];
+    NSData *data = nil;
+    if ([params isKindOfClass:[NSData class]]) {
+        data = params;
+    } else if ([params isKindOfClass:[NSString class]]) {
+        data = [[NSData alloc] initWithBase64EncodedString:params options:NSDataBase64DecodingIgnoreUnknownCharacters];
+    }
+    if (data) {
+        [self drawCommandsWithData:data];
+    }
+}
+
+- (void)drawCommandsWithData:(NSData *)data {
+    if (!data.length) {
+        return;
+    }
+    KRMemoryCacheModule *module = [self.hr_rootView moduleWithName:NSStringFromClass([KRMemoryCacheModule class])];
+    self.displayList.contextParam = self.hr_rootView.contextParam;
+    NSError *error = nil;
+    [KRCanvasCommandStream decodeData:data
+                        toDisplayList:self.displayList
+                        imageProvider:^UIImage * _Nullable(NSString *cacheKey) {
+        return [module imageWithKey:cacheKey];
+    } error:&error];
+    if (error) {
+        [KRLogModule logError:[NSString stringWithFormat:@"canvas drawCommands failed: %@", error.localizedDescription]];
+    }
+    [self p_setNeedsDisplayForDirtyRect];
 }
 
 #pragma mark - override
 
 - (void)drawRect:(CGRect)rect {
     [super drawRect:rect];
+    if (_asyncLayer) {
+        return;
+    }
+    self.pendingDisplayRect = CGRectNull;
+    [self.displayList clearDirtyRect];
     CGContextRef context = UIGraphicsGetCurrentContext();
     if (!context) {
         return;
     }
-    for (KRPathRenderAction action in self.renderActions) {
-        action(context, self.path);
-    }
+    [self.displayList replayInContext:context clipRect:rect];
 }
 
 
 
 - (void)setFrame:(CGRect)frame {
     [super setFrame:frame];
-    [self setNeedsDisplay];
+    if (_asyncLayer) {
+        [CATransaction begin];
+        [CATransaction setDisableActions:YES];
+        _asyncLayer.frame = self.bounds;
+        [CATransaction commit];
+    }
+    [self p_setNeedsFullDisplay];
 }
 
-#pragma mark - getter
+#pragma mark - private
 
-
-- (NSMutableArray<KRPathRenderAction> *)renderActions {
-    if (!_renderActions) {
-        _renderActions = [[NSMutableArray alloc] init];
+- (void)p_setNeedsFullDisplay {
+    self.pendingDisplayRect = self.bounds;
+    if (_asyncLayer) {
+        [self p_scheduleAsyncDisplay];
+        return;
     }
-    return _renderActions;
+    [self setNeedsDisplay];
 }
 
-// 在ios中，首次绘制图案，默认原点(0, 0)未生效，需要手动设置一次move到该原点，对齐安卓
-- (void)initDefaultInitPointIfNeed:(CGContextRef)context path:(CGMutablePathRef) path {
-    CGPoint point = CGPathGetCurrentPoint(path);
-    if (CGPointEqualToPoint(point, CGPointZero)) {
-        CGPathMoveToPoint(path, NULL, 0, 0);
+/// 只重绘新增命令覆盖的区域，已提交的区域包含新增区域时不再重复提交
+- (void)p_setNeedsDisplayForDirtyRect {
+    CGRect dirtyRect = CGRectIntersection(self.displayList.dirtyRect, self.bounds);
+    if (CGRectIsNull(dirtyRect) || CGRectIsEmpty(dirtyRect)) {
+        return;
     }
+    if (!CGRectIsNull(self.pendingDisplayRect) && CGRectContainsRect(self.pendingDisplayRect, dirtyRect)) {
+        return;
+    }
+    self.pendingDisplayRect = CGRectUnion(self.pendingDisplayRect, dirtyRect);
+    if (_asyncLayer) {
+        [self p_scheduleAsyncDisplay];
+        return;
+    }
+    [self setNeedsDisplayInRect:dirtyRect];
 }
 
-- (CGGradientRef)gradientWithColorStopsStr:(NSString *)colorStopStr {
-    NSArray<NSString *>* splits = [colorStopStr componentsSeparatedByString:@","];
-    NSMutableArray *colors = [NSMutableArray new];
-    NSMutableArray<NSNumber *> *locations = [NSMutableArray new];
-    for (int i = 0; i < splits.count; i++) {
-        NSString *colorStopStr = splits[i];
-        if (!colorStopStr.length) {
-            continue;
-        }
-        NSArray<NSString *> *colorAndStop = [colorStopStr componentsSeparatedByString:@" "];
-        UIColor *color = [UIView css_color:(NSString *)colorAndStop.firstObject];
-        [colors addObject:(__bridge id)color.CGColor];
-        [locations addObject:@([colorAndStop.lastObject floatValue])];
-    }
-    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
-    CGFloat locationsC[locations.count];
-    for (NSInteger i = 0; i < locations.count; i++) {
-        locationsC[i] = [locations[i] floatValue];
+/// 同一轮主线程任务内的变更合并为一次光栅化
+- (void)p_scheduleAsyncDisplay {
+    if (_asyncDisplayScheduled) {
+        return;
     }
-    CGGradientRef gradient = CGGradientCreateWithColors(colorSpace, (__bridge CFArrayRef)colors, locations.count > 0 ? locationsC : NULL);
+    _asyncDisplayScheduled = YES;
+    KR_WEAK_SELF
     dispatch_async(dispatch_get_main_queue(), ^{
-        // 释放资源
-        CGGradientRelease(gradient);
-        CGColorSpaceRelease(colorSpace);
+        [weakSelf p_asyncDisplay];
     });
-    return gradient;
-}
-
-- (void)applyStrokeStyle:(CGContextRef)context path:(CGMutablePathRef) path {
-    if (self.strokeStyle.length) {
-        NSString *linearGradientPrefix = @"linear-gradient";
-        if ([self.strokeStyle hasPrefix:linearGradientPrefix]) {
-            
-           NSDictionary *params = [[self.strokeStyle substringFromIndex:linearGradientPrefix.length] kr_stringToDictionary];
-            CGFloat x0 = [params[@"x0"] doubleValue];
-            CGFloat y0 = [params[@"y0"] doubleValue];
-            CGFloat x1 = [params[@"x1"] doubleValue];
-            CGFloat y1 = [params[@"y1"] doubleValue];
-            NSString *colorStopStr = params[@"colorStops"] ?: @"";
-            CGGradientRef gradient = [self gradientWithColorStopsStr:colorStopStr];
-            // 保存当前图形状态
-            CGContextSaveGState(context);
-            CGContextReplacePathWithStrokedPath(context);
-            // 将上下文裁剪为路径
-            CGContextClip(context);
-            // 绘制渐变
-            CGContextDrawLinearGradient(context, gradient, CGPointMake(x0, y0), CGPointMake(x1, y1), 0);
-            // 恢复先前的图形状态（包括裁剪状态）
-            CGContextRestoreGState(context);
-            
-            CGContextSetStrokeColorWithColor(context, [UIColor clearColor].CGColor);
-        } else {
-            UIColor *color = [UIView css_color:self.strokeStyle];
-            CGContextSetStrokeColorWithColor(context, color.CGColor);
-        }
-    } else {
-        CGContextSetStrokeColorWithColor(context, [UIColor clearColor].CGColor);
-    }
-}
-- (void)applyFillStyle:(CGContextRef)context path:(CGMutablePathRef) path {
-    if (self.fillStyle.length) {
-        //渐变
-        NSString *linearGradientPrefix = @"linear-gradient";
-        if ([self.fillStyle hasPrefix:linearGradientPrefix]) {
-            
-           NSDictionary *params = [[self.fillStyle substringFromIndex:linearGradientPrefix.length] kr_stringToDictionary];
-            CGFloat x0 = [params[@"x0"] doubleValue];
-            CGFloat y0 = [params[@"y0"] doubleValue];
-            CGFloat x1 = [params[@"x1"] doubleValue];
-            CGFloat y1 = [params[@"y1"] doubleValue];
-            NSString *colorStopStr = params[@"colorStops"] ?: @"";
-            CGGradientRef gradient = [self gradientWithColorStopsStr:colorStopStr];
-            // 保存当前图形状态
-            CGContextSaveGState(context);
-            // 将上下文裁剪为路径
-            CGContextClip(context);
-            // 绘制渐变
-            CGContextDrawLinearGradient(context, gradient, CGPointMake(x0, y0), CGPointMake(x1, y1), 0);
-            // 恢复先前的图形状态（包括裁剪状态）
-            CGContextRestoreGState(context);
-            CGContextSetFillColorWithColor(context, [UIColor clearColor].CGColor);
-        } else {
-            UIColor *color = [UIView css_color:self.fillStyle];
-            CGContextSetFillColorWithColor(context, color.CGColor);
-        }
-    } else {
-        CGContextSetFillColorWithColor(context, [UIColor clearColor].CGColor);
-    }
 }
 
-
-#pragma mark - dealloc
-
-- (void)dealloc {
-
-    if (_path) {
-        CGPathRelease(_path);
+- (void)p_asyncDisplay {
+    _asyncDisplayScheduled = NO;
+    if (!_asyncLayer) {
+        return;
+    }
+    _asyncInFlightRect = CGRectUnion(_asyncInFlightRect, self.pendingDisplayRect);
+    self.pendingDisplayRect = CGRectNull;
+    [self.displayList clearDirtyRect];
+    CGSize size = self.bounds.size;
+    if (CGRectIsNull(_asyncInFlightRect) || size.width <= 0 || size.height <= 0) {
+        return;
     }
+    KR_WEAK_SELF
+    [_rasterizer rasterizeDisplayList:[self.displayList copy]
+                                 size:size
+                                scale:_asyncLayer.contentsScale
+                            dirtyRect:_asyncInFlightRect
+                           completion:^(CGImageRef image) {
+        KR_STRONG_SELF_RETURN_IF_NIL
+        strongSelf->_asyncInFlightRect = CGRectNull;
+        [CATransaction begin];
+        [CATransaction setDisableActions:YES];
+        strongSelf->_asyncLayer.contents = (__bridge id)image;
+        [CATransaction commit];
+    }];
 }
 
-
 @end
@@ -34,7 +34,7 @@
 @synthesize hr_rootView;
 - (instancetype)initWithFrame:(CGRect)frame {
     if (self = [super initWithFrame:frame]) {
-        
+        self.kr_virtualizationDisable = YES; // 吸顶需常驻视图树
     }
     return self;
 }
@@ -119,9 +119,11 @@
     // 仅支持垂直方向置顶
     if (offset.y  > CGRectGetMinY(frame) - [self.css_hoverMarginTop floatValue]) {
         frame.origin.y = offset.y + [self.css_hoverMarginTop floatValue];
-        self.frame = frame;
-    } else {
-        self.frame = frame;
+    }
+    CGRect oldFrame = self.frame;
+    self.frame = frame;
+    if (!CGRectEqualToRect(oldFrame, frame)) {
+        [KRScrollContentView subviewFrameDidChange:self];
     }
     [self adjustHoverViewLayerIfNeed];
 }
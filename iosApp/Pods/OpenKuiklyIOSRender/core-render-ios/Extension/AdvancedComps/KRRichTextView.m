@@ -24,6 +24,8 @@ NSString *const KuiklyIndexAttributeName = @"KuiklyIndexAttributeName";
 
 @property (nonatomic, strong) NSNumber *css_numberOfLines;
 @property (nonatomic, strong) NSString *css_lineBreakMode;
+/// 是否在后台线程绘制文本
+@property (nonatomic, strong) NSNumber *css_asyncDisplay;
 
 
 @end
@@ -51,6 +53,7 @@ NSString *const KuiklyIndexAttributeName = @"KuiklyIndexAttributeName";
     self.attributedText = nil;
     self.css_numberOfLines = nil;
     self.css_lineBreakMode = nil;
+    self.css_asyncDisplay = nil;
 }
 
 + (id<KuiklyRenderShadowProtocol>)hrv_createShadow {
@@ -79,6 +82,11 @@ NSString *const KuiklyIndexAttributeName = @"KuiklyIndexAttributeName";
     }
 }
 
+- (void)setCss_asyncDisplay:(NSNumber *)css_asyncDisplay {
+    _css_asyncDisplay = css_asyncDisplay;
+    self.displaysAsynchronously = [css_asyncDisplay boolValue];
+}
+
 #pragma mark - override
 
 - (void)css_onClickTapWithSender:(UIGestureRecognizer *)sender {
@@ -117,6 +125,29 @@ NSString *const KuiklyIndexAttributeName = @"KuiklyIndexAttributeName";
 
 @end
 
+/// 不同约束尺寸下缓存的排版结果个数上限
+static const NSUInteger kKRRichTextMeasureCacheLimit = 4;
+
+/// 单个span解析后的样式段，样式与内容不变时可跨排版复用
+@interface KRRichTextSpanRun : NSObject
+
+@property (nonatomic, strong) NSDictionary *span;
+/// 构建时shadow的基础样式版本
+@property (nonatomic, assign) NSUInteger baseStyleVersion;
+/// 构建时从前面span继承的textPostProcessor
+@property (nonatomic, copy, nullable) NSString *inheritedTextPostProcessor;
+/// 本span生效的textPostProcessor（含继承）
+@property (nonatomic, copy, nullable) NSString *textPostProcessor;
+@property (nonatomic, strong, nullable) UIFont *font;
+@property (nonatomic, strong, nullable) NSAttributedString *attributedString;
+/// 占位span的attachment
+@property (nonatomic, strong, nullable) KRRichTextAttachment *attachment;
+
+@end
+
+@implementation KRRichTextSpanRun
+@end
+
 /// KRRichTextShadow
 @interface KRRichTextShadow()
 
@@ -126,6 +157,20 @@ NSString *const KuiklyIndexAttributeName = @"KuiklyIndexAttributeName";
     NSMutableDictionary<NSString *, id> *_props; // context thread used
     NSArray<NSDictionary *> * _spans; // context thread used
     NSMutableAttributedString *_mAttributedString; // context thread used
+    /// 任意属性变化时递增
+    NSUInteger _contentVersion;
+    /// values以外的属性变化时递增，所有span需重建
+    NSUInteger _baseStyleVersion;
+    /// 已解析的values及其原始值
+    id _parsedValues;
+    NSArray<NSDictionary *> *_parsedSpans;
+    NSArray<KRRichTextSpanRun *> *_spanRuns;
+    /// 当前版本拼接好的富文本，测量时会复制，本身不挂排版结果
+    NSMutableAttributedString *_builtAttributedString;
+    NSUInteger _builtVersion;
+    /// 测量结果，key为约束尺寸，value为挂有排版结果的富文本
+    NSMutableDictionary<NSValue *, NSMutableAttributedString *> *_measureCache;
+    NSUInteger _measureCacheVersion;
 }
 
 #pragma mark - KuiklyRenderShadowProtocol
@@ -134,19 +179,53 @@ NSString *const KuiklyIndexAttributeName = @"KuiklyIndexAttributeName";
     if (!_props) {
         _props = [[NSMutableDictionary alloc] init];
     }
+    id oldValue = _props[propKey];
+    if (oldValue == propValue || [oldValue isEqual:propValue]) {
+        return;
+    }
     _props[propKey] = propValue;
+    _contentVersion++;
+    if (![propKey isEqualToString:@"values"]) {
+        _baseStyleVersion++;
+    }
+}
+
+- (void)setStrokeAndFill:(bool)strokeAndFill {
+    if (_strokeAndFill != strokeAndFill) {
+        _strokeAndFill = strokeAndFill;
+        _contentVersion++;
+        _baseStyleVersion++;
+    }
 }
 
 
 - (CGSize)hrv_calculateRenderViewSizeWithConstraintSize:(CGSize)constraintSize {
-    _mAttributedString = [self p_buildAttributedString];
-   
     CGFloat height = constraintSize.height > 0 ? constraintSize.height : MAXFLOAT;
+    if (!_measureCache) {
+        _measureCache = [NSMutableDictionary new];
+    }
+    if (_measureCacheVersion != _contentVersion) {
+        [_measureCache removeAllObjects];
+        _measureCacheVersion = _contentVersion;
+    }
+    NSValue *cacheKey = [NSValue valueWithCGSize:CGSizeMake(constraintSize.width, height)];
+    NSMutableAttributedString *cachedAttributedString = _measureCache[cacheKey];
+    if (cachedAttributedString) {
+        _mAttributedString = cachedAttributedString;
+        return cachedAttributedString.hr_size;
+    }
+    // 排版结果挂在富文本上，且可能已交给主线程，每个约束各用一份拷贝
+    _mAttributedString = [[self p_buildAttributedString] mutableCopy];
+   
     NSInteger numberOfLines = [KRConvertUtil NSInteger:_props[@"numberOfLines"]];
     NSLineBreakMode lineBreakMode = [KRConvertUtil NSLineBreakMode:_props[@"lineBreakMode"]];
     CGFloat lineBreakMargin = [KRConvertUtil CGFloat:_props[@"lineBreakMargin"]];
     CGFloat lineHeight = [KRConvertUtil CGFloat:_props[@"lineHeight"]];
     CGSize fitSize = [KRLabel sizeThatFits:CGSizeMake(constraintSize.width, height) attributedString:_mAttributedString numberOfLines:numberOfLines lineBreakMode:lineBreakMode lineBreakMarin:lineBreakMargin lineHeight:lineHeight];
+    if (_measureCache.count >= kKRRichTextMeasureCacheLimit) {
+        [_measureCache removeAllObjects];
+    }
+    _measureCache[cacheKey] = _mAttributedString;
     return fitSize;
 }
 
@@ -170,109 +249,57 @@ NSString *const KuiklyIndexAttributeName = @"KuiklyIndexAttributeName";
 #pragma mark - public
 
 - (NSAttributedString *)buildAttributedString {
-    return [self p_buildAttributedString];
+    return [[self p_buildAttributedString] copy];
 }
 
 #pragma mark - private
 
+- (NSArray<NSDictionary *> *)p_parsedSpans {
+    id values = _props[@"values"];
+    if (_parsedSpans && (values == _parsedValues || [values isEqual:_parsedValues])) {
+        return _parsedSpans;
+    }
+    _parsedValues = values;
+    _parsedSpans = [KRConvertUtil hr_arrayWithJSONString:values];
+    return _parsedSpans;
+}
+
+/// 按span拼接富文本，内容未变时直接复用，仅重建变化的span
 - (NSMutableAttributedString *)p_buildAttributedString {
-    NSArray *spans = [KRConvertUtil hr_arrayWithJSONString:_props[@"values"]];
+    if (_builtAttributedString && _builtVersion == _contentVersion) {
+        return _builtAttributedString;
+    }
+    NSArray *spans = [self p_parsedSpans];
     if (!spans.count) {
-        spans = @[_props ? : @{}];
+        spans = @[_props ? [_props copy] : @{}];
     }
     _spans = spans;
+    NSArray<KRRichTextSpanRun *> *oldRuns = _spanRuns;
+    NSMutableArray<KRRichTextSpanRun *> *runs = [NSMutableArray arrayWithCapacity:spans.count];
     NSString *textPostProcessor = nil;
-    NSMutableArray * richAttrArray = [NSMutableArray new];
     UIFont *mainFont = nil;
-    for (NSMutableDictionary * span in spans) {
-        if (span[@"placeholderWidth"]) { // 属于占位span
-            NSAttributedString *placeholderSpanAttributedString = [self p_createPlaceholderSpanAttributedStringWithSpan:span];
-            [richAttrArray addObject:placeholderSpanAttributedString];
-            continue;
-        }
-        
-        NSString *text = span[@"value"] ?: span[@"text"];
-        if (!text.length) {
-            continue;
-        }
-        NSMutableDictionary *propStyle = [(_props ? : @{}) mutableCopy];
-        [propStyle addEntriesFromDictionary:span];
-        
-        // 批量解析与字体相关的属性
-        UIFont *font = [KRConvertUtil UIFont:propStyle];
-        
-        // 解析颜色：包括渐变色和纯色
-        UIColor * color = [UIView css_color:propStyle[@"color"]] ?: [UIColor blackColor];
-        NSString *cssGricent = propStyle[@"backgroundImage"];
-        BOOL hasGradient = NO;
-        if (cssGricent && [cssGricent hasPrefix:@"linear-gradient("]) {
-            hasGradient = YES;
-        }
-        
-        CGFloat letterSpacing = [KRConvertUtil CGFloat:propStyle[@"letterSpacing"]];
-        KRTextDecorationLineType textDecoration = [KRConvertUtil KRTextDecorationLineType:propStyle[@"textDecoration"]];
-        NSTextAlignment textAlign = [KRConvertUtil NSTextAlignment:propStyle[@"textAlign"]];
-        NSNumber *lineHeight = nil;
-        NSNumber *lineSpacing = nil;
-        NSNumber *paragraphSpacing = propStyle[@"paragraphSpacing"] ? @([KRConvertUtil CGFloat:propStyle[@"paragraphSpacing"]]) : nil;
-        if (propStyle[@"lineHeight"]) {
-            lineHeight = @([KRConvertUtil CGFloat:propStyle[@"lineHeight"]]);
-        } else {
-            lineSpacing = @([KRConvertUtil CGFloat:propStyle[@"lineSpacing"]]);
-        }
-        CGFloat headIndent = [KRConvertUtil CGFloat:propStyle[@"headIndent"]];
-        UIColor *strokeColor = [UIView css_color:propStyle[@"strokeColor"]];
-        CGFloat strokeWidth = [KRConvertUtil CGFloat:propStyle[@"strokeWidth"]];
-        NSInteger spanIndex = [spans indexOfObject:span];
-        
-        NSShadow *textShadow = nil;
-        NSString *cssTextShadow = propStyle[@"textShadow"];
-        if ([cssTextShadow isKindOfClass:[NSString class]] && cssTextShadow.length > 0) {
-            CSSBoxShadow *shadow = [[CSSBoxShadow alloc] initWithCSSBoxShadow:cssTextShadow];
-            
-            textShadow = [NSShadow new];
-            textShadow.shadowColor = shadow.shadowColor;
-            textShadow.shadowOffset = CGSizeMake(shadow.offsetX, shadow.offsetY);
-            textShadow.shadowBlurRadius = shadow.shadowRadius;
-        }
-        if (propStyle[@"textPostProcessor"]) {
-            textPostProcessor = propStyle[@"textPostProcessor"];
+    NSMutableAttributedString *resAttr = [[NSMutableAttributedString alloc] init];
+    for (NSUInteger spanIndex = 0; spanIndex < spans.count; spanIndex++) {
+        NSDictionary *span = spans[spanIndex];
+        KRRichTextSpanRun *run = spanIndex < oldRuns.count ? oldRuns[spanIndex] : nil;
+        BOOL reusable = run && !run.attachment
+            && run.baseStyleVersion == _baseStyleVersion
+            && (run.inheritedTextPostProcessor == textPostProcessor || [run.inheritedTextPostProcessor isEqualToString:textPostProcessor])
+            && [run.span isEqual:span];
+        if (!reusable) {
+            run = [self p_createSpanRunWithSpan:span spanIndex:spanIndex inheritedTextPostProcessor:textPostProcessor];
         }
-
+        [runs addObject:run];
+        textPostProcessor = run.textPostProcessor;
         if (!mainFont) {
-            mainFont = font;
-        }
-        if ([textPostProcessor isKindOfClass:[NSString class]] && textPostProcessor.length) {
-            // 代理
-            if ([[KuiklyRenderBridge componentExpandHandler] respondsToSelector:@selector(kr_customTextWithText:textPostProcessor:)]) {
-                text = [[KuiklyRenderBridge componentExpandHandler] kr_customTextWithText:text textPostProcessor:textPostProcessor];
-            }
+            mainFont = run.font;
         }
-        
-        NSMutableAttributedString *spanAttrString = [self p_createSpanAttributedStringWithText:text
-                                                                                     spanIndex:spanIndex
-                                                                                          font:font
-                                                                                         color:color
-                                                                                   hasGradient:hasGradient  // 新增参数
-                                                                                    cssGricent:cssGricent  // 新增参数
-                                                                                 letterSpacing:letterSpacing
-                                                                                textDecoration:textDecoration
-                                                                                     textAlign:textAlign
-                                                                                   lineSpacing:lineSpacing
-                                                                                     lineHeight:lineHeight
-                                                                              paragraphSpacing:paragraphSpacing
-                                                                                     headIndent:headIndent strokeColor:strokeColor
-                                                                                   strokeWidth:strokeWidth
-                                                                                        shadow:textShadow];
-        if (spanAttrString) {
-            [richAttrArray addObject:spanAttrString];
+        if (run.attributedString) {
+            [resAttr appendAttributedString:run.attributedString];
         }
     }
-    
-    NSMutableAttributedString *resAttr = [[NSMutableAttributedString alloc] init];
-    for (NSAttributedString *attr in richAttrArray) {
-        [resAttr appendAttributedString:attr];
-    }
+    _spanRuns = runs;
+
     if ([textPostProcessor isKindOfClass:[NSString class]] && textPostProcessor.length) {
         // 代理
         if ([[KuiklyRenderBridge componentExpandHandler] respondsToSelector:@selector(kr_customTextWithAttributedString:font:textPostProcessor:)]) {
@@ -285,9 +312,101 @@ NSString *const KuiklyIndexAttributeName = @"KuiklyIndexAttributeName";
             resAttr = [[KuiklyRenderBridge componentExpandHandler] hr_customTextWithAttributedString:resAttr textPostProcessor:textPostProcessor];
         }
     }
+    _builtAttributedString = resAttr;
+    _builtVersion = _contentVersion;
     return resAttr;
 }
 
+- (KRRichTextSpanRun *)p_createSpanRunWithSpan:(NSDictionary *)span
+                                     spanIndex:(NSUInteger)spanIndex
+                    inheritedTextPostProcessor:(NSString *)inheritedTextPostProcessor {
+    KRRichTextSpanRun *run = [KRRichTextSpanRun new];
+    run.span = span;
+    run.baseStyleVersion = _baseStyleVersion;
+    run.inheritedTextPostProcessor = inheritedTextPostProcessor;
+    run.textPostProcessor = inheritedTextPostProcessor;
+    if (span[@"placeholderWidth"]) { // 属于占位span
+        KRRichTextAttachment *attachment = nil;
+        run.attributedString = [self p_createPlaceholderSpanAttributedStringWithSpan:span attachment:&attachment];
+        run.attachment = attachment;
+        return run;
+    }
+    
+    NSString *text = span[@"value"] ?: span[@"text"];
+    if (!text.length) {
+        return run;
+    }
+    NSMutableDictionary *propStyle = [(_props ? : @{}) mutableCopy];
+    [propStyle addEntriesFromDictionary:span];
+    
+    // 批量解析与字体相关的属性
+    UIFont *font = [KRConvertUtil UIFont:propStyle];
+    run.font = font;
+    
+    // 解析颜色：包括渐变色和纯色
+    UIColor * color = [UIView css_color:propStyle[@"color"]] ?: [UIColor blackColor];
+    NSString *cssGricent = propStyle[@"backgroundImage"];
+    BOOL hasGradient = NO;
+    if (cssGricent && [cssGricent hasPrefix:@"linear-gradient("]) {
+        hasGradient = YES;
+    }
+    
+    CGFloat letterSpacing = [KRConvertUtil CGFloat:propStyle[@"letterSpacing"]];
+    KRTextDecorationLineType textDecoration = [KRConvertUtil KRTextDecorationLineType:propStyle[@"textDecoration"]];
+    NSTextAlignment textAlign = [KRConvertUtil NSTextAlignment:propStyle[@"textAlign"]];
+    NSNumber *lineHeight = nil;
+    NSNumber *lineSpacing = nil;
+    NSNumber *paragraphSpacing = propStyle[@"paragraphSpacing"] ? @([KRConvertUtil CGFloat:propStyle[@"paragraphSpacing"]]) : nil;
+    if (propStyle[@"lineHeight"]) {
+        lineHeight = @([KRConvertUtil CGFloat:propStyle[@"lineHeight"]]);
+    } else {
+        lineSpacing = @([KRConvertUtil CGFloat:propStyle[@"lineSpacing"]]);
+    }
+    CGFloat headIndent = [KRConvertUtil CGFloat:propStyle[@"headIndent"]];
+    UIColor *strokeColor = [UIView css_color:propStyle[@"strokeColor"]];
+    CGFloat strokeWidth = [KRConvertUtil CGFloat:propStyle[@"strokeWidth"]];
+    
+    NSShadow *textShadow = nil;
+    NSString *cssTextShadow = propStyle[@"textShadow"];
+    if ([cssTextShadow isKindOfClass:[NSString class]] && cssTextShadow.length > 0) {
+        CSSBoxShadow *shadow = [[CSSBoxShadow alloc] initWithCSSBoxShadow:cssTextShadow];
+        
+        textShadow = [NSShadow new];
+        textShadow.shadowColor = shadow.shadowColor;
+        textShadow.shadowOffset = CGSizeMake(shadow.offsetX, shadow.offsetY);
+        textShadow.shadowBlurRadius = shadow.shadowRadius;
+    }
+    NSString *textPostProcessor = inheritedTextPostProcessor;
+    if (propStyle[@"textPostProcessor"]) {
+        textPostProcessor = propStyle[@"textPostProcessor"];
+        run.textPostProcessor = textPostProcessor;
+    }
+
+    if ([textPostProcessor isKindOfClass:[NSString class]] && textPostProcessor.length) {
+        // 代理
+        if ([[KuiklyRenderBridge componentExpandHandler] respondsToSelector:@selector(kr_customTextWithText:textPostProcessor:)]) {
+            text = [[KuiklyRenderBridge componentExpandHandler] kr_customTextWithText:text textPostProcessor:textPostProcessor];
+        }
+    }
+    
+    run.attributedString = [[self p_createSpanAttributedStringWithText:text
+                                                             spanIndex:spanIndex
+                                                                  font:font
+                                                                 color:color
+                                                           hasGradient:hasGradient
+                                                            cssGricent:cssGricent
+                                                         letterSpacing:letterSpacing
+                                                        textDecoration:textDecoration
+                                                             textAlign:textAlign
+                                                           lineSpacing:lineSpacing
+                                                             lineHeight:lineHeight
+                                                      paragraphSpacing:paragraphSpacing
+                                                             headIndent:headIndent strokeColor:strokeColor
+                                                           strokeWidth:strokeWidth
+                                                                shadow:textShadow] copy];
+    return run;
+}
+
 
 - (nullable NSMutableAttributedString *)p_createSpanAttributedStringWithText:(NSString *)text
                                                                    spanIndex:(NSUInteger)spanIndex
@@ -347,7 +466,7 @@ NSString *const KuiklyIndexAttributeName = @"KuiklyIndexAttributeName";
     
 }
 
-- (NSAttributedString *)p_createPlaceholderSpanAttributedStringWithSpan:(NSMutableDictionary *)span {
+- (NSAttributedString *)p_createPlaceholderSpanAttributedStringWithSpan:(NSDictionary *)span attachment:(KRRichTextAttachment **)outAttachment {
     KRRichTextAttachment *attachment = [[KRRichTextAttachment alloc] init];
     CGFloat height = [span[@"placeholderHeight"] doubleValue];
     CGFloat width = [span[@"placeholderWidth"] doubleValue];
@@ -371,8 +490,8 @@ NSString *const KuiklyIndexAttributeName = @"KuiklyIndexAttributeName";
     }
 
     attachment.bounds = CGRectMake(0, -attachment.offsetY, width, height);
-    if ([span isKindOfClass:[NSMutableDictionary class]]) {
-        ((NSMutableDictionary *)span)[@"attachment"] = attachment;
+    if (outAttachment) {
+        *outAttachment = attachment;
     }
 
     NSAttributedString *attrString = [NSAttributedString attributedStringWithAttachment:attachment];
@@ -421,8 +540,8 @@ NSString *const KuiklyIndexAttributeName = @"KuiklyIndexAttributeName";
         return @"";
     }
     NSInteger spanIndex = [params intValue];
-    if (spanIndex < _spans.count ) {
-        KRRichTextAttachment *attachment = _spans[spanIndex][@"attachment"];
+    if (spanIndex >= 0 && spanIndex < _spanRuns.count) {
+        KRRichTextAttachment *attachment = _spanRuns[spanIndex].attachment;
 
         // 检查attachment是否在可见范围内
         NSInteger numberOfLines = [KRConvertUtil NSInteger:_props[@"numberOfLines"]];
@@ -104,6 +104,21 @@ typedef void(^ImageCompletionBlock)(UIImage * _Nullable image, NSError * _Nullab
  */
 - (BOOL)hr_setImageWithUrl:(nullable NSString *)url forImageView:(UIImageView *)imageView complete:(ImageCompletionBlock)completeBlock;
 
+/*
+ * 自定义实现设置图片（带目标像素尺寸，实现后优先于以上两个方法调用）
+ * @param url 设置的图片url，如果url为nil，则是取消图片设置，需要view.image = nil
+ * @param targetPixelSize 按view尺寸和屏幕scale计算的目标像素尺寸，可按该尺寸降采样解码以节省内存，
+ *                        CGSizeZero表示需按原图解码；降采样时缓存key需包含该尺寸
+ * @param complete 图片处理完成后的回调
+ * @return 是否处理该图片设置，返回值为YES，则交给该代理实现，否则sdk内部自己处理
+ *
+ * 注意：降采样解码后请设置image.kr_originalPixelSize为原图像素尺寸，以保证loadResolution回调原图尺寸
+ */
+- (BOOL)hr_setImageWithUrl:(nullable NSString *)url
+              forImageView:(UIImageView *)imageView
+           targetPixelSize:(CGSize)targetPixelSize
+                  complete:(ImageCompletionBlock)completeBlock;
+
 /*
  * 自定义实现设置颜值
  * @param value 设置的颜色值
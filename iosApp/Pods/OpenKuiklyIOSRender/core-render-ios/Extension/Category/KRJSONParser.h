@@ -0,0 +1,35 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * @brief JSON解析（NSJSONSerialization的替代实现）
+ * 解析只生成tape，返回的NSDictionary/NSArray为只读懒加载容器：元素在首次访问时才创建并缓存，
+ * 调用方只读取少量字段时可避免构建整棵对象树。容器可跨线程读取。
+ * 数值为NSNumber（整数long long、小数double），true/false为@YES/@NO，null为NSNull。
+ */
+@interface KRJSONParser : NSObject
+
+/// 解析UTF-8 JSON数据，失败返回nil
++ (nullable id)objectWithData:(NSData *)data error:(NSError * _Nullable * _Nullable)error;
++ (nullable id)objectWithUTF8Bytes:(const char *)bytes length:(NSUInteger)length error:(NSError * _Nullable * _Nullable)error;
++ (nullable id)objectWithString:(NSString *)string;
+
+@end
+
+NS_ASSUME_NONNULL_END
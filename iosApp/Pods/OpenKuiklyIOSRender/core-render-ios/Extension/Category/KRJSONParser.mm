@@ -0,0 +1,274 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRJSONParser.h"
+#import "KRJSONParserCore.hpp"
+
+#include <memory>
+#include <mutex>
+
+using kuikly::json::Document;
+using kuikly::json::TapeType;
+
+static NSString *const KRJSONParserErrorDomain = @"KRJSONParserErrorDomain";
+
+typedef std::shared_ptr<const Document> KRJSONDocumentRef;
+
+static id KRJSONMaterialize(const KRJSONDocumentRef &document, size_t index);
+
+static NSString *KRJSONStringAt(const Document &document, size_t index) {
+    uint32_t length = 0;
+    const char *bytes = document.StringAt(index, &length);
+    return [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding] ?: @"";
+}
+
+#pragma mark - KRLazyJSONDictionary
+
+/*
+ * 只读字典，首次按key访问时建立key索引（小对象直接顺序比较UTF-8字节），值按需创建
+ */
+@interface KRLazyJSONDictionary : NSDictionary
+
+- (instancetype)initWithDocument:(const KRJSONDocumentRef &)document index:(size_t)index;
+
+@end
+
+@implementation KRLazyJSONDictionary {
+    KRJSONDocumentRef _document;
+    size_t _index;
+    NSUInteger _count;
+    std::mutex _mutex;
+    /// 每个键值对的值所在tape下标
+    std::vector<size_t> _valueIndexes;
+    std::vector<id> _values;
+    NSArray<NSString *> *_keys;
+    NSDictionary<NSString *, NSNumber *> *_slotsByKey;
+}
+
+- (instancetype)initWithDocument:(const KRJSONDocumentRef &)document index:(size_t)index {
+    if (self = [super init]) {
+        _document = document;
+        _index = index;
+        size_t end = document->ContainerEndAt(index);
+        for (size_t i = index + 1; i < end; i = document->NextIndex(document->NextIndex(i))) {
+            _valueIndexes.push_back(document->NextIndex(i));
+        }
+        _count = _valueIndexes.size();
+        _values.resize(_count);
+    }
+    return self;
+}
+
+- (NSUInteger)count {
+    return _count;
+}
+
+- (id)objectForKey:(id)aKey {
+    if (![aKey isKindOfClass:[NSString class]]) {
+        return nil;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    NSInteger slot = [self p_slotForKey:aKey];
+    if (slot < 0) {
+        return nil;
+    }
+    id value = _values[slot];
+    if (!value) {
+        value = KRJSONMaterialize(_document, _valueIndexes[slot]);
+        _values[slot] = value;
+    }
+    return value;
+}
+
+- (NSEnumerator *)keyEnumerator {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return [[self p_keys] objectEnumerator];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+#pragma mark - private（需持有_mutex）
+
+- (NSInteger)p_slotForKey:(NSString *)key {
+    if (_count <= 8 && !_slotsByKey) {
+        // 小对象：直接与tape中的UTF-8键比较，不创建NSString；重复键以最后一个为准
+        char buffer[128];
+        const char *utf8 = CFStringGetCStringPtr((__bridge CFStringRef)key, kCFStringEncodingUTF8);
+        NSUInteger utf8Length = 0;
+        if (utf8) {
+            utf8Length = strlen(utf8);
+        } else if ([key getBytes:buffer maxLength:sizeof(buffer) usedLength:&utf8Length encoding:NSUTF8StringEncoding
+                         options:0 range:NSMakeRange(0, key.length) remainingRange:NULL]
+                   && utf8Length < sizeof(buffer)
+                   && [key lengthOfBytesUsingEncoding:NSUTF8StringEncoding] == utf8Length) {
+            utf8 = buffer;
+        }
+        if (utf8) {
+            for (NSInteger slot = (NSInteger)_count - 1; slot >= 0; slot--) {
+                uint32_t length = 0;
+                const char *bytes = _document->StringAt(_valueIndexes[slot] - 1, &length);
+                if (length == utf8Length && memcmp(bytes, utf8, length) == 0) {
+                    return slot;
+                }
+            }
+            return -1;
+        }
+    }
+    if (!_slotsByKey) {
+        NSArray<NSString *> *keys = [self p_keys];
+        NSMutableDictionary<NSString *, NSNumber *> *slots = [NSMutableDictionary dictionaryWithCapacity:_count];
+        for (NSUInteger slot = 0; slot < _count; slot++) {
+            slots[keys[slot]] = @(slot);
+        }
+        _slotsByKey = slots;
+    }
+    NSNumber *slot = _slotsByKey[key];
+    return slot ? slot.integerValue : -1;
+}
+
+- (NSArray<NSString *> *)p_keys {
+    if (!_keys) {
+        NSMutableArray<NSString *> *keys = [NSMutableArray arrayWithCapacity:_count];
+        for (size_t valueIndex : _valueIndexes) {
+            // 键紧挨在值之前
+            [keys addObject:KRJSONStringAt(*_document, valueIndex - 1)];
+        }
+        _keys = keys;
+    }
+    return _keys;
+}
+
+@end
+
+#pragma mark - KRLazyJSONArray
+
+@interface KRLazyJSONArray : NSArray
+
+- (instancetype)initWithDocument:(const KRJSONDocumentRef &)document index:(size_t)index;
+
+@end
+
+@implementation KRLazyJSONArray {
+    KRJSONDocumentRef _document;
+    size_t _index;
+    NSUInteger _count;
+    std::mutex _mutex;
+    std::vector<size_t> _elementIndexes;
+    std::vector<id> _values;
+}
+
+- (instancetype)initWithDocument:(const KRJSONDocumentRef &)document index:(size_t)index {
+    if (self = [super init]) {
+        _document = document;
+        _index = index;
+        _count = document->ContainerCountAt(index);
+        if (_count == 0xFFFFFF) {
+            // 计数饱和，按实际元素数计算
+            _count = 0;
+            for (size_t i = index + 1; i < document->ContainerEndAt(index); i = document->NextIndex(i)) {
+                _count++;
+            }
+        }
+    }
+    return self;
+}
+
+- (NSUInteger)count {
+    return _count;
+}
+
+- (id)objectAtIndex:(NSUInteger)index {
+    if (index >= _count) {
+        [NSException raise:NSRangeException format:@"index %lu beyond bounds [0 .. %lu]", (unsigned long)index, (unsigned long)_count];
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_elementIndexes.empty()) {
+        _elementIndexes.reserve(_count);
+        for (size_t i = _index + 1, end = _document->ContainerEndAt(_index); i < end; i = _document->NextIndex(i)) {
+            _elementIndexes.push_back(i);
+        }
+        _values.resize(_count);
+    }
+    id value = _values[index];
+    if (!value) {
+        value = KRJSONMaterialize(_document, _elementIndexes[index]);
+        _values[index] = value;
+    }
+    return value;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+@end
+
+#pragma mark - KRJSONParser
+
+static id KRJSONMaterialize(const KRJSONDocumentRef &document, size_t index) {
+    switch (document->TypeAt(index)) {
+        case TapeType::kObjectStart:
+            return [[KRLazyJSONDictionary alloc] initWithDocument:document index:index];
+        case TapeType::kArrayStart:
+            return [[KRLazyJSONArray alloc] initWithDocument:document index:index];
+        case TapeType::kString:
+            return KRJSONStringAt(*document, index);
+        case TapeType::kInt64:
+            return @(document->Int64At(index));
+        case TapeType::kDouble:
+            return @(document->DoubleAt(index));
+        case TapeType::kTrue:
+            return @YES;
+        case TapeType::kFalse:
+            return @NO;
+        default:
+            return [NSNull null];
+    }
+}
+
+@implementation KRJSONParser
+
++ (id)objectWithData:(NSData *)data error:(NSError **)error {
+    return [self objectWithUTF8Bytes:(const char *)data.bytes length:data.length error:error];
+}
+
++ (id)objectWithUTF8Bytes:(const char *)bytes length:(NSUInteger)length error:(NSError **)error {
+    auto document = std::make_shared<Document>();
+    if (!bytes || !document->Parse(bytes, length)) {
+        if (error) {
+            NSString *reason = bytes ? [NSString stringWithUTF8String:document->error().c_str()] : @"empty input";
+            *error = [NSError errorWithDomain:KRJSONParserErrorDomain
+                                         code:1
+                                     userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"%@ at offset %zu", reason, document->error_offset()]}];
+        }
+        return nil;
+    }
+    return KRJSONMaterialize(document, Document::kRootIndex);
+}
+
++ (id)objectWithString:(NSString *)string {
+    if (![string isKindOfClass:[NSString class]]) {
+        return nil;
+    }
+    const char *utf8 = CFStringGetCStringPtr((__bridge CFStringRef)string, kCFStringEncodingUTF8);
+    if (utf8) {
+        return [self objectWithUTF8Bytes:utf8 length:strlen(utf8) error:nil];
+    }
+    return [self objectWithData:[string dataUsingEncoding:NSUTF8StringEncoding] error:nil];
+}
+
+@end
@@ -0,0 +1,644 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "KRJSONParserCore.hpp"
+
+#include <cstdlib>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define KR_JSON_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define KR_JSON_SSE2 1
+#endif
+
+namespace kuikly {
+namespace json {
+
+namespace {
+
+/// 64字节分块的分类结果，第i位对应块内第i个字节
+struct BlockMasks {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t op;
+    uint64_t whitespace;
+    bool ascii;
+};
+
+#if KR_JSON_NEON
+
+inline uint64_t MoveMask(uint8x16_t value) {
+    static const uint8_t kBits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t masked = vandq_u8(value, vld1q_u8(kBits));
+    return static_cast<uint64_t>(vaddv_u8(vget_low_u8(masked))) |
+           (static_cast<uint64_t>(vaddv_u8(vget_high_u8(masked))) << 8);
+}
+
+inline void Classify(const uint8_t *block, BlockMasks &masks) {
+    masks = BlockMasks{0, 0, 0, 0, true};
+    uint8x16_t high = vdupq_n_u8(0);
+    for (int i = 0; i < 4; i++) {
+        uint8x16_t c = vld1q_u8(block + 16 * i);
+        int shift = 16 * i;
+        masks.quote |= MoveMask(vceqq_u8(c, vdupq_n_u8('"'))) << shift;
+        masks.backslash |= MoveMask(vceqq_u8(c, vdupq_n_u8('\\'))) << shift;
+        uint8x16_t op = vorrq_u8(vorrq_u8(vceqq_u8(c, vdupq_n_u8('{')), vceqq_u8(c, vdupq_n_u8('}'))),
+                                 vorrq_u8(vceqq_u8(c, vdupq_n_u8('[')), vceqq_u8(c, vdupq_n_u8(']'))));
+        op = vorrq_u8(op, vorrq_u8(vceqq_u8(c, vdupq_n_u8(':')), vceqq_u8(c, vdupq_n_u8(','))));
+        masks.op |= MoveMask(op) << shift;
+        uint8x16_t ws = vorrq_u8(vorrq_u8(vceqq_u8(c, vdupq_n_u8(' ')), vceqq_u8(c, vdupq_n_u8('\t'))),
+                                 vorrq_u8(vceqq_u8(c, vdupq_n_u8('\n')), vceqq_u8(c, vdupq_n_u8('\r'))));
+        masks.whitespace |= MoveMask(ws) << shift;
+        high = vorrq_u8(high, c);
+    }
+    masks.ascii = vmaxvq_u8(high) < 0x80;
+}
+
+#elif KR_JSON_SSE2
+
+inline uint64_t MoveMask(__m128i value) {
+    return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(value)));
+}
+
+inline void Classify(const uint8_t *block, BlockMasks &masks) {
+    masks = BlockMasks{0, 0, 0, 0, true};
+    int high = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+        int shift = 16 * i;
+        masks.quote |= MoveMask(_mm_cmpeq_epi8(c, _mm_set1_epi8('"'))) << shift;
+        masks.backslash |= MoveMask(_mm_cmpeq_epi8(c, _mm_set1_epi8('\\'))) << shift;
+        __m128i op = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('{')), _mm_cmpeq_epi8(c, _mm_set1_epi8('}'))),
+                                  _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('[')), _mm_cmpeq_epi8(c, _mm_set1_epi8(']'))));
+        op = _mm_or_si128(op, _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(':')), _mm_cmpeq_epi8(c, _mm_set1_epi8(','))));
+        masks.op |= MoveMask(op) << shift;
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\t'))),
+                                  _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\r'))));
+        masks.whitespace |= MoveMask(ws) << shift;
+        high |= _mm_movemask_epi8(c);
+    }
+    masks.ascii = high == 0;
+}
+
+#else
+
+inline void Classify(const uint8_t *block, BlockMasks &masks) {
+    masks = BlockMasks{0, 0, 0, 0, true};
+    for (int i = 0; i < 64; i++) {
+        uint8_t c = block[i];
+        uint64_t bit = 1ULL << i;
+        switch (c) {
+            case '"': masks.quote |= bit; break;
+            case '\\': masks.backslash |= bit; break;
+            case '{': case '}': case '[': case ']': case ':': case ',': masks.op |= bit; break;
+            case ' ': case '\t': case '\n': case '\r': masks.whitespace |= bit; break;
+            default:
+                if (c >= 0x80) {
+                    masks.ascii = false;
+                }
+                break;
+        }
+    }
+}
+
+#endif
+
+inline uint64_t PrefixXor(uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+/// 被奇数个连续反斜杠转义的字符位置，prevEscaped为跨块进位
+inline uint64_t FindEscaped(uint64_t backslash, uint64_t &prevEscaped) {
+    backslash &= ~prevEscaped;
+    uint64_t followsEscape = (backslash << 1) | prevEscaped;
+    const uint64_t kEvenBits = 0x5555555555555555ULL;
+    uint64_t oddSequenceStarts = backslash & ~kEvenBits & ~followsEscape;
+    uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+    prevEscaped = sequencesStartingOnEvenBits < oddSequenceStarts ? 1 : 0;
+    uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+    return (kEvenBits ^ invertMask) & followsEscape;
+}
+
+bool ValidateUTF8(const uint8_t *data, size_t length) {
+    size_t i = 0;
+    while (i < length) {
+        // ASCII每次跳过8字节
+        while (i + 8 <= length) {
+            uint64_t word;
+            memcpy(&word, data + i, sizeof(word));
+            if (word & 0x8080808080808080ULL) {
+                break;
+            }
+            i += 8;
+        }
+        if (i >= length) {
+            break;
+        }
+        uint8_t c = data[i];
+        if (c < 0x80) {
+            i++;
+            continue;
+        }
+        // 按首字节限定第二字节范围，排除过长编码、代理区与超出U+10FFFF
+        if (c >= 0xC2 && c <= 0xDF) {
+            if (i + 1 >= length || (data[i + 1] & 0xC0) != 0x80) {
+                return false;
+            }
+            i += 2;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            if (i + 2 >= length) {
+                return false;
+            }
+            uint8_t c1 = data[i + 1];
+            uint8_t c2 = data[i + 2];
+            if ((c1 & 0xC0) != 0x80 || (c2 & 0xC0) != 0x80 || (c == 0xE0 && c1 < 0xA0) || (c == 0xED && c1 >= 0xA0)) {
+                return false;
+            }
+            i += 3;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            if (i + 3 >= length) {
+                return false;
+            }
+            uint8_t c1 = data[i + 1];
+            if ((c1 & 0xC0) != 0x80 || (data[i + 2] & 0xC0) != 0x80 || (data[i + 3] & 0xC0) != 0x80
+                || (c == 0xF0 && c1 < 0x90) || (c == 0xF4 && c1 >= 0x90)) {
+                return false;
+            }
+            i += 4;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool IsDelimiter(uint8_t c) {
+    switch (c) {
+        case ' ': case '\t': case '\n': case '\r':
+        case ',': case ':': case ']': case '}': case '[': case '{':
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// 8字节中是否含有'"'、'\\'或控制字符
+inline bool HasSpecialStringByte(uint64_t word) {
+    const uint64_t kOnes = 0x0101010101010101ULL;
+    const uint64_t kHighs = 0x8080808080808080ULL;
+    uint64_t quote = word ^ (kOnes * '"');
+    uint64_t backslash = word ^ (kOnes * '\\');
+    uint64_t special = ((quote - kOnes) & ~quote) | ((backslash - kOnes) & ~backslash) | (word - kOnes * 0x20);
+    return (special & ~word & kHighs) != 0;
+}
+
+inline int HexValue(uint8_t c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+inline void AppendUTF8(std::vector<char> &out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+struct ContainerFrame {
+    size_t tape_index;
+    uint32_t count;
+    bool is_object;
+};
+
+}  // namespace
+
+bool Document::Fail(const char *message, size_t offset) {
+    error_ = message;
+    error_offset_ = offset;
+    return false;
+}
+
+bool Document::Parse(const char *json, size_t length) {
+    structurals_.clear();
+    tape_.clear();
+    string_buffer_.clear();
+    error_.clear();
+    error_offset_ = 0;
+    if (!json || length >= 0xFFFFFFFFu) {
+        return Fail("invalid input", 0);
+    }
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(json);
+    return FindStructurals(data, length) && BuildTape(data, length);
+}
+
+bool Document::FindStructurals(const uint8_t *json, size_t length) {
+    structurals_.reserve(length / 4 + 8);
+    uint64_t prevEscaped = 0;
+    uint64_t prevInString = 0;
+    uint64_t prevScalar = 0;
+    size_t firstNonASCIIBlock = length;
+    uint8_t tail[64];
+    for (size_t offset = 0; offset < length; offset += 64) {
+        const uint8_t *block = json + offset;
+        if (length - offset < 64) {
+            // 末尾不足64字节时补空格
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, block, length - offset);
+            block = tail;
+        }
+        BlockMasks masks;
+        Classify(block, masks);
+        if (!masks.ascii && firstNonASCIIBlock == length) {
+            firstNonASCIIBlock = offset;
+        }
+        uint64_t escaped = FindEscaped(masks.backslash, prevEscaped);
+        uint64_t quote = masks.quote & ~escaped;
+        // 字符串区间：含起始引号与内容，不含结束引号
+        uint64_t inString = PrefixXor(quote) ^ prevInString;
+        prevInString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+        uint64_t outside = ~inString & ~quote;
+        uint64_t op = masks.op & outside;
+        uint64_t scalar = outside & ~masks.op & ~masks.whitespace;
+        uint64_t scalarStart = scalar & ~((scalar << 1) | prevScalar);
+        prevScalar = scalar >> 63;
+        uint64_t structurals = op | (quote & inString) | scalarStart;
+        while (structurals) {
+            structurals_.push_back(static_cast<uint32_t>(offset + __builtin_ctzll(structurals)));
+            structurals &= structurals - 1;
+        }
+    }
+    // 补空格会产生越界的标量起点，丢弃
+    while (!structurals_.empty() && structurals_.back() >= length) {
+        structurals_.pop_back();
+    }
+    if (prevInString) {
+        return Fail("unterminated string", length);
+    }
+    if (firstNonASCIIBlock < length && !ValidateUTF8(json + firstNonASCIIBlock, length - firstNonASCIIBlock)) {
+        return Fail("invalid UTF-8", firstNonASCIIBlock);
+    }
+    return true;
+}
+
+bool Document::BuildTape(const uint8_t *json, size_t length) {
+    enum State {
+        kExpectValue,
+        kExpectValueOrArrayEnd,
+        kExpectKey,
+        kExpectKeyOrObjectEnd,
+        kAfterValue,
+    };
+    tape_.reserve(structurals_.size() + structurals_.size() / 2 + 4);
+    string_buffer_.reserve(length + 16);
+    Append(TapeType::kRoot, 0);
+    std::vector<ContainerFrame> stack;
+    State state = kExpectValue;
+    size_t count = structurals_.size();
+    size_t index = 0;
+    while (true) {
+        if (state == kAfterValue && stack.empty()) {
+            if (index < count) {
+                return Fail("trailing content", structurals_[index]);
+            }
+            break;
+        }
+        if (index >= count) {
+            return Fail(stack.empty() ? "empty document" : "unexpected end of document", length);
+        }
+        size_t position = structurals_[index++];
+        uint8_t c = json[position];
+        switch (state) {
+            case kExpectKeyOrObjectEnd:
+                if (c == '}') {
+                    goto close_container;
+                }
+                // fall through
+            case kExpectKey:
+                if (c != '"') {
+                    return Fail("expected object key", position);
+                }
+                if (!ParseString(json, length, position)) {
+                    return false;
+                }
+                if (index >= count || json[structurals_[index]] != ':') {
+                    return Fail("expected ':'", index < count ? structurals_[index] : length);
+                }
+                index++;
+                state = kExpectValue;
+                continue;
+            case kExpectValueOrArrayEnd:
+                if (c == ']') {
+                    goto close_container;
+                }
+                // fall through
+            case kExpectValue:
+                if (!stack.empty()) {
+                    stack.back().count++;
+                }
+                switch (c) {
+                    case '{':
+                    case '[':
+                        if (stack.size() >= kMaxDepth) {
+                            return Fail("exceeded maximum depth", position);
+                        }
+                        stack.push_back(ContainerFrame{tape_.size(), 0, c == '{'});
+                        Append(c == '{' ? TapeType::kObjectStart : TapeType::kArrayStart, 0);
+                        state = c == '{' ? kExpectKeyOrObjectEnd : kExpectValueOrArrayEnd;
+                        continue;
+                    case '"':
+                        if (!ParseString(json, length, position)) {
+                            return false;
+                        }
+                        break;
+                    case 't':
+                        if (!ParseLiteral(json, length, position, "true", TapeType::kTrue)) {
+                            return false;
+                        }
+                        break;
+                    case 'f':
+                        if (!ParseLiteral(json, length, position, "false", TapeType::kFalse)) {
+                            return false;
+                        }
+                        break;
+                    case 'n':
+                        if (!ParseLiteral(json, length, position, "null", TapeType::kNull)) {
+                            return false;
+                        }
+                        break;
+                    default:
+                        if (c == '-' || (c >= '0' && c <= '9')) {
+                            if (!ParseNumber(json, length, position)) {
+                                return false;
+                            }
+                            break;
+                        }
+                        return Fail("unexpected character", position);
+                }
+                state = kAfterValue;
+                continue;
+            case kAfterValue:
+                if (c == ',') {
+                    state = stack.back().is_object ? kExpectKey : kExpectValue;
+                    continue;
+                }
+                if ((c == '}' && stack.back().is_object) || (c == ']' && !stack.back().is_object)) {
+                    goto close_container;
+                }
+                return Fail("expected ',' or container end", position);
+        }
+    close_container: {
+            ContainerFrame frame = stack.back();
+            stack.pop_back();
+            size_t end = tape_.size();
+            uint64_t elementCount = frame.count > 0xFFFFFF ? 0xFFFFFF : frame.count;
+            tape_[frame.tape_index] |= (elementCount << 32) | static_cast<uint64_t>(end);
+            Append(frame.is_object ? TapeType::kObjectEnd : TapeType::kArrayEnd, frame.tape_index);
+            state = kAfterValue;
+        }
+    }
+    Append(TapeType::kRoot, 0);
+    return true;
+}
+
+bool Document::ParseString(const uint8_t *json, size_t length, size_t position) {
+    size_t lengthOffset = string_buffer_.size();
+    Append(TapeType::kString, lengthOffset);
+    string_buffer_.resize(lengthOffset + sizeof(uint32_t));
+    size_t i = position + 1;
+    while (true) {
+        size_t runStart = i;
+        // 无需转义的连续区间整体拷贝，每次检查8字节
+        while (i + 8 <= length) {
+            uint64_t word;
+            memcpy(&word, json + i, sizeof(word));
+            if (HasSpecialStringByte(word)) {
+                break;
+            }
+            i += 8;
+        }
+        while (i < length && json[i] != '"' && json[i] != '\\' && json[i] >= 0x20) {
+            i++;
+        }
+        string_buffer_.insert(string_buffer_.end(), json + runStart, json + i);
+        if (i >= length) {
+            return Fail("unterminated string", position);
+        }
+        uint8_t c = json[i];
+        if (c == '"') {
+            break;
+        }
+        if (c < 0x20) {
+            return Fail("control character in string", i);
+        }
+        // 转义
+        if (i + 1 >= length) {
+            return Fail("unterminated escape", i);
+        }
+        uint8_t escape = json[i + 1];
+        i += 2;
+        switch (escape) {
+            case '"': string_buffer_.push_back('"'); break;
+            case '\\': string_buffer_.push_back('\\'); break;
+            case '/': string_buffer_.push_back('/'); break;
+            case 'b': string_buffer_.push_back('\b'); break;
+            case 'f': string_buffer_.push_back('\f'); break;
+            case 'n': string_buffer_.push_back('\n'); break;
+            case 'r': string_buffer_.push_back('\r'); break;
+            case 't': string_buffer_.push_back('\t'); break;
+            case 'u': {
+                auto readHex4 = [&](size_t at, uint32_t &out) -> bool {
+                    if (at + 4 > length) {
+                        return false;
+                    }
+                    out = 0;
+                    for (size_t k = 0; k < 4; k++) {
+                        int value = HexValue(json[at + k]);
+                        if (value < 0) {
+                            return false;
+                        }
+                        out = (out << 4) | static_cast<uint32_t>(value);
+                    }
+                    return true;
+                };
+                uint32_t codePoint = 0;
+                if (!readHex4(i, codePoint)) {
+                    return Fail("invalid unicode escape", i);
+                }
+                i += 4;
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                    uint32_t low = 0;
+                    if (i + 1 < length && json[i] == '\\' && json[i + 1] == 'u' && readHex4(i + 2, low)
+                        && low >= 0xDC00 && low <= 0xDFFF) {
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    } else {
+                        codePoint = 0xFFFD;  // 孤立代理项按替换字符处理
+                    }
+                } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+                    codePoint = 0xFFFD;
+                }
+                AppendUTF8(string_buffer_, codePoint);
+                break;
+            }
+            default:
+                return Fail("invalid escape", i - 1);
+        }
+    }
+    uint32_t stringLength = static_cast<uint32_t>(string_buffer_.size() - lengthOffset - sizeof(uint32_t));
+    memcpy(string_buffer_.data() + lengthOffset, &stringLength, sizeof(stringLength));
+    string_buffer_.push_back('\0');
+    return true;
+}
+
+bool Document::ParseLiteral(const uint8_t *json, size_t length, size_t position, const char *literal, TapeType type) {
+    size_t literalLength = strlen(literal);
+    if (position + literalLength > length || memcmp(json + position, literal, literalLength) != 0
+        || (position + literalLength < length && !IsDelimiter(json[position + literalLength]))) {
+        return Fail("invalid literal", position);
+    }
+    Append(type, 0);
+    return true;
+}
+
+bool Document::ParseNumber(const uint8_t *json, size_t length, size_t position) {
+    static const double kPowersOf10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    size_t i = position;
+    bool negative = false;
+    if (json[i] == '-') {
+        negative = true;
+        i++;
+    }
+    if (i >= length || json[i] < '0' || json[i] > '9') {
+        return Fail("invalid number", position);
+    }
+    uint64_t mantissa = 0;
+    int digits = 0;
+    if (json[i] == '0') {
+        i++;
+        if (i < length && json[i] >= '0' && json[i] <= '9') {
+            return Fail("leading zero in number", position);
+        }
+    } else {
+        while (i < length && json[i] >= '0' && json[i] <= '9') {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (json[i] - '0');
+            }
+            digits++;
+            i++;
+        }
+    }
+    bool isInteger = true;
+    int64_t exponent = 0;
+    if (i < length && json[i] == '.') {
+        isInteger = false;
+        i++;
+        if (i >= length || json[i] < '0' || json[i] > '9') {
+            return Fail("invalid fraction", position);
+        }
+        while (i < length && json[i] >= '0' && json[i] <= '9') {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (json[i] - '0');
+                exponent--;
+            }
+            if (mantissa || json[i] != '0') {
+                digits++;
+            }
+            i++;
+        }
+    }
+    if (i < length && (json[i] == 'e' || json[i] == 'E')) {
+        isInteger = false;
+        i++;
+        bool negativeExponent = false;
+        if (i < length && (json[i] == '+' || json[i] == '-')) {
+            negativeExponent = json[i] == '-';
+            i++;
+        }
+        if (i >= length || json[i] < '0' || json[i] > '9') {
+            return Fail("invalid exponent", position);
+        }
+        int64_t explicitExponent = 0;
+        while (i < length && json[i] >= '0' && json[i] <= '9') {
+            if (explicitExponent < 100000) {
+                explicitExponent = explicitExponent * 10 + (json[i] - '0');
+            }
+            i++;
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if (i < length && !IsDelimiter(json[i])) {
+        return Fail("invalid number", position);
+    }
+    if (isInteger && digits <= 19) {
+        if (!negative && mantissa <= static_cast<uint64_t>(INT64_MAX)) {
+            Append(TapeType::kInt64, 0);
+            tape_.push_back(mantissa);
+            return true;
+        }
+        if (negative && mantissa <= static_cast<uint64_t>(INT64_MAX) + 1) {
+            Append(TapeType::kInt64, 0);
+            tape_.push_back(static_cast<uint64_t>(0) - mantissa);
+            return true;
+        }
+    }
+    double value;
+    if (digits <= 19 && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        // 精确快速路径（尾数与10的幂均可精确表示）
+        value = static_cast<double>(mantissa);
+        value = exponent < 0 ? value / kPowersOf10[-exponent] : value * kPowersOf10[exponent];
+        if (negative) {
+            value = -value;
+        }
+    } else {
+        std::string text(reinterpret_cast<const char *>(json + position), i - position);
+        value = strtod(text.c_str(), nullptr);
+    }
+    Append(TapeType::kDouble, 0);
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    tape_.push_back(bits);
+    return true;
+}
+
+}  // namespace json
+}  // namespace kuikly
@@ -0,0 +1,131 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KRJSONParserCore_hpp
+#define KRJSONParserCore_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/*
+ * tape式JSON解析核心，仅依赖C++标准库，可脱离iOS单独编译/测试。
+ *
+ * 阶段1：按64字节分块，用SIMD（NEON/SSE2，其他平台标量）找出引号、反斜杠与结构字符，
+ *       通过前缀异或得到字符串区间，产出结构字符下标并校验UTF-8。
+ * 阶段2：遍历结构字符下标生成tape，字符串反转义后存入string buffer，数字解析为int64/double。
+ * tape只记录位置与数值，不创建任何对象，上层按需取值（见KRJSONParser）。
+ */
+namespace kuikly {
+namespace json {
+
+enum class TapeType : uint8_t {
+    kRoot = 'r',
+    kObjectStart = '{',
+    kObjectEnd = '}',
+    kArrayStart = '[',
+    kArrayEnd = ']',
+    kString = '"',
+    kInt64 = 'l',
+    kDouble = 'd',
+    kTrue = 't',
+    kFalse = 'f',
+    kNull = 'n',
+};
+
+/// 最大嵌套层数
+constexpr size_t kMaxDepth = 1024;
+
+class Document {
+public:
+    /// 解析UTF-8 JSON，失败返回false，可通过error()/error_offset()获取原因
+    bool Parse(const char *json, size_t length);
+
+    const std::string &error() const { return error_; }
+    size_t error_offset() const { return error_offset_; }
+
+    /// 根值所在tape下标
+    static constexpr size_t kRootIndex = 1;
+
+    TapeType TypeAt(size_t index) const {
+        return static_cast<TapeType>(tape_[index] >> 56);
+    }
+    uint64_t PayloadAt(size_t index) const {
+        return tape_[index] & kPayloadMask;
+    }
+    /// 容器元素个数（对象为键值对个数）
+    uint32_t ContainerCountAt(size_t index) const {
+        return static_cast<uint32_t>(PayloadAt(index) >> 32);
+    }
+    /// 容器结束标记所在下标
+    size_t ContainerEndAt(size_t index) const {
+        return static_cast<size_t>(PayloadAt(index) & 0xFFFFFFFFu);
+    }
+    /// 下一个兄弟值的下标
+    size_t NextIndex(size_t index) const {
+        switch (TypeAt(index)) {
+            case TapeType::kObjectStart:
+            case TapeType::kArrayStart:
+                return ContainerEndAt(index) + 1;
+            case TapeType::kInt64:
+            case TapeType::kDouble:
+                return index + 2;
+            default:
+                return index + 1;
+        }
+    }
+    int64_t Int64At(size_t index) const {
+        return static_cast<int64_t>(tape_[index + 1]);
+    }
+    double DoubleAt(size_t index) const {
+        double value;
+        memcpy(&value, &tape_[index + 1], sizeof(value));
+        return value;
+    }
+    /// 反转义后的字符串（UTF-8，不含'\0'）
+    const char *StringAt(size_t index, uint32_t *length) const {
+        const char *base = string_buffer_.data() + PayloadAt(index);
+        memcpy(length, base, sizeof(uint32_t));
+        return base + sizeof(uint32_t);
+    }
+    size_t tape_size() const { return tape_.size(); }
+
+private:
+    static constexpr uint64_t kPayloadMask = (1ULL << 56) - 1;
+
+    bool FindStructurals(const uint8_t *json, size_t length);
+    bool BuildTape(const uint8_t *json, size_t length);
+    bool ParseString(const uint8_t *json, size_t length, size_t position);
+    bool ParseNumber(const uint8_t *json, size_t length, size_t position);
+    bool ParseLiteral(const uint8_t *json, size_t length, size_t position, const char *literal, TapeType type);
+    bool Fail(const char *message, size_t offset);
+
+    void Append(TapeType type, uint64_t payload) {
+        tape_.push_back((static_cast<uint64_t>(type) << 56) | (payload & kPayloadMask));
+    }
+
+    std::vector<uint32_t> structurals_;
+    std::vector<uint64_t> tape_;
+    std::vector<char> string_buffer_;
+    std::string error_;
+    size_t error_offset_ = 0;
+};
+
+}  // namespace json
+}  // namespace kuikly
+
+#endif /* KRJSONParserCore_hpp */
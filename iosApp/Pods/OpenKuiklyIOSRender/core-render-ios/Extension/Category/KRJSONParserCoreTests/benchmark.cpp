@@ -0,0 +1,125 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * KRJSONParserCore解析吞吐基准：内置Kuikly典型负载（单次桥接调用、批量桥接调用、列表feed回包、
+ * 数字密集的Canvas命令），也可传入JSON文件路径。
+ *   kr_json_benchmark [--iterations N] [payload.json ...]
+ * N为每个负载的解析次数，缺省按负载大小选取（约解析200MB）。
+ */
+
+#include "KRJSONParserCore.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::string BridgeCallPayload(int viewId) {
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer),
+             "{\"viewId\":%d,\"props\":{\"frame\":\"0 %d 375 88\",\"backgroundColor\":\"#ffffff\","
+             "\"borderRadius\":\"8 8 8 8\",\"opacity\":1,\"text\":\"Hello Kuikly %d\",\"fontSize\":15,"
+             "\"color\":\"#333333\"},\"events\":[\"click\",\"longPress\"]}",
+             viewId, viewId * 88, viewId);
+    return buffer;
+}
+
+std::string BridgeBatchPayload(int count) {
+    std::string json = "[";
+    for (int i = 0; i < count; i++) {
+        json += (i ? "," : "") + BridgeCallPayload(i);
+    }
+    return json + "]";
+}
+
+std::string FeedPayload(int count) {
+    std::string json = "{\"code\":0,\"msg\":\"ok\",\"data\":{\"list\":[";
+    char buffer[1024];
+    for (int i = 0; i < count; i++) {
+        snprintf(buffer, sizeof(buffer),
+                 "%s{\"id\":%d,\"title\":\"标题 %d 这是一个商品的标题\",\"cover\":\"https://example.com/img/%d.jpg?w=300&h=300\","
+                 "\"price\":%.14g,\"tags\":[\"热卖\",\"新品\",\"包邮\"],\"author\":{\"name\":\"user%d\","
+                 "\"avatar\":\"https:\\/\\/example.com\\/a\\/%d.png\",\"vip\":%s},\"stats\":{\"like\":%d,\"comment\":%d},"
+                 "\"desc\":\"描述\\n描述\\n描述\\n\\\"引用\\\"\\u00e9\"}",
+                 i ? "," : "", i, i, i, 100 + i * 0.731 + 0.0123456789, i, i, i % 3 ? "true" : "false",
+                 (i * 7919) % 10000, (i * 104729) % 1000);
+        json += buffer;
+    }
+    return json + "],\"hasMore\":true,\"cursor\":\"c8f1e2\"}}";
+}
+
+std::string CanvasPayload(int count) {
+    std::string json = "{\"commands\":[";
+    char buffer[128];
+    for (int i = 0; i < count; i++) {
+        snprintf(buffer, sizeof(buffer), "%s[\"lineTo\",%.3f,%.3f]", i ? "," : "", i * 0.37 + 1.5, (i % 100) * 2.125 - 40);
+        json += buffer;
+    }
+    return json + "]}";
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    long iterations = 0;
+    std::vector<std::pair<std::string, std::string>> payloads;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = strtol(argv[++i], nullptr, 10);
+            continue;
+        }
+        std::ifstream file(argv[i], std::ios::binary);
+        if (!file) {
+            fprintf(stderr, "cannot open %s\n", argv[i]);
+            return 1;
+        }
+        std::stringstream stream;
+        stream << file.rdbuf();
+        payloads.emplace_back(argv[i], stream.str());
+    }
+    if (payloads.empty()) {
+        payloads.emplace_back("bridge call", BridgeCallPayload(12));
+        payloads.emplace_back("bridge batch x200", BridgeBatchPayload(200));
+        payloads.emplace_back("feed x200", FeedPayload(200));
+        payloads.emplace_back("canvas x5000", CanvasPayload(5000));
+    }
+
+    kuikly::json::Document document;
+    for (const auto &payload : payloads) {
+        const std::string &json = payload.second;
+        long count = iterations > 0 ? iterations : static_cast<long>(200 * 1024 * 1024 / (json.size() + 1)) + 1;
+        if (!document.Parse(json.data(), json.size())) {
+            fprintf(stderr, "%s: parse failed: %s at %zu\n", payload.first.c_str(), document.error().c_str(), document.error_offset());
+            return 1;
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < count; i++) {
+            document.Parse(json.data(), json.size());
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printf("%-20s %8zu bytes %10.2f us/parse %8.0f MB/s\n", payload.first.c_str(), json.size(),
+               seconds / count * 1e6, json.size() * count / seconds / 1e6);
+    }
+    return 0;
+}
@@ -0,0 +1,748 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * KRJSONParserCore一致性测试：以本文件内的递归下降参考解析器（严格按RFC 8259）为基准，
+ * 对手写用例、随机生成的JSON及其随机变异逐一比较接受/拒绝结果与解析出的值。
+ * 参考解析器与核心约定一致的部分：孤立的\u代理项替换为U+FFFD，整数超出int64时按double解析，
+ * 最大嵌套层数为kMaxDepth。
+ */
+
+#include "KRJSONParserCore.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using kuikly::json::Document;
+using kuikly::json::TapeType;
+
+namespace {
+
+struct Value {
+    enum Type { kNull, kTrue, kFalse, kInt64, kDouble, kString, kArray, kObject };
+    Type type = kNull;
+    int64_t integer = 0;
+    double number = 0;
+    std::string string;
+    std::vector<Value> elements;
+    std::vector<std::pair<std::string, Value>> members;
+};
+
+bool Equal(const Value &a, const Value &b) {
+    if (a.type != b.type) {
+        return false;
+    }
+    switch (a.type) {
+        case Value::kInt64:
+            return a.integer == b.integer;
+        case Value::kDouble:
+            // 两边都应正确舍入，按位比较（含-0与inf）
+            return memcmp(&a.number, &b.number, sizeof(double)) == 0;
+        case Value::kString:
+            return a.string == b.string;
+        case Value::kArray:
+            if (a.elements.size() != b.elements.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < a.elements.size(); i++) {
+                if (!Equal(a.elements[i], b.elements[i])) {
+                    return false;
+                }
+            }
+            return true;
+        case Value::kObject:
+            if (a.members.size() != b.members.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < a.members.size(); i++) {
+                if (a.members[i].first != b.members[i].first || !Equal(a.members[i].second, b.members[i].second)) {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            return true;
+    }
+}
+
+// 参考解析器
+
+class ReferenceParser {
+public:
+    ReferenceParser(const std::string &json) : json_(json) {}
+
+    bool Parse(Value *value) {
+        SkipWhitespace();
+        if (!ParseValue(value, 0)) {
+            return false;
+        }
+        SkipWhitespace();
+        return position_ == json_.size();
+    }
+
+private:
+    int Peek() const { return position_ < json_.size() ? static_cast<uint8_t>(json_[position_]) : -1; }
+
+    void SkipWhitespace() {
+        while (Peek() == ' ' || Peek() == '\t' || Peek() == '\n' || Peek() == '\r') {
+            position_++;
+        }
+    }
+
+    bool Consume(const char *literal) {
+        size_t length = strlen(literal);
+        if (json_.compare(position_, length, literal) != 0) {
+            return false;
+        }
+        position_ += length;
+        return true;
+    }
+
+    bool ParseValue(Value *value, size_t depth) {
+        switch (Peek()) {
+            case '{':
+                return ParseObject(value, depth + 1);
+            case '[':
+                return ParseArray(value, depth + 1);
+            case '"':
+                value->type = Value::kString;
+                return ParseString(&value->string);
+            case 't':
+                value->type = Value::kTrue;
+                return Consume("true");
+            case 'f':
+                value->type = Value::kFalse;
+                return Consume("false");
+            case 'n':
+                value->type = Value::kNull;
+                return Consume("null");
+            default:
+                return ParseNumber(value);
+        }
+    }
+
+    bool ParseObject(Value *value, size_t depth) {
+        if (depth > kuikly::json::kMaxDepth) {
+            return false;
+        }
+        value->type = Value::kObject;
+        position_++;
+        SkipWhitespace();
+        if (Peek() == '}') {
+            position_++;
+            return true;
+        }
+        while (true) {
+            std::pair<std::string, Value> member;
+            if (Peek() != '"' || !ParseString(&member.first)) {
+                return false;
+            }
+            SkipWhitespace();
+            if (Peek() != ':') {
+                return false;
+            }
+            position_++;
+            SkipWhitespace();
+            if (!ParseValue(&member.second, depth)) {
+                return false;
+            }
+            value->members.push_back(std::move(member));
+            SkipWhitespace();
+            if (Peek() == '}') {
+                position_++;
+                return true;
+            }
+            if (Peek() != ',') {
+                return false;
+            }
+            position_++;
+            SkipWhitespace();
+        }
+    }
+
+    bool ParseArray(Value *value, size_t depth) {
+        if (depth > kuikly::json::kMaxDepth) {
+            return false;
+        }
+        value->type = Value::kArray;
+        position_++;
+        SkipWhitespace();
+        if (Peek() == ']') {
+            position_++;
+            return true;
+        }
+        while (true) {
+            Value element;
+            if (!ParseValue(&element, depth)) {
+                return false;
+            }
+            value->elements.push_back(std::move(element));
+            SkipWhitespace();
+            if (Peek() == ']') {
+                position_++;
+                return true;
+            }
+            if (Peek() != ',') {
+                return false;
+            }
+            position_++;
+            SkipWhitespace();
+        }
+    }
+
+    static void AppendUTF8(std::string *out, uint32_t codePoint) {
+        if (codePoint < 0x80) {
+            out->push_back(static_cast<char>(codePoint));
+        } else if (codePoint < 0x800) {
+            out->push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            out->push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else if (codePoint < 0x10000) {
+            out->push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            out->push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out->push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else {
+            out->push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            out->push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            out->push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out->push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+
+    bool ReadHex4(uint32_t *out) {
+        if (position_ + 4 > json_.size()) {
+            return false;
+        }
+        *out = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = json_[position_++];
+            int digit = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+            if (digit < 0) {
+                return false;
+            }
+            *out = (*out << 4) | static_cast<uint32_t>(digit);
+        }
+        return true;
+    }
+
+    /// 校验一个完整的UTF-8序列（拒绝过长编码、代理项与超出U+10FFFF）
+    bool ConsumeUTF8(std::string *out) {
+        uint8_t lead = static_cast<uint8_t>(json_[position_]);
+        size_t count;
+        uint32_t codePoint;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            count = 1;
+            codePoint = lead & 0x1F;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            count = 2;
+            codePoint = lead & 0x0F;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            count = 3;
+            codePoint = lead & 0x07;
+        } else {
+            return false;
+        }
+        if (position_ + count >= json_.size()) {
+            return false;
+        }
+        for (size_t i = 1; i <= count; i++) {
+            uint8_t c = static_cast<uint8_t>(json_[position_ + i]);
+            if ((c & 0xC0) != 0x80) {
+                return false;
+            }
+            codePoint = (codePoint << 6) | (c & 0x3F);
+        }
+        static const uint32_t kMinimum[] = {0, 0x80, 0x800, 0x10000};
+        if (codePoint < kMinimum[count] || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+            return false;
+        }
+        out->append(json_, position_, count + 1);
+        position_ += count + 1;
+        return true;
+    }
+
+    bool ParseString(std::string *out) {
+        position_++;
+        while (true) {
+            int c = Peek();
+            if (c < 0 || c < 0x20) {
+                return false;
+            }
+            if (c == '"') {
+                position_++;
+                return true;
+            }
+            if (c >= 0x80) {
+                if (!ConsumeUTF8(out)) {
+                    return false;
+                }
+                continue;
+            }
+            position_++;
+            if (c != '\\') {
+                out->push_back(static_cast<char>(c));
+                continue;
+            }
+            int escape = Peek();
+            position_++;
+            switch (escape) {
+                case '"': out->push_back('"'); break;
+                case '\\': out->push_back('\\'); break;
+                case '/': out->push_back('/'); break;
+                case 'b': out->push_back('\b'); break;
+                case 'f': out->push_back('\f'); break;
+                case 'n': out->push_back('\n'); break;
+                case 'r': out->push_back('\r'); break;
+                case 't': out->push_back('\t'); break;
+                case 'u': {
+                    uint32_t codePoint;
+                    if (!ReadHex4(&codePoint)) {
+                        return false;
+                    }
+                    if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                        size_t saved = position_;
+                        uint32_t low;
+                        if (Consume("\\u") && ReadHex4(&low) && low >= 0xDC00 && low <= 0xDFFF) {
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        } else {
+                            position_ = saved;
+                            codePoint = 0xFFFD;
+                        }
+                    } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+                        codePoint = 0xFFFD;
+                    }
+                    AppendUTF8(out, codePoint);
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+    }
+
+    bool ParseNumber(Value *value) {
+        size_t start = position_;
+        if (Peek() == '-') {
+            position_++;
+        }
+        if (Peek() == '0') {
+            position_++;
+        } else if (Peek() >= '1' && Peek() <= '9') {
+            while (Peek() >= '0' && Peek() <= '9') {
+                position_++;
+            }
+        } else {
+            return false;
+        }
+        bool isInteger = true;
+        if (Peek() == '.') {
+            isInteger = false;
+            position_++;
+            if (!(Peek() >= '0' && Peek() <= '9')) {
+                return false;
+            }
+            while (Peek() >= '0' && Peek() <= '9') {
+                position_++;
+            }
+        }
+        if (Peek() == 'e' || Peek() == 'E') {
+            isInteger = false;
+            position_++;
+            if (Peek() == '+' || Peek() == '-') {
+                position_++;
+            }
+            if (!(Peek() >= '0' && Peek() <= '9')) {
+                return false;
+            }
+            while (Peek() >= '0' && Peek() <= '9') {
+                position_++;
+            }
+        }
+        std::string text = json_.substr(start, position_ - start);
+        if (isInteger) {
+            errno = 0;
+            long long integer = strtoll(text.c_str(), nullptr, 10);
+            if (errno == 0) {
+                value->type = Value::kInt64;
+                value->integer = integer;
+                return true;
+            }
+        }
+        value->type = Value::kDouble;
+        value->number = strtod(text.c_str(), nullptr);
+        return true;
+    }
+
+    const std::string &json_;
+    size_t position_ = 0;
+};
+
+// tape转换与序列化
+
+Value ValueFromTape(const Document &document, size_t index) {
+    Value value;
+    switch (document.TypeAt(index)) {
+        case TapeType::kObjectStart: {
+            value.type = Value::kObject;
+            size_t end = document.ContainerEndAt(index);
+            for (size_t i = index + 1; i < end;) {
+                uint32_t length;
+                const char *key = document.StringAt(i, &length);
+                i = document.NextIndex(i);
+                value.members.emplace_back(std::string(key, length), ValueFromTape(document, i));
+                i = document.NextIndex(i);
+            }
+            break;
+        }
+        case TapeType::kArrayStart: {
+            value.type = Value::kArray;
+            size_t end = document.ContainerEndAt(index);
+            for (size_t i = index + 1; i < end; i = document.NextIndex(i)) {
+                value.elements.push_back(ValueFromTape(document, i));
+            }
+            break;
+        }
+        case TapeType::kString: {
+            value.type = Value::kString;
+            uint32_t length;
+            const char *string = document.StringAt(index, &length);
+            value.string.assign(string, length);
+            break;
+        }
+        case TapeType::kInt64:
+            value.type = Value::kInt64;
+            value.integer = document.Int64At(index);
+            break;
+        case TapeType::kDouble:
+            value.type = Value::kDouble;
+            value.number = document.DoubleAt(index);
+            break;
+        case TapeType::kTrue:
+            value.type = Value::kTrue;
+            break;
+        case TapeType::kFalse:
+            value.type = Value::kFalse;
+            break;
+        default:
+            value.type = Value::kNull;
+            break;
+    }
+    return value;
+}
+
+/// 序列化选项，随机生成用例时打乱空白与转义写法
+struct WriteStyle {
+    std::mt19937_64 *random = nullptr;
+
+    bool Chance(int percent) const { return random && static_cast<int>((*random)() % 100) < percent; }
+    void Whitespace(std::string *out) const {
+        static const char kWhitespace[] = {' ', '\t', '\n', '\r'};
+        while (Chance(15)) {
+            out->push_back(kWhitespace[(*random)() % 4]);
+        }
+    }
+};
+
+void WriteString(const std::string &string, const WriteStyle &style, std::string *out) {
+    out->push_back('"');
+    char buffer[16];
+    for (size_t i = 0; i < string.size(); i++) {
+        uint8_t c = static_cast<uint8_t>(string[i]);
+        if (c == '"' || c == '\\') {
+            out->push_back('\\');
+            out->push_back(static_cast<char>(c));
+        } else if (c < 0x20 || (c < 0x80 && style.Chance(3))) {
+            snprintf(buffer, sizeof(buffer), style.Chance(50) ? "\\u%04x" : "\\u%04X", c);
+            out->append(buffer);
+        } else if (c == '/' && style.Chance(50)) {
+            out->append("\\/");
+        } else if (c >= 0xF0 && style.Chance(50)) {
+            // 四字节UTF-8改写为代理对转义
+            uint32_t codePoint = ((c & 0x07) << 18) | ((string[i + 1] & 0x3F) << 12) | ((string[i + 2] & 0x3F) << 6) | (string[i + 3] & 0x3F);
+            codePoint -= 0x10000;
+            snprintf(buffer, sizeof(buffer), "\\u%04x\\u%04x", 0xD800 + (codePoint >> 10), 0xDC00 + (codePoint & 0x3FF));
+            out->append(buffer);
+            i += 3;
+        } else {
+            out->push_back(static_cast<char>(c));
+        }
+    }
+    out->push_back('"');
+}
+
+/// 最短的可精确还原的写法
+void WriteDouble(double number, const WriteStyle &style, std::string *out) {
+    char buffer[40];
+    bool exponentForm = style.Chance(30);
+    for (int precision = 1; precision <= 17; precision++) {
+        if (exponentForm) {
+            snprintf(buffer, sizeof(buffer), "%.*e", precision - 1, number);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%.*g", precision, number);
+        }
+        if (strtod(buffer, nullptr) == number) {
+            break;
+        }
+    }
+    std::string text(buffer);
+    if (text.find_first_of(".eE") == std::string::npos) {
+        text += ".0";  // 保持double类型
+    }
+    out->append(text);
+}
+
+void Write(const Value &value, const WriteStyle &style, std::string *out) {
+    switch (value.type) {
+        case Value::kNull: out->append("null"); break;
+        case Value::kTrue: out->append("true"); break;
+        case Value::kFalse: out->append("false"); break;
+        case Value::kInt64: out->append(std::to_string(value.integer)); break;
+        case Value::kDouble: WriteDouble(value.number, style, out); break;
+        case Value::kString: WriteString(value.string, style, out); break;
+        case Value::kArray:
+            out->push_back('[');
+            for (size_t i = 0; i < value.elements.size(); i++) {
+                if (i) {
+                    out->push_back(',');
+                }
+                style.Whitespace(out);
+                Write(value.elements[i], style, out);
+                style.Whitespace(out);
+            }
+            out->push_back(']');
+            break;
+        case Value::kObject:
+            out->push_back('{');
+            for (size_t i = 0; i < value.members.size(); i++) {
+                if (i) {
+                    out->push_back(',');
+                }
+                style.Whitespace(out);
+                WriteString(value.members[i].first, style, out);
+                style.Whitespace(out);
+                out->push_back(':');
+                style.Whitespace(out);
+                Write(value.members[i].second, style, out);
+                style.Whitespace(out);
+            }
+            out->push_back('}');
+            break;
+    }
+}
+
+// 随机用例
+
+std::string RandomString(std::mt19937_64 &random) {
+    static const char *const kPieces[] = {"a", "b", "Z", "0", " ", "\"", "\\", "/", "\n", "\t", "\x01", "\x1f",
+                                          "\xc3\xa9", "\xe4\xb8\xad", "\xf0\x9f\x98\x80", "\xef\xbf\xbf", "{}", "[]", ":,"};
+    std::string string;
+    size_t length = random() % 24;
+    if (random() % 20 == 0) {
+        length += 64 + random() % 200;  // 跨多个64字节分块
+    }
+    for (size_t i = 0; i < length; i++) {
+        string += kPieces[random() % (sizeof(kPieces) / sizeof(kPieces[0]))];
+    }
+    return string;
+}
+
+Value RandomValue(std::mt19937_64 &random, int depth) {
+    Value value;
+    unsigned kind = static_cast<unsigned>(random() % 10);
+    if (depth > 5 && kind >= 8) {
+        kind = random() % 8;
+    }
+    switch (kind) {
+        case 0: value.type = Value::kNull; break;
+        case 1: value.type = random() % 2 ? Value::kTrue : Value::kFalse; break;
+        case 2:
+            value.type = Value::kInt64;
+            value.integer = static_cast<int64_t>(random()) >> (random() % 64);
+            break;
+        case 3:
+            value.type = Value::kInt64;
+            value.integer = static_cast<int64_t>(random() % 2001) - 1000;
+            break;
+        case 4: {
+            value.type = Value::kDouble;
+            uint64_t bits = random();
+            memcpy(&value.number, &bits, sizeof(bits));
+            if (!std::isfinite(value.number)) {
+                value.number = 0.5;
+            }
+            break;
+        }
+        case 5:
+            value.type = Value::kDouble;
+            value.number = static_cast<double>(static_cast<int64_t>(random() % 2000000) - 1000000) / 100.0;
+            break;
+        case 6:
+        case 7:
+            value.type = Value::kString;
+            value.string = RandomString(random);
+            break;
+        case 8: {
+            value.type = Value::kArray;
+            size_t count = random() % 7;
+            for (size_t i = 0; i < count; i++) {
+                value.elements.push_back(RandomValue(random, depth + 1));
+            }
+            break;
+        }
+        default: {
+            value.type = Value::kObject;
+            size_t count = random() % 7;
+            for (size_t i = 0; i < count; i++) {
+                // 先生成key再生成value，保证同一种子在各编译器下得到相同的文档
+                std::string key = RandomString(random);
+                Value member = RandomValue(random, depth + 1);
+                value.members.emplace_back(std::move(key), std::move(member));
+            }
+            break;
+        }
+    }
+    return value;
+}
+
+void Mutate(std::mt19937_64 &random, std::string *json) {
+    static const char kBytes[] = "{}[]:,\"\\ 0e-.tx\x00\xff\x80\xc3";
+    size_t count = 1 + random() % 3;
+    for (size_t i = 0; i < count && !json->empty(); i++) {
+        size_t position = random() % json->size();
+        char byte = kBytes[random() % (sizeof(kBytes) - 1)];
+        switch (random() % 3) {
+            case 0: (*json)[position] = byte; break;
+            case 1: json->insert(json->begin() + static_cast<long>(position), byte); break;
+            default: json->erase(position, 1); break;
+        }
+    }
+}
+
+// 用例执行
+
+struct Stats {
+    size_t total = 0;
+    size_t accepted = 0;
+    size_t failures = 0;
+};
+
+std::string Preview(const std::string &json) {
+    std::string preview = json.substr(0, 80);
+    for (char &c : preview) {
+        if (static_cast<uint8_t>(c) < 0x20) {
+            c = '?';
+        }
+    }
+    return preview;
+}
+
+void Check(const std::string &json, Stats *stats, const char *label) {
+    stats->total++;
+    Value expected;
+    bool expectedOk = ReferenceParser(json).Parse(&expected);
+    Document document;
+    bool ok = document.Parse(json.data(), json.size());
+    if (ok != expectedOk) {
+        stats->failures++;
+        printf("FAIL [%s] %s: %s\n", label, ok ? "accepted invalid" : "rejected valid", Preview(json).c_str());
+        if (!ok) {
+            printf("     error: %s at %zu\n", document.error().c_str(), document.error_offset());
+        }
+        return;
+    }
+    if (!ok) {
+        return;
+    }
+    stats->accepted++;
+    if (!Equal(ValueFromTape(document, Document::kRootIndex), expected)) {
+        stats->failures++;
+        printf("FAIL [%s] value mismatch: %s\n", label, Preview(json).c_str());
+    }
+}
+
+/// 手写用例：边界数字、转义、UTF-8、结构错误、嵌套深度等
+std::vector<std::string> HandwrittenCases() {
+    std::vector<std::string> cases = {
+        "{}", "[]", "1", "-0", "-0.0", "0.5", "1e400", "-1e400", "1e-400", "-1.5e-3", "1E5", "1e+5", "1e-5",
+        "9223372036854775807", "-9223372036854775808", "9223372036854775808", "-9223372036854775809",
+        "123456789012345678901234", "0.1234567890123456789", "3.141592653589793238462643383279",
+        "2.2250738585072011e-308", "4.9e-324", "1.7976931348623157e308", "9007199254740993", "9007199254740993.0",
+        "\"a\\\"b\"", "\"\\\\\"", "\"\\/\\b\\f\\n\\r\\t\"", "\"\\u0041\\u00e9\\ud83d\\ude00\"", "\"\\ud83d\"",
+        "\"\\ude00\"", "\"\\ud83dx\"", "\"\\ud83d\\u0041\"", "\"\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80\"",
+        "[true,false,null]", "{\"a\":[{\"b\":null}]}", " \t\r\n[ 1 , 2 ]\n", "{\"\":\"\"}", "{\"a\":1,\"a\":2}",
+        // 非法
+        "", "   ", "[1,]", "{\"a\":1,}", "01", "-01", "1.", ".5", "-", "+1", "tru", "nul", "True", "NaN", "Infinity",
+        "[1 2]", "{\"a\" 1}", "{\"a\":}", "{a:1}", "{'a':1}", "\"\x01\"", "\"\t\"", "\"abc", "[", "]", "{", "}",
+        "[1]x", "{\"a\":1}{\"b\":2}", "1 2", "\"\\x\"", "\"\\u12\"", "\"\\u12G4\"", "[-]", "[--1]", "[1e]", "[1e+]",
+        "\"\xc3\"", "\"\xc3\x28\"", "\"\xc0\xaf\"", "\"\xe0\x80\xaf\"", "\"\xed\xa0\x80\"", "\"\xf4\x90\x80\x80\"",
+        "\"\xff\"", "\xef\xbb\xbf{}", "[\"a\"\"b\"]", "{\"a\":1:2}", "[1,,2]", "[,]", "{,}", "\x00", "[\x00]",
+    };
+    // 反斜杠跨64字节分块边界
+    for (size_t count = 60; count <= 70; count++) {
+        cases.push_back("\"" + std::string(count, '\\') + "\"");
+        cases.push_back("[\"" + std::string(count, 'a') + "\\\"\",1]");
+    }
+    // 嵌套深度上限
+    size_t depth = kuikly::json::kMaxDepth;
+    cases.push_back(std::string(depth, '[') + std::string(depth, ']'));
+    cases.push_back(std::string(depth + 1, '[') + std::string(depth + 1, ']'));
+    std::string nestedObject;
+    for (size_t i = 0; i < depth; i++) {
+        nestedObject += "{\"a\":";
+    }
+    nestedObject += "1" + std::string(depth, '}');
+    cases.push_back(nestedObject);
+    return cases;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    size_t randomCount = argc > 1 ? static_cast<size_t>(strtoul(argv[1], nullptr, 10)) : 3000;
+    Stats stats;
+    for (const std::string &json : HandwrittenCases()) {
+        Check(json, &stats, "handwritten");
+    }
+    std::mt19937_64 random(7);
+    for (size_t i = 0; i < randomCount; i++) {
+        WriteStyle style;
+        style.random = &random;
+        std::string json;
+        style.Whitespace(&json);
+        Write(RandomValue(random, 0), style, &json);
+        style.Whitespace(&json);
+        Check(json, &stats, "random");
+        for (int k = 0; k < 3; k++) {
+            std::string mutated = json;
+            Mutate(random, &mutated);
+            Check(mutated, &stats, "mutated");
+        }
+    }
+    printf("KRJSONParserCore conformance (%s): %zu cases, %zu accepted, %zu failures\n",
+#if defined(__SSE2__) || (defined(__aarch64__) && defined(__ARM_NEON))
+           "simd",
+#else
+           "scalar",
+#endif
+           stats.total, stats.accepted, stats.failures);
+    return stats.failures ? 1 : 0;
+}
@@ -98,6 +98,24 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (UIImage *)kr_applyColorFilterWithColorMatrix:(NSString *)colorFilterMatrix;
 
+/**
+ * 图片原始像素尺寸（降采样解码的图片记录解码前尺寸，未记录时返回图片自身像素尺寸）
+ */
+@property (nonatomic, assign) CGSize kr_originalPixelSize;
+
+/**
+ * 按目标像素尺寸降采样解码图片，目标尺寸为CGSizeZero或不小于原图时按原图解码
+ * @param data 图片数据
+ * @param targetPixelSize 目标像素尺寸
+ * @param aspectFill YES表示降采样结果需铺满目标尺寸，NO表示完整放入目标尺寸
+ */
++ (nullable UIImage *)kr_imageWithData:(NSData *)data targetPixelSize:(CGSize)targetPixelSize aspectFill:(BOOL)aspectFill;
+
+/**
+ * 按目标像素尺寸降采样解码本地图片文件，规则同kr_imageWithData:targetPixelSize:aspectFill:
+ */
++ (nullable UIImage *)kr_imageWithContentsOfFile:(NSString *)path targetPixelSize:(CGSize)targetPixelSize aspectFill:(BOOL)aspectFill;
+
 @end
 
 @interface NSMutableAttributedString (KR)
@@ -21,6 +21,8 @@
 #import <objc/runtime.h>
 #import <Accelerate/Accelerate.h>
 #import <CoreImage/CoreImage.h>
+#import <ImageIO/ImageIO.h>
+#import "KRTraceRecorder.h"
 
 @implementation NSObject (KR)
 
@@ -535,6 +537,96 @@
     return filteredImage;
 }
 
+- (CGSize)kr_originalPixelSize {
+    NSValue *value = objc_getAssociatedObject(self, @selector(kr_originalPixelSize));
+    if (value) {
+        return [value CGSizeValue];
+    }
+    return CGSizeMake(self.size.width * self.scale, self.size.height * self.scale);
+}
+
+- (void)setKr_originalPixelSize:(CGSize)kr_originalPixelSize {
+    objc_setAssociatedObject(self, @selector(kr_originalPixelSize), [NSValue valueWithCGSize:kr_originalPixelSize], OBJC_ASSOCIATION_RETAIN);
+}
+
++ (UIImage *)kr_imageWithData:(NSData *)data targetPixelSize:(CGSize)targetPixelSize aspectFill:(BOOL)aspectFill {
+    if (!data.length) {
+        return nil;
+    }
+    CGImageSourceRef source = CGImageSourceCreateWithData((__bridge CFDataRef)data, NULL);
+    KRTraceBegin("image.decode");
+    UIImage *image = [self kr_imageWithImageSource:source targetPixelSize:targetPixelSize aspectFill:aspectFill];
+    if (source) {
+        CFRelease(source);
+    }
+    image = image ?: [UIImage imageWithData:data];
+    KRTraceEnd("image.decode");
+    return image;
+}
+
++ (UIImage *)kr_imageWithContentsOfFile:(NSString *)path targetPixelSize:(CGSize)targetPixelSize aspectFill:(BOOL)aspectFill {
+    if (!path.length) {
+        return nil;
+    }
+    CGImageSourceRef source = CGImageSourceCreateWithURL((__bridge CFURLRef)[NSURL fileURLWithPath:path], NULL);
+    KRTraceBegin("image.decode");
+    UIImage *image = [self kr_imageWithImageSource:source targetPixelSize:targetPixelSize aspectFill:aspectFill];
+    if (source) {
+        CFRelease(source);
+    }
+    image = image ?: [UIImage imageWithContentsOfFile:path];
+    KRTraceEnd("image.decode");
+    return image;
+}
+
+/*
+ * 降采样解码，无需降采样（或不支持降采样）时返回nil，由调用方走原图解码
+ */
++ (UIImage *)kr_imageWithImageSource:(CGImageSourceRef)source targetPixelSize:(CGSize)targetPixelSize aspectFill:(BOOL)aspectFill {
+    if (!source || targetPixelSize.width <= 0 || targetPixelSize.height <= 0) {
+        return nil;
+    }
+    if (CGImageSourceGetCount(source) != 1) { // 动图交由原解码逻辑处理
+        return nil;
+    }
+    CFDictionaryRef properties = CGImageSourceCopyPropertiesAtIndex(source, 0, NULL);
+    if (!properties) {
+        return nil;
+    }
+    NSDictionary *imageProperties = (__bridge_transfer NSDictionary *)properties;
+    CGFloat pixelWidth = [imageProperties[(__bridge NSString *)kCGImagePropertyPixelWidth] doubleValue];
+    CGFloat pixelHeight = [imageProperties[(__bridge NSString *)kCGImagePropertyPixelHeight] doubleValue];
+    NSInteger orientation = [imageProperties[(__bridge NSString *)kCGImagePropertyOrientation] integerValue];
+    if (orientation >= kCGImagePropertyOrientationLeftMirrored) { // 旋转90度的方向，宽高互换
+        CGFloat temp = pixelWidth;
+        pixelWidth = pixelHeight;
+        pixelHeight = temp;
+    }
+    if (pixelWidth <= 0 || pixelHeight <= 0) {
+        return nil;
+    }
+    CGFloat horizontalRatio = targetPixelSize.width / pixelWidth;
+    CGFloat verticalRatio = targetPixelSize.height / pixelHeight;
+    CGFloat ratio = aspectFill ? MAX(horizontalRatio, verticalRatio) : MIN(horizontalRatio, verticalRatio);
+    if (ratio >= 1) {
+        return nil;
+    }
+    NSDictionary *options = @{
+        (__bridge NSString *)kCGImageSourceCreateThumbnailFromImageAlways : @YES,
+        (__bridge NSString *)kCGImageSourceCreateThumbnailWithTransform : @YES,
+        (__bridge NSString *)kCGImageSourceShouldCacheImmediately : @YES,
+        (__bridge NSString *)kCGImageSourceThumbnailMaxPixelSize : @(ceil(MAX(pixelWidth, pixelHeight) * ratio))
+    };
+    CGImageRef cgImage = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)options);
+    if (!cgImage) {
+        return nil;
+    }
+    UIImage *image = [UIImage imageWithCGImage:cgImage];
+    CGImageRelease(cgImage);
+    image.kr_originalPixelSize = CGSizeMake(pixelWidth, pixelHeight);
+    return image;
+}
+
 
 @end
 
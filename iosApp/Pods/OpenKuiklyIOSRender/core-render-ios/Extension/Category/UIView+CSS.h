@@ -56,6 +56,8 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, assign) BOOL kr_canCancelInScrollView;
 /// 是否禁止复用
 @property (nonatomic, assign) BOOL kr_reuseDisable;
+/// 在开启虚拟化的列表中是否禁止移出视图树（如吸顶view）
+@property (nonatomic, assign) BOOL kr_virtualizationDisable;
 /// View的Wrapper，部分情况下需要外层包裹KRView，比如boxShadowView等
 @property (nonatomic, strong, nullable) UIView *kr_commonWrapperView;
 
@@ -17,6 +17,7 @@
 #import <objc/runtime.h>
 #import "KRConvertUtil.h"
 #import "KRView.h"
+#import "KRScrollView.h"
 #import "KuiklyRenderBridge.h"
 #import "KuiklyRenderViewExportProtocol.h"
 #define LAZY_ANIMATION_KEY @"lazyAnimationKey"
@@ -233,6 +234,8 @@
        
         self.css_transformImp = css_transform.length ? [[CSSTransform alloc] initWithCSSTransform:css_transform] : nil;
         [self.css_transformImp applyToView:self animation:self.css_animationImp oldTransform:oldTransform];
+        // 形变改变了frame（外接矩形），同步列表索引
+        [KRScrollContentView subviewFrameDidChange:self];
     }
 }
 
@@ -359,9 +362,11 @@
 }
 
 - (void)setCss_zIndex:(NSNumber *)css_zIndex {
-    if (self.css_zIndex != css_zIndex) {
+    NSNumber *oldZIndex = self.css_zIndex;
+    if (oldZIndex != css_zIndex) {
         objc_setAssociatedObject(self, @selector(css_zIndex), css_zIndex, OBJC_ASSOCIATION_RETAIN);
         self.layer.zPosition = [css_zIndex intValue];
+        [KRView subviewZIndexDidChange:self oldZIndex:oldZIndex];
     }
 }
 
@@ -490,6 +495,7 @@
     objc_setAssociatedObject(self, @selector(css_frame), css_frame, OBJC_ASSOCIATION_RETAIN);
     if (!css_frame) {
         self.frame = CGRectZero;
+        [KRScrollContentView subviewFrameDidChange:self];
         return ;
     }
     CGRect frame =  [css_frame CGRectValue];
@@ -514,6 +520,7 @@
     } else {
         setFrameBlock();
     }
+    [KRScrollContentView subviewFrameDidChange:self];
     [self p_limitMaxBorderRadisuIfNeed];
 }
 
@@ -686,6 +693,14 @@
     objc_setAssociatedObject(self, @selector(kr_reuseDisable), @(kr_reuseDisable), OBJC_ASSOCIATION_RETAIN);
 }
 
+- (BOOL)kr_virtualizationDisable {
+    return [objc_getAssociatedObject(self, @selector(kr_virtualizationDisable)) boolValue];
+}
+
+- (void)setKr_virtualizationDisable:(BOOL)kr_virtualizationDisable {
+    objc_setAssociatedObject(self, @selector(kr_virtualizationDisable), @(kr_virtualizationDisable), OBJC_ASSOCIATION_RETAIN);
+}
+
 - (void)css_onClickTapWithSender:(UIGestureRecognizer *)sender {
     CGPoint location = [sender locationInView:self];
     CGPoint pageLocation = [sender locationInView:self.window];
@@ -843,7 +858,11 @@
 }
 
 - (void)hrv_removeFromSuperview {
-    [(self.kr_commonWrapperView ?: self) removeFromSuperview];
+    UIView *view = self.kr_commonWrapperView ?: self;
+    if (!view.superview) { // 可能已被虚拟化列表移出视图树
+        [KRScrollContentView detachedSubviewWillRemove:view];
+    }
+    [view removeFromSuperview];
 }
 
 #pragma mark - view extension
@@ -14,12 +14,13 @@
  */
 
 #import "KRScrollViewOffsetAnimator.h"
+#import "KRDisplayLink.h"
 
 @interface KRScrollViewOffsetAnimator ()
 
 @property (nonatomic, weak) UIScrollView *scrollView;
 @property (nonatomic, weak) id<KRScrollViewOffsetAnimatorDelegate> delegate;
-@property (nonatomic, strong) CADisplayLink *displayLink;
+@property (nonatomic, strong) KRDisplayLink *displayLink;
 @property (nonatomic, strong) NSDate *animationStartTime;
 @property (nonatomic, assign) CGPoint fromOffset;
 @property (nonatomic, assign) CGPoint toOffset;
@@ -43,18 +44,21 @@
 }
 
 - (void)cancel {
-    [self.displayLink invalidate];
+    [self.displayLink stop];
     self.displayLink = nil;
 }
 
 - (void)animateToOffset:(CGPoint)offset withVelocity:(CGPoint)velocity {
     [self cancel];
     self.lastOffset = [self getCurScrollContetOffset];
-    self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(updateScrollViewContentOffset:)];
-    [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    self.displayLink = [[KRDisplayLink alloc] init];
+    __weak __typeof__(self) wself = self;
+    [self.displayLink startWithCallback:^(CFTimeInterval timestamp) {
+        [wself updateScrollViewContentOffset];
+    }];
 }
 
-- (void)updateScrollViewContentOffset:(CADisplayLink *)displayLink {
+- (void)updateScrollViewContentOffset {
     // 在动画过程中，可以通过以下方式获取当前的偏移量
     CGPoint currentOffset = [self getCurScrollContetOffset];
     if (!CGPointEqualToPoint(currentOffset, self.lastOffset)) {
@@ -15,13 +15,57 @@
 
 #import <UIKIt/UIKit.h>
 #import "KuiklyRenderViewExportProtocol.h"
+#import "KRMemoryMonitor.h"
 
 NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, KRImageLoadPriority) {
+    KRImageLoadPriorityVisible = 0,     // 可见或即将可见（默认）
+    KRImageLoadPriorityPrefetch = 1,    // 列表惯性滚动中不在可视区域，预取即可，应低于可见图片
+    KRImageLoadPriorityHigh = 2,        // 位于列表惯性滚动预测的停留区域，应优先于其他图片
+};
+
 /*
  * @brief 暴露给Kotlin侧调用的Image组件
  */
 @interface KRImageView : UIImageView<KuiklyRenderViewExportProtocol>
 
+/// 本次加载的优先级，在调用hr_setImageWithUrl前更新，自定义图片加载可据此调度下载
+@property (nonatomic, assign, readonly) KRImageLoadPriority loadPriority;
+
+/*
+ * 提升加载优先级：图片尚未加载完成时按新优先级立即（重新）发起加载
+ */
+- (void)promoteLoadPriority:(KRImageLoadPriority)priority;
+
+
+@end
+
+/*
+ * @brief 图片刷新缓存，view复用时暂存图片，复用后设置相同src时直接命中，避免闪白
+ * 采用新/旧两代缓存：每个代际周期结束时新代变为旧代、旧代丢弃，图片最多存活两个周期；
+ * 总字节数超出上限时优先淘汰旧代，仍超出则按写入顺序淘汰新代中最早的图片。仅在主线程访问。
+ */
+@interface KRImageRefreshCache : NSObject
+/** 缓存字节数上限，默认20MB */
+@property (nonatomic, assign) NSUInteger byteLimit;
+/** 当前缓存的图片字节数 */
+@property (nonatomic, assign, readonly) NSUInteger totalBytes;
+/** 查询命中次数 */
+@property (nonatomic, assign, readonly) NSUInteger hitCount;
+/** 查询未命中次数 */
+@property (nonatomic, assign, readonly) NSUInteger missCount;
+
++ (instancetype)sharedInstance;
+/// clock为代际计时时钟（秒，单调递增），init使用CACurrentMediaTime；自测可注入模拟时钟
+- (instancetype)initWithClock:(CFTimeInterval (^)(void))clock NS_DESIGNATED_INITIALIZER;
+- (void)cacheWithKey:(NSString *)key image:(UIImage *)image;
+- (UIImage *_Nullable)imageWithKey:(NSString *)key;
+- (void)removeAllCache;
+/** 命中率（无查询时为0） */
+- (double)hitRate;
+/** 内存压力：警告时淘汰旧代，严重时全部清空（KRMemoryPressureNotification到来时调用） */
+- (void)handleMemoryPressureLevel:(KRMemoryPressureLevel)level;
 
 @end
 
@@ -22,6 +22,8 @@
 #import "KuiklyContextParam.h"
 #import "NSObject+KR.h"
 #import "KRBlurView.h"
+#import "KRMemoryMonitor.h"
+#import "KRScrollView.h"
 
 NSString *const KRImageAssetsPrefix = @"assets://";
 NSString *const KRImageLocalPathPrefix = @"file://";
@@ -30,20 +32,16 @@ NSString *const KRImageBase64Prefix = @"data:image";
 
 
 
+typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
+
 /*
- * @brief 图片刷新缓存类
+ * 图片是否为降采样解码的图片（像素尺寸小于原图）
  */
-@interface KRImageRefreshCache : NSObject
-/** 延迟批量更新标记 */
-@property (nonatomic, assign) NSUInteger delayBatchFlag;
-+ (instancetype)sharedInstance;
-- (void)cacheWithKey:(NSString *)key image:(UIImage *)image;
-- (UIImage *_Nullable)imageWithKey:(NSString *)key;
-- (void)removeAllCache;
-
-
-@end
-typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
+static BOOL KRImageIsDownsampled(UIImage *image) {
+    CGSize originalPixelSize = image.kr_originalPixelSize;
+    return originalPixelSize.width > image.size.width * image.scale
+        || originalPixelSize.height > image.size.height * image.scale;
+}
 
 /*
  * @brief 暴露给Kotlin侧调用的Image组件
@@ -82,6 +80,12 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
 
 @implementation KRImageView {
     UIImage *_originImage;
+    /** 当前src加载时使用的目标像素尺寸，CGSizeZero表示按原图解码 */
+    CGSize _targetPixelSize;
+    /** src已设置但尺寸未确定，待frame设置后再加载 */
+    BOOL _needsLoadSrc;
+    /// promoteLoadPriority提升后的优先级下限，src变化或复用时重置
+    KRImageLoadPriority _promotedLoadPriority;
 }
 
 @synthesize hr_rootView;
@@ -91,6 +95,7 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
         self.contentMode = UIViewContentModeScaleAspectFill;
         self.clipsToBounds = YES;
         self.semanticContentAttribute = UISemanticContentAttributeForceLeftToRight;
+        _promotedLoadPriority = KRImageLoadPriorityPrefetch;
     }
     return self;
 }
@@ -104,10 +109,15 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
 
 - (void)hrv_prepareForeReuse {
     if (self.image && self.css_src && _originImage) {
-        [[KRImageRefreshCache sharedInstance] cacheWithKey:self.css_src image:_originImage];
+        NSString *cacheKey = [self p_cacheKeyWithSrc:self.css_src targetPixelSize:_targetPixelSize];
+        [[KRImageRefreshCache sharedInstance] cacheWithKey:cacheKey image:_originImage];
     }
     KUIKLY_RESET_CSS_COMMON_PROP;
     _originImage = nil;
+    _targetPixelSize = CGSizeZero;
+    _needsLoadSrc = NO;
+    _loadPriority = KRImageLoadPriorityVisible;
+    _promotedLoadPriority = KRImageLoadPriorityPrefetch;
     self.css_src = nil;
     self.css_tintColor = nil;
     self.css_colorFilter = nil;
@@ -146,7 +156,9 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
     }
     // Remove "file://" prefix to get the actual file path
     NSString *actualPath = [localUrl substringFromIndex:[KRImageLocalPathPrefix length]];
-    UIImage *image = [UIImage imageWithContentsOfFile:actualPath];
+    UIImage *image = [UIImage kr_imageWithContentsOfFile:actualPath
+                                         targetPixelSize:_targetPixelSize
+                                              aspectFill:[self p_isAspectFillDecode]];
     self.image = image;
 }
 
@@ -154,14 +166,15 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
     if (self.css_src != css_src) {
         _css_src = css_src;
         [self bindImageToView:nil]; // clear current image 清除缓存
+        _needsLoadSrc = NO;
+        _promotedLoadPriority = KRImageLoadPriorityPrefetch;
         if (css_src) {
-            UIImage *image = [[KRImageRefreshCache sharedInstance] imageWithKey:css_src];
-            if (image) {
-                self.image = image;
+            if (CGSizeEqualToSize(self.bounds.size, CGSizeZero)) {
+                // 尺寸未确定（如新建或复用重置后），待frame设置后再按view尺寸加载
+                [self p_setNeedsLoadSrc];
                 return;
             }
-            // 缓存中不存在当前src对应的图片，则再执行加载
-            [self setImageWithSrc:css_src];
+            [self p_loadSrc];
         }
     }
 }
@@ -171,8 +184,23 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
  * @param css_src：图片路径
  */
 - (void)setImageWithSrc:(NSString *)css_src {
+    [self p_loadImageWithSrc:css_src clearCurrentImage:YES];
+}
+
+/*
+ * 根据src加载图片
+ * @param css_src：图片路径
+ * @param clearCurrentImage：是否先清除当前图片（尺寸变大重新加载时保留当前图片，避免闪白）
+ */
+- (void)p_loadImageWithSrc:(NSString *)css_src clearCurrentImage:(BOOL)clearCurrentImage {
+    if (_needsLoadSrc) {
+        return; // 待frame设置后统一加载
+    }
     if (css_src) {
-        [self bindImageToView:nil]; // clear current image
+        if (clearCurrentImage) {
+            [self bindImageToView:nil]; // clear current image
+        }
+        _targetPixelSize = [self p_targetPixelSize];
         if ([css_src hasPrefix:KRImageAssetsPrefix]) {
             [self setAssetsImage:css_src];
         } else if ([css_src hasPrefix:KRImageBase64Prefix]) {
@@ -231,21 +259,31 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
 }
 
 - (BOOL)setImageWithUrl:(NSString *)url {
+    _loadPriority = [self p_loadPriorityInScrollView];
+    if ([self p_loadPriorityRank:_promotedLoadPriority] > [self p_loadPriorityRank:_loadPriority]) {
+        _loadPriority = _promotedLoadPriority;
+    }
     BOOL handled = false;
-    if ([[KuiklyRenderBridge componentExpandHandler] respondsToSelector:@selector(hr_setImageWithUrl:forImageView:complete:)]) {
-        __weak typeof(self) wself = self;
+    __weak typeof(self) wself = self;
+    ImageCompletionBlock completeBlock = ^(UIImage * _Nullable image, NSError * _Nullable error, NSURL * _Nullable imageURL) {
+        if (error && [imageURL.absoluteString isEqualToString:url]) {
+            if (wself.css_loadFailure) {
+                [wself p_fireLoadFailureEventWithErrorCode:error.code];
+            } else {
+                wself.pendingLoadFailure = true;
+                wself.errorCode = error.code;
+            }
+        }
+    };
+    if ([[KuiklyRenderBridge componentExpandHandler] respondsToSelector:@selector(hr_setImageWithUrl:forImageView:targetPixelSize:complete:)]) {
         handled = [[KuiklyRenderBridge componentExpandHandler] hr_setImageWithUrl:url
                                                                      forImageView:self
-                                                                         complete:^(UIImage * _Nullable image, NSError * _Nullable error, NSURL * _Nullable imageURL) {
-            if (error && [imageURL.absoluteString isEqualToString:url]) {
-                if (wself.css_loadFailure) {
-                    [self p_fireLoadFailureEventWithErrorCode:error.code];
-                } else {
-                    wself.pendingLoadFailure = true;
-                    wself.errorCode = error.code;
-                }
-            }
-        }];
+                                                                  targetPixelSize:_targetPixelSize
+                                                                         complete:completeBlock];
+    } else if ([[KuiklyRenderBridge componentExpandHandler] respondsToSelector:@selector(hr_setImageWithUrl:forImageView:complete:)]) {
+        handled = [[KuiklyRenderBridge componentExpandHandler] hr_setImageWithUrl:url
+                                                                     forImageView:self
+                                                                         complete:completeBlock];
     } else if ([[KuiklyRenderBridge componentExpandHandler] respondsToSelector:@selector(hr_setImageWithUrl:forImageView:)]) {
         handled = [[KuiklyRenderBridge componentExpandHandler] hr_setImageWithUrl:url forImageView:self];
     } else {
@@ -255,6 +293,52 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
 }
 
 
+// 所在列表有预测的惯性滚动时，预测停留区域内的图片高优先级加载，其余可视区域外的图片按预取优先级加载
+- (KRImageLoadPriority)p_loadPriorityInScrollView {
+    UIView *view = self.superview;
+    while (view && ![view isKindOfClass:[KRScrollView class]]) {
+        view = view.superview;
+    }
+    KRScrollView *scrollView = (KRScrollView *)view;
+    if (!scrollView.hasPredictedVisibleRange) {
+        return KRImageLoadPriorityVisible;
+    }
+    CGRect rect = [self convertRect:self.bounds toView:scrollView];
+    if (CGRectIntersectsRect(rect, scrollView.predictedVisibleRect)) {
+        return KRImageLoadPriorityHigh;
+    }
+    return CGRectIntersectsRect(rect, scrollView.bounds) ? KRImageLoadPriorityVisible : KRImageLoadPriorityPrefetch;
+}
+
+- (void)promoteLoadPriority:(KRImageLoadPriority)priority {
+    NSString *src = self.css_src;
+    if (!src || self.image || [self p_loadPriorityRank:priority] <= [self p_loadPriorityRank:_loadPriority]) {
+        return;
+    }
+    _promotedLoadPriority = priority;
+    if (_needsLoadSrc) {
+        // 尚未设置frame，按原图尺寸立即加载
+        [self p_loadSrc];
+    } else if (![src hasPrefix:KRImageAssetsPrefix] && ![src hasPrefix:KRImageBase64Prefix]
+               && ![src hasPrefix:KRImageLocalPathPrefix]) {
+        // 以新的优先级重新发起网络加载
+        [self setImageWithSrc:src];
+    }
+}
+
+/// 优先级排序，数值越大越优先
+- (NSInteger)p_loadPriorityRank:(KRImageLoadPriority)priority {
+    switch (priority) {
+        case KRImageLoadPriorityPrefetch:
+            return 0;
+        case KRImageLoadPriorityVisible:
+            return 1;
+        case KRImageLoadPriorityHigh:
+            return 2;
+    }
+    return 1;
+}
+
 - (void)setCss_resize:(NSString *)css_resize {
     if (self.css_resize != css_resize) {
         _css_resize = css_resize;
@@ -325,6 +409,18 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
     }
 }
 
+- (void)setFrame:(CGRect)frame {
+    [super setFrame:frame];
+    if (CGSizeEqualToSize(self.bounds.size, CGSizeZero)) {
+        return;
+    }
+    if (_needsLoadSrc) {
+        [self p_loadSrc];
+    } else if ([self p_shouldReloadForLargerSize]) {
+        [self p_loadImageWithSrc:self.css_src clearCurrentImage:NO];
+    }
+}
+
 - (void)layoutSubviews {
     [super layoutSubviews];
     [self p_syncMaskLinearGradientIfNeed];
@@ -332,6 +428,82 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
 
 #pragma mark - private
 
+- (void)p_loadSrc {
+    _needsLoadSrc = NO;
+    CGSize targetPixelSize = [self p_targetPixelSize];
+    NSString *cacheKey = [self p_cacheKeyWithSrc:self.css_src targetPixelSize:targetPixelSize];
+    UIImage *image = [[KRImageRefreshCache sharedInstance] imageWithKey:cacheKey];
+    if (image) {
+        _targetPixelSize = targetPixelSize;
+        self.image = image;
+        return;
+    }
+    // 缓存中不存在当前src对应的图片，则再执行加载
+    [self setImageWithSrc:self.css_src];
+}
+
+- (void)p_setNeedsLoadSrc {
+    _needsLoadSrc = YES;
+    NSString *src = self.css_src;
+    KR_WEAK_SELF
+    dispatch_async(dispatch_get_main_queue(), ^{
+        KR_STRONG_SELF_RETURN_IF_NIL
+        // 兜底：本轮UI操作后仍未设置frame，则按原图尺寸加载
+        if (strongSelf->_needsLoadSrc && strongSelf.css_src == src) {
+            [strongSelf p_loadSrc];
+        }
+    });
+}
+
+/*
+ * 降采样解码的目标像素尺寸（view尺寸 * 屏幕scale），CGSizeZero表示按原图解码
+ */
+- (CGSize)p_targetPixelSize {
+    if (self.css_capInsets.length || [self.css_dotNineImage boolValue]) {
+        return CGSizeZero; // 拉伸区域基于原图尺寸计算
+    }
+    UIViewContentMode contentMode = self.contentMode;
+    if (contentMode != UIViewContentModeScaleAspectFill
+        && contentMode != UIViewContentModeScaleAspectFit
+        && contentMode != UIViewContentModeScaleToFill) {
+        return CGSizeZero; // 非缩放模式按图片原尺寸展示
+    }
+    CGSize size = self.bounds.size;
+    if (size.width <= 0 || size.height <= 0) {
+        return CGSizeZero;
+    }
+    CGFloat scale = [UIScreen mainScreen].scale;
+    return CGSizeMake(ceil(size.width * scale), ceil(size.height * scale));
+}
+
+- (BOOL)p_isAspectFillDecode {
+    return self.contentMode != UIViewContentModeScaleAspectFit;
+}
+
+/*
+ * view变大且当前图片为降采样图片时，需按新尺寸重新加载
+ */
+- (BOOL)p_shouldReloadForLargerSize {
+    if (!_originImage || !self.css_src || CGSizeEqualToSize(_targetPixelSize, CGSizeZero)) {
+        return NO;
+    }
+    if (!KRImageIsDownsampled(_originImage)) {
+        return NO;
+    }
+    CGSize targetPixelSize = [self p_targetPixelSize];
+    if (CGSizeEqualToSize(targetPixelSize, CGSizeZero)) {
+        return YES;
+    }
+    return targetPixelSize.width > _targetPixelSize.width || targetPixelSize.height > _targetPixelSize.height;
+}
+
+- (NSString *)p_cacheKeyWithSrc:(NSString *)src targetPixelSize:(CGSize)targetPixelSize {
+    if (!src || CGSizeEqualToSize(targetPixelSize, CGSizeZero)) {
+        return src;
+    }
+    return [NSString stringWithFormat:@"%@#%.0fx%.0f", src, targetPixelSize.width, targetPixelSize.height];
+}
+
 - (void)p_setBase64Image:(NSString *)base64Str {
     __weak typeof(&*self) weakSelf = self;
     KuiklyRenderView *rootView =  self.hr_rootView;
@@ -340,6 +512,15 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
         return;
     }
     NSString *md5Key = base64Str;
+    CGSize targetPixelSize = _targetPixelSize;
+    BOOL aspectFill = [self p_isAspectFillDecode];
+    // 降采样图片以目标尺寸区分缓存，原key保留base64数据以便按其他尺寸解码
+    NSString *sizedKey = [self p_cacheKeyWithSrc:md5Key targetPixelSize:targetPixelSize];
+    id sizedImage = [module memoryObjectForKey:sizedKey];
+    if ([sizedImage isKindOfClass:[UIImage class]]) {
+        weakSelf.image = (UIImage *)sizedImage;
+        return ;
+    }
     base64Str = [module memoryObjectForKey:md5Key];
     if ([base64Str isKindOfClass:[UIImage class]]) {
         weakSelf.image = (UIImage *)base64Str;
@@ -352,9 +533,12 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
             if (range.length) {
                 NSString * base64 = [base64Str substringFromIndex:NSMaxRange(range)];
                 NSData * imageData =[[NSData alloc] initWithBase64EncodedString:base64 options:NSDataBase64DecodingIgnoreUnknownCharacters];
-                UIImage *image = [UIImage imageWithData:imageData];
+                UIImage *image = [UIImage kr_imageWithData:imageData targetPixelSize:targetPixelSize aspectFill:aspectFill];
+                if (!image) {
+                    return;
+                }
                 dispatch_async(dispatch_get_main_queue(), ^{
-                    [module setMemoryObjectWithKey:md5Key value:image];
+                    [module setMemoryObjectWithKey:(KRImageIsDownsampled(image) ? sizedKey : md5Key) value:image];
                     if (weakSelf.css_src == md5Key) {
                         weakSelf.image = image;
                     }
@@ -395,8 +579,10 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
 
 -(void)p_fireLoadResolutionEventWithImage:(UIImage *)image {
     if (_css_loadResolution) {
-        _css_loadResolution(@{ @"imageWidth" : @(image.size.width * image.scale),
-                               @"imageHeight" : @(image.size.height * image.scale)
+        // 降采样解码时仍回调原图尺寸（染色等处理后的图片不带原图尺寸，取处理前图片）
+        CGSize originalPixelSize = (_originImage ?: image).kr_originalPixelSize;
+        _css_loadResolution(@{ @"imageWidth" : @(originalPixelSize.width),
+                               @"imageHeight" : @(originalPixelSize.height)
                             });
     }
 }
@@ -563,8 +749,26 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
 
 // ***** KRImageRefreshCache ****** /
 
+/** 缓存代际周期（秒） */
+static const NSTimeInterval KRImageRefreshCacheGenerationInterval = 1.0;
+/** 默认缓存字节数上限 */
+static const NSUInteger KRImageRefreshCacheDefaultByteLimit = 20 * 1024 * 1024;
+
 @implementation KRImageRefreshCache {
-    NSMutableDictionary *_imageCache;
+    /** 新代缓存 */
+    NSMutableDictionary<NSString *, UIImage *> *_youngCache;
+    /** 新代key的写入顺序，超出上限时从最早写入的开始淘汰 */
+    NSMutableOrderedSet<NSString *> *_youngKeys;
+    /** 旧代缓存 */
+    NSMutableDictionary<NSString *, UIImage *> *_oldCache;
+    NSUInteger _youngBytes;
+    NSUInteger _oldBytes;
+    /** 当前新代开始时间 */
+    CFTimeInterval _generationBeginTime;
+    /** 是否已安排代际轮转 */
+    BOOL _rotationScheduled;
+    /** 代际计时时钟 */
+    CFTimeInterval (^_clock)(void);
 }
 
 + (instancetype)sharedInstance {
@@ -577,44 +781,195 @@ typedef void (^KRSetImageBlock) (UIImage *_Nullable image);
 }
 
 - (instancetype)init {
+    return [self initWithClock:^CFTimeInterval{
+        return CACurrentMediaTime();
+    }];
+}
+
+- (instancetype)initWithClock:(CFTimeInterval (^)(void))clock {
     self = [super init];
     if (self) {
-        _imageCache = [NSMutableDictionary new];
+        _youngCache = [NSMutableDictionary new];
+        _youngKeys = [NSMutableOrderedSet new];
+        _oldCache = [NSMutableDictionary new];
+        _byteLimit = KRImageRefreshCacheDefaultByteLimit;
+        _clock = [clock copy];
+        _generationBeginTime = _clock();
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(p_onMemoryPressure:)
+                                                     name:KRMemoryPressureNotification
+                                                   object:nil];
+        [KRMemoryMonitor registerMemoryCostReporter:self];
     }
     return self;
 }
 
+#pragma mark - KRMemoryCostReporter
+
+- (NSString *)kr_memoryCategory {
+    return @"imageRefreshCache";
+}
+
+- (int64_t)kr_memoryCost {
+    return self.totalBytes;
+}
+
 - (void)cacheWithKey:(NSString *)key image:(UIImage *)image {
-    if (key && image) {
-        [_imageCache setObject:image forKey:key];
-        // 等2s后释放
-        NSUInteger flag = ++self.delayBatchFlag;
-        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(2 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
-            if (flag == self.delayBatchFlag) {
-                [[[self class] sharedInstance] removeAllCache];
-            }
-        });
+    NSAssert([NSThread isMainThread], @"should be run on main thread");
+    if (!key || !image) {
+        return;
+    }
+    [self p_rotateGenerationIfNeed];
+    NSUInteger cost = [self p_costWithImage:image];
+    if (cost > _byteLimit) {
+        return;
+    }
+    [self p_removeImageWithKey:key];
+    if (_youngBytes + _oldBytes + cost > _byteLimit) {
+        [self p_removeOldGeneration];
+    }
+    if (_youngBytes + cost > _byteLimit) {
+        [self p_evictYoungGenerationToBytes:_byteLimit - cost];
     }
+    _youngCache[key] = image;
+    [_youngKeys addObject:key];
+    _youngBytes += cost;
+    [self p_scheduleRotationIfNeed];
 }
 
 - (UIImage *_Nullable)imageWithKey:(NSString *)key {
-    if (key) {
-        return _imageCache[key];
+    NSAssert([NSThread isMainThread], @"should be run on main thread");
+    if (!key) {
+        return nil;
+    }
+    [self p_rotateGenerationIfNeed];
+    UIImage *image = _youngCache[key];
+    if (!image) {
+        image = _oldCache[key];
+        if (image) { // 旧代命中，提升到新代
+            NSUInteger cost = [self p_costWithImage:image];
+            [_oldCache removeObjectForKey:key];
+            _oldBytes -= MIN(_oldBytes, cost);
+            _youngCache[key] = image;
+            [_youngKeys addObject:key];
+            _youngBytes += cost;
+        }
+    }
+    if (image) {
+        _hitCount++;
+    } else {
+        _missCount++;
     }
-    return nil;
+    return image;
 }
 
 - (void)removeCacheWithKey:(NSString *)key {
     if (key) {
-        [_imageCache removeObjectForKey:key];
+        [self p_removeImageWithKey:key];
     }
 }
 
 - (void)removeAllCache {
-    [_imageCache removeAllObjects];
+    [_youngCache removeAllObjects];
+    [_youngKeys removeAllObjects];
+    [_oldCache removeAllObjects];
+    _youngBytes = 0;
+    _oldBytes = 0;
+}
+
+- (NSUInteger)totalBytes {
+    return _youngBytes + _oldBytes;
+}
+
+- (double)hitRate {
+    NSUInteger total = _hitCount + _missCount;
+    return total ? (double)_hitCount / total : 0;
+}
+
+- (void)handleMemoryPressureLevel:(KRMemoryPressureLevel)level {
+    if (level >= KRMemoryPressureLevel_Critical) {
+        [self removeAllCache];
+    } else if (level == KRMemoryPressureLevel_Warning) {
+        [self p_removeOldGeneration];
+    }
+}
+
+#pragma mark - private
+
+- (void)p_rotateGenerationIfNeed {
+    CFTimeInterval now = _clock();
+    CFTimeInterval elapsed = now - _generationBeginTime;
+    if (elapsed < KRImageRefreshCacheGenerationInterval) {
+        return;
+    }
+    if (elapsed >= KRImageRefreshCacheGenerationInterval * 2) {
+        [self removeAllCache]; // 超过两个周期未轮转，新旧两代均已过期
+    } else {
+        _oldCache = _youngCache;
+        _oldBytes = _youngBytes;
+        _youngCache = [NSMutableDictionary new];
+        [_youngKeys removeAllObjects];
+        _youngBytes = 0;
+    }
+    _generationBeginTime = now;
+}
+
+// 无访问时也需按周期轮转，保证缓存最终清空
+- (void)p_scheduleRotationIfNeed {
+    if (_rotationScheduled) {
+        return;
+    }
+    _rotationScheduled = YES;
+    __weak typeof(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(KRImageRefreshCacheGenerationInterval * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf) {
+            return;
+        }
+        strongSelf->_rotationScheduled = NO;
+        [strongSelf p_rotateGenerationIfNeed];
+        if (strongSelf.totalBytes > 0) {
+            [strongSelf p_scheduleRotationIfNeed];
+        }
+    });
+}
+
+- (void)p_removeImageWithKey:(NSString *)key {
+    UIImage *image = _youngCache[key];
+    if (image) {
+        [_youngCache removeObjectForKey:key];
+        [_youngKeys removeObject:key];
+        _youngBytes -= MIN(_youngBytes, [self p_costWithImage:image]);
+    }
+    image = _oldCache[key];
+    if (image) {
+        [_oldCache removeObjectForKey:key];
+        _oldBytes -= MIN(_oldBytes, [self p_costWithImage:image]);
+    }
+}
+
+- (void)p_onMemoryPressure:(NSNotification *)notification {
+    [self handleMemoryPressureLevel:[notification.userInfo[KRMemoryPressureLevelKey] integerValue]];
 }
 
+// 按写入顺序淘汰新代，直到新代字节数不超过bytes
+- (void)p_evictYoungGenerationToBytes:(NSUInteger)bytes {
+    while (_youngBytes > bytes && _youngKeys.count) {
+        [self p_removeImageWithKey:_youngKeys.firstObject];
+    }
+}
 
+- (void)p_removeOldGeneration {
+    [_oldCache removeAllObjects];
+    _oldBytes = 0;
+}
 
+- (NSUInteger)p_costWithImage:(UIImage *)image {
+    CGImageRef cgImage = image.CGImage;
+    if (cgImage) {
+        return CGImageGetBytesPerRow(cgImage) * CGImageGetHeight(cgImage);
+    }
+    return (NSUInteger)(image.size.width * image.scale * image.size.height * image.scale * 4);
+}
 
 @end
@@ -0,0 +1,51 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * @brief 列表内容子view沿滚动轴的有序索引，用于滚动中的可见性查询
+ * 子view按起点排序并记录前缀最大终点，区间查询为O(log n + k)；
+ * 子view增删、frame（含形变后的外接矩形）变化时增量更新，删除按记录的起点二分定位；
+ * 短时间内变化过多则在下次查询时整体重建。
+ * 索引不持有子view，需由contentView在子view移除前通知（见KRScrollContentView）。
+ */
+@interface KRScrollContentIndex : NSObject
+
+- (instancetype)initWithContentView:(UIView *)contentView;
+/// 索引provider返回的view（如列表虚拟化中已移出视图树的子view），重建时调用provider
+- (instancetype)initWithViewsProvider:(NSArray<UIView *> *(^)(void))viewsProvider NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// 是否按横轴建立索引，修改后重建
+@property (nonatomic, assign) BOOL horizontal;
+/// 已索引的子view数量
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+- (void)setNeedsRebuild;
+- (void)subviewDidAdd:(UIView *)subview;
+- (void)subviewWillRemove:(UIView *)subview;
+- (void)subviewFrameDidChange:(UIView *)subview;
+
+/*
+ * @brief 枚举滚动轴上与[from, to)相交的子view（顺序不保证）
+ */
+- (void)enumerateSubviewsFrom:(CGFloat)from to:(CGFloat)to usingBlock:(void (NS_NOESCAPE ^)(UIView *subview, BOOL *stop))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
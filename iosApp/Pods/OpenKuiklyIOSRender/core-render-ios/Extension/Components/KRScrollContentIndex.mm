@@ -0,0 +1,213 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRScrollContentIndex.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+/// 两次查询之间增量更新超过该次数时改为整体重建（批量布局时逐个增量更新反而更慢）
+static const NSUInteger kKRScrollIndexMaxPendingUpdates = 64;
+
+namespace {
+
+struct KRScrollIndexEntry {
+    CGFloat start;
+    CGFloat end;
+    __unsafe_unretained UIView *view;
+};
+
+}  // namespace
+
+@implementation KRScrollContentIndex {
+    NSArray<UIView *> *(^_viewsProvider)(void);
+    /// 按start升序
+    std::vector<KRScrollIndexEntry> _entries;
+    /// _maxEnds[i]为_entries[0...i]中最大的end
+    std::vector<CGFloat> _maxEnds;
+    /// _maxEnds前多少项有效
+    size_t _validMaxEndCount;
+    /// 已索引view的起点，删除时据此二分定位
+    std::unordered_map<const void *, CGFloat> _startsByView;
+    BOOL _needsRebuild;
+    NSUInteger _pendingUpdateCount;
+}
+
+- (instancetype)initWithContentView:(UIView *)contentView {
+    __weak UIView *weakContentView = contentView;
+    return [self initWithViewsProvider:^NSArray<UIView *> *{
+        return weakContentView.subviews;
+    }];
+}
+
+- (instancetype)initWithViewsProvider:(NSArray<UIView *> *(^)(void))viewsProvider {
+    if (self = [super init]) {
+        _viewsProvider = [viewsProvider copy];
+        _needsRebuild = YES;
+    }
+    return self;
+}
+
+- (void)setHorizontal:(BOOL)horizontal {
+    if (_horizontal != horizontal) {
+        _horizontal = horizontal;
+        [self setNeedsRebuild];
+    }
+}
+
+- (NSUInteger)count {
+    [self p_rebuildIfNeeded];
+    return _entries.size();
+}
+
+- (void)setNeedsRebuild {
+    _needsRebuild = YES;
+}
+
+- (void)subviewDidAdd:(UIView *)subview {
+    if ([self p_shouldUpdateIncrementally]) {
+        [self p_insertEntry:[self p_entryWithView:subview]];
+    }
+}
+
+- (void)subviewWillRemove:(UIView *)subview {
+    if ([self p_shouldUpdateIncrementally]) {
+        [self p_removeView:subview];
+    }
+}
+
+- (void)subviewFrameDidChange:(UIView *)subview {
+    if ([self p_shouldUpdateIncrementally]) {
+        [self p_removeView:subview];
+        [self p_insertEntry:[self p_entryWithView:subview]];
+    }
+}
+
+- (void)enumerateSubviewsFrom:(CGFloat)from to:(CGFloat)to usingBlock:(void (NS_NOESCAPE ^)(UIView *, BOOL *))block {
+    [self p_rebuildIfNeeded];
+    [self p_updateMaxEndsIfNeeded];
+    _pendingUpdateCount = 0;
+    // 最后一个start < to的位置往前扫描，前缀最大end不超过from时更靠前的都不可能相交
+    auto it = std::lower_bound(_entries.begin(), _entries.end(), to, [](const KRScrollIndexEntry &entry, CGFloat value) {
+        return entry.start < value;
+    });
+    BOOL stop = NO;
+    for (size_t i = it - _entries.begin(); i > 0; i--) {
+        if (_maxEnds[i - 1] < from) {
+            break;
+        }
+        const KRScrollIndexEntry &entry = _entries[i - 1];
+        // 尺寸为0的view按点处理
+        if (entry.end > from || (entry.end == entry.start && entry.start >= from)) {
+            block(entry.view, &stop);
+            if (stop) {
+                break;
+            }
+        }
+    }
+}
+
+#pragma mark - private
+
+- (BOOL)p_shouldUpdateIncrementally {
+    if (_needsRebuild) {
+        return NO;
+    }
+    if (++_pendingUpdateCount > kKRScrollIndexMaxPendingUpdates) {
+        _needsRebuild = YES;
+        return NO;
+    }
+    return YES;
+}
+
+- (KRScrollIndexEntry)p_entryWithView:(UIView *)view {
+    CGRect frame = view.frame;
+    if (_horizontal) {
+        return {CGRectGetMinX(frame), CGRectGetMaxX(frame), view};
+    }
+    return {CGRectGetMinY(frame), CGRectGetMaxY(frame), view};
+}
+
+- (void)p_insertEntry:(const KRScrollIndexEntry &)entry {
+    // 同一父view内调整层级时只会再次回调didAddSubview
+    [self p_removeView:entry.view];
+    _startsByView[(__bridge const void *)entry.view] = entry.start;
+    auto it = std::upper_bound(_entries.begin(), _entries.end(), entry.start, [](CGFloat value, const KRScrollIndexEntry &other) {
+        return value < other.start;
+    });
+    size_t position = it - _entries.begin();
+    _entries.insert(it, entry);
+    _validMaxEndCount = std::min(_validMaxEndCount, position);
+}
+
+- (void)p_removeView:(UIView *)view {
+    auto found = _startsByView.find((__bridge const void *)view);
+    if (found == _startsByView.end()) {
+        return;
+    }
+    CGFloat start = found->second;
+    _startsByView.erase(found);
+    auto it = std::lower_bound(_entries.begin(), _entries.end(), start, [](const KRScrollIndexEntry &entry, CGFloat value) {
+        return entry.start < value;
+    });
+    while (it != _entries.end() && it->start == start && it->view != view) {
+        ++it;
+    }
+    if (it == _entries.end() || it->view != view) {
+        // 起点为NaN等无法比较的值时退化为线性查找，保证不残留已移除的view
+        it = std::find_if(_entries.begin(), _entries.end(), [view](const KRScrollIndexEntry &entry) {
+            return entry.view == view;
+        });
+        if (it == _entries.end()) {
+            return;
+        }
+    }
+    size_t position = it - _entries.begin();
+    _entries.erase(it);
+    _validMaxEndCount = std::min(_validMaxEndCount, position);
+}
+
+- (void)p_rebuildIfNeeded {
+    if (!_needsRebuild) {
+        return;
+    }
+    _needsRebuild = NO;
+    _pendingUpdateCount = 0;
+    _entries.clear();
+    _startsByView.clear();
+    NSArray<UIView *> *subviews = _viewsProvider ? _viewsProvider() : nil;
+    _entries.reserve(subviews.count);
+    for (UIView *subview in subviews) {
+        KRScrollIndexEntry entry = [self p_entryWithView:subview];
+        _entries.push_back(entry);
+        _startsByView[(__bridge const void *)subview] = entry.start;
+    }
+    std::stable_sort(_entries.begin(), _entries.end(), [](const KRScrollIndexEntry &a, const KRScrollIndexEntry &b) {
+        return a.start < b.start;
+    });
+    _validMaxEndCount = 0;
+}
+
+- (void)p_updateMaxEndsIfNeeded {
+    size_t count = _entries.size();
+    _maxEnds.resize(count);
+    for (size_t i = _validMaxEndCount; i < count; i++) {
+        _maxEnds[i] = i ? std::max(_maxEnds[i - 1], _entries[i].end) : _entries[i].end;
+    }
+    _validMaxEndCount = count;
+}
+
+@end
@@ -0,0 +1,63 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * @brief 列表内容子view的虚拟化窗口
+ * 开启后，frame远离可视区域（可视区域外扩overscan之外）的子view会被移出视图树，仅保留view对象与逻辑顺序，
+ * 滚动接近时再按逻辑顺序插回，使挂在视图树上的子view数量只与窗口大小相关。
+ * 移出的子树中由drawRect:绘制的view会释放layer.contents（KRLabel同时取消异步绘制），插回时重绘。
+ * Kotlin侧的节点树与插入下标不受影响：开启期间子view的插入/移除需经由虚拟化窗口换算（见KRScrollContentView）。
+ */
+@interface KRScrollContentVirtualizer : NSObject
+
+- (instancetype)initWithContentView:(UIView *)contentView NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// 可视区域两侧的外扩距离，大于0时开启虚拟化，否则关闭并按逻辑顺序插回全部子view
+@property (nonatomic, assign) CGFloat overscan;
+@property (nonatomic, assign, readonly, getter=isEnabled) BOOL enabled;
+/// 是否按横轴计算窗口
+@property (nonatomic, assign) BOOL horizontal;
+/// 逻辑子view个数（含已移出视图树的）
+@property (nonatomic, assign, readonly) NSUInteger logicalCount;
+/// 已移出视图树的子view个数
+@property (nonatomic, assign, readonly) NSUInteger detachedCount;
+/// 是否正在移出/插回子view（此时contentView的willRemoveSubview不是Kotlin侧的移除）
+@property (nonatomic, assign, readonly, getter=isMutatingSubviews) BOOL mutatingSubviews;
+
+/// Kotlin侧插入子view，index为逻辑下标
+- (void)insertSubview:(UIView *)subview atLogicalIndex:(NSInteger)index;
+/// Kotlin侧移除子view（已挂在视图树上或已移出的均可）
+- (void)subviewWillRemove:(UIView *)subview;
+/// 已移出视图树的子view frame变化
+- (void)detachedSubviewFrameDidChange:(UIView *)subview;
+/*
+ * 更新可视区域[visibleFrom, visibleTo]，移出/插回子view
+ * force为NO时，可视区域变化小于overscan的1/4则跳过
+ */
+- (void)updateWithVisibleFrom:(CGFloat)visibleFrom to:(CGFloat)visibleTo force:(BOOL)force;
+/// 枚举已移出视图树且与[from, to)相交的子view
+- (void)enumerateDetachedSubviewsFrom:(CGFloat)from to:(CGFloat)to usingBlock:(void (NS_NOESCAPE ^)(UIView *subview, BOOL *stop))block;
+
+/// 已移出视图树的子view所属的虚拟化窗口，未被移出时返回nil
++ (nullable KRScrollContentVirtualizer *)virtualizerOfDetachedSubview:(UIView *)subview;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,358 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRScrollContentVirtualizer.h"
+#import <objc/runtime.h>
+#import "KRScrollContentIndex.h"
+#import "UIView+CSS.h"
+#import "KRLabel.h"
+
+static const void *kKRDetachedVirtualizerKey = &kKRDetachedVirtualizerKey;
+
+/// 是否由drawRect:生成layer.contents（移出后可释放，插回时setNeedsDisplay重绘）
+static BOOL KRViewDrawsOwnContents(UIView *view) {
+    static NSMutableDictionary<NSString *, NSNumber *> *cache;
+    static IMP baseDrawRect;
+    if (!cache) {
+        cache = [NSMutableDictionary new];
+        baseDrawRect = [UIView instanceMethodForSelector:@selector(drawRect:)];
+    }
+    NSString *className = NSStringFromClass(view.class);
+    NSNumber *drawsOwnContents = cache[className];
+    if (!drawsOwnContents) {
+        // UIImageView的contents即图片本身，清空后无法通过重绘恢复
+        drawsOwnContents = @(![view isKindOfClass:[UIImageView class]]
+                             && [view.class instanceMethodForSelector:@selector(drawRect:)] != baseDrawRect);
+        cache[className] = drawsOwnContents;
+    }
+    return drawsOwnContents.boolValue;
+}
+
+@implementation KRScrollContentVirtualizer {
+    __weak UIView *_contentView;
+    /// 全部子view的逻辑顺序（与Kotlin侧一致），仅开启时维护
+    NSMutableArray<UIView *> *_logicalSubviews;
+    /// 子view -> 逻辑下标，仅[0, _validIndexCount)内的下标有效，中间插入/移除后从该位置起惰性重建
+    NSMapTable<UIView *, NSNumber *> *_logicalIndexes;
+    NSUInteger _validIndexCount;
+    /// 已移出视图树的子view，由虚拟化窗口持有
+    NSMutableSet<UIView *> *_detachedSubviews;
+    KRScrollContentIndex *_detachedIndex;
+    /// 是否已有可视区域，首次update前插入的子view均直接挂上
+    BOOL _hasWindow;
+    CGFloat _visibleFrom;
+    CGFloat _visibleTo;
+}
+
+- (instancetype)initWithContentView:(UIView *)contentView {
+    if (self = [super init]) {
+        _contentView = contentView;
+        _detachedSubviews = [NSMutableSet new];
+        _logicalIndexes = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                                valueOptions:NSPointerFunctionsStrongMemory];
+        __weak typeof(self) weakSelf = self;
+        _detachedIndex = [[KRScrollContentIndex alloc] initWithViewsProvider:^NSArray<UIView *> *{
+            __strong typeof(weakSelf) strongSelf = weakSelf;
+            return strongSelf ? strongSelf->_detachedSubviews.allObjects : nil;
+        }];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    for (UIView *subview in _detachedSubviews) {
+        objc_setAssociatedObject(subview, kKRDetachedVirtualizerKey, nil, OBJC_ASSOCIATION_ASSIGN);
+    }
+}
+
+#pragma mark - public
+
+- (void)setOverscan:(CGFloat)overscan {
+    overscan = MAX(0, overscan);
+    if (_overscan == overscan) {
+        return;
+    }
+    BOOL wasEnabled = self.isEnabled;
+    _overscan = overscan;
+    if (!wasEnabled && overscan > 0) {
+        _logicalSubviews = [_contentView.subviews mutableCopy] ?: [NSMutableArray new];
+        [_logicalIndexes removeAllObjects];
+        _validIndexCount = 0;
+        _hasWindow = NO;
+    } else if (wasEnabled && overscan <= 0) {
+        [self p_attachAllSubviews];
+        _logicalSubviews = nil;
+        [_logicalIndexes removeAllObjects];
+        _validIndexCount = 0;
+        _hasWindow = NO;
+    }
+}
+
+- (BOOL)isEnabled {
+    return _logicalSubviews != nil;
+}
+
+- (void)setHorizontal:(BOOL)horizontal {
+    if (_horizontal != horizontal) {
+        _horizontal = horizontal;
+        _detachedIndex.horizontal = horizontal;
+        _hasWindow = NO;
+    }
+}
+
+- (NSUInteger)logicalCount {
+    return self.isEnabled ? _logicalSubviews.count : _contentView.subviews.count;
+}
+
+- (NSUInteger)detachedCount {
+    return _detachedSubviews.count;
+}
+
+- (void)insertSubview:(UIView *)subview atLogicalIndex:(NSInteger)index {
+    UIView *contentView = _contentView;
+    if (!contentView) {
+        return;
+    }
+    if (!self.isEnabled) {
+        [contentView insertSubview:subview atIndex:index];
+        return;
+    }
+    // 重复插入（移动）时先去掉旧记录
+    [self p_forgetSubview:subview];
+    NSUInteger count = _logicalSubviews.count;
+    NSUInteger logicalIndex = (index < 0 || index > count) ? count : index;
+    [_logicalSubviews insertObject:subview atIndex:logicalIndex];
+    if (logicalIndex == count && _validIndexCount == count) {
+        // 追加到末尾（常见情况）无需重建
+        [_logicalIndexes setObject:@(logicalIndex) forKey:subview];
+        _validIndexCount++;
+    } else {
+        _validIndexCount = MIN(_validIndexCount, logicalIndex);
+    }
+    // 刚创建的子view frame通常尚未设置，留在窗口外的会在frame变化时再插回
+    if (!_hasWindow || ![self p_canDetachSubview:subview]
+        || [self p_subview:subview intersectsFrom:_visibleFrom - _overscan to:_visibleTo + _overscan]) {
+        [self p_attachSubview:subview];
+    } else {
+        [self p_detachSubview:subview];
+    }
+}
+
+- (void)subviewWillRemove:(UIView *)subview {
+    if (self.isEnabled) {
+        [self p_forgetSubview:subview];
+    }
+}
+
+- (void)detachedSubviewFrameDidChange:(UIView *)subview {
+    if (![_detachedSubviews containsObject:subview]) {
+        return;
+    }
+    [_detachedIndex subviewFrameDidChange:subview];
+    if (_hasWindow && [self p_subview:subview intersectsFrom:_visibleFrom - _overscan to:_visibleTo + _overscan]) {
+        [self p_attachSubview:subview];
+    }
+}
+
+- (void)updateWithVisibleFrom:(CGFloat)visibleFrom to:(CGFloat)visibleTo force:(BOOL)force {
+    UIView *contentView = _contentView;
+    if (!self.isEnabled || !contentView) {
+        return;
+    }
+    CGFloat threshold = _overscan / 4;
+    if (!force && _hasWindow
+        && fabs(visibleFrom - _visibleFrom) < threshold && fabs(visibleTo - _visibleTo) < threshold) {
+        return;
+    }
+    _hasWindow = YES;
+    _visibleFrom = visibleFrom;
+    _visibleTo = visibleTo;
+    // 移出：保留区比插回区再外扩overscan/2，避免在边界处反复移出插回
+    CGFloat keepFrom = visibleFrom - _overscan * 1.5;
+    CGFloat keepTo = visibleTo + _overscan * 1.5;
+    for (UIView *subview in [contentView.subviews copy]) {
+        if ([self p_canDetachSubview:subview]
+            && ![self p_subview:subview intersectsFrom:keepFrom to:keepTo]
+            && [self p_logicalIndexOfSubview:subview] != NSNotFound) {
+            [self p_detachSubview:subview];
+        }
+    }
+    // 插回：与窗口相交的已移出子view
+    NSMutableArray<UIView *> *attachSubviews = [NSMutableArray new];
+    [_detachedIndex enumerateSubviewsFrom:visibleFrom - _overscan
+                                       to:visibleTo + _overscan
+                               usingBlock:^(UIView *subview, BOOL *stop) {
+        [attachSubviews addObject:subview];
+    }];
+    for (UIView *subview in attachSubviews) {
+        [self p_attachSubview:subview];
+    }
+}
+
+- (void)enumerateDetachedSubviewsFrom:(CGFloat)from to:(CGFloat)to usingBlock:(void (NS_NOESCAPE ^)(UIView *, BOOL *))block {
+    if (_detachedSubviews.count) {
+        [_detachedIndex enumerateSubviewsFrom:from to:to usingBlock:block];
+    }
+}
+
++ (KRScrollContentVirtualizer *)virtualizerOfDetachedSubview:(UIView *)subview {
+    return objc_getAssociatedObject(subview, kKRDetachedVirtualizerKey);
+}
+
+#pragma mark - private
+
+- (BOOL)p_canDetachSubview:(UIView *)subview {
+    // 吸顶等需常驻的view以及正在执行动画的view不移出
+    return !subview.kr_virtualizationDisable && subview.layer.animationKeys.count == 0;
+}
+
+- (BOOL)p_subview:(UIView *)subview intersectsFrom:(CGFloat)from to:(CGFloat)to {
+    CGRect frame = subview.frame;
+    CGFloat start = _horizontal ? CGRectGetMinX(frame) : CGRectGetMinY(frame);
+    CGFloat end = _horizontal ? CGRectGetMaxX(frame) : CGRectGetMaxY(frame);
+    return end >= from && start <= to;
+}
+
+/// 子view的逻辑下标，不在逻辑列表中返回NSNotFound
+- (NSUInteger)p_logicalIndexOfSubview:(UIView *)subview {
+    NSNumber *index = [_logicalIndexes objectForKey:subview];
+    if (index && index.unsignedIntegerValue < _validIndexCount) {
+        return index.unsignedIntegerValue;
+    }
+    if (_validIndexCount < _logicalSubviews.count) {
+        for (NSUInteger i = _validIndexCount; i < _logicalSubviews.count; i++) {
+            [_logicalIndexes setObject:@(i) forKey:_logicalSubviews[i]];
+        }
+        _validIndexCount = _logicalSubviews.count;
+        index = [_logicalIndexes objectForKey:subview];
+    }
+    return index ? index.unsignedIntegerValue : NSNotFound;
+}
+
+/// 按逻辑顺序插到前一个已挂上的兄弟view之后（只遍历窗口内已挂上的子view）
+- (void)p_attachSubview:(UIView *)subview {
+    UIView *contentView = _contentView;
+    NSUInteger logicalIndex = [self p_logicalIndexOfSubview:subview];
+    if (!contentView || logicalIndex == NSNotFound) {
+        return;
+    }
+    NSArray<UIView *> *attachedSubviews = contentView.subviews;
+    NSUInteger physicalIndex = 0;
+    NSUInteger currentIndex = NSNotFound;
+    NSUInteger previousLogicalIndex = NSNotFound;
+    for (NSUInteger i = 0; i < attachedSubviews.count; i++) {
+        UIView *attached = attachedSubviews[i];
+        if (attached == subview) {
+            currentIndex = i;
+            continue;
+        }
+        NSUInteger index = [self p_logicalIndexOfSubview:attached];
+        if (index < logicalIndex && (previousLogicalIndex == NSNotFound || index > previousLogicalIndex)) {
+            previousLogicalIndex = index;
+            physicalIndex = i + 1;
+        }
+    }
+    if (currentIndex != NSNotFound && currentIndex < physicalIndex) {
+        physicalIndex--;
+    }
+    BOOL wasDetached = [_detachedSubviews containsObject:subview];
+    [self p_removeDetachedRecord:subview];
+    _mutatingSubviews = YES;
+    [contentView insertSubview:subview atIndex:physicalIndex];
+    _mutatingSubviews = NO;
+    if (wasDetached) {
+        [self p_restoreBackingStoresInView:subview];
+    }
+}
+
+- (void)p_detachSubview:(UIView *)subview {
+    if (![_detachedSubviews containsObject:subview]) {
+        [_detachedSubviews addObject:subview];
+        [_detachedIndex subviewDidAdd:subview];
+        objc_setAssociatedObject(subview, kKRDetachedVirtualizerKey, self, OBJC_ASSOCIATION_ASSIGN);
+    }
+    if (subview.superview) {
+        _mutatingSubviews = YES;
+        [subview removeFromSuperview];
+        _mutatingSubviews = NO;
+        [self p_releaseBackingStoresInView:subview];
+    }
+}
+
+/// 释放移出的子树中自绘view的位图，view对象与属性保留
+- (void)p_releaseBackingStoresInView:(UIView *)view {
+    if ([view isKindOfClass:[KRLabel class]]) {
+        [(KRLabel *)view cancelAsyncDisplay];
+    }
+    if (view.layer.contents && KRViewDrawsOwnContents(view)) {
+        view.layer.contents = nil;
+    }
+    for (UIView *subview in view.subviews) {
+        [self p_releaseBackingStoresInView:subview];
+    }
+}
+
+/// 插回后重绘已释放位图的自绘view
+- (void)p_restoreBackingStoresInView:(UIView *)view {
+    if (!view.layer.contents && KRViewDrawsOwnContents(view)) {
+        [view setNeedsDisplay];
+    }
+    for (UIView *subview in view.subviews) {
+        [self p_restoreBackingStoresInView:subview];
+    }
+}
+
+- (void)p_removeDetachedRecord:(UIView *)subview {
+    if ([_detachedSubviews containsObject:subview]) {
+        [_detachedIndex subviewWillRemove:subview];
+        objc_setAssociatedObject(subview, kKRDetachedVirtualizerKey, nil, OBJC_ASSOCIATION_ASSIGN);
+        [_detachedSubviews removeObject:subview];
+    }
+}
+
+- (void)p_forgetSubview:(UIView *)subview {
+    NSUInteger logicalIndex = [self p_logicalIndexOfSubview:subview];
+    if (logicalIndex != NSNotFound) {
+        [_logicalSubviews removeObjectAtIndex:logicalIndex];
+        [_logicalIndexes removeObjectForKey:subview];
+        _validIndexCount = MIN(_validIndexCount, logicalIndex);
+    }
+    BOOL wasDetached = [_detachedSubviews containsObject:subview];
+    [self p_removeDetachedRecord:subview];
+    if (wasDetached) {
+        // 移除或移动到别处后不再经由p_attachSubview插回，需在此恢复
+        [self p_restoreBackingStoresInView:subview];
+    }
+}
+
+/// 关闭时按逻辑顺序插回全部子view
+- (void)p_attachAllSubviews {
+    UIView *contentView = _contentView;
+    NSUInteger physicalIndex = 0;
+    for (UIView *subview in [_logicalSubviews copy]) {
+        if ([_detachedSubviews containsObject:subview]) {
+            [self p_removeDetachedRecord:subview];
+            _mutatingSubviews = YES;
+            [contentView insertSubview:subview atIndex:physicalIndex];
+            _mutatingSubviews = NO;
+            [self p_restoreBackingStoresInView:subview];
+            physicalIndex++;
+        } else if (subview.superview == contentView) {
+            physicalIndex = [contentView.subviews indexOfObjectIdenticalTo:subview] + 1;
+        }
+    }
+}
+
+@end
@@ -19,6 +19,8 @@
 #import "NestedScrollProtocol.h"
 
 #import "KRView.h"
+#import "KRScrollContentIndex.h"
+#import "KRScrollContentVirtualizer.h"
 NS_ASSUME_NONNULL_BEGIN
 
 /*
@@ -36,6 +38,11 @@ NS_ASSUME_NONNULL_BEGIN
 /// Nested scroll coordinator
 @property (nonatomic, strong) NestedScrollCoordinator *nestedScrollCoordinator;
 
+/// 松手后的惯性滚动是否已有预测的可见区域（滚动停止或重新拖拽时清除）
+@property (nonatomic, assign, readonly) BOOL hasPredictedVisibleRange;
+/// 预测的惯性滚动停留区域（本view坐标系），无预测时为CGRectNull
+@property (nonatomic, assign, readonly) CGRect predictedVisibleRect;
+
 /*
  * 添加滚动监听
  */
@@ -54,6 +61,10 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 @interface KRScrollContentView : KRView<KuiklyRenderViewExportProtocol>
+/// 子view沿滚动轴的索引
+@property (nonatomic, strong, readonly) KRScrollContentIndex *contentIndex;
+/// 子view虚拟化窗口（由KRScrollView的virtualizationOverscan属性开启）
+@property (nonatomic, strong, readonly) KRScrollContentVirtualizer *virtualizer;
 /*
  * 添加滚动监听
  */
@@ -62,6 +73,18 @@ NS_ASSUME_NONNULL_BEGIN
  * 删除滚动监听
  */
 - (void)removeScrollContentViewDelegate:(id<KRScrollContentViewDelegate>)scrollContentViewDelegate;
+/*
+ * 子view的frame在布局之外被修改时（如吸顶）需调用，以更新contentIndex
+ */
++ (void)subviewFrameDidChange:(UIView *)subview;
+/*
+ * Kotlin侧移除已被虚拟化窗口移出视图树的子view
+ */
++ (void)detachedSubviewWillRemove:(UIView *)subview;
+/*
+ * 按所在KRScrollView的可视区域更新虚拟化窗口，force为NO时滚动距离过小则跳过
+ */
+- (void)updateVirtualizationWindowWithForce:(BOOL)force;
 @end
 
 
@@ -22,6 +22,26 @@
 #import "KRScrollViewOffsetAnimator.h"
 #import "KRScrollView+NestedScroll.h"
 #import "NSObject+KR.h"
+#import "KRScrollEventStats.h"
+#import "KRImageView.h"
+
+/*
+ * 二进制scroll事件（scrollEventEncoding为"binary"时），小端：
+ * [0] KR_BINARY_EVENT_MAGIC  [1] 标记位  [2] 版本  [3] 触摸点个数n（最多kKRScrollEventMaxTouches）
+ * [4, 28) float32 × 6：offsetX, offsetY, contentWidth, contentHeight, viewWidth, viewHeight
+ * [28, 28 + 8n) float32 × 2n：每个触摸点的pageX, pageY
+ */
+static NSString *const kKRScrollEventEncodingBinary = @"binary";
+static const uint8_t kKRScrollEventVersion = 1;
+enum {
+    kKRScrollEventMaxTouches = 4,
+    kKRScrollEventHeaderLength = 28,
+};
+/// 标记位：bit0同步（KR_BINARY_EVENT_SYNC_FLAG），bit1拖拽中，bit2滚动停止时补发的最终事件
+static const uint8_t kKRScrollEventFlagDragging = 1 << 1;
+static const uint8_t kKRScrollEventFlagSettle = 1 << 2;
+/// 预测可见区域沿滚动方向的外扩：速度（pt/ms）× 该时长，最多为可视区域长度的2倍
+static const CGFloat kKRPredictLookaheadDuration = 150;
 
 /*
  * @brief 暴露给Kotlin侧调用的Scoller组件
@@ -42,8 +62,14 @@
 @property (nonatomic, strong) NSNumber *KUIKLY_PROP(dynamicSyncScrollDisable);
 /** attr is minContentOffset */
 @property (nonatomic, strong) NSNumber *KUIKLY_PROP(limitHeaderBounces);
+/** attr is virtualizationOverscan，大于0时开启子view虚拟化，值为可视区域外保留的距离 */
+@property (nonatomic, strong) NSNumber *KUIKLY_PROP(virtualizationOverscan);
 /** attr nestedScroll */
 @property (nonatomic, strong) NSString *KUIKLY_PROP(nestedScroll);
+/** attr is scrollEventEncoding，"binary"时scroll事件为紧凑二进制（格式见文件头部），默认为字典 */
+@property (nonatomic, strong) NSString *KUIKLY_PROP(scrollEventEncoding);
+/** attr is scrollEventThrottle，0（默认）每次offset变化都分发，>0滚动超过该距离才分发，<0拖拽/惯性滚动中只在停止时分发 */
+@property (nonatomic, strong) NSNumber *KUIKLY_PROP(scrollEventThrottle);
 /** event is scroll  */
 @property (nonatomic, strong) KuiklyRenderCallback KUIKLY_PROP(scroll);
 /** event is dragBegin  */
@@ -52,6 +78,8 @@
 @property (nonatomic, strong) KuiklyRenderCallback KUIKLY_PROP(dragEnd);
 /** event is willDragEnd  */
 @property (nonatomic, strong) KuiklyRenderCallback KUIKLY_PROP(willDragEnd);
+/** event is predictVisibleRange，松手时按目标offset与速度预测的可见区域 */
+@property (nonatomic, strong) KuiklyRenderCallback KUIKLY_PROP(predictVisibleRange);
 /** event is scrollEnd  */
 @property (nonatomic, strong) KuiklyRenderCallback KUIKLY_PROP(scrollEnd);
 
@@ -79,6 +107,10 @@
     KRScrollViewOffsetAnimator *_offsetAnimator;
     /**忽略分发ScrollEvent**/
     BOOL _ignoreDispatchScrollEvent;
+    /** 上次分发scroll事件时的offset */
+    CGPoint _lastDispatchedContentOffset;
+    /** 是否有被节流未分发的scroll事件 */
+    BOOL _hasPendingScrollEvent;
 }
 @synthesize hr_rootView;
 @synthesize lastContentOffset = _lastContentOffset;
@@ -88,6 +120,7 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
 
 - (instancetype)initWithFrame:(CGRect)frame {
     if (self = [super initWithFrame: frame]) {
+        _predictedVisibleRect = CGRectNull;
         if (@available(iOS 13.0, *)) {
             self.automaticallyAdjustsScrollIndicatorInsets = NO;
         } else {
@@ -121,6 +154,8 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
         [self css_contentInsetWithParams:params];
     } else if ([method isEqualToString:@"contentInsetWhenEndDrag"]) {
         [self css_contentInsetWhenEndDragWithParams:params];
+    } else if ([method isEqualToString:@"visibleRange"]) {
+        [self css_visibleRangeWithParams:params callback:callback];
     }
 }
 
@@ -164,6 +199,14 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
     [super insertSubview:view atIndex:index];
 }
 
+- (void)didAddSubview:(UIView *)subview {
+    [super didAddSubview:subview];
+    if ([subview isKindOfClass:[KRScrollContentView class]] && _css_virtualizationOverscan) {
+        ((KRScrollContentView *)subview).virtualizer.overscan = [_css_virtualizationOverscan doubleValue];
+        [(KRScrollContentView *)subview updateVirtualizationWindowWithForce:YES];
+    }
+}
+
 - (void)removeFromSuperview {
     [super removeFromSuperview];
     if (_wrapperView.superview) {
@@ -183,6 +226,7 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
         }
     }
     [super setContentOffset:contentOffset];
+    [[self p_contentView] updateVirtualizationWindowWithForce:NO];
     [self p_dispatchScrollEventIfNeed];
 }
 
@@ -204,6 +248,7 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
 
 - (void)scrollViewWillBeginDragging:(UIScrollView *)scrollView {
     _isCurrentlyDragging = YES;
+    [self p_clearPredictedVisibleRange];
     if (_css_dragBegin) {
        _css_dragBegin([self p_generateEventBaseParams]);
     }
@@ -212,6 +257,8 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
 - (void)scrollViewDidEndDragging:(UIScrollView *)scrollView willDecelerate:(BOOL)decelerate {
     _isCurrentlyDragging = NO;
     if (!decelerate) { // 滑动结束
+        [self p_clearPredictedVisibleRange];
+        [self p_flushScrollEventIfNeed];
         if (_css_scrollEnd) {
             _css_scrollEnd([self p_generateEventBaseParams]);
         }
@@ -229,6 +276,8 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
 }
 
 - (void)scrollViewDidEndDecelerating:(UIScrollView *)scrollView {
+    [self p_clearPredictedVisibleRange];
+    [self p_flushScrollEventIfNeed];
     if (_css_scrollEnd) {
         _css_scrollEnd([self p_generateEventBaseParams]);
     }
@@ -239,6 +288,7 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
 }
 
 - (void)scrollViewDidEndScrollingAnimation:(UIScrollView *)scrollView {
+    [self p_flushScrollEventIfNeed];
     if (_css_scrollEnd) {
         _css_scrollEnd([self p_generateEventBaseParams]);
     }
@@ -259,6 +309,8 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
         _css_willDragEnd(params); /// setContentOffset ()
         _targetContentOffset = nil;
     }
+    // 目标offset可能已被willDragEnd修改
+    [self p_predictVisibleRangeWithVelocity:velocity targetContentOffset:*targetContentOffset];
 }
 
 
@@ -313,6 +365,39 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
 }
 
 
+/*
+ * 查询可见子view（参数为预加载距离，可为空），回调子view的scrollIndex：
+ * {"firstIndex": 最小index, "lastIndex": 最大index, "indexes": [升序index]}，无可见子view时first/last为-1
+ */
+- (void)css_visibleRangeWithParams:(NSString *)params callback:(KuiklyRenderCallback)callback {
+    if (!callback) {
+        return;
+    }
+    KRScrollContentView *contentView = (KRScrollContentView *)self.subviews.firstObject;
+    NSMutableArray<NSNumber *> *indexes = [NSMutableArray new];
+    if ([contentView isKindOfClass:[KRScrollContentView class]]) {
+        CGFloat overscan = MAX(0, [params doubleValue]);
+        BOOL horizontal = contentView.contentIndex.horizontal;
+        CGFloat start = horizontal ? self.contentOffset.x : self.contentOffset.y;
+        CGFloat length = horizontal ? CGRectGetWidth(self.frame) : CGRectGetHeight(self.frame);
+        void (^collectIndex)(UIView *, BOOL *) = ^(UIView *subview, BOOL *stop) {
+            NSNumber *scrollIndex = subview.css_scrollIndex;
+            if (scrollIndex) {
+                [indexes addObject:scrollIndex];
+            }
+        };
+        [contentView.contentIndex enumerateSubviewsFrom:start - overscan to:start + length + overscan usingBlock:collectIndex];
+        // 预加载距离可能超出虚拟化窗口
+        [contentView.virtualizer enumerateDetachedSubviewsFrom:start - overscan to:start + length + overscan usingBlock:collectIndex];
+        [indexes sortUsingSelector:@selector(compare:)];
+    }
+    callback(@{
+        @"firstIndex": indexes.firstObject ?: @(-1),
+        @"lastIndex": indexes.lastObject ?: @(-1),
+        @"indexes": indexes,
+    });
+}
+
 #pragma mark - setter (css property)
 
 - (void)setCss_bouncesEnable:(NSNumber *)css_bouncesEnable {
@@ -385,6 +470,15 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
     }
 }
 
+- (void)setCss_virtualizationOverscan:(NSNumber *)css_virtualizationOverscan {
+    if (_css_virtualizationOverscan != css_virtualizationOverscan) {
+        _css_virtualizationOverscan = css_virtualizationOverscan;
+        KRScrollContentView *contentView = [self p_contentView];
+        contentView.virtualizer.overscan = [css_virtualizationOverscan doubleValue];
+        [contentView updateVirtualizationWindowWithForce:YES];
+    }
+}
+
 - (void)setCss_dynamicSyncScrollDisable:(NSNumber *)css_dynamicSyncScrollDisable {
     if (self.css_dynamicSyncScrollDisable != css_dynamicSyncScrollDisable) {
         _css_dynamicSyncScrollDisable = css_dynamicSyncScrollDisable;
@@ -396,6 +490,7 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
     [super setCss_frame:css_frame];
     self.skipNestScrollLock = NO;
     _wrapperView.frame = self.frame;
+    [[self p_contentView] updateVirtualizationWindowWithForce:YES];
 }
 
 
@@ -427,6 +522,16 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
 }
 
 #pragma mark - private
+
+- (KRScrollContentView *)p_contentView {
+    for (UIView *subview in self.subviews) {
+        if ([subview isKindOfClass:[KRScrollContentView class]]) {
+            return (KRScrollContentView *)subview;
+        }
+    }
+    return nil;
+}
+
 /// 是否有足够多的可见内容视图
 - (BOOL)p_hasEnoughVisibleContentViews {
     UIView *contentView = self.subviews.firstObject;
@@ -435,38 +540,42 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
         <=  MAX(CGRectGetHeight(self.frame), CGRectGetWidth(self.frame))) {
         return YES;
     }
+    if (CGRectGetWidth(contentView.frame) >= CGRectGetHeight(contentView.frame)) { // 横向布局
+        return contentView.subviews.count > 0;
+    }
+    // 纵向布局：可见区域顶部30%与下半部分都有内容视图（坐标转换到contentView内）
     CGPoint offset = self.contentOffset;
-    BOOL hasTopViewInVisibleFrame = NO;
-    BOOL hasBottomViewInVisibleFrame = NO;
-    CGRect visibleFrame = CGRectMake(0, 0, CGRectGetWidth(self.frame), CGRectGetHeight(self.frame));
-    for (UIView *subView in contentView.subviews) {
+    CGFloat width = CGRectGetWidth(self.frame);
+    CGFloat height = CGRectGetHeight(self.frame);
+    CGRect topAreaRect = CGRectMake(offset.x + 1, offset.y + 1, width - 2, height * 0.3);
+    CGRect bottomAreaRect = CGRectMake(offset.x + 1, offset.y + height * 0.5 - 1, width - 2, height * 0.5);
+    __block BOOL hasTopViewInVisibleFrame = NO;
+    __block BOOL hasBottomViewInVisibleFrame = NO;
+    void (^checkSubview)(UIView *, BOOL *) = ^(UIView *subView, BOOL *stop) {
         CGRect subViewFrame = subView.frame;
-        subViewFrame.origin.x -= offset.x;
-        subViewFrame.origin.y -= offset.y;
-        
-        if (CGRectGetWidth(contentView.frame) < CGRectGetHeight(contentView.frame)) { // 纵向布局
-            CGRect topAreaRect = CGRectMake(1, 1, CGRectGetWidth(visibleFrame) - 2, CGRectGetHeight(visibleFrame) * 0.3);
-            CGRect bottomAreaRect = CGRectMake(1,
-                                               CGRectGetHeight(visibleFrame) * 0.5 - 1,
-                                               CGRectGetWidth(visibleFrame) - 2,
-                                               CGRectGetHeight(visibleFrame) * 0.5);
-            
-            if (CGRectContainsRect(subViewFrame, topAreaRect) || CGRectContainsRect(topAreaRect, subViewFrame)
-                || CGRectIntersectsRect(subViewFrame, topAreaRect)){
-                hasTopViewInVisibleFrame = YES;
-            }
-            if (CGRectContainsRect(subViewFrame, bottomAreaRect) || CGRectContainsRect(bottomAreaRect, subViewFrame)
-                || CGRectIntersectsRect(subViewFrame, bottomAreaRect)){
-                hasBottomViewInVisibleFrame = YES;
-            }
-            if (hasTopViewInVisibleFrame && hasBottomViewInVisibleFrame) {
-                return YES;
+        if (CGRectContainsRect(subViewFrame, topAreaRect) || CGRectContainsRect(topAreaRect, subViewFrame)
+            || CGRectIntersectsRect(subViewFrame, topAreaRect)){
+            hasTopViewInVisibleFrame = YES;
+        }
+        if (CGRectContainsRect(subViewFrame, bottomAreaRect) || CGRectContainsRect(bottomAreaRect, subViewFrame)
+            || CGRectIntersectsRect(subViewFrame, bottomAreaRect)){
+            hasBottomViewInVisibleFrame = YES;
+        }
+        *stop = hasTopViewInVisibleFrame && hasBottomViewInVisibleFrame;
+    };
+    if ([contentView isKindOfClass:[KRScrollContentView class]]) {
+        [((KRScrollContentView *)contentView).contentIndex enumerateSubviewsFrom:CGRectGetMinY(topAreaRect)
+                                                                            to:CGRectGetMaxY(bottomAreaRect)
+                                                                    usingBlock:checkSubview];
+    } else {
+        BOOL stop = NO;
+        for (UIView *subView in contentView.subviews) {
+            checkSubview(subView, &stop);
+            if (stop) {
+                break;
             }
-        } else { // 横向布局
-            return YES;
         }
     }
-    
     return hasTopViewInVisibleFrame && hasBottomViewInVisibleFrame;
 }
 
@@ -502,11 +611,12 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
                 if (![self.css_dynamicSyncScrollDisable boolValue] && !self.setContentSizeing) {
                     syncCallback = ![self p_hasEnoughVisibleContentViews];
                 }
-                NSMutableDictionary *param = [[self p_generateEventBaseParams] mutableCopy];
-                param[KR_SYNC_CALLBACK_KEY] = @(syncCallback ? 1 : 0); // 同步加载
-                if (self.css_scroll) {
-                    self.css_scroll(param);
+                // 需要同步加载时不节流，避免白屏
+                if (!syncCallback && [self p_shouldThrottleScrollEvent]) {
+                    self->_hasPendingScrollEvent = YES;
+                    return;
                 }
+                [self p_fireScrollEventWithSync:syncCallback settle:NO];
             };
             if (CGRectEqualToRect(self.frame, CGRectZero)) {
                 // 首次setContentOffset->等自身frame在下一个runloop设置
@@ -519,6 +629,152 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
     }
 }
 
+/*
+ * 按松手目标offset与速度预测可见区域，回调predictVisibleRange：
+ * {"targetOffsetX", "targetOffsetY", "velocityX", "velocityY", "rangeStart", "rangeEnd",
+ *  "firstIndex", "lastIndex"}，range为contentView坐标沿滚动轴的区间，index为区间内已有子view的scrollIndex（无则为-1）
+ */
+- (void)p_predictVisibleRangeWithVelocity:(CGPoint)velocity targetContentOffset:(CGPoint)targetContentOffset {
+    KRScrollContentView *contentView = [self p_contentView];
+    // 与visibleRange一致按contentIndex的方向取滚动轴
+    BOOL horizontal = contentView ? contentView.contentIndex.horizontal : [_css_directionRow boolValue];
+    CGFloat speed = horizontal ? velocity.x : velocity.y;
+    if (speed == 0) {
+        return;
+    }
+    CGFloat viewportLength = horizontal ? CGRectGetWidth(self.bounds) : CGRectGetHeight(self.bounds);
+    CGFloat contentLength = horizontal ? self.contentSize.width : self.contentSize.height;
+    CGFloat target = horizontal ? targetContentOffset.x : targetContentOffset.y;
+    CGFloat lookahead = MIN(fabs(speed) * kKRPredictLookaheadDuration, viewportLength * 2);
+    CGFloat rangeStart = MAX(0, target - (speed < 0 ? lookahead : 0));
+    CGFloat rangeEnd = MIN(MAX(contentLength, viewportLength), target + viewportLength + (speed > 0 ? lookahead : 0));
+
+    _hasPredictedVisibleRange = YES;
+    CGSize crossSize = contentView ? contentView.bounds.size : self.contentSize;
+    CGRect rangeRect = horizontal ? CGRectMake(rangeStart, 0, rangeEnd - rangeStart, MAX(crossSize.height, CGRectGetHeight(self.bounds)))
+                                  : CGRectMake(0, rangeStart, MAX(crossSize.width, CGRectGetWidth(self.bounds)), rangeEnd - rangeStart);
+    _predictedVisibleRect = contentView ? [contentView convertRect:rangeRect toView:self] : rangeRect;
+    // 停留区域内的图片立即以高优先级开始加载，不等待布局
+    [contentView.contentIndex enumerateSubviewsFrom:rangeStart to:rangeEnd usingBlock:^(UIView *subview, BOOL *stop) {
+        [self p_promoteImageLoadInView:subview];
+    }];
+    if (!_css_predictVisibleRange) {
+        return;
+    }
+
+    __block NSInteger firstIndex = NSIntegerMax;
+    __block NSInteger lastIndex = -1;
+    void (^collectIndex)(UIView *, BOOL *) = ^(UIView *subview, BOOL *stop) {
+        NSNumber *scrollIndex = subview.css_scrollIndex;
+        if (scrollIndex) {
+            firstIndex = MIN(firstIndex, scrollIndex.integerValue);
+            lastIndex = MAX(lastIndex, scrollIndex.integerValue);
+        }
+    };
+    [contentView.contentIndex enumerateSubviewsFrom:rangeStart to:rangeEnd usingBlock:collectIndex];
+    [contentView.virtualizer enumerateDetachedSubviewsFrom:rangeStart to:rangeEnd usingBlock:collectIndex];
+    _css_predictVisibleRange(@{
+        @"targetOffsetX": @(targetContentOffset.x),
+        @"targetOffsetY": @(targetContentOffset.y),
+        @"velocityX": @(velocity.x),
+        @"velocityY": @(velocity.y),
+        @"rangeStart": @(rangeStart),
+        @"rangeEnd": @(rangeEnd),
+        @"firstIndex": @(lastIndex < 0 ? -1 : firstIndex),
+        @"lastIndex": @(lastIndex),
+    });
+}
+
+- (void)p_clearPredictedVisibleRange {
+    _hasPredictedVisibleRange = NO;
+    _predictedVisibleRect = CGRectNull;
+}
+
+- (void)p_promoteImageLoadInView:(UIView *)view {
+    if ([view isKindOfClass:[KRImageView class]]) {
+        [(KRImageView *)view promoteLoadPriority:KRImageLoadPriorityHigh];
+        return;
+    }
+    for (UIView *subview in view.subviews) {
+        [self p_promoteImageLoadInView:subview];
+    }
+}
+
+- (BOOL)p_shouldThrottleScrollEvent {
+    CGFloat throttle = [_css_scrollEventThrottle doubleValue];
+    if (throttle < 0) {
+        // 非用户滚动（如代码设置offset）没有停止回调，不节流
+        return self.isDragging || self.isDecelerating;
+    }
+    if (throttle > 0) {
+        return fabs(_lastContentOffset.x - _lastDispatchedContentOffset.x) < throttle
+            && fabs(_lastContentOffset.y - _lastDispatchedContentOffset.y) < throttle;
+    }
+    return NO;
+}
+
+// 滚动停止时补发被节流的最后一次offset
+- (void)p_flushScrollEventIfNeed {
+    if (_hasPendingScrollEvent && _css_scroll) {
+        [self p_fireScrollEventWithSync:NO settle:YES];
+    }
+    _hasPendingScrollEvent = NO;
+}
+
+- (void)p_fireScrollEventWithSync:(BOOL)sync settle:(BOOL)settle {
+    _hasPendingScrollEvent = NO;
+    _lastDispatchedContentOffset = _lastContentOffset;
+    id result = nil;
+    BOOL binary = [_css_scrollEventEncoding isEqualToString:kKRScrollEventEncodingBinary];
+    if (binary) {
+        result = [self p_binaryScrollEventWithSync:sync settle:settle];
+    } else {
+        NSMutableDictionary *param = [[self p_generateEventBaseParams] mutableCopy];
+        param[KR_SYNC_CALLBACK_KEY] = @(sync ? 1 : 0); // 同步加载
+        result = param;
+    }
+    if ([KRScrollEventStats isRecording]) {
+        [self p_recordScrollEventStatsWithResult:result binary:binary];
+    }
+    if (self.css_scroll) {
+        self.css_scroll(result);
+    }
+}
+
+- (NSData *)p_binaryScrollEventWithSync:(BOOL)sync settle:(BOOL)settle {
+    uint8_t buffer[kKRScrollEventHeaderLength + kKRScrollEventMaxTouches * 2 * sizeof(float)];
+    NSUInteger touchCount = MIN(self.panGestureRecognizer.numberOfTouches, kKRScrollEventMaxTouches);
+    buffer[0] = KR_BINARY_EVENT_MAGIC;
+    buffer[1] = (sync ? KR_BINARY_EVENT_SYNC_FLAG : 0)
+        | (_isCurrentlyDragging ? kKRScrollEventFlagDragging : 0)
+        | (settle ? kKRScrollEventFlagSettle : 0);
+    buffer[2] = kKRScrollEventVersion;
+    buffer[3] = (uint8_t)touchCount;
+    float values[6 + kKRScrollEventMaxTouches * 2] = {
+        (float)_lastContentOffset.x, (float)_lastContentOffset.y,
+        (float)self.contentSize.width, (float)self.contentSize.height,
+        (float)self.frame.size.width, (float)self.frame.size.height,
+    };
+    for (NSUInteger i = 0; i < touchCount; i++) {
+        CGPoint pagePoint = [self.panGestureRecognizer locationOfTouch:i inView:self.hr_rootView];
+        values[6 + i * 2] = (float)pagePoint.x;
+        values[6 + i * 2 + 1] = (float)pagePoint.y;
+    }
+    NSUInteger valuesLength = (6 + touchCount * 2) * sizeof(float);
+    memcpy(buffer + 4, values, valuesLength);
+    return [NSData dataWithBytes:buffer length:4 + valuesLength];
+}
+
+- (void)p_recordScrollEventStatsWithResult:(id)result binary:(BOOL)binary {
+    if (binary) {
+        [KRScrollEventStats recordEventWithBytes:[result length] binary:YES];
+        return;
+    }
+    // 与跨桥时一致序列化为JSON来计算字节数
+    NSData *json = [NSJSONSerialization dataWithJSONObject:result options:0 error:nil];
+    [KRScrollEventStats recordEventWithBytes:json.length binary:NO];
+}
+
 // 在该contentInset下的列表最大可滚动偏移
 - (CGPoint)p_maxContentOffsetInContentInset:(UIEdgeInsets)contentInset {
     CGFloat offsetTop = [_css_directionRow boolValue] ? self.contentOffset.x + contentInset.left : self.contentOffset.y + contentInset.top;
@@ -626,6 +882,8 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
 
 - (instancetype)initWithFrame:(CGRect)frame {
     if (self = [super initWithFrame:frame]) {
+        _contentIndex = [[KRScrollContentIndex alloc] initWithContentView:self];
+        _virtualizer = [[KRScrollContentVirtualizer alloc] initWithContentView:self];
         _delegateProxy = [KRMultiDelegateProxy alloc];
         [_delegateProxy addDelegate:self];
         self.delegate = (id<KRScrollContentViewDelegate>)_delegateProxy;
@@ -639,10 +897,26 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
     KUIKLY_SET_CSS_COMMON_PROP
 }
 
+- (void)hrv_insertSubview:(UIView *)subView atIndex:(NSInteger)index {
+    if (!_virtualizer.isEnabled) {
+        [super hrv_insertSubview:subView atIndex:index];
+        return;
+    }
+    // 开启虚拟化时index为逻辑下标，由虚拟化窗口换算为实际位置
+    [_virtualizer insertSubview:subView.kr_commonWrapperView ?: subView atLogicalIndex:index];
+}
+
+- (NSUInteger)hrv_subviewCount {
+    return _virtualizer.logicalCount;
+}
+
 - (void)setFrame:(CGRect)frame {
     [super setFrame:frame];
+    // 与p_hasEnoughVisibleContentViews一致：宽小于高为纵向布局
+    _contentIndex.horizontal = CGRectGetWidth(frame) >= CGRectGetHeight(frame);
+    _virtualizer.horizontal = _contentIndex.horizontal;
     [self syncScrollViewContentSize];
-    
+    [self updateVirtualizationWindowWithForce:YES];
 }
 
 - (void)didMoveToSuperview {
@@ -681,6 +955,32 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
     [_delegateProxy removeDelegate:scrollContentViewDelegate];
 }
 
++ (void)subviewFrameDidChange:(UIView *)subview {
+    KRScrollContentView *contentView = (KRScrollContentView *)subview.superview;
+    if ([contentView isKindOfClass:[KRScrollContentView class]]) {
+        [contentView.contentIndex subviewFrameDidChange:subview];
+    } else if (!contentView) {
+        [[KRScrollContentVirtualizer virtualizerOfDetachedSubview:subview] detachedSubviewFrameDidChange:subview];
+    }
+}
+
++ (void)detachedSubviewWillRemove:(UIView *)subview {
+    [[KRScrollContentVirtualizer virtualizerOfDetachedSubview:subview] subviewWillRemove:subview];
+}
+
+- (void)updateVirtualizationWindowWithForce:(BOOL)force {
+    KRScrollView *scrollView = (KRScrollView *)self.superview;
+    if (!_virtualizer.isEnabled || ![scrollView isKindOfClass:[KRScrollView class]] || CGRectIsEmpty(scrollView.bounds)) {
+        return;
+    }
+    CGRect visibleRect = scrollView.bounds;
+    if (_virtualizer.horizontal) {
+        [_virtualizer updateWithVisibleFrom:CGRectGetMinX(visibleRect) to:CGRectGetMaxX(visibleRect) force:force];
+    } else {
+        [_virtualizer updateWithVisibleFrom:CGRectGetMinY(visibleRect) to:CGRectGetMaxY(visibleRect) force:force];
+    }
+}
+
 #pragma mark - override
 
 - (BOOL)pointInside:(CGPoint)point withEvent:(UIEvent *)event {
@@ -700,6 +1000,19 @@ KUIKLY_NESTEDSCROLL_PROTOCOL_PROPERTY_IMP
     }
 }
 
+- (void)didAddSubview:(UIView *)subview {
+    [super didAddSubview:subview];
+    [_contentIndex subviewDidAdd:subview];
+}
+
+- (void)willRemoveSubview:(UIView *)subview {
+    [super willRemoveSubview:subview];
+    [_contentIndex subviewWillRemove:subview];
+    if (!_virtualizer.isMutatingSubviews) {
+        [_virtualizer subviewWillRemove:subview];
+    }
+}
+
 @end
 
 
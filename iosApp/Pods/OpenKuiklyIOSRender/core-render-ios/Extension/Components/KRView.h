@@ -32,6 +32,11 @@ NS_ASSUME_NONNULL_BEGIN
 // The touch move callback for the view
 @property (nonatomic, strong, nullable) KuiklyRenderCallback css_touchMove;
 
+/*
+ * 子view的zIndex发生变化时需调用，以更新父KRView的层级索引
+ */
++ (void)subviewZIndexDidChange:(UIView *)subview oldZIndex:(nullable NSNumber *)oldZIndex;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -26,6 +26,8 @@
 #define CSS_METHOD_ACCESSIBILITY_FOCUS @"accessibilityFocus"
 /// 无障碍朗读语音
 #define CSS_METHOD_ACCESSIBILITY_ANNOUNCE @"accessibilityAnnounce"
+/// 不在window上时屏幕刷新帧事件的分频倍数
+static const NSUInteger kKRViewOffscreenFrameIntervalMultiplier = 4;
 
 
 #pragma mark - KRVisualEffectView
@@ -54,6 +56,8 @@
 @property (nonatomic, strong) NSNumber *KUIKLY_PROP(screenFramePause);
 /**屏幕刷新帧事件(VSYNC信号)**/
 @property (nonatomic, strong) KuiklyRenderCallback KUIKLY_PROP(screenFrame);
+/**屏幕刷新帧事件分频系数，每N帧回调一次，默认为1**/
+@property (nonatomic, strong) NSNumber *KUIKLY_PROP(screenFrameInterval);
 
 /// For iOS's special effect, like `liquid glass`, etc.
 @property (nonatomic, weak) KRVisualEffectView *effectView;
@@ -111,6 +115,12 @@
 @implementation KRView {
     /// 正在调用HitTest方法
     BOOL _hitTesting;
+    /// 设置了zIndex的子view个数
+    NSUInteger _zIndexSubviewCount;
+    /// 按zIndex稳定排序的子view（HitTest时使用），为nil表示需要重建，首次HitTest前不维护
+    NSMutableArray<UIView *> *_zOrderedSubviews;
+    /// 正在调整已有子view的位置（此时不计入增删）
+    BOOL _reorderingSubview;
     /// 屏幕刷新定时器
     KRDisplayLink *_displaylink;
 }
@@ -155,15 +165,38 @@
         _displaylink = nil;
         if (_css_screenFrame) {
             _displaylink = [[KRDisplayLink alloc] init];
+            [self p_updateScreenFrameInterval];
             [_displaylink startWithCallback:^(CFTimeInterval timestamp) {
                 if (css_screenFrame) {
                     css_screenFrame(nil);
                 }
             }];
+            [_displaylink pause:[_css_screenFramePause boolValue]];
         }
     }
 }
 
+- (void)setCss_screenFrameInterval:(NSNumber *)css_screenFrameInterval {
+    if (_css_screenFrameInterval != css_screenFrameInterval) {
+        _css_screenFrameInterval = css_screenFrameInterval;
+        [self p_updateScreenFrameInterval];
+    }
+}
+
+- (void)didMoveToWindow {
+    [super didMoveToWindow];
+    [self p_updateScreenFrameInterval];
+}
+
+/// 不在window上（如页面被覆盖）时降低屏幕刷新帧事件的频率
+- (void)p_updateScreenFrameInterval {
+    if (!_displaylink) {
+        return;
+    }
+    NSUInteger frameInterval = MAX([_css_screenFrameInterval unsignedIntegerValue], 1);
+    _displaylink.frameInterval = self.window ? frameInterval : frameInterval * kKRViewOffscreenFrameIntervalMultiplier;
+}
+
 #pragma mark - override - base touch
 
 - (void)touchesBegan:(NSSet<UITouch *> *)touches withEvent:(UIEvent *)event {
@@ -227,27 +260,163 @@
 }
 
 - (NSArray<__kindof UIView *> *)subviews {
-    NSArray<__kindof UIView *> *views = [super subviews];
-    if (views.count && _hitTesting) { // 根据zIndex排序，解决zIndex手势响应问题
-        views = [[views copy] sortedArrayUsingComparator:^NSComparisonResult(UIView *  _Nonnull obj1, UIView *  _Nonnull obj2) {
-            if (obj1.css_zIndex.intValue < obj2.css_zIndex.intValue) {
+    if (_hitTesting) { // 根据zIndex排序，解决zIndex手势响应问题
+        return [self p_zOrderedSubviews];
+    }
+    return [super subviews];
+}
+
+#pragma mark - z-order index
+
++ (void)subviewZIndexDidChange:(UIView *)subview oldZIndex:(NSNumber *)oldZIndex {
+    KRView *superview = (KRView *)subview.superview;
+    if ([superview isKindOfClass:[KRView class]]) {
+        [superview p_subviewZIndexDidChange:subview oldZIndex:oldZIndex];
+    }
+}
+
+- (void)didAddSubview:(UIView *)subview {
+    [super didAddSubview:subview];
+    if (_reorderingSubview) {
+        return;
+    }
+    if (subview.css_zIndex) {
+        _zIndexSubviewCount++;
+    }
+    [self p_insertSubviewIntoZOrder:subview];
+}
+
+- (void)willRemoveSubview:(UIView *)subview {
+    [super willRemoveSubview:subview];
+    if (subview.css_zIndex && _zIndexSubviewCount > 0) {
+        _zIndexSubviewCount--;
+    }
+    [_zOrderedSubviews removeObjectIdenticalTo:subview];
+}
+
+- (void)addSubview:(UIView *)view {
+    [self p_moveSubview:view withBlock:^{
+        [super addSubview:view];
+    }];
+}
+
+- (void)insertSubview:(UIView *)view atIndex:(NSInteger)index {
+    [self p_moveSubview:view withBlock:^{
+        [super insertSubview:view atIndex:index];
+    }];
+}
+
+- (void)insertSubview:(UIView *)view aboveSubview:(UIView *)siblingSubview {
+    [self p_moveSubview:view withBlock:^{
+        [super insertSubview:view aboveSubview:siblingSubview];
+    }];
+}
+
+- (void)insertSubview:(UIView *)view belowSubview:(UIView *)siblingSubview {
+    [self p_moveSubview:view withBlock:^{
+        [super insertSubview:view belowSubview:siblingSubview];
+    }];
+}
+
+- (void)bringSubviewToFront:(UIView *)view {
+    [super bringSubviewToFront:view];
+    [self p_invalidateZOrder];
+}
+
+- (void)sendSubviewToBack:(UIView *)view {
+    [super sendSubviewToBack:view];
+    [self p_invalidateZOrder];
+}
+
+- (void)exchangeSubviewAtIndex:(NSInteger)index1 withSubviewAtIndex:(NSInteger)index2 {
+    [super exchangeSubviewAtIndex:index1 withSubviewAtIndex:index2];
+    [self p_invalidateZOrder];
+}
+
+- (void)p_subviewZIndexDidChange:(UIView *)subview oldZIndex:(NSNumber *)oldZIndex {
+    if (subview.css_zIndex && !oldZIndex) {
+        _zIndexSubviewCount++;
+    } else if (!subview.css_zIndex && oldZIndex && _zIndexSubviewCount > 0) {
+        _zIndexSubviewCount--;
+    }
+    if (_zOrderedSubviews) {
+        [_zOrderedSubviews removeObjectIdenticalTo:subview];
+        [self p_insertSubviewIntoZOrder:subview];
+    }
+}
+
+/// 添加子view，若已是自身子view则只是调整位置，此时重建层级索引
+- (void)p_moveSubview:(UIView *)view withBlock:(dispatch_block_t)block {
+    if (view.superview != self) {
+        block();
+        return;
+    }
+    _reorderingSubview = YES;
+    block();
+    _reorderingSubview = NO;
+    [self p_invalidateZOrder];
+}
+
+/// 将子view按zIndex插入有序索引，无法确定同zIndex子view间的先后时标记为待重建
+- (void)p_insertSubviewIntoZOrder:(UIView *)subview {
+    if (!_zOrderedSubviews) {
+        return;
+    }
+    int zIndex = subview.css_zIndex.intValue;
+    NSUInteger lower = [self p_zOrderBoundForZIndex:zIndex upper:NO];
+    NSUInteger upper = [self p_zOrderBoundForZIndex:zIndex upper:YES];
+    if (lower == upper) {
+        [_zOrderedSubviews insertObject:subview atIndex:lower];
+    } else {
+        // 追加到末尾/插入到最前时，可直接排在同zIndex子view之后/之前
+        NSArray<UIView *> *views = [super subviews];
+        if (views.lastObject == subview) {
+            [_zOrderedSubviews insertObject:subview atIndex:upper];
+        } else if (views.firstObject == subview) {
+            [_zOrderedSubviews insertObject:subview atIndex:lower];
+        } else {
+            [self p_invalidateZOrder];
+        }
+    }
+}
+
+/// 二分查找zIndex在有序索引中的下界/上界
+- (NSUInteger)p_zOrderBoundForZIndex:(int)zIndex upper:(BOOL)upper {
+    NSUInteger low = 0;
+    NSUInteger high = _zOrderedSubviews.count;
+    while (low < high) {
+        NSUInteger mid = low + (high - low) / 2;
+        int midZIndex = _zOrderedSubviews[mid].css_zIndex.intValue;
+        if (midZIndex < zIndex || (upper && midZIndex == zIndex)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+- (void)p_invalidateZOrder {
+    _zOrderedSubviews = nil;
+}
+
+- (NSArray<UIView *> *)p_zOrderedSubviews {
+    if (!_zOrderedSubviews) {
+        // 稳定排序，同zIndex保持子view原有顺序
+        NSArray<UIView *> *views = [super subviews];
+        _zOrderedSubviews = [[views sortedArrayWithOptions:NSSortStable usingComparator:^NSComparisonResult(UIView * _Nonnull obj1, UIView * _Nonnull obj2) {
+            int zIndex1 = obj1.css_zIndex.intValue;
+            int zIndex2 = obj2.css_zIndex.intValue;
+            if (zIndex1 < zIndex2) {
                 return NSOrderedAscending;
-            } else if (obj1.css_zIndex.intValue > obj2.css_zIndex.intValue) {
+            } else if (zIndex1 > zIndex2) {
                 return NSOrderedDescending;
-            } else {
-                NSUInteger index1 = [views indexOfObject:obj1];
-                NSUInteger index2 = [views indexOfObject:obj2];
-                if (index1 < index2) {
-                    return NSOrderedAscending;
-                } else if (index1 > index2) {
-                    return NSOrderedDescending;
-                } else {
-                    return NSOrderedSame;
-                }
             }
-        }];
+            return NSOrderedSame;
+        }] mutableCopy];
     }
-    return views;
+    // 直接返回索引本身，HitTest期间不会修改子view，避免每次HitTest拷贝
+    return _zOrderedSubviews;
 }
 
 
@@ -473,12 +642,7 @@
 
 
 - (BOOL)p_hasZIndexInSubviews {
-    for (UIView *subView in self.subviews) {
-        if (subView.css_zIndex) {
-            return YES;
-        }
-    }
-    return NO;
+    return _zIndexSubviewCount > 0;
 }
 
 #pragma mark - dealloc
@@ -73,6 +73,10 @@ NSString *const KRPageDataSnapshotKey = @"kr_snapshotKey";
         [self addDelegatorLifeCycleListener:(id<KRControllerDelegatorLifeCycleProtocol>)_performanceManager];
         _eventLazyTasks = [[NSMutableArray alloc] init];
         [self p_addNotifications];
+        if (pageData[KRPageDataSnapshotKey]) {
+            // 在view加载前预读快照文件，viewDidLoad中仍同步展示
+            [KRSnapshotModule prefaultSnapshotWithSnapshotKey:pageData[KRPageDataSnapshotKey]];
+        }
     }
     return self;
 }
@@ -0,0 +1,55 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(uint8_t, KRBinaryLogLevel) {
+    KRBinaryLogLevelDebug = 0,
+    KRBinaryLogLevelInfo = 1,
+    KRBinaryLogLevelError = 2,
+};
+
+/*
+ * 写入一条二进制日志（未开启时开销仅为一次原子读）
+ * 调用线程只做拷贝，不做格式化和IO；缓冲区满时丢弃
+ */
+FOUNDATION_EXTERN BOOL KRBinaryLogIsEnabled(void);
+FOUNDATION_EXTERN void KRBinaryLogWrite(KRBinaryLogLevel level, NSString *message);
+
+/*
+ * 二进制日志：各线程无锁缓冲 + 单写线程写入mmap环形文件，进程崩溃后文件中的日志仍可读取；
+ * 崩溃前约100ms内、尚在线程缓冲区中的日志会丢失，必须落盘的日志需先调用flush
+ * 文件格式见KRBinaryLogCore.hpp，可用decodeFileAtPath:或KRBinaryLogCore.cpp中的解码工具解析
+ */
+@interface KRBinaryLog : NSObject
+
+/// 开启并写入filePath（已存在的文件会先移动到previousFilePathForFilePath:，用于分析上次崩溃）
++ (BOOL)openWithFilePath:(NSString *)filePath ringSize:(NSUInteger)ringSize;
+/// 写出剩余日志并关闭
++ (void)close;
++ (BOOL)isOpen;
+/// 同步把缓冲中的日志写入文件
++ (void)flush;
+/// 因缓冲区满被丢弃的日志条数
++ (uint64_t)droppedCount;
++ (NSString *)previousFilePathForFilePath:(NSString *)filePath;
+/// 解码日志文件为文本行，文件无效时返回nil
++ (nullable NSArray<NSString *> *)decodeFileAtPath:(NSString *)filePath;
+
+@end
+
+NS_ASSUME_NONNULL_END
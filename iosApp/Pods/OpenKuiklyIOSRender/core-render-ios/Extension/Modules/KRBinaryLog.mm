@@ -0,0 +1,107 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRBinaryLog.h"
+#import "KRBinaryLogCore.hpp"
+
+using kuikly::log::BinaryLogger;
+using kuikly::log::Level;
+
+BOOL KRBinaryLogIsEnabled(void) {
+    return BinaryLogger::Shared().IsOpen();
+}
+
+void KRBinaryLogWrite(KRBinaryLogLevel level, NSString *message) {
+    BinaryLogger &logger = BinaryLogger::Shared();
+    if (!logger.IsOpen() || !message) {
+        return;
+    }
+    Level logLevel = static_cast<Level>(level);
+    const char *cString = CFStringGetCStringPtr((__bridge CFStringRef)message, kCFStringEncodingUTF8);
+    if (cString) {
+        logger.LogString(logLevel, cString, strlen(cString));
+        return;
+    }
+    // 短日志在栈上转码，避免UTF8String产生autorelease对象
+    char buffer[512];
+    NSUInteger usedLength = 0;
+    NSRange remainingRange = NSMakeRange(0, 0);
+    BOOL converted = [message getBytes:buffer
+                             maxLength:sizeof(buffer)
+                            usedLength:&usedLength
+                              encoding:NSUTF8StringEncoding
+                               options:0
+                                 range:NSMakeRange(0, message.length)
+                        remainingRange:&remainingRange];
+    if (converted && remainingRange.length == 0) {
+        logger.LogString(logLevel, buffer, usedLength);
+        return;
+    }
+    @autoreleasepool {
+        const char *utf8 = message.UTF8String;
+        if (utf8) {
+            logger.LogString(logLevel, utf8, strlen(utf8));
+        }
+    }
+}
+
+@implementation KRBinaryLog
+
++ (BOOL)openWithFilePath:(NSString *)filePath ringSize:(NSUInteger)ringSize {
+    if (BinaryLogger::Shared().IsOpen()) {
+        return YES;
+    }
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    if ([fileManager fileExistsAtPath:filePath]) {
+        NSString *previousPath = [self previousFilePathForFilePath:filePath];
+        [fileManager removeItemAtPath:previousPath error:nil];
+        [fileManager moveItemAtPath:filePath toPath:previousPath error:nil];
+    }
+    return BinaryLogger::Shared().Open(filePath.fileSystemRepresentation, ringSize);
+}
+
++ (void)close {
+    BinaryLogger::Shared().Close();
+}
+
++ (BOOL)isOpen {
+    return BinaryLogger::Shared().IsOpen();
+}
+
++ (void)flush {
+    BinaryLogger::Shared().Flush();
+}
+
++ (uint64_t)droppedCount {
+    return BinaryLogger::Shared().DroppedCount();
+}
+
++ (NSString *)previousFilePathForFilePath:(NSString *)filePath {
+    return [filePath stringByAppendingPathExtension:@"prev"];
+}
+
++ (NSArray<NSString *> *)decodeFileAtPath:(NSString *)filePath {
+    NSMutableArray<NSString *> *lines = [NSMutableArray new];
+    bool success = kuikly::log::DecodeLogFile(filePath.fileSystemRepresentation, [lines](const kuikly::log::DecodedRecord &record) {
+        std::string line = kuikly::log::FormatDecodedRecord(record);
+        NSString *string = [[NSString alloc] initWithBytes:line.data() length:line.size() encoding:NSUTF8StringEncoding];
+        if (string) {
+            [lines addObject:string];
+        }
+    });
+    return success ? lines : nil;
+}
+
+@end
@@ -0,0 +1,666 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "KRBinaryLogCore.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <ctime>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace kuikly {
+namespace log {
+
+/*
+ * 文件布局：[FileHeader | format表 | 环形区]
+ * 环形区内head/tail为逻辑偏移（只增不减），[tail, head)之间均为完整记录；
+ * 记录不跨越环形区末尾，剩余空间不足时写入填充记录后从头开始。
+ * 写入顺序：先推进tail（腾出空间）-> 写记录 -> 再推进head，崩溃时文件中最多丢失正在写的一条；
+ * 仍在线程缓冲区中的日志不在此列，见KRBinaryLogCore.hpp。
+ */
+static const char kFileMagic[8] = {'K', 'R', 'B', 'L', 'O', 'G', '0', '1'};
+static const uint32_t kFileVersion = 1;
+static const size_t kFormatTableSize = 64 * 1024;
+static const uint8_t kRecordTypePadding = 0;
+static const uint8_t kRecordTypeLog = 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t format_table_offset;
+    uint64_t format_table_size;
+    uint64_t ring_offset;
+    uint64_t ring_size;
+    uint64_t tail;
+    uint64_t head;
+    uint32_t format_count;
+    uint32_t format_table_used;
+    uint64_t dropped;
+};
+
+static const size_t kFileHeaderSize = 4096;
+static_assert(sizeof(FileHeader) <= kFileHeaderSize, "FileHeader too large");
+
+static inline size_t AlignUp8(size_t value) {
+    return (value + 7) & ~static_cast<size_t>(7);
+}
+
+static uint64_t NowUnixNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+// ThreadLogBuffer
+
+/*
+ * 单生产者（所属线程）单消费者（写线程）的字节环形缓冲区
+ */
+class ThreadLogBuffer {
+public:
+    explicit ThreadLogBuffer(uint32_t tid) : tid_(tid), data_(new uint8_t[kThreadBufferSize]) {}
+    ~ThreadLogBuffer() { delete[] data_; }
+
+    uint32_t tid() const { return tid_; }
+
+    /// 生产者：预留size字节，空间不足返回false
+    bool Reserve(size_t size, uint64_t &position) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        uint64_t tail = tail_.load(std::memory_order_acquire);
+        if (head + size - tail > kThreadBufferSize) {
+            return false;
+        }
+        position = head;
+        return true;
+    }
+
+    void Write(uint64_t position, const void *data, size_t length) {
+        size_t offset = position & (kThreadBufferSize - 1);
+        size_t first = std::min(length, kThreadBufferSize - offset);
+        memcpy(data_ + offset, data, first);
+        if (first < length) {
+            memcpy(data_, static_cast<const uint8_t *>(data) + first, length - first);
+        }
+    }
+
+    /// 生产者：提交到end，返回提交后是否已超过半满（需要唤醒写线程）
+    bool Commit(uint64_t end) {
+        head_.store(end, std::memory_order_release);
+        return end - tail_.load(std::memory_order_relaxed) > kThreadBufferSize / 2;
+    }
+
+    /// 消费者：依次取出完整记录
+    template <typename Fn>
+    void Drain(std::vector<uint8_t> &scratch, Fn &&fn) {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        while (tail < head) {
+            RecordHeader header;
+            Read(tail, &header, sizeof(header));
+            scratch.resize(header.length);
+            Read(tail, scratch.data(), header.length);
+            fn(scratch.data(), header.length);
+            tail += header.length;
+        }
+        tail_.store(tail, std::memory_order_release);
+    }
+
+    bool IsEmpty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed);
+    }
+
+    std::atomic<bool> retired{false};
+
+private:
+    void Read(uint64_t position, void *out, size_t length) const {
+        size_t offset = position & (kThreadBufferSize - 1);
+        size_t first = std::min(length, kThreadBufferSize - offset);
+        memcpy(out, data_ + offset, first);
+        if (first < length) {
+            memcpy(static_cast<uint8_t *>(out) + first, data_, length - first);
+        }
+    }
+
+    const uint32_t tid_;
+    uint8_t *data_;
+    std::atomic<uint64_t> head_{0};
+    std::atomic<uint64_t> tail_{0};
+};
+
+/// 线程退出时标记缓冲区待回收，由写线程写完后释放
+struct ThreadLogBufferHolder {
+    ThreadLogBuffer *buffer = nullptr;
+    ~ThreadLogBufferHolder() {
+        if (buffer) {
+            buffer->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+// BinaryLogger
+
+BinaryLogger &BinaryLogger::Shared() {
+    // 不析构，避免进程退出时其他线程仍在记录
+    static BinaryLogger *logger = new BinaryLogger();
+    return *logger;
+}
+
+void BinaryLogger::ArgEncoder::Put(const void *data, size_t length) {
+    length = std::min(length, remaining);
+    buffer->Write(position, data, length);
+    position += length;
+    remaining -= length;
+}
+
+void BinaryLogger::EncodeString(ArgEncoder &encoder, const char *data, size_t length) {
+    uint8_t type = kArgString;
+    uint32_t stored = static_cast<uint32_t>(std::min(length, kMaxRecordSize));
+    encoder.Put(&type, 1);
+    // 超过单条上限时按实际剩余空间截断
+    stored = static_cast<uint32_t>(std::min<size_t>(stored, encoder.remaining > 4 ? encoder.remaining - 4 : 0));
+    encoder.Put(&stored, 4);
+    if (data && stored) {
+        encoder.Put(data, stored);
+    }
+}
+
+bool BinaryLogger::BeginRecord(Level level, uint16_t formatId, size_t payload, ArgEncoder &encoder) {
+    payload = std::min(payload, kMaxRecordSize - sizeof(RecordHeader));
+    size_t length = AlignUp8(sizeof(RecordHeader) + payload);
+    ThreadLogBuffer *buffer = CurrentThreadBuffer();
+    uint64_t position = 0;
+    if (!buffer->Reserve(length, position)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        Wake();
+        return false;
+    }
+    RecordHeader header;
+    header.length = static_cast<uint32_t>(length);
+    header.type = kRecordTypeLog;
+    header.level = static_cast<uint8_t>(level);
+    header.format_id = formatId;
+    header.tid = buffer->tid();
+    header.payload_length = static_cast<uint32_t>(payload);
+    header.timestamp_ns = NowUnixNanoseconds();
+    buffer->Write(position, &header, sizeof(header));
+    encoder.buffer = buffer;
+    encoder.position = position + sizeof(header);
+    encoder.end = position + length;
+    encoder.remaining = payload;
+    return true;
+}
+
+void BinaryLogger::CommitRecord(ArgEncoder &encoder) {
+    if (encoder.buffer->Commit(encoder.end)) {
+        Wake();
+    }
+}
+
+ThreadLogBuffer *BinaryLogger::CurrentThreadBuffer() {
+    static thread_local ThreadLogBufferHolder holder;
+    if (!holder.buffer) {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        holder.buffer = new ThreadLogBuffer(next_tid_++);
+        buffers_.push_back(holder.buffer);
+    }
+    return holder.buffer;
+}
+
+uint16_t BinaryLogger::RegisterFormat(const char *format) {
+    if (!format) {
+        return kInvalidFormatId;
+    }
+    std::lock_guard<std::mutex> lock(formats_mutex_);
+    if (formats_.empty()) {
+        formats_.push_back("%s");
+    }
+    for (size_t i = 0; i < formats_.size(); i++) {
+        if (formats_[i] == format) {
+            return static_cast<uint16_t>(i);
+        }
+    }
+    if (formats_.size() >= kInvalidFormatId) {
+        return kInvalidFormatId;
+    }
+    formats_.push_back(format);
+    if (IsOpen()) {
+        WriteFormatTable();
+    }
+    return static_cast<uint16_t>(formats_.size() - 1);
+}
+
+/// 需持有formats_mutex_；format表只追加，已写入的条目不会改变
+void BinaryLogger::WriteFormatTable() {
+    if (!map_) {
+        return;
+    }
+    if (formats_.empty()) {
+        formats_.push_back("%s");
+    }
+    FileHeader *header = reinterpret_cast<FileHeader *>(map_);
+    uint8_t *table = map_ + header->format_table_offset;
+    uint32_t used = header->format_table_used;
+    for (size_t i = header->format_count; i < formats_.size(); i++) {
+        const std::string &format = formats_[i];
+        uint16_t length = static_cast<uint16_t>(std::min<size_t>(format.size(), 0xFFFF));
+        size_t entry = AlignUp8(4 + length);
+        if (used + entry > header->format_table_size) {
+            break;
+        }
+        uint16_t id = static_cast<uint16_t>(i);
+        memcpy(table + used, &id, 2);
+        memcpy(table + used + 2, &length, 2);
+        memcpy(table + used + 4, format.data(), length);
+        used += static_cast<uint32_t>(entry);
+        std::atomic_thread_fence(std::memory_order_release);
+        header->format_table_used = used;
+        header->format_count = static_cast<uint32_t>(i + 1);
+    }
+}
+
+bool BinaryLogger::Open(const std::string &path, size_t ringSize) {
+    std::lock_guard<std::mutex> drainLock(drain_mutex_);
+    if (IsOpen()) {
+        return true;
+    }
+    ringSize = AlignUp8(std::max<size_t>(ringSize, kMaxRecordSize * 4));
+    size_t mapSize = kFileHeaderSize + kFormatTableSize + ringSize;
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(mapSize)) != 0) {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    fd_ = fd;
+    map_ = static_cast<uint8_t *>(map);
+    map_size_ = mapSize;
+    FileHeader *header = reinterpret_cast<FileHeader *>(map_);
+    memset(header, 0, sizeof(FileHeader));
+    header->version = kFileVersion;
+    header->header_size = static_cast<uint32_t>(kFileHeaderSize);
+    header->format_table_offset = kFileHeaderSize;
+    header->format_table_size = kFormatTableSize;
+    header->ring_offset = kFileHeaderSize + kFormatTableSize;
+    header->ring_size = ringSize;
+    {
+        std::lock_guard<std::mutex> formatLock(formats_mutex_);
+        WriteFormatTable();
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(header->magic, kFileMagic, sizeof(kFileMagic));
+
+    running_ = true;
+    writer_ = std::thread(&BinaryLogger::WriterLoop, this);
+    open_.store(true, std::memory_order_release);
+    return true;
+}
+
+void BinaryLogger::Close() {
+    if (!IsOpen()) {
+        return;
+    }
+    open_.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        running_ = false;
+    }
+    wake_cv_.notify_one();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    std::lock_guard<std::mutex> drainLock(drain_mutex_);
+    std::lock_guard<std::mutex> formatLock(formats_mutex_);
+    DrainAll();
+    msync(map_, map_size_, MS_SYNC);
+    munmap(map_, map_size_);
+    close(fd_);
+    map_ = nullptr;
+    map_size_ = 0;
+    fd_ = -1;
+}
+
+void BinaryLogger::Flush() {
+    std::lock_guard<std::mutex> drainLock(drain_mutex_);
+    if (map_) {
+        DrainAll();
+    }
+}
+
+void BinaryLogger::Wake() {
+    if (!wake_pending_.exchange(true, std::memory_order_acq_rel)) {
+        wake_cv_.notify_one();
+    }
+}
+
+void BinaryLogger::WriterLoop() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (running_) {
+        wake_cv_.wait_for(lock, std::chrono::milliseconds(100), [this] {
+            return !running_ || wake_pending_.load(std::memory_order_acquire);
+        });
+        wake_pending_.store(false, std::memory_order_release);
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> drainLock(drain_mutex_);
+            DrainAll();
+        }
+        lock.lock();
+    }
+}
+
+/// 需持有drain_mutex_
+void BinaryLogger::DrainAll() {
+    std::vector<ThreadLogBuffer *> buffers;
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        buffers = buffers_;
+    }
+    std::vector<ThreadLogBuffer *> retired;
+    for (ThreadLogBuffer *buffer : buffers) {
+        // 先读retired再drain，保证回收前线程最后写入的记录已被写出
+        bool isRetired = buffer->retired.load(std::memory_order_acquire);
+        buffer->Drain(scratch_, [this](const uint8_t *record, uint32_t length) {
+            AppendToFile(record, length);
+        });
+        if (isRetired && buffer->IsEmpty()) {
+            retired.push_back(buffer);
+        }
+    }
+    if (map_) {
+        reinterpret_cast<FileHeader *>(map_)->dropped = dropped_.load(std::memory_order_relaxed);
+    }
+    if (!retired.empty()) {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        for (ThreadLogBuffer *buffer : retired) {
+            buffers_.erase(std::remove(buffers_.begin(), buffers_.end(), buffer), buffers_.end());
+            delete buffer;
+        }
+    }
+}
+
+/// 需持有drain_mutex_
+void BinaryLogger::AppendToFile(const uint8_t *record, uint32_t length) {
+    if (!map_) {
+        return;
+    }
+    FileHeader *header = reinterpret_cast<FileHeader *>(map_);
+    uint8_t *ring = map_ + header->ring_offset;
+    uint64_t ringSize = header->ring_size;
+    uint64_t head = header->head;
+    uint64_t tail = header->tail;
+
+    auto ensureSpace = [&](uint64_t size) {
+        while (head + size - tail > ringSize) {
+            RecordHeader oldest;
+            memcpy(&oldest, ring + (tail % ringSize), sizeof(uint32_t));
+            tail += oldest.length;
+        }
+        header->tail = tail;
+        std::atomic_thread_fence(std::memory_order_release);
+    };
+
+    uint64_t offset = head % ringSize;
+    if (ringSize - offset < length) {
+        uint32_t padding = static_cast<uint32_t>(ringSize - offset);
+        ensureSpace(padding);
+        RecordHeader pad;
+        memset(&pad, 0, sizeof(pad));
+        pad.length = padding;
+        pad.type = kRecordTypePadding;
+        memcpy(ring + offset, &pad, std::min<size_t>(padding, sizeof(pad)));
+        head += padding;
+        std::atomic_thread_fence(std::memory_order_release);
+        header->head = head;
+        offset = 0;
+    }
+    ensureSpace(length);
+    memcpy(ring + offset, record, length);
+    std::atomic_thread_fence(std::memory_order_release);
+    header->head = head + length;
+}
+
+// 解码
+
+namespace {
+
+struct DecodedArg {
+    uint8_t type;
+    int64_t int_value;
+    uint64_t uint_value;
+    double double_value;
+    std::string string_value;
+};
+
+bool DecodeArgs(const uint8_t *data, size_t length, std::vector<DecodedArg> &args) {
+    size_t position = 0;
+    while (position < length) {
+        DecodedArg arg;
+        arg.type = data[position++];
+        switch (arg.type) {
+            case kArgInt:
+            case kArgUInt:
+            case kArgDouble:
+                if (position + 8 > length) {
+                    return false;
+                }
+                memcpy(&arg.int_value, data + position, 8);
+                memcpy(&arg.uint_value, data + position, 8);
+                memcpy(&arg.double_value, data + position, 8);
+                position += 8;
+                break;
+            case kArgString: {
+                uint32_t stored = 0;
+                if (position + 4 > length) {
+                    return false;
+                }
+                memcpy(&stored, data + position, 4);
+                position += 4;
+                stored = static_cast<uint32_t>(std::min<size_t>(stored, length - position));
+                arg.string_value.assign(reinterpret_cast<const char *>(data + position), stored);
+                position += stored;
+                break;
+            }
+            default:
+                // 对齐填充或未知类型，结束解析
+                return true;
+        }
+        args.push_back(std::move(arg));
+    }
+    return true;
+}
+
+/// 按printf语义格式化，参数类型以记录中的类型为准
+std::string FormatMessage(const std::string &format, const std::vector<DecodedArg> &args) {
+    std::string out;
+    size_t argIndex = 0;
+    char buf[128];
+    for (size_t i = 0; i < format.size(); i++) {
+        char c = format[i];
+        if (c != '%') {
+            out.push_back(c);
+            continue;
+        }
+        if (i + 1 < format.size() && format[i + 1] == '%') {
+            out.push_back('%');
+            i++;
+            continue;
+        }
+        // 解析 flags/width/precision/length/conversion
+        size_t start = i++;
+        std::string spec("%");
+        while (i < format.size() && strchr("-+ #0", format[i])) {
+            spec.push_back(format[i++]);
+        }
+        while (i < format.size() && (isdigit(static_cast<unsigned char>(format[i])) || format[i] == '.')) {
+            spec.push_back(format[i++]);
+        }
+        while (i < format.size() && strchr("hlLqjzt", format[i])) {
+            i++;
+        }
+        if (i >= format.size()) {
+            out.append(format, start, std::string::npos);
+            break;
+        }
+        char conversion = format[i];
+        if (argIndex >= args.size()) {
+            out.append(format, start, i - start + 1);
+            continue;
+        }
+        const DecodedArg &arg = args[argIndex++];
+        switch (arg.type) {
+            case kArgString:
+                // 字符串忽略宽度等修饰，直接拼接
+                out.append(arg.string_value);
+                break;
+            case kArgDouble:
+                spec.push_back(strchr("eEfFgGaA", conversion) ? conversion : 'g');
+                snprintf(buf, sizeof(buf), spec.c_str(), arg.double_value);
+                out.append(buf);
+                break;
+            case kArgUInt:
+                spec.append("ll");
+                spec.push_back(strchr("uxXo", conversion) ? conversion : 'u');
+                snprintf(buf, sizeof(buf), spec.c_str(), static_cast<unsigned long long>(arg.uint_value));
+                out.append(buf);
+                break;
+            default:
+                spec.append("ll");
+                spec.push_back(strchr("dixXuoc", conversion) ? (conversion == 'c' ? 'd' : conversion) : 'd');
+                snprintf(buf, sizeof(buf), spec.c_str(), static_cast<long long>(arg.int_value));
+                out.append(buf);
+                break;
+        }
+    }
+    return out;
+}
+
+}  // namespace
+
+bool DecodeLogFile(const std::string &path, const std::function<void(const DecodedRecord &)> &callback) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(FileHeader)) {
+        return false;
+    }
+    FileHeader header;
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0 || header.version != kFileVersion
+        || header.ring_offset + header.ring_size > data.size()
+        || header.format_table_offset + header.format_table_size > data.size()
+        || header.head < header.tail || header.head - header.tail > header.ring_size) {
+        return false;
+    }
+    std::vector<std::string> formats;
+    const uint8_t *table = data.data() + header.format_table_offset;
+    for (size_t used = 0; used + 4 <= std::min<uint64_t>(header.format_table_used, header.format_table_size);) {
+        uint16_t id = 0;
+        uint16_t length = 0;
+        memcpy(&id, table + used, 2);
+        memcpy(&length, table + used + 2, 2);
+        if (used + 4 + length > header.format_table_size) {
+            break;
+        }
+        if (formats.size() <= id) {
+            formats.resize(id + 1);
+        }
+        formats[id].assign(reinterpret_cast<const char *>(table + used + 4), length);
+        used += AlignUp8(4 + length);
+    }
+    if (formats.empty()) {
+        formats.push_back("%s");
+    }
+
+    const uint8_t *ring = data.data() + header.ring_offset;
+    std::vector<DecodedArg> args;
+    for (uint64_t position = header.tail; position < header.head;) {
+        uint64_t offset = position % header.ring_size;
+        RecordHeader record;
+        if (offset + sizeof(uint32_t) > header.ring_size) {
+            return false;
+        }
+        memcpy(&record, ring + offset, std::min<uint64_t>(sizeof(record), header.ring_size - offset));
+        if (record.length < 8 || record.length % 8 || offset + record.length > header.ring_size) {
+            return false;
+        }
+        if (record.type == kRecordTypeLog && record.length >= sizeof(RecordHeader)) {
+            args.clear();
+            size_t payload = std::min<size_t>(record.payload_length, record.length - sizeof(RecordHeader));
+            DecodeArgs(ring + offset + sizeof(RecordHeader), payload, args);
+            DecodedRecord decoded;
+            decoded.level = static_cast<Level>(record.level);
+            decoded.tid = record.tid;
+            decoded.timestamp_ns = record.timestamp_ns;
+            const std::string &format = record.format_id < formats.size() && !formats[record.format_id].empty()
+                                            ? formats[record.format_id] : formats[kStringFormatId];
+            decoded.message = FormatMessage(format, args);
+            callback(decoded);
+        }
+        position += record.length;
+    }
+    return true;
+}
+
+std::string FormatDecodedRecord(const DecodedRecord &record) {
+    time_t seconds = static_cast<time_t>(record.timestamp_ns / 1000000000ULL);
+    unsigned milliseconds = static_cast<unsigned>((record.timestamp_ns / 1000000ULL) % 1000);
+    struct tm local;
+    localtime_r(&seconds, &local);
+    char time[32];
+    strftime(time, sizeof(time), "%Y-%m-%d %H:%M:%S", &local);
+    static const char *kLevelNames[] = {"debug", "info", "error"};
+    const char *level = static_cast<uint8_t>(record.level) < 3 ? kLevelNames[static_cast<uint8_t>(record.level)] : "unknown";
+    char prefix[96];
+    snprintf(prefix, sizeof(prefix), "%s.%03u|%s|%u|", time, milliseconds, level, record.tid);
+    return prefix + record.message;
+}
+
+}  // namespace log
+}  // namespace kuikly
+
+#ifdef KR_BINARY_LOG_DECODER_MAIN
+/*
+ * 解码工具：c++ -std=c++11 -DKR_BINARY_LOG_DECODER_MAIN KRBinaryLogCore.cpp -o krlogdecode
+ * 用法：krlogdecode <日志文件>
+ */
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <kuikly binary log file>\n", argv[0]);
+        return 1;
+    }
+    bool success = kuikly::log::DecodeLogFile(argv[1], [](const kuikly::log::DecodedRecord &record) {
+        printf("%s\n", kuikly::log::FormatDecodedRecord(record).c_str());
+    });
+    if (!success) {
+        fprintf(stderr, "invalid log file: %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,229 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KRBinaryLogCore_hpp
+#define KRBinaryLogCore_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+ * 二进制日志核心，仅依赖C++标准库与POSIX mmap，可脱离iOS单独编译/benchmark。
+ *
+ * 调用线程只把(时间戳, 等级, format id, 参数)编码进线程独占的无锁环形缓冲区，
+ * 由单个写线程汇总写入mmap映射的环形文件；文件页由内核持有，进程崩溃后已写入文件的日志不丢失。
+ * 崩溃时尚未汇总的日志会丢失：每个线程缓冲区中最多kThreadBufferSize字节，约为写线程一个汇总周期（100ms）内的日志；
+ * 崩溃前必须落盘的日志（如即将abort）需先调用Flush。信号处理函数中不能调用Flush（需加锁），不做崩溃时补写。
+ * 格式化推迟到读取时进行（见DecodeLogFile），缓冲区满时丢弃并计数，不阻塞调用方。
+ */
+namespace kuikly {
+namespace log {
+
+enum class Level : uint8_t {
+    kDebug = 0,
+    kInfo = 1,
+    kError = 2,
+};
+
+/// 预置format："%s"，用于已格式化好的字符串
+constexpr uint16_t kStringFormatId = 0;
+constexpr uint16_t kInvalidFormatId = 0xFFFF;
+/// 单条日志最大字节数（超长字符串参数会被截断）
+constexpr size_t kMaxRecordSize = 8 * 1024;
+/// 每个线程的缓冲区容量，需为2的幂
+constexpr size_t kThreadBufferSize = 64 * 1024;
+
+/// 记录头，线程缓冲区与文件中的布局一致，记录按8字节对齐
+struct RecordHeader {
+    uint32_t length;  // 含记录头，已对齐
+    uint8_t type;     // 0: 填充 1: 日志
+    uint8_t level;
+    uint16_t format_id;
+    uint32_t tid;
+    uint32_t payload_length;
+    uint64_t timestamp_ns;  // unix时间（ns）
+};
+static_assert(sizeof(RecordHeader) == 24, "unexpected RecordHeader layout");
+
+/// 参数类型标记
+enum ArgType : uint8_t {
+    kArgInt = 'i',
+    kArgUInt = 'u',
+    kArgDouble = 'd',
+    kArgString = 's',
+};
+
+/// 字符串参数（不要求以'\0'结尾）
+struct StringArg {
+    const char *data;
+    size_t length;
+};
+
+class ThreadLogBuffer;
+
+class BinaryLogger {
+public:
+    static BinaryLogger &Shared();
+
+    /// 创建（覆盖）并映射日志文件，启动写线程；ringSize为环形区大小
+    bool Open(const std::string &path, size_t ringSize);
+    /// 写出剩余日志并关闭文件
+    void Close();
+    bool IsOpen() const {
+        return open_.load(std::memory_order_relaxed);
+    }
+
+    /// 注册format字符串，返回format id，线程安全；同一字符串返回同一id
+    uint16_t RegisterFormat(const char *format);
+
+    /// 记录一条日志，参数支持整数、浮点、const char *、std::string、StringArg
+    template <typename... Args>
+    bool Log(Level level, uint16_t formatId, const Args &... args) {
+        if (!IsOpen()) {
+            return false;
+        }
+        size_t payload = PayloadSize(args...);
+        ArgEncoder encoder;
+        if (!BeginRecord(level, formatId, payload, encoder)) {
+            return false;
+        }
+        Encode(encoder, args...);
+        CommitRecord(encoder);
+        return true;
+    }
+
+    bool LogString(Level level, const char *message, size_t length) {
+        return Log(level, kStringFormatId, StringArg{message, length});
+    }
+
+    /// 同步把所有线程缓冲区写入文件
+    void Flush();
+    /// 因缓冲区满被丢弃的日志条数
+    uint64_t DroppedCount() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    /// 参数编码器，由BeginRecord初始化，写入线程缓冲区
+    struct ArgEncoder {
+        ThreadLogBuffer *buffer = nullptr;
+        uint64_t position = 0;
+        uint64_t end = 0;
+        size_t remaining = 0;
+        void Put(const void *data, size_t length);
+    };
+
+private:
+    BinaryLogger() = default;
+    BinaryLogger(const BinaryLogger &) = delete;
+    BinaryLogger &operator=(const BinaryLogger &) = delete;
+
+    static size_t PayloadSize() { return 0; }
+    template <typename T, typename... Rest>
+    static size_t PayloadSize(const T &value, const Rest &... rest) {
+        return ArgSize(value) + PayloadSize(rest...);
+    }
+    static size_t ArgSize(const char *value) { return 1 + 4 + (value ? std::min(strlen(value), kMaxRecordSize) : 0); }
+    static size_t ArgSize(const std::string &value) { return 1 + 4 + std::min(value.size(), kMaxRecordSize); }
+    static size_t ArgSize(const StringArg &value) { return 1 + 4 + std::min(value.length, kMaxRecordSize); }
+    template <typename T>
+    static size_t ArgSize(const T &) { return 1 + 8; }
+
+    static void Encode(ArgEncoder &) {}
+    template <typename T, typename... Rest>
+    static void Encode(ArgEncoder &encoder, const T &value, const Rest &... rest) {
+        EncodeArg(encoder, value);
+        Encode(encoder, rest...);
+    }
+    static void EncodeString(ArgEncoder &encoder, const char *data, size_t length);
+    static void EncodeArg(ArgEncoder &encoder, const char *value) { EncodeString(encoder, value, value ? strlen(value) : 0); }
+    static void EncodeArg(ArgEncoder &encoder, const std::string &value) { EncodeString(encoder, value.data(), value.size()); }
+    static void EncodeArg(ArgEncoder &encoder, const StringArg &value) { EncodeString(encoder, value.data, value.length); }
+    static void EncodeArg(ArgEncoder &encoder, double value) { EncodeFixed(encoder, kArgDouble, value); }
+    static void EncodeArg(ArgEncoder &encoder, float value) { EncodeFixed(encoder, kArgDouble, static_cast<double>(value)); }
+    template <typename T>
+    static void EncodeArg(ArgEncoder &encoder, const T &value) {
+        static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "unsupported log argument type");
+        if (std::is_signed<T>::value) {
+            EncodeFixed(encoder, kArgInt, static_cast<int64_t>(value));
+        } else {
+            EncodeFixed(encoder, kArgUInt, static_cast<uint64_t>(value));
+        }
+    }
+    template <typename T>
+    static void EncodeFixed(ArgEncoder &encoder, uint8_t type, T value) {
+        encoder.Put(&type, 1);
+        encoder.Put(&value, sizeof(value));
+    }
+
+    bool BeginRecord(Level level, uint16_t formatId, size_t payload, ArgEncoder &encoder);
+    void CommitRecord(ArgEncoder &encoder);
+    ThreadLogBuffer *CurrentThreadBuffer();
+    void WriterLoop();
+    void DrainAll();
+    void AppendToFile(const uint8_t *record, uint32_t length);
+    void WriteFormatTable();
+    void Wake();
+
+    std::atomic<bool> open_{false};
+    std::atomic<uint64_t> dropped_{0};
+
+    std::mutex buffers_mutex_;
+    std::vector<ThreadLogBuffer *> buffers_;
+    uint32_t next_tid_ = 1;
+
+    std::mutex formats_mutex_;
+    std::vector<std::string> formats_;
+
+    /// 保证线程缓冲区只有一个消费者，同时保护文件写入
+    std::mutex drain_mutex_;
+    std::vector<uint8_t> scratch_;
+    int fd_ = -1;
+    uint8_t *map_ = nullptr;
+    size_t map_size_ = 0;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic<bool> wake_pending_{false};
+    bool running_ = false;
+    std::thread writer_;
+};
+
+struct DecodedRecord {
+    Level level;
+    uint32_t tid;
+    uint64_t timestamp_ns;
+    /// 按format格式化后的内容
+    std::string message;
+};
+
+/// 解码日志文件，按写入顺序回调；文件无效时返回false
+bool DecodeLogFile(const std::string &path, const std::function<void(const DecodedRecord &)> &callback);
+/// 格式化为单行文本："yyyy-MM-dd HH:mm:ss.SSS|level|tid|message"（本地时区）
+std::string FormatDecodedRecord(const DecodedRecord &record);
+
+}  // namespace log
+}  // namespace kuikly
+
+#endif /* KRBinaryLogCore_hpp */
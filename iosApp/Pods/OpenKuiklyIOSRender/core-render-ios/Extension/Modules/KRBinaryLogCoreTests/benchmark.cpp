@@ -0,0 +1,181 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/*
+ * KRBinaryLogCore吞吐基准：多线程并发写入，统计每秒调用次数、每秒实际写入文件的日志条数与调用方单次耗时（p50/p99），
+ * 并与"加锁 + snprintf + fwrite"的同步格式化写法对比；结束后解码核对写出条数。
+ * 线程缓冲区满时日志被丢弃，吞吐以写入文件的条数为准，同时给出丢弃率；
+ * 另以"丢弃后让出CPU重试"的方式节流调用方再跑一轮，得到不丢日志时可持续的写入速度。
+ * 单次耗时含一次steady_clock读取的开销。
+ */
+
+#include "KRBinaryLogCore.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using kuikly::log::BinaryLogger;
+using kuikly::log::Level;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double seconds = 0;
+    std::vector<uint32_t> latencies;  // ns
+};
+
+template <typename Fn>
+Result Run(int threadCount, int lines, Fn &&logLine) {
+    Result result;
+    std::vector<std::vector<uint32_t>> latencies(threadCount);
+    std::vector<std::thread> threads;
+    Clock::time_point start = Clock::now();
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t] {
+            std::vector<uint32_t> &samples = latencies[t];
+            samples.reserve(lines);
+            for (int i = 0; i < lines; i++) {
+                Clock::time_point begin = Clock::now();
+                logLine(t, i);
+                samples.push_back(static_cast<uint32_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count()));
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (std::vector<uint32_t> &samples : latencies) {
+        result.latencies.insert(result.latencies.end(), samples.begin(), samples.end());
+    }
+    std::sort(result.latencies.begin(), result.latencies.end());
+    return result;
+}
+
+/// 解码日志文件，返回记录条数，文件无效时返回false
+bool DecodeCount(const std::string &path, size_t &decoded) {
+    decoded = 0;
+    return kuikly::log::DecodeLogFile(path, [&decoded](const kuikly::log::DecodedRecord &) {
+        decoded++;
+    });
+}
+
+uint32_t Percentile(const std::vector<uint32_t> &sorted, double percentile) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(percentile * (sorted.size() - 1));
+    return sorted[index];
+}
+
+/// calls为调用次数，persisted为写入文件的条数
+void Print(const char *name, const Result &result, size_t calls, size_t persisted) {
+    printf("%-16s %10.0f calls/s %10.0f persisted lines/s  dropped %5.1f%%  p50 %6u ns  p99 %6u ns  max %8u ns\n", name,
+           calls / result.seconds, persisted / result.seconds, calls ? 100.0 * (calls - persisted) / calls : 0.0,
+           Percentile(result.latencies, 0.5), Percentile(result.latencies, 0.99), result.latencies.back());
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    int threadCount = 4;
+    int lines = 200000;
+    std::string dir = ".";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--threads") == 0) {
+            threadCount = std::max(1, atoi(argv[i + 1]));
+        } else if (strcmp(argv[i], "--lines") == 0) {
+            lines = std::max(1, atoi(argv[i + 1]));
+        } else if (strcmp(argv[i], "--dir") == 0) {
+            dir = argv[i + 1];
+        }
+    }
+    size_t total = static_cast<size_t>(threadCount) * lines;
+    const char *format = "render view %s tag=%d frame=%.2f visible=%u";
+    printf("KRBinaryLogCore benchmark: %d threads x %d lines\n", threadCount, lines);
+
+    // 基准：调用线程格式化并加锁写文件
+    std::string textPath = dir + "/benchmark.txt";
+    FILE *textFile = fopen(textPath.c_str(), "w");
+    if (!textFile) {
+        fprintf(stderr, "cannot open %s\n", textPath.c_str());
+        return 1;
+    }
+    std::mutex textMutex;
+    Result text = Run(threadCount, lines, [&](int t, int i) {
+        char buffer[256];
+        int length = snprintf(buffer, sizeof(buffer), format, "KRView", t * lines + i, 1.5 * i, static_cast<unsigned>(i & 1));
+        std::lock_guard<std::mutex> lock(textMutex);
+        fwrite(buffer, 1, static_cast<size_t>(length), textFile);
+        fputc('\n', textFile);
+    });
+    fclose(textFile);
+    Print("snprintf+fwrite", text, total, total);
+
+    BinaryLogger &logger = BinaryLogger::Shared();
+    std::string path = dir + "/benchmark.klog";
+    uint16_t formatId = logger.RegisterFormat(format);
+    // 环形区容纳全部日志，便于核对条数
+    if (!logger.Open(path, total * 96)) {
+        fprintf(stderr, "cannot open %s\n", path.c_str());
+        return 1;
+    }
+    Result binary = Run(threadCount, lines, [&](int t, int i) {
+        logger.Log(Level::kInfo, formatId, "KRView", t * lines + i, 1.5 * i, static_cast<unsigned>(i & 1));
+    });
+    logger.Close();
+
+    size_t decoded = 0;
+    bool success = DecodeCount(path, decoded);
+    uint64_t dropped = logger.DroppedCount();
+    Print("binary log", binary, total, decoded);
+    if (!success || decoded + dropped != total) {
+        fprintf(stderr, "decoded %zu + dropped %llu lines do not match: expected %zu\n", decoded,
+                static_cast<unsigned long long>(dropped), total);
+        return 1;
+    }
+
+    // 节流：缓冲区满时让出CPU等写线程汇总后重试，全部日志都应写入文件
+    std::string pacedPath = dir + "/benchmark_paced.klog";
+    if (!logger.Open(pacedPath, total * 96)) {
+        fprintf(stderr, "cannot open %s\n", pacedPath.c_str());
+        return 1;
+    }
+    Result paced = Run(threadCount, lines, [&](int t, int i) {
+        while (!logger.Log(Level::kInfo, formatId, "KRView", t * lines + i, 1.5 * i, static_cast<unsigned>(i & 1))) {
+            std::this_thread::yield();
+        }
+    });
+    logger.Close();
+    success = DecodeCount(pacedPath, decoded);
+    Print("binary (paced)", paced, total, decoded);
+    if (!success || decoded != total) {
+        fprintf(stderr, "paced run decoded %zu lines: expected %zu\n", decoded, total);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/*
+ * KRBinaryLogCore功能测试：写入后用DecodeLogFile解码，核对内容、顺序、环形覆盖、多线程与丢弃计数。
+ * BinaryLogger为进程单例，每个用例各自Open/Close一个日志文件。
+ */
+
+#include "KRBinaryLogCore.hpp"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using kuikly::log::BinaryLogger;
+using kuikly::log::DecodedRecord;
+using kuikly::log::Level;
+
+namespace {
+
+size_t gFailures = 0;
+
+#define EXPECT(condition, ...)                                  \
+    do {                                                        \
+        if (!(condition)) {                                     \
+            gFailures++;                                        \
+            printf("FAIL %s:%d %s: ", __FILE__, __LINE__, #condition); \
+            printf(__VA_ARGS__);                                \
+            printf("\n");                                       \
+        }                                                       \
+    } while (0)
+
+std::vector<DecodedRecord> Decode(const std::string &path, bool *success) {
+    std::vector<DecodedRecord> records;
+    *success = kuikly::log::DecodeLogFile(path, [&records](const DecodedRecord &record) {
+        records.push_back(record);
+    });
+    return records;
+}
+
+/// 按格式写入各类参数，解码后与snprintf结果一致
+void TestRoundTrip(const std::string &dir) {
+    BinaryLogger &logger = BinaryLogger::Shared();
+    std::string path = dir + "/roundtrip.klog";
+    uint16_t formatId = logger.RegisterFormat("view %s tag=%d size=%.2f flags=%x count=%u");
+    EXPECT(logger.RegisterFormat("view %s tag=%d size=%.2f flags=%x count=%u") == formatId, "same format twice");
+    EXPECT(logger.Open(path, 1 << 20), "open %s", path.c_str());
+    logger.Log(Level::kInfo, formatId, "KRView", -12, 3.14159, 0xBEEFu, static_cast<uint64_t>(7));
+    logger.LogString(Level::kError, "plain string", 12);
+    logger.Log(Level::kDebug, formatId, std::string("KRLabel"), 1);  // 参数不足时保留格式符
+    logger.Close();
+
+    bool success = false;
+    std::vector<DecodedRecord> records = Decode(path, &success);
+    EXPECT(success, "decode %s", path.c_str());
+    EXPECT(records.size() == 3, "decoded %zu records", records.size());
+    if (records.size() == 3) {
+        EXPECT(records[0].message == "view KRView tag=-12 size=3.14 flags=beef count=7", "got '%s'", records[0].message.c_str());
+        EXPECT(records[0].level == Level::kInfo, "level %d", static_cast<int>(records[0].level));
+        EXPECT(records[1].message == "plain string", "got '%s'", records[1].message.c_str());
+        EXPECT(records[1].level == Level::kError, "level %d", static_cast<int>(records[1].level));
+        EXPECT(records[2].message == "view KRLabel tag=1 size=%.2f flags=%x count=%u", "got '%s'", records[2].message.c_str());
+        EXPECT(records[0].timestamp_ns <= records[1].timestamp_ns, "timestamps not ordered");
+    }
+}
+
+/// 环形区写满后覆盖最旧的记录，解码结果为最新的连续一段
+void TestRingWrap(const std::string &dir) {
+    BinaryLogger &logger = BinaryLogger::Shared();
+    std::string path = dir + "/wrap.klog";
+    uint16_t formatId = logger.RegisterFormat("line %d");
+    uint64_t droppedBefore = logger.DroppedCount();
+    EXPECT(logger.Open(path, 0), "open %s", path.c_str());  // 取最小环形区
+    const int kLines = 20000;
+    for (int i = 0; i < kLines; i++) {
+        logger.Log(Level::kInfo, formatId, i);
+        if (i % 256 == 0) {
+            logger.Flush();
+        }
+    }
+    logger.Close();
+
+    bool success = false;
+    std::vector<DecodedRecord> records = Decode(path, &success);
+    EXPECT(success, "decode %s", path.c_str());
+    EXPECT(!records.empty() && records.size() < static_cast<size_t>(kLines), "decoded %zu records", records.size());
+    uint64_t dropped = logger.DroppedCount() - droppedBefore;
+    EXPECT(dropped == 0, "dropped %llu", static_cast<unsigned long long>(dropped));
+    if (!records.empty()) {
+        int expected = kLines - static_cast<int>(records.size());
+        for (const DecodedRecord &record : records) {
+            std::string line = "line " + std::to_string(expected++);
+            if (record.message != line) {
+                EXPECT(false, "expected '%s' got '%s'", line.c_str(), record.message.c_str());
+                break;
+            }
+        }
+    }
+}
+
+/// 多线程写入：每个线程内保持顺序，写出条数 + 丢弃条数 = 调用次数；已退出线程的日志不丢失
+void TestThreads(const std::string &dir) {
+    BinaryLogger &logger = BinaryLogger::Shared();
+    std::string path = dir + "/threads.klog";
+    uint16_t formatId = logger.RegisterFormat("thread %d seq %d");
+    uint64_t droppedBefore = logger.DroppedCount();
+    EXPECT(logger.Open(path, 16 << 20), "open %s", path.c_str());
+    const int kThreads = 4;
+    const int kLines = 50000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([&logger, formatId, t] {
+            for (int i = 0; i < kLines; i++) {
+                logger.Log(Level::kInfo, formatId, t, i);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    // 线程均已退出，Flush后其缓冲区被回收；文件在Close前即可解码（模拟进程崩溃）
+    logger.Flush();
+    bool success = false;
+    std::vector<DecodedRecord> records = Decode(path, &success);
+    EXPECT(success, "decode before close %s", path.c_str());
+    logger.Close();
+
+    uint64_t dropped = logger.DroppedCount() - droppedBefore;
+    EXPECT(records.size() + dropped == static_cast<size_t>(kThreads * kLines),
+           "decoded %zu + dropped %llu != %d", records.size(), static_cast<unsigned long long>(dropped), kThreads * kLines);
+    std::map<int, int> lastSeq;
+    for (const DecodedRecord &record : records) {
+        int thread = 0;
+        int seq = 0;
+        if (sscanf(record.message.c_str(), "thread %d seq %d", &thread, &seq) != 2) {
+            EXPECT(false, "unexpected line '%s'", record.message.c_str());
+            break;
+        }
+        auto it = lastSeq.find(thread);
+        if (it != lastSeq.end() && seq <= it->second) {
+            EXPECT(false, "thread %d out of order: %d after %d", thread, seq, it->second);
+            break;
+        }
+        lastSeq[thread] = seq;
+    }
+    EXPECT(lastSeq.size() == static_cast<size_t>(kThreads), "saw %zu threads", lastSeq.size());
+}
+
+/// 非日志文件解码失败
+void TestInvalidFile(const std::string &dir) {
+    std::string path = dir + "/invalid.klog";
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file) {
+        std::string junk(8192, 'x');
+        fwrite(junk.data(), 1, junk.size(), file);
+        fclose(file);
+    }
+    bool success = true;
+    Decode(path, &success);
+    EXPECT(!success, "junk file decoded");
+    Decode(dir + "/missing.klog", &success);
+    EXPECT(!success, "missing file decoded");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    std::string dir = argc > 1 ? argv[1] : ".";
+    TestRoundTrip(dir);
+    TestRingWrap(dir);
+    TestThreads(dir);
+    TestInvalidFile(dir);
+    printf("KRBinaryLogCore tests: %zu failures\n", gFailures);
+    return gFailures ? 1 : 0;
+}
@@ -41,7 +41,13 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)logError:(NSString *)message;
 
-
+@optional
+/*
+ * @brief 是否开启二进制日志（默认NO，首个页面初始化时读取）
+ * 开启后日志先写入mmap环形文件（见KRBinaryLog），默认handler不再输出到控制台；
+ * 通过registerLogHandler:注册的handler仍会收到全部日志
+ */
+- (BOOL)binaryLogEnable;
 
 @end
 
@@ -58,6 +64,14 @@ NS_ASSUME_NONNULL_BEGIN
  * @brief 打印信息
  */
 + (void)logInfo:(NSString *)infoLog;
+/*
+ * @brief 按logHandler的binaryLogEnable开启二进制日志（渲染初始化时调用，只生效一次）
+ */
++ (void)openBinaryLogIfNeeded;
+/*
+ * @brief 二进制日志文件路径，上次运行的日志见[KRBinaryLog previousFilePathForFilePath:]
+ */
++ (NSString *)binaryLogFilePath;
 
 @end
 
@@ -16,10 +16,12 @@
 #import "KRLogModule.h"
 #import "KuiklyRenderThreadManager.h"
 #import "KRConvertUtil.h"
-#import "KuiklyRenderThreadManager.h"
+#import "KRBinaryLog.h"
 
 static id<KuiklyLogProtocol> gLogHandler;
 static id<KuiklyLogProtocol> gLogUserSuppliedHandler;
+/// 二进制日志环形区大小
+static const NSUInteger kKRBinaryLogRingSize = 4 * 1024 * 1024;
 
 
 @interface KuiklyLogHandler : NSObject<KuiklyLogProtocol>
@@ -94,10 +96,15 @@ static id<KuiklyLogProtocol> gLogUserSuppliedHandler;
 
 - (void)logInfo:(NSDictionary *)args {
     NSString *message = args[KR_PARAM_KEY];
+    KRBinaryLogWrite(KRBinaryLogLevelInfo, message);
+    if (![KRLogModule p_shouldForwardToLogHandler]) {
+        return;
+    }
     if (_asyncLogEnable) {
-        NSString *logTime = [self logTimeDate];
+        // 只记录时间戳，格式化放到日志线程
+        CFAbsoluteTime logTime = CFAbsoluteTimeGetCurrent();
         [self addLogTask:^{
-            [[KRLogModule logHandler] logInfo:[NSString stringWithFormat:@"|%@|%@", logTime, message]];
+            [[KRLogModule logHandler] logInfo:[NSString stringWithFormat:@"|%@|%@", [KRLogModule p_logTimeStringWithTime:logTime], message]];
         }];
     } else {
         [[KRLogModule logHandler] logInfo:message];
@@ -108,10 +115,15 @@ static id<KuiklyLogProtocol> gLogUserSuppliedHandler;
 
 - (void)logDebug:(NSDictionary *)args {
     NSString *message = args[KR_PARAM_KEY];
+    KRBinaryLogWrite(KRBinaryLogLevelDebug, message);
+    if (![KRLogModule p_shouldForwardToLogHandler]) {
+        return;
+    }
     if (_asyncLogEnable) {
-        NSString *logTime = [self logTimeDate];
+        // 只记录时间戳，格式化放到日志线程
+        CFAbsoluteTime logTime = CFAbsoluteTimeGetCurrent();
         [self addLogTask:^{
-            [[KRLogModule logHandler] logDebug:[NSString stringWithFormat:@"|%@|%@", logTime, message]];
+            [[KRLogModule logHandler] logDebug:[NSString stringWithFormat:@"|%@|%@", [KRLogModule p_logTimeStringWithTime:logTime], message]];
         }];
     } else {
         [[KRLogModule logHandler] logDebug:message];
@@ -120,10 +132,15 @@ static id<KuiklyLogProtocol> gLogUserSuppliedHandler;
 
 - (void)logError:(NSDictionary *)args {
     NSString *message = args[KR_PARAM_KEY];
+    KRBinaryLogWrite(KRBinaryLogLevelError, message);
+    if (![KRLogModule p_shouldForwardToLogHandler]) {
+        return;
+    }
     if (_asyncLogEnable) {
-        NSString *logTime = [self logTimeDate];
+        // 只记录时间戳，格式化放到日志线程
+        CFAbsoluteTime logTime = CFAbsoluteTimeGetCurrent();
         [self addLogTask:^{
-            [[KRLogModule logHandler] logError:[NSString stringWithFormat:@"|%@|%@", logTime, message]];
+            [[KRLogModule logHandler] logError:[NSString stringWithFormat:@"|%@|%@", [KRLogModule p_logTimeStringWithTime:logTime], message]];
         }];
     } else {
         [[KRLogModule logHandler] logError:message];
@@ -134,19 +151,53 @@ static id<KuiklyLogProtocol> gLogUserSuppliedHandler;
 
 + (void)logError:(NSString *)errorLog {
     NSString *message = [NSString stringWithFormat:@"[kuikly error]%@", errorLog];
-    NSLog(@"%@", message);
-    [[KRLogModule logHandler] logError:message]; // 日志落入接入层体系中
+    KRBinaryLogWrite(KRBinaryLogLevelError, message);
+    // 不再额外同步NSLog，默认handler已输出到控制台
+    if ([self p_shouldForwardToLogHandler]) {
+        [[KRLogModule logHandler] logError:message]; // 日志落入接入层体系中
+    }
 #if DEBUG
     [KRConvertUtil hr_alertWithTitle:@"kuikly error" message:message]; // 本地开发可视化提醒
 #endif
 }
 
 + (void)logInfo:(NSString *)infoLog {
-    [[KRLogModule logHandler] logInfo:infoLog]; // 日志落入接入层体系中
+    KRBinaryLogWrite(KRBinaryLogLevelInfo, infoLog);
+    if ([self p_shouldForwardToLogHandler]) {
+        [[KRLogModule logHandler] logInfo:infoLog]; // 日志落入接入层体系中
+    }
+}
+
++ (void)openBinaryLogIfNeeded {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        id<KuiklyLogProtocol> handler = [self logHandler];
+        if (![handler respondsToSelector:@selector(binaryLogEnable)] || ![handler binaryLogEnable]) {
+            return;
+        }
+        NSString *filePath = [self binaryLogFilePath];
+        [[NSFileManager defaultManager] createDirectoryAtPath:[filePath stringByDeletingLastPathComponent]
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:nil];
+        if (![KRBinaryLog openWithFilePath:filePath ringSize:kKRBinaryLogRingSize]) {
+            [[self logHandler] logError:[NSString stringWithFormat:@"[kuikly error]open binary log failed: %@", filePath]];
+        }
+    });
+}
+
++ (NSString *)binaryLogFilePath {
+    NSString *cachesPath = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+    return [[cachesPath stringByAppendingPathComponent:@"kuikly_log"] stringByAppendingPathComponent:@"kuikly.klog"];
 }
 
 
 #pragma mark - private
+
+/// 二进制日志开启后由其落盘，默认handler不再重复输出；自定义handler照常接收
++ (BOOL)p_shouldForwardToLogHandler {
+    return gLogUserSuppliedHandler || !KRBinaryLogIsEnabled();
+}
   
 - (void)addLogTask:(dispatch_block_t)task {
     assert([KuiklyRenderThreadManager isContextQueue]);
@@ -173,11 +224,15 @@ static id<KuiklyLogProtocol> gLogUserSuppliedHandler;
     }
 }
 
-- (NSString *)logTimeDate {
-    NSDate *date = [NSDate date];
-    NSDateFormatter *formatter = [[NSDateFormatter alloc] init];
-    [formatter setDateFormat:@"HH:mm.ss.SSS"];
-    return [formatter stringFromDate:date];
++ (NSString *)p_logTimeStringWithTime:(CFAbsoluteTime)time {
+    // 复用formatter，避免每行日志创建NSDateFormatter
+    static NSDateFormatter *formatter;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        formatter = [[NSDateFormatter alloc] init];
+        [formatter setDateFormat:@"HH:mm.ss.SSS"];
+    });
+    return [formatter stringFromDate:[NSDate dateWithTimeIntervalSinceReferenceDate:time]];
 }
 
 @end
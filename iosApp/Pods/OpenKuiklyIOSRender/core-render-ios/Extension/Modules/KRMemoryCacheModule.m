@@ -16,6 +16,7 @@
 #import "KRMemoryCacheModule.h"
 #import "NSObject+KR.h"
 #import "KRImageView.h"
+#import "KRMemoryMonitor.h"
 
 extern NSString *const KRImageBase64Prefix;
 extern NSString *const KRImageAssetsPrefix;
@@ -25,7 +26,7 @@ static NSString *const kCacheStateComplete = @"Complete";
 static NSString *const kCacheStateInProgress = @"InProgress";
 
 
-@interface KRMemoryCacheModule(){
+@interface KRMemoryCacheModule()<KRMemoryCostReporter>{
     NSMutableDictionary* _imageCache;
     NSLock* _imageCacheLock;
 }
@@ -34,11 +35,35 @@ static NSString *const kCacheStateInProgress = @"InProgress";
 
 @end
 
+/// 图片按解码后的位图（动图累加每帧）、字符串按UTF-16、NSData按字节数估算
+static int64_t KRMemoryCacheCostOfObject(id object) {
+    if ([object isKindOfClass:[UIImage class]]) {
+        UIImage *image = object;
+        if (image.images.count) {
+            int64_t cost = 0;
+            for (UIImage *frame in image.images) {
+                cost += KRMemoryCacheCostOfObject(frame);
+            }
+            return cost;
+        }
+        CGImageRef cgImage = image.CGImage;
+        return cgImage ? (int64_t)(CGImageGetBytesPerRow(cgImage) * CGImageGetHeight(cgImage)) : 0;
+    }
+    if ([object isKindOfClass:[NSString class]]) {
+        return (int64_t)([(NSString *)object length] * sizeof(unichar));
+    }
+    if ([object isKindOfClass:[NSData class]]) {
+        return (int64_t)[(NSData *)object length];
+    }
+    return 0;
+}
+
 @implementation KRMemoryCacheModule
 
 - (instancetype)init{
     if(self = [super init]){
         _imageCacheLock = [[NSLock alloc] init];
+        [KRMemoryMonitor registerMemoryCostReporter:self];
         return self;
     }
     return nil;
@@ -229,6 +254,26 @@ static NSString *const kCacheStateInProgress = @"InProgress";
     return [cacheObj isKindOfClass:[UIImage class]] ? (UIImage*)cacheObj : nil;
 }
 
+#pragma mark - KRMemoryCostReporter
+
+- (NSString *)kr_memoryCategory {
+    return @"memoryCacheModule";
+}
+
+// 缓存内容由kotlin侧按key持有和使用，内存压力时不做淘汰，仅统计开销
+- (int64_t)kr_memoryCost {
+    int64_t cost = 0;
+    [_imageCacheLock lock];
+    for (id cacheObj in _imageCache.allValues) {
+        cost += KRMemoryCacheCostOfObject(cacheObj);
+    }
+    [_imageCacheLock unlock];
+    for (id value in _memoryKeyValueMap.allValues) {
+        cost += KRMemoryCacheCostOfObject(value);
+    }
+    return cost;
+}
+
 - (void)dealloc {
     NSDictionary* cache = _imageCache;
     _imageCache = nil;
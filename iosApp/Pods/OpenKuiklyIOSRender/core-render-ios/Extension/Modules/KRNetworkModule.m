@@ -15,6 +15,57 @@
 
 #import "KRNetworkModule.h"
 #import "KRHttpRequestTool.h"
+#import "KRHttpSessionPool.h"
+
+/*
+ * 回包模式：string(默认，回包转字符串、headers转JSON)、bytes(原始字节)、stream(分片回调原始字节)
+ * bytes回调为定长数组[resInfo, headers, data]：resInfo为{"success", "statusCode", "errorMsg"}的JSON字符串，headers与data为NSData；
+ * 含NSData的数组跨桥时原样透传（字典会被JSON序列化，无法携带NSData），stream事件格式见p_streamRequestWithMethod
+ */
+static NSString *const kKRResponseTypeBytes = @"bytes";
+static NSString *const kKRResponseTypeStream = @"stream";
+
+/*
+ * 回包headers编码为紧凑map："key\0value\0key\0value\0"（UTF-8），Kotlin侧按\0切分即可，无需JSON解析
+ */
+static NSData *KRNetworkEncodeHeaders(NSURLResponse *response) {
+    if (![response isKindOfClass:[NSHTTPURLResponse class]]) {
+        return [NSData data];
+    }
+    NSMutableData *encoded = [NSMutableData data];
+    const char separator = '\0';
+    [((NSHTTPURLResponse *)response).allHeaderFields enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+        NSString *field = [key description];
+        NSString *fieldValue = [value description];
+        [encoded appendData:[field dataUsingEncoding:NSUTF8StringEncoding]];
+        [encoded appendBytes:&separator length:1];
+        [encoded appendData:[fieldValue dataUsingEncoding:NSUTF8StringEncoding]];
+        [encoded appendBytes:&separator length:1];
+    }];
+    return encoded;
+}
+
+static NSInteger KRNetworkStatusCode(NSURLResponse *response, NSError *error, BOOL success) {
+    if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+        return ((NSHTTPURLResponse *)response).statusCode;
+    }
+    return success ? 200 : error.code;
+}
+
+/// bytes模式与stream模式resInfo字段
+static NSString *const kKRNetworkSuccessKey = @"success";
+static NSString *const kKRNetworkStatusCodeKey = @"statusCode";
+static NSString *const kKRNetworkErrorMsgKey = @"errorMsg";
+
+/// 请求结果resInfo：{"success", "statusCode", "errorMsg"}的JSON字符串
+static NSString *KRNetworkResInfo(NSURLResponse *response, NSError *error, BOOL success) {
+    NSDictionary *resInfo = @{
+        kKRNetworkSuccessKey: @(success ? 1 : 0),
+        kKRNetworkStatusCodeKey: @(KRNetworkStatusCode(response, error, success)),
+        kKRNetworkErrorMsgKey: (error ? [error localizedDescription] : @"") ?: @""
+    };
+    return [resInfo hr_dictionaryToString];
+}
 
 @implementation KRNetworkModule
 
@@ -30,7 +81,36 @@
     NSDictionary *headers = param[@"headers"];
     NSString *cookie = param[@"cookie"];
     NSInteger timeout = [param[@"timeout"] intValue];
-    
+    NSString *responseType = param[@"responseType"];
+
+    KRHttpRequestPriority priority = [KRHttpRequestScheduler priorityFromValue:param[@"priority"]];
+    if ([responseType isEqual:kKRResponseTypeStream]) {
+        [self p_streamRequestWithMethod:method url:url param:requestParam headers:headers timeout:timeout cookie:cookie
+                               priority:priority requestId:param[@"requestId"] callback:callback];
+        return;
+    }
+    if ([responseType isEqual:kKRResponseTypeBytes]) {
+        [KRHttpRequestTool requestWithMethod:method
+                                         url:url
+                                       param:requestParam
+                                  binaryData:nil
+                                     headers:headers
+                                     timeout:timeout
+                                      cookie:cookie
+                                    priority:priority
+                                  identifier:[self p_schedulerIdentifierWithRequestId:param[@"requestId"]]
+                                      pageId:[self p_pageId]
+                               responseBlock:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
+            if (callback) {
+                // 原始字节与编码后的headers以数组直接跨桥，不做字符串转码与JSON序列化
+                callback(@[KRNetworkResInfo(response, error, data && error == nil),
+                           KRNetworkEncodeHeaders(response),
+                           data ?: [NSData data]]);
+            }
+        }];
+        return;
+    }
+
     [KRHttpRequestTool requestWithMethod:method
                                      url:url
                                    param:requestParam
@@ -38,6 +118,9 @@
                                  headers:headers
                                  timeout:timeout
                                   cookie:cookie
+                                priority:priority
+                              identifier:[self p_schedulerIdentifierWithRequestId:param[@"requestId"]]
+                                  pageId:[self p_pageId]
                            responseBlock:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
         int success = data && error == nil ? 1 : 0;
         NSString * errorMsg = (error ? [error localizedDescription] : @"") ?: @"";
@@ -86,6 +169,9 @@
                                  headers:headers
                                  timeout:timeout
                                   cookie:cookie
+                                priority:[KRHttpRequestScheduler priorityFromValue:param[@"priority"]]
+                              identifier:[self p_schedulerIdentifierWithRequestId:param[@"requestId"]]
+                                  pageId:[self p_pageId]
                            responseBlock:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
         int success = data && error == nil ? 1 : 0;
         NSString * errorMsg = (error ? [error localizedDescription] : @"") ?: @"";
@@ -107,4 +193,79 @@
     }];
 }
 
+/*
+ * 取消请求（参数为发起请求时的requestId），call by kotlin
+ */
+- (void)cancelHttpRequest:(NSDictionary *)args {
+    NSString *identifier = [self p_schedulerIdentifierWithRequestId:args[KR_PARAM_KEY]];
+    if (identifier) {
+        [KRHttpRequestTool cancelRequestWithIdentifier:identifier];
+    }
+}
+
+/*
+ * 预连接页面将访问的host（参数为{"urls": [url或host]}），call by kotlin
+ */
+- (void)warmUpHosts:(NSDictionary *)args {
+    NSDictionary *param = [args[KR_PARAM_KEY] hr_stringToDictionary];
+    [[KRHttpSessionPool sharedPool] warmUpWithURLs:param[@"urls"]];
+}
+
+#pragma mark - private
+
+/*
+ * 流式回调，均为定长数组[event, resInfo, bytes]，依次为：
+ * ["response", {"statusCode"}, headers] -> ["data", "", 分片]... -> ["end", {"success", "statusCode", "errorMsg"}, 空NSData]
+ * 每个事件都携带NSData，保证跨桥时按数组原样透传
+ */
+- (void)p_streamRequestWithMethod:(NSString *)method
+                              url:(NSString *)url
+                            param:(NSDictionary *)param
+                          headers:(NSDictionary *)headers
+                          timeout:(NSInteger)timeout
+                           cookie:(NSString *)cookie
+                         priority:(KRHttpRequestPriority)priority
+                        requestId:(id)requestId
+                         callback:(KuiklyRenderCallback)callback {
+    [KRHttpRequestTool streamRequestWithMethod:method
+                                           url:url
+                                         param:param
+                                    binaryData:nil
+                                       headers:headers
+                                       timeout:timeout
+                                        cookie:cookie
+                                      priority:priority
+                                    identifier:[self p_schedulerIdentifierWithRequestId:requestId]
+                                        pageId:[self p_pageId]
+                                    eventBlock:^(NSURLResponse * _Nullable response, NSData * _Nullable chunk, BOOL finished, NSError * _Nullable error) {
+        if (!callback) {
+            return;
+        }
+        if (finished) {
+            callback(@[@"end", KRNetworkResInfo(response, error, error == nil), [NSData data]]);
+        } else if (chunk) {
+            callback(@[@"data", @"", chunk]);
+        } else {
+            NSDictionary *resInfo = @{ kKRNetworkStatusCodeKey: @(KRNetworkStatusCode(response, nil, YES)) };
+            callback(@[@"response", [resInfo hr_dictionaryToString], KRNetworkEncodeHeaders(response)]);
+        }
+    }];
+}
+
+/// 请求耗时按页面统计
+- (NSString *)p_pageId {
+    return [KRHttpSessionPool pageIdForOwner:self.hr_rootView];
+}
+
+/// requestId只在页面内唯一，加上模块实例前缀避免不同页面冲突
+- (NSString *)p_schedulerIdentifierWithRequestId:(id)requestId {
+    if ([requestId isKindOfClass:[NSNumber class]]) {
+        requestId = [requestId stringValue];
+    }
+    if (![requestId isKindOfClass:[NSString class]] || ![requestId length]) {
+        return nil;
+    }
+    return [NSString stringWithFormat:@"%p_%@", self, requestId];
+}
+
 @end
@@ -27,6 +27,20 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (UIImage *)snapshotPagerWithSnapshotKey:(NSString *)snapshotKey;
 
+/*
+ * @brief 在后台映射快照文件并逐页预读，使文件页驻留在系统页缓存中，随后snapshotPagerWithSnapshotKey:同步获取时少读盘
+ * 只影响读盘耗时，不影响同步获取的结果，可在页面view加载前调用
+ * @param snapshotKey 同kotlin侧设置snapshotPager方法传入的key
+ */
++ (void)prefaultSnapshotWithSnapshotKey:(NSString *)snapshotKey;
+
+/*
+ * @brief 快照各阶段耗时统计，单位毫秒
+ * @return {"captureCount", "lastCapture", "avgCapture", "encodeCount", "lastEncode", "avgEncode",
+ *          "loadCount", "lastLoad", "avgLoad", "lastBytes"}
+ */
++ (NSDictionary *)snapshotMetrics;
+
 @end
 
 NS_ASSUME_NONNULL_END
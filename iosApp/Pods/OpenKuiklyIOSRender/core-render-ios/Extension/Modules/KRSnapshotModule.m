@@ -16,8 +16,94 @@
 #import "KRSnapshotModule.h"
 #import "KuiklyRenderView.h"
 #import "KRComponentDefine.h"
+#import "KRLogModule.h"
+#import <QuartzCore/QuartzCore.h>
+#import <pthread.h>
+#include <fcntl.h>
+#include <sys/time.h>
+#include <unistd.h>
 #define _KRWeakSelf __weak typeof(self) weakSelf = self;
 
+/*
+ * 快照文件格式：64字节头部 + 预解码的位图像素（BGRA，预乘alpha，32位小端，即iOS显示的原生格式）
+ * 加载时内存映射文件并直接作为CGImage的数据源，无需解码；写入为顺序写，编码耗时近似于拷贝
+ */
+static const uint32_t kKRSnapshotMagic = 0x4B52534E; // "KRSN"
+static const uint32_t kKRSnapshotVersion = 1;
+/// 头部长度，保证像素数据按64字节对齐
+static const size_t kKRSnapshotHeaderSize = 64;
+/// 快照文件后缀，区别于旧版本的PNG快照
+static NSString *const kKRSnapshotFileExtension = @"krbitmap";
+/// 快照目录的文件数与字节数上限（单个全屏快照约10MB），超出时按最近使用时间淘汰
+static const NSUInteger kKRSnapshotMaxFileCount = 16;
+static const unsigned long long kKRSnapshotMaxDiskBytes = 96 * 1024 * 1024;
+/// 超过该时长的临时文件视为写入中断的残留
+static const NSTimeInterval kKRSnapshotStaleTempFileAge = 60;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytesPerRow;
+    uint32_t bitmapInfo;
+    float scale;
+} KRSnapshotHeader;
+
+/// 快照位图，capture时在主线程生成，encode时在后台写入文件后释放
+@interface KRSnapshotBitmap : NSObject
+
+@property (nonatomic, assign) void *pixels;
+@property (nonatomic, assign) size_t width;
+@property (nonatomic, assign) size_t height;
+@property (nonatomic, assign) size_t bytesPerRow;
+@property (nonatomic, assign) CGFloat scale;
+/// 截图序号，同一key的并发写入以序号大者为准
+@property (nonatomic, assign) uint64_t sequence;
+
+@end
+
+@implementation KRSnapshotBitmap
+
+- (void)dealloc {
+    free(_pixels);
+}
+
+@end
+
+/// 各阶段耗时统计
+typedef struct {
+    NSUInteger count;
+    double last;
+    double total;
+} KRSnapshotStageMetrics;
+
+static pthread_mutex_t gKRSnapshotMetricsLock = PTHREAD_MUTEX_INITIALIZER;
+static KRSnapshotStageMetrics gKRSnapshotCaptureMetrics;
+static KRSnapshotStageMetrics gKRSnapshotEncodeMetrics;
+static KRSnapshotStageMetrics gKRSnapshotLoadMetrics;
+static size_t gKRSnapshotLastBytes = 0;
+
+/// 串行化快照文件的替换与淘汰
+static pthread_mutex_t gKRSnapshotFileLock = PTHREAD_MUTEX_INITIALIZER;
+/// 各key最后写入的截图序号（持有gKRSnapshotFileLock访问）
+static NSMutableDictionary<NSString *, NSNumber *> *gKRSnapshotWrittenSequences;
+/// 截图序号，仅主线程访问
+static uint64_t gKRSnapshotSequence = 0;
+
+static void KRSnapshotRecordMetrics(KRSnapshotStageMetrics *metrics, CFTimeInterval begin) {
+    double cost = (CACurrentMediaTime() - begin) * 1000.0;
+    pthread_mutex_lock(&gKRSnapshotMetricsLock);
+    metrics->count++;
+    metrics->last = cost;
+    metrics->total += cost;
+    pthread_mutex_unlock(&gKRSnapshotMetricsLock);
+}
+
+static void KRSnapshotReleaseMappedData(void *info, const void *data, size_t size) {
+    CFRelease(info);
+}
+
 @interface KRSnapshotModule()
 
 
@@ -37,32 +123,19 @@
 
 
 - (void)snapshotRootViewIfNeedWithSnapshotKey:(NSString *)snapshotKey {
-    CGFloat beginTime = CFAbsoluteTimeGetCurrent();
+    CFTimeInterval beginTime = CACurrentMediaTime();
     UIView *snapshotView = self.hr_rootView;
-    CALayer *snapshotLayer = snapshotView.layer;
-    CGRect bounds = snapshotView.bounds;
-    UIImage *snapshotImage = [UIView kr_safeAsImageWithLayer:snapshotLayer bounds:bounds];
-    if (!snapshotImage || snapshotImage.size.width == 0) {
+    KRSnapshotBitmap *bitmap = [[self class] p_captureBitmapWithView:snapshotView];
+    if (!bitmap) {
         return ;
     }
-    CGFloat endTime = CFAbsoluteTimeGetCurrent();
-    NSLog(@"snapshot cost time:%.2lfms", (endTime - beginTime) * 1000.0);
-    dispatch_async(dispatch_get_global_queue(0, 0), ^{
-        [[self class] saveImageToDiskWithCacheKey:snapshotKey image:snapshotImage];
+    KRSnapshotRecordMetrics(&gKRSnapshotCaptureMetrics, beginTime);
+    bitmap.sequence = ++gKRSnapshotSequence;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        [[self class] p_saveBitmapToDiskWithCacheKey:snapshotKey bitmap:bitmap];
     });
 }
 
-+ (void)saveImageToDiskWithCacheKey:(NSString *)cacheKey image:(UIImage *)image {
-    NSData *imageData = UIImagePNGRepresentation(image);
-    NSString *cacheFilePath = [self generateSnapshotFilePathWithCacheKey:cacheKey];
-    NSError *error = nil;
-    [[NSFileManager defaultManager] removeItemAtPath:cacheFilePath error:&error];
-    BOOL success = [imageData writeToFile:cacheFilePath atomically:YES];
-#if DEBUG
-    assert(success);
-#endif
-}
-
 // 创建缓存目录
 + (NSString *)generateSnapshotFilePathWithCacheKey:(NSString *)cacheKey {
     NSString *cachesDir = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
@@ -78,17 +151,260 @@
 }
 
 + (UIImage *)snapshotPagerWithSnapshotKey:(NSString *)snapshotKey {
+    CFTimeInterval beginTime = CACurrentMediaTime();
     NSString *snapshotCacheFilePath = [self generateSnapshotFilePathWithCacheKey:snapshotKey];
-    if ([[NSFileManager defaultManager] fileExistsAtPath:snapshotCacheFilePath]) {
+    NSString *bitmapFilePath = [snapshotCacheFilePath stringByAppendingPathExtension:kKRSnapshotFileExtension];
+    UIImage *image = [self p_loadBitmapImageWithFilePath:bitmapFilePath];
+    if (image) {
+        // 更新修改时间，淘汰时按最近使用保留
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+            utimes(bitmapFilePath.fileSystemRepresentation, NULL);
+        });
+    } else if ([[NSFileManager defaultManager] fileExistsAtPath:snapshotCacheFilePath]) {
+        // 兼容旧版本保存的PNG快照
         NSData *imageData = [[NSData alloc] initWithContentsOfFile:snapshotCacheFilePath];
-        if (!imageData) {
-            return nil;
+        image = imageData ? [[UIImage alloc] initWithData:imageData] : nil;
+    }
+    if (image) {
+        KRSnapshotRecordMetrics(&gKRSnapshotLoadMetrics, beginTime);
+    }
+    return image;
+}
+
++ (void)prefaultSnapshotWithSnapshotKey:(NSString *)snapshotKey {
+    if (!snapshotKey) {
+        return ;
+    }
+    NSString *bitmapFilePath = [[self generateSnapshotFilePathWithCacheKey:snapshotKey] stringByAppendingPathExtension:kKRSnapshotFileExtension];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        // 逐页读取映射的文件，缺页在本线程发生，映射释放后文件页仍留在页缓存中
+        NSData *data = [NSData dataWithContentsOfFile:bitmapFilePath options:NSDataReadingMappedAlways error:nil];
+        const volatile uint8_t *bytes = (const uint8_t *)data.bytes;
+        size_t pageSize = (size_t)getpagesize();
+        uint8_t sum = 0;
+        for (size_t offset = 0; offset < data.length; offset += pageSize) {
+            sum += bytes[offset];
         }
-        return [[UIImage alloc] initWithData:imageData];
+        (void)sum;
+    });
+}
+
++ (NSDictionary *)snapshotMetrics {
+    pthread_mutex_lock(&gKRSnapshotMetricsLock);
+    KRSnapshotStageMetrics capture = gKRSnapshotCaptureMetrics;
+    KRSnapshotStageMetrics encode = gKRSnapshotEncodeMetrics;
+    KRSnapshotStageMetrics load = gKRSnapshotLoadMetrics;
+    size_t lastBytes = gKRSnapshotLastBytes;
+    pthread_mutex_unlock(&gKRSnapshotMetricsLock);
+    return @{
+        @"captureCount": @(capture.count),
+        @"lastCapture": @(capture.last),
+        @"avgCapture": @(capture.count ? capture.total / capture.count : 0),
+        @"encodeCount": @(encode.count),
+        @"lastEncode": @(encode.last),
+        @"avgEncode": @(encode.count ? encode.total / encode.count : 0),
+        @"loadCount": @(load.count),
+        @"lastLoad": @(load.last),
+        @"avgLoad": @(load.count ? load.total / load.count : 0),
+        @"lastBytes": @(lastBytes),
+    };
+}
+
+#pragma mark - private
+
+/// 以屏幕scale将view绘制到原生格式的位图中（主线程）
++ (KRSnapshotBitmap *)p_captureBitmapWithView:(UIView *)view {
+    CGRect bounds = view.bounds;
+    CGFloat scale = view.window.screen.scale ?: [UIScreen mainScreen].scale;
+    size_t width = (size_t)ceil(CGRectGetWidth(bounds) * scale);
+    size_t height = (size_t)ceil(CGRectGetHeight(bounds) * scale);
+    if (width == 0 || height == 0) {
+        return nil;
+    }
+    size_t bytesPerRow = (width * 4 + 63) & ~(size_t)63;
+    void *pixels = calloc(height, bytesPerRow);
+    if (!pixels) {
+        return nil;
+    }
+    KRSnapshotBitmap *bitmap = [[KRSnapshotBitmap alloc] init];
+    bitmap.pixels = pixels;
+    bitmap.width = width;
+    bitmap.height = height;
+    bitmap.bytesPerRow = bytesPerRow;
+    bitmap.scale = scale;
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(pixels, width, height, 8, bytesPerRow, colorSpace,
+                                                 kCGBitmapByteOrder32Little | kCGImageAlphaPremultipliedFirst);
+    CGColorSpaceRelease(colorSpace);
+    if (!context) {
+        return nil;
+    }
+    // 转为UIKit坐标系
+    CGContextTranslateCTM(context, 0, height);
+    CGContextScaleCTM(context, scale, -scale);
+    CGContextTranslateCTM(context, -CGRectGetMinX(bounds), -CGRectGetMinY(bounds));
+    UIGraphicsPushContext(context);
+    // 在window上时使用系统快照绘制，复杂层级下比renderInContext快
+    BOOL drawn = view.window && [view drawViewHierarchyInRect:bounds afterScreenUpdates:NO];
+    if (!drawn) {
+        [view.layer renderInContext:context];
+    }
+    UIGraphicsPopContext();
+    CGContextRelease(context);
+    return bitmap;
+}
+
+/// 写入临时文件后原子替换，避免先删除导致加载到空快照（后台线程）
++ (void)p_saveBitmapToDiskWithCacheKey:(NSString *)cacheKey bitmap:(KRSnapshotBitmap *)bitmap {
+    CFTimeInterval beginTime = CACurrentMediaTime();
+    NSString *filePath = [[self generateSnapshotFilePathWithCacheKey:cacheKey] stringByAppendingPathExtension:kKRSnapshotFileExtension];
+    NSString *tempPath = [filePath stringByAppendingFormat:@".%@.tmp", [NSUUID UUID].UUIDString];
+    uint8_t header[kKRSnapshotHeaderSize] = {0};
+    KRSnapshotHeader info = {
+        kKRSnapshotMagic, kKRSnapshotVersion, (uint32_t)bitmap.width, (uint32_t)bitmap.height,
+        (uint32_t)bitmap.bytesPerRow, kCGBitmapByteOrder32Little | kCGImageAlphaPremultipliedFirst, (float)bitmap.scale,
+    };
+    memcpy(header, &info, sizeof(info));
+    size_t pixelBytes = bitmap.bytesPerRow * bitmap.height;
+
+    BOOL success = NO;
+    BOOL stale = NO;
+    int fd = open(tempPath.fileSystemRepresentation, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        success = write(fd, header, sizeof(header)) == (ssize_t)sizeof(header)
+            && write(fd, bitmap.pixels, pixelBytes) == (ssize_t)pixelBytes;
+        close(fd);
+        if (success) {
+            pthread_mutex_lock(&gKRSnapshotFileLock);
+            if (!gKRSnapshotWrittenSequences) {
+                gKRSnapshotWrittenSequences = [NSMutableDictionary new];
+            }
+            // 同一key先截的图可能后写完，不能覆盖更新的快照
+            stale = bitmap.sequence < [gKRSnapshotWrittenSequences[cacheKey] unsignedLongLongValue];
+            if (!stale) {
+                success = rename(tempPath.fileSystemRepresentation, filePath.fileSystemRepresentation) == 0;
+                if (success) {
+                    gKRSnapshotWrittenSequences[cacheKey] = @(bitmap.sequence);
+                    [self p_evictSnapshotFilesExceptPath:filePath];
+                }
+            }
+            pthread_mutex_unlock(&gKRSnapshotFileLock);
+        }
+        if (!success || stale) {
+            unlink(tempPath.fileSystemRepresentation);
+        }
+    }
+    if (stale) {
+        return ;
+    }
+    if (!success) {
+        [KRLogModule logError:[NSString stringWithFormat:@"save snapshot failed: %@ errno:%d", cacheKey, errno]];
+        return ;
+    }
+    // 旧版本的PNG快照已无用
+    [[NSFileManager defaultManager] removeItemAtPath:[self generateSnapshotFilePathWithCacheKey:cacheKey] error:nil];
+    KRSnapshotRecordMetrics(&gKRSnapshotEncodeMetrics, beginTime);
+    pthread_mutex_lock(&gKRSnapshotMetricsLock);
+    gKRSnapshotLastBytes = sizeof(header) + pixelBytes;
+    pthread_mutex_unlock(&gKRSnapshotMetricsLock);
+}
+
+/// 快照目录超出文件数或字节数上限时，从最久未使用的快照开始删除，并清理残留的临时文件（持有gKRSnapshotFileLock调用）
++ (void)p_evictSnapshotFilesExceptPath:(NSString *)keepPath {
+    NSString *directory = [keepPath stringByDeletingLastPathComponent];
+    NSURL *directoryURL = [NSURL fileURLWithPath:directory isDirectory:YES];
+    NSArray<NSURLResourceKey> *keys = @[ NSURLIsRegularFileKey, NSURLContentModificationDateKey, NSURLFileSizeKey ];
+    NSArray<NSURL *> *fileURLs = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:directoryURL
+                                                               includingPropertiesForKeys:keys
+                                                                                  options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                                    error:nil];
+    NSMutableArray<NSDictionary<NSURLResourceKey, id> *> *snapshots = [NSMutableArray arrayWithCapacity:fileURLs.count];
+    NSMutableArray<NSURL *> *snapshotURLs = [NSMutableArray arrayWithCapacity:fileURLs.count];
+    for (NSURL *fileURL in fileURLs) {
+        NSDictionary<NSURLResourceKey, id> *values = [fileURL resourceValuesForKeys:keys error:nil];
+        if (![values[NSURLIsRegularFileKey] boolValue]) {
+            continue;
+        }
+        if ([fileURL.pathExtension isEqualToString:@"tmp"]) {
+            // 正在写入的临时文件不计入，只删除长时间未完成的
+            if (-[values[NSURLContentModificationDateKey] timeIntervalSinceNow] > kKRSnapshotStaleTempFileAge) {
+                unlink(fileURL.fileSystemRepresentation);
+            }
+            continue;
+        }
+        [snapshots addObject:values];
+        [snapshotURLs addObject:fileURL];
+    }
+    if (snapshots.count <= kKRSnapshotMaxFileCount) {
+        unsigned long long totalBytes = 0;
+        for (NSDictionary<NSURLResourceKey, id> *values in snapshots) {
+            totalBytes += [values[NSURLFileSizeKey] unsignedLongLongValue];
+        }
+        if (totalBytes <= kKRSnapshotMaxDiskBytes) {
+            return;
+        }
+    }
+    // 按修改时间从新到旧保留，加载时会更新修改时间
+    NSMutableArray<NSNumber *> *order = [NSMutableArray arrayWithCapacity:snapshots.count];
+    for (NSUInteger i = 0; i < snapshots.count; i++) {
+        [order addObject:@(i)];
+    }
+    [order sortUsingComparator:^NSComparisonResult(NSNumber *index1, NSNumber *index2) {
+        NSDate *date1 = snapshots[index1.unsignedIntegerValue][NSURLContentModificationDateKey];
+        NSDate *date2 = snapshots[index2.unsignedIntegerValue][NSURLContentModificationDateKey];
+        return [date2 compare:date1];
+    }];
+    NSString *keepFileName = keepPath.lastPathComponent;
+    unsigned long long keptBytes = 0;
+    NSUInteger keptCount = 0;
+    for (NSNumber *index in order) {
+        NSURL *fileURL = snapshotURLs[index.unsignedIntegerValue];
+        unsigned long long fileBytes = [snapshots[index.unsignedIntegerValue][NSURLFileSizeKey] unsignedLongLongValue];
+        BOOL keep = [fileURL.lastPathComponent isEqualToString:keepFileName]
+            || (keptCount < kKRSnapshotMaxFileCount && keptBytes + fileBytes <= kKRSnapshotMaxDiskBytes);
+        if (keep) {
+            keptCount++;
+            keptBytes += fileBytes;
+        } else {
+            unlink(fileURL.fileSystemRepresentation);
+        }
+    }
+}
+
+/// 内存映射快照文件并直接包装为CGImage，不做解码与拷贝
++ (UIImage *)p_loadBitmapImageWithFilePath:(NSString *)filePath {
+    NSData *data = [NSData dataWithContentsOfFile:filePath options:NSDataReadingMappedAlways error:nil];
+    if (data.length < kKRSnapshotHeaderSize) {
+        return nil;
+    }
+    KRSnapshotHeader header;
+    memcpy(&header, data.bytes, sizeof(header));
+    if (header.magic != kKRSnapshotMagic || header.version != kKRSnapshotVersion || header.width == 0 || header.height == 0
+        || header.bytesPerRow < header.width * 4 || header.scale <= 0
+        || data.length < kKRSnapshotHeaderSize + (size_t)header.bytesPerRow * header.height) {
+        return nil;
+    }
+    size_t pixelBytes = (size_t)header.bytesPerRow * header.height;
+    // 由CGImage持有映射的文件数据，随图片释放
+    void *info = (void *)CFBridgingRetain(data);
+    CGDataProviderRef provider = CGDataProviderCreateWithData(info, (const uint8_t *)data.bytes + kKRSnapshotHeaderSize,
+                                                              pixelBytes, KRSnapshotReleaseMappedData);
+    if (!provider) {
+        CFRelease(info);
+        return nil;
+    }
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGImageRef imageRef = CGImageCreate(header.width, header.height, 8, 32, header.bytesPerRow, colorSpace,
+                                        (CGBitmapInfo)header.bitmapInfo, provider, NULL, false, kCGRenderingIntentDefault);
+    CGColorSpaceRelease(colorSpace);
+    CGDataProviderRelease(provider);
+    if (!imageRef) {
+        return nil;
     }
-   
-    return nil;
-  
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:header.scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+    return image;
 }
 
 @end
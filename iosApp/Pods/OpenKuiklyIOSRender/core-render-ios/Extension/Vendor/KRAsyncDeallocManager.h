@@ -13,17 +13,31 @@
  * limitations under the License.
  */
 
+
 #import <Foundation/Foundation.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
+/*
+ * 异步释放对象，避免大批对象在主线程集中析构
+ * 任意线程投递的对象经无锁队列交给专用的低优先级线程，每次唤醒只释放有限数量/时长的一批；
+ * UIView、CALayer须在主线程析构，改为在主线程分多个runloop分批释放。
+ */
 @interface KRAsyncDeallocManager : NSObject
 
 
 + (instancetype)shareManager;
 
+/*
+ * 投递待释放对象，调用方需放弃自身对该对象的引用，可在任意线程调用
+ */
 - (void)asyncDeallocWithObject:(id _Nullable)deallocObject;
 
+/*
+ * 释放队列统计：{"depth", "maxDepth", "freedCount", "avgLatency", "maxLatency", "sliceCount", "maxSliceCost"}
+ * 耗时单位为毫秒，latency为对象从投递到释放的时长
+ */
+- (NSDictionary *)statistics;
 
 @end
 
@@ -13,19 +13,55 @@
  * limitations under the License.
  */
 
-#import "KRAsyncDeallocManager.h"
 
-@interface KRAsyncDeallocManager()
+#import "KRAsyncDeallocManager.h"
+#import <UIKit/UIKit.h>
+#import <QuartzCore/QuartzCore.h>
+#import <stdatomic.h>
 
-@property (nullable, nonatomic, strong) NSMutableArray * deallocObjects;
+/// 首次投递后延迟释放的时长，避开页面退出时主线程的集中工作
+static const NSTimeInterval kKRAsyncDeallocDelay = 0.5;
+/// 后台线程每次唤醒最多释放的对象个数
+static const NSUInteger kKRAsyncDeallocSliceCount = 512;
+/// 后台线程每次唤醒的释放时长上限（秒）
+static const CFTimeInterval kKRAsyncDeallocSliceBudget = 0.004;
+/// 主线程每个runloop最多释放的对象个数
+static const NSUInteger kKRAsyncDeallocMainSliceCount = 200;
 
-@property (nonatomic, assign) BOOL _setNeedDeallocObjects;
+/// 无锁队列节点
+typedef struct KRAsyncDeallocNode {
+    void *object; // 以CFBridgingRetain持有
+    CFTimeInterval enqueueTime;
+    struct KRAsyncDeallocNode *next;
+} KRAsyncDeallocNode;
 
+@interface KRAsyncDeallocManager()
 
+/// 待在主线程释放的对象（仅主线程访问）
+@property (nonatomic, strong) NSMutableArray *mainDeallocObjects;
+/// 主线程释放是否已调度（仅主线程访问）
+@property (nonatomic, assign) BOOL setNeedMainDealloc;
 
 @end
 
-@implementation KRAsyncDeallocManager
+@implementation KRAsyncDeallocManager {
+    dispatch_queue_t _deallocQueue;
+    /// 多生产者单消费者的无锁栈，消费者整体取出后逆序得到投递顺序
+    _Atomic(KRAsyncDeallocNode *) _head;
+    atomic_bool _drainScheduled;
+    /// 已取出待释放的节点（仅释放线程访问）
+    KRAsyncDeallocNode *_pendingHead;
+    KRAsyncDeallocNode *_pendingTail;
+    // 统计
+    atomic_long _depth;
+    atomic_long _maxDepth;
+    atomic_llong _freedCount;
+    atomic_llong _latencySampleCount; // 只统计后台释放的对象
+    atomic_llong _totalLatencyUs;
+    atomic_llong _maxLatencyUs;
+    atomic_llong _sliceCount;
+    atomic_llong _maxSliceCostUs;
+}
 
 + (instancetype)shareManager{
     static KRAsyncDeallocManager * instance = nil;
@@ -40,46 +76,184 @@
 {
     self = [super init];
     if (self) {
-        _deallocObjects = [NSMutableArray new];
+        _mainDeallocObjects = [NSMutableArray new];
+        dispatch_queue_attr_t attr = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0);
+        _deallocQueue = dispatch_queue_create("com.tencent.kuikly.dealloc", attr);
+        atomic_init(&_head, NULL);
+        atomic_init(&_drainScheduled, false);
     }
     return self;
 }
 
 - (void)asyncDeallocWithObject:(id)deallocObject{
-    [self _asyncDeallocOnDefaultGlobalQueueWithObject:deallocObject];
+    if (deallocObject == nil) {
+        return ;
+    }
+    if ([deallocObject isKindOfClass:[UIView class]] || [deallocObject isKindOfClass:[CALayer class]]) {
+        [self p_deallocOnMainQueueWithObject:deallocObject];
+        return ;
+    }
+    KRAsyncDeallocNode *node = malloc(sizeof(KRAsyncDeallocNode));
+    if (!node) {
+        return ; // 分配失败时由调用方的引用正常释放
+    }
+    node->object = (void *)CFBridgingRetain(deallocObject);
+    node->enqueueTime = CACurrentMediaTime();
+    KRAsyncDeallocNode *head = atomic_load_explicit(&_head, memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (!atomic_compare_exchange_weak(&_head, &head, node));
+    [self p_depthDidIncrease];
+    // 仅空闲后的首次投递延迟唤醒；释放线程忙碌时由其在本轮结束后继续取出
+    if (!atomic_exchange(&_drainScheduled, true)) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kKRAsyncDeallocDelay * NSEC_PER_SEC)), _deallocQueue, ^{
+            [self p_drain];
+        });
+    }
 }
 
+- (NSDictionary *)statistics {
+    long long latencySampleCount = atomic_load(&_latencySampleCount);
+    long long totalLatencyUs = atomic_load(&_totalLatencyUs);
+    return @{
+        @"depth": @(atomic_load(&_depth)),
+        @"maxDepth": @(atomic_load(&_maxDepth)),
+        @"freedCount": @(atomic_load(&_freedCount)),
+        @"avgLatency": @(latencySampleCount > 0 ? totalLatencyUs / 1000.0 / latencySampleCount : 0),
+        @"maxLatency": @(atomic_load(&_maxLatencyUs) / 1000.0),
+        @"sliceCount": @(atomic_load(&_sliceCount)),
+        @"maxSliceCost": @(atomic_load(&_maxSliceCostUs) / 1000.0),
+    };
+}
 
 #pragma mark - private
 
-- (void)_asyncDeallocOnDefaultGlobalQueueWithObject:(id)deallocObject{
-    if (deallocObject == nil) {
-        return ;
+/// 在释放线程上释放一批对象，未释放完则让出线程后继续
+- (void)p_drain {
+    // 取出已投递的节点，逆序后追加到待释放链表尾部
+    KRAsyncDeallocNode *node = atomic_exchange(&_head, NULL);
+    KRAsyncDeallocNode *reversed = NULL;
+    KRAsyncDeallocNode *reversedTail = node;
+    while (node) {
+        KRAsyncDeallocNode *next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
     }
-    if ([NSThread isMainThread]) {
-        [_deallocObjects addObject:deallocObject];
-        if (__setNeedDeallocObjects == NO) {
-            __setNeedDeallocObjects = YES;
-            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.5 * NSEC_PER_SEC)),dispatch_get_main_queue(), ^{
-                NSMutableArray * objects = self.deallocObjects;
-                self.deallocObjects = [NSMutableArray new];
-                self._setNeedDeallocObjects = NO;
-                dispatch_async(dispatch_get_global_queue(0, 0), ^{
-                    [objects removeAllObjects];
-                });
-            });
+    if (reversed) {
+        if (_pendingTail) {
+            _pendingTail->next = reversed;
+        } else {
+            _pendingHead = reversed;
         }
-    }else {
-        dispatch_async(dispatch_get_main_queue(), ^{
-            [self _asyncDeallocOnDefaultGlobalQueueWithObject:deallocObject];
+        _pendingTail = reversedTail;
+    }
+    if (!_pendingHead) {
+        [self p_finishDrain];
+        return;
+    }
+
+    CFTimeInterval begin = CACurrentMediaTime();
+    NSUInteger freed = 0;
+    long long latencyUs = 0;
+    long long maxLatencyUs = 0;
+    @autoreleasepool {
+        while (_pendingHead && freed < kKRAsyncDeallocSliceCount) {
+            node = _pendingHead;
+            _pendingHead = node->next;
+            long long nodeLatencyUs = (long long)((CACurrentMediaTime() - node->enqueueTime) * 1000000);
+            latencyUs += nodeLatencyUs;
+            maxLatencyUs = MAX(maxLatencyUs, nodeLatencyUs);
+            CFRelease(node->object);
+            free(node);
+            freed++;
+            // 每释放一小组检查一次时长，避免频繁取时间
+            if ((freed & 31) == 0 && CACurrentMediaTime() - begin > kKRAsyncDeallocSliceBudget) {
+                break;
+            }
+        }
+    }
+    if (!_pendingHead) {
+        _pendingTail = NULL;
+    }
+    atomic_fetch_add(&_latencySampleCount, (long long)freed);
+    [self p_recordSliceWithFreedCount:freed latencyUs:latencyUs maxLatencyUs:maxLatencyUs
+                               costUs:(long long)((CACurrentMediaTime() - begin) * 1000000)];
+
+    if (_pendingHead) {
+        dispatch_async(_deallocQueue, ^{
+            [self p_drain];
         });
+    } else {
+        [self p_finishDrain];
     }
 }
 
+/// 待释放链表已清空，回到空闲状态；期间有新投递时立即继续，不再延迟
+- (void)p_finishDrain {
+    atomic_store(&_drainScheduled, false);
+    // 与投递方的入栈、置位均为顺序一致的原子操作：投递方若看到仍在调度中而未唤醒，这里必然能看到其节点
+    if (atomic_load(&_head) && !atomic_exchange(&_drainScheduled, true)) {
+        dispatch_async(_deallocQueue, ^{
+            [self p_drain];
+        });
+    }
+}
 
+/// UIView、CALayer在主线程分批释放
+- (void)p_deallocOnMainQueueWithObject:(id)deallocObject {
+    if (![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self p_deallocOnMainQueueWithObject:deallocObject];
+        });
+        return ;
+    }
+    [_mainDeallocObjects addObject:deallocObject];
+    [self p_depthDidIncrease];
+    if (!_setNeedMainDealloc) {
+        _setNeedMainDealloc = YES;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kKRAsyncDeallocDelay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            [self p_drainMainQueue];
+        });
+    }
+}
 
+- (void)p_drainMainQueue {
+    CFTimeInterval begin = CACurrentMediaTime();
+    NSUInteger count = MIN(_mainDeallocObjects.count, kKRAsyncDeallocMainSliceCount);
+    @autoreleasepool {
+        [_mainDeallocObjects removeObjectsInRange:NSMakeRange(0, count)];
+    }
+    [self p_recordSliceWithFreedCount:count latencyUs:0 maxLatencyUs:0
+                               costUs:(long long)((CACurrentMediaTime() - begin) * 1000000)];
+    if (_mainDeallocObjects.count) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self p_drainMainQueue];
+        });
+    } else {
+        _setNeedMainDealloc = NO;
+    }
+}
 
-#pragma mark - getter
+- (void)p_depthDidIncrease {
+    long depth = atomic_fetch_add(&_depth, 1) + 1;
+    long maxDepth = atomic_load_explicit(&_maxDepth, memory_order_relaxed);
+    while (depth > maxDepth && !atomic_compare_exchange_weak(&_maxDepth, &maxDepth, depth)) {
+    }
+}
 
+- (void)p_recordSliceWithFreedCount:(NSUInteger)freedCount latencyUs:(long long)latencyUs
+                       maxLatencyUs:(long long)maxLatencyUs costUs:(long long)costUs {
+    atomic_fetch_sub(&_depth, (long)freedCount);
+    atomic_fetch_add(&_freedCount, (long long)freedCount);
+    atomic_fetch_add(&_totalLatencyUs, latencyUs);
+    atomic_fetch_add(&_sliceCount, 1);
+    long long currentMax = atomic_load_explicit(&_maxLatencyUs, memory_order_relaxed);
+    while (maxLatencyUs > currentMax && !atomic_compare_exchange_weak(&_maxLatencyUs, &currentMax, maxLatencyUs)) {
+    }
+    long long currentSliceMax = atomic_load_explicit(&_maxSliceCostUs, memory_order_relaxed);
+    while (costUs > currentSliceMax && !atomic_compare_exchange_weak(&_maxSliceCostUs, &currentSliceMax, costUs)) {
+    }
+}
 
 @end
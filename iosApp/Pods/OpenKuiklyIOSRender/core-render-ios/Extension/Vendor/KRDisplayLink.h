@@ -19,8 +19,14 @@
 
 typedef void (^DisplayLinkCallback)(CFTimeInterval timestamp);
 
+/*
+ * 屏幕刷新回调，由共享的KRFrameClock驱动
+ */
 @interface KRDisplayLink : NSObject
 
+/// 分频系数，每frameInterval帧回调一次，默认为1
+@property (nonatomic, assign) NSUInteger frameInterval;
+
 - (void)startWithCallback:(DisplayLinkCallback)callback;
 - (void)stop;
 - (void)pause:(BOOL)pause;
@@ -15,64 +15,40 @@
 
 // KRDisplayLink.m
 #import "KRDisplayLink.h"
+#import "KRFrameClock.h"
 
-@interface _KRDisplayLink : NSObject
+@interface KRDisplayLink ()
 
-@property (nonatomic, strong) CADisplayLink *displayLink;
-@property (nonatomic, copy) DisplayLinkCallback callback;
+@property (nonatomic, strong) KRFrameSubscription *subscription;
 
 @end
 
-@implementation _KRDisplayLink
+@implementation KRDisplayLink
 
-- (void)updateDisplay {
-    if (self.callback) {
-        self.callback(self.displayLink.timestamp);
+- (instancetype)init {
+    if (self = [super init]) {
+        _frameInterval = 1;
     }
+    return self;
 }
 
-- (void)startWithCallback:(DisplayLinkCallback)callback {
-    [self stop];
-    self.callback = callback;
-    self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(updateDisplay)];
-    [self.displayLink addToRunLoop:NSRunLoop.mainRunLoop forMode:NSRunLoopCommonModes];
+- (void)setFrameInterval:(NSUInteger)frameInterval {
+    _frameInterval = MAX(frameInterval, 1);
+    self.subscription.frameInterval = _frameInterval;
 }
 
-- (void)pause:(BOOL)pause {
-    self.displayLink.paused = pause;
-}
-
-- (void)stop {
-    [self.displayLink invalidate];
-    self.displayLink = nil;
-    self.callback = nil;
-}
-
-@end
-
-
-@interface KRDisplayLink ()
-
-@property (nonatomic, strong) _KRDisplayLink *displayLink;
-
-@end
-
-@implementation KRDisplayLink
-
-
 - (void)startWithCallback:(DisplayLinkCallback)callback {
     [self stop];
-    self.displayLink = [[_KRDisplayLink alloc] init];
-    [self.displayLink startWithCallback:callback];
+    self.subscription = [[KRFrameClock sharedClock] subscribeWithFrameInterval:_frameInterval callback:callback];
 }
 
 - (void)pause:(BOOL)pause {
-    [self.displayLink pause:pause];
+    self.subscription.paused = pause;
 }
 
 - (void)stop {
-    [self.displayLink stop];
-    self.displayLink = nil;
+    [self.subscription invalidate];
+    self.subscription = nil;
 }
 
 - (void)dealloc {
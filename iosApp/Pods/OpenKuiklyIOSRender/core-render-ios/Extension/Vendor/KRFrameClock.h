@@ -0,0 +1,64 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <UIKit/UIKit.h>
+#import <QuartzCore/QuartzCore.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef void (^KRFrameClockCallback)(CFTimeInterval timestamp);
+
+/*
+ * 帧时钟的订阅者，由KRFrameClock创建，需在主线程访问
+ */
+@interface KRFrameSubscription : NSObject
+
+/// 分频系数，每frameInterval帧回调一次，最小为1
+@property (nonatomic, assign) NSUInteger frameInterval;
+/// 是否暂停回调
+@property (nonatomic, assign, getter=isPaused) BOOL paused;
+/// 是否已取消订阅
+@property (nonatomic, assign, readonly, getter=isInvalidated) BOOL invalidated;
+
+/*
+ * 取消订阅
+ */
+- (void)invalidate;
+
+@end
+
+/*
+ * 进程内共享的帧时钟（主线程）
+ * 以一个CADisplayLink驱动所有订阅者，无活跃订阅者时暂停。
+ * 每帧的回调在一次Context线程批量派发中完成（见KuiklyRenderThreadManager beginContextQueueBatch）。
+ */
+@interface KRFrameClock : NSObject
+
++ (instancetype)sharedClock;
+
+/*
+ * 添加订阅者
+ * @param frameInterval 分频系数，每frameInterval帧回调一次
+ * @param callback 帧回调，参数为当前帧的时间戳
+ */
+- (KRFrameSubscription *)subscribeWithFrameInterval:(NSUInteger)frameInterval callback:(KRFrameClockCallback)callback;
+
+/// 当前订阅者个数（含暂停的订阅者）
+@property (nonatomic, assign, readonly) NSUInteger subscriberCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,185 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "KRFrameClock.h"
+#import "KuiklyRenderThreadManager.h"
+
+@interface KRFrameClock ()
+
+- (void)p_subscriptionStateDidChange;
+- (void)p_onFrame:(CADisplayLink *)displayLink;
+
+@end
+
+@interface KRFrameSubscription ()
+
+@property (nonatomic, weak) KRFrameClock *clock;
+@property (nonatomic, copy, nullable) KRFrameClockCallback callback;
+/// 订阅时的帧序号，分频以此为起点
+@property (nonatomic, assign) uint64_t startFrame;
+
+@end
+
+@implementation KRFrameSubscription
+
+- (void)setFrameInterval:(NSUInteger)frameInterval {
+    _frameInterval = MAX(frameInterval, 1);
+}
+
+- (void)setPaused:(BOOL)paused {
+    if (_paused != paused) {
+        _paused = paused;
+        [_clock p_subscriptionStateDidChange];
+    }
+}
+
+- (void)invalidate {
+    if (_invalidated) {
+        return;
+    }
+    _invalidated = YES;
+    _callback = nil;
+    [_clock p_subscriptionStateDidChange];
+}
+
+@end
+
+/// CADisplayLink强持有target，以弱引用代理避免循环引用
+@interface _KRFrameClockProxy : NSObject
+
+@property (nonatomic, weak) KRFrameClock *clock;
+
+@end
+
+@implementation KRFrameClock {
+    CADisplayLink *_displayLink;
+    NSMutableArray<KRFrameSubscription *> *_subscriptions;
+    uint64_t _frameIndex;
+    /// 正在分发帧回调，此时只记录订阅状态变化，分发结束后再处理
+    BOOL _dispatching;
+    BOOL _stateChangedWhileDispatching;
+}
+
++ (instancetype)sharedClock {
+    static KRFrameClock *clock = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        clock = [[KRFrameClock alloc] init];
+    });
+    return clock;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _subscriptions = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (NSUInteger)subscriberCount {
+    NSUInteger count = 0;
+    for (KRFrameSubscription *subscription in _subscriptions) {
+        count += subscription.invalidated ? 0 : 1;
+    }
+    return count;
+}
+
+- (KRFrameSubscription *)subscribeWithFrameInterval:(NSUInteger)frameInterval callback:(KRFrameClockCallback)callback {
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    KRFrameSubscription *subscription = [[KRFrameSubscription alloc] init];
+    subscription.clock = self;
+    subscription.callback = callback;
+    subscription.frameInterval = frameInterval;
+    subscription.startFrame = _frameIndex;
+    [_subscriptions addObject:subscription];
+    [self p_subscriptionStateDidChange];
+    return subscription;
+}
+
+#pragma mark - private
+
+- (void)p_subscriptionStateDidChange {
+    if (_dispatching) {
+        _stateChangedWhileDispatching = YES;
+        return;
+    }
+    [self p_removeInvalidatedSubscriptions];
+    BOOL active = NO;
+    for (KRFrameSubscription *subscription in _subscriptions) {
+        if (!subscription.paused) {
+            active = YES;
+            break;
+        }
+    }
+    if (!_subscriptions.count) {
+        [_displayLink invalidate];
+        _displayLink = nil;
+    } else if (active && !_displayLink) {
+        _KRFrameClockProxy *proxy = [[_KRFrameClockProxy alloc] init];
+        proxy.clock = self;
+        _displayLink = [CADisplayLink displayLinkWithTarget:proxy selector:@selector(onFrame:)];
+        [_displayLink addToRunLoop:NSRunLoop.mainRunLoop forMode:NSRunLoopCommonModes];
+    } else {
+        _displayLink.paused = !active;
+    }
+}
+
+- (void)p_removeInvalidatedSubscriptions {
+    NSIndexSet *indexes = [_subscriptions indexesOfObjectsPassingTest:^BOOL(KRFrameSubscription * _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
+        return obj.invalidated;
+    }];
+    if (indexes.count) {
+        [_subscriptions removeObjectsAtIndexes:indexes];
+    }
+}
+
+- (void)p_onFrame:(CADisplayLink *)displayLink {
+    uint64_t frameIndex = ++_frameIndex;
+    CFTimeInterval timestamp = displayLink.timestamp;
+    _dispatching = YES;
+    [KuiklyRenderThreadManager beginContextQueueBatch];
+    // 回调中新增的订阅者从下一帧开始回调
+    NSUInteger count = _subscriptions.count;
+    for (NSUInteger i = 0; i < count; i++) {
+        KRFrameSubscription *subscription = _subscriptions[i];
+        if (subscription.paused || subscription.invalidated) {
+            continue;
+        }
+        if ((frameIndex - subscription.startFrame) % subscription.frameInterval != 0) {
+            continue;
+        }
+        KRFrameClockCallback callback = subscription.callback;
+        if (callback) {
+            callback(timestamp);
+        }
+    }
+    [KuiklyRenderThreadManager commitContextQueueBatch];
+    _dispatching = NO;
+    if (_stateChangedWhileDispatching) {
+        _stateChangedWhileDispatching = NO;
+        [self p_subscriptionStateDidChange];
+    }
+}
+
+@end
+
+@implementation _KRFrameClockProxy
+
+- (void)onFrame:(CADisplayLink *)displayLink {
+    [_clock p_onFrame:displayLink];
+}
+
+@end
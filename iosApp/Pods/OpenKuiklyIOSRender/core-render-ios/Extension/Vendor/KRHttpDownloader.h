@@ -0,0 +1,63 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 下载进度（字节），total未知时为-1，在context队列回调
+typedef void (^KRHttpDownloadProgressBlock)(int64_t receivedBytes, int64_t totalBytes);
+/// 下载完成，成功时path为存储路径，在后台线程回调
+typedef void (^KRHttpDownloadCompletionBlock)(NSString * _Nullable path, NSError * _Nullable error);
+
+@interface KRHttpDownloadOptions : NSObject
+
+/// 最大并发连接数，默认4
+@property (nonatomic, assign) NSUInteger maxConnections;
+/// 每个分片的最小字节数，文件小于2个分片时单连接下载，默认1MB
+@property (nonatomic, assign) int64_t minChunkSize;
+/// 期望的文件MD5（十六进制，不区分大小写），为空时只校验长度
+@property (nonatomic, copy, nullable) NSString *expectedMD5;
+/// 单个分片失败后的重试次数，默认3
+@property (nonatomic, assign) NSUInteger maxRetryCount;
+
+@end
+
+/*
+ * 分片并行断点续传下载（用于PAG、APNG、视频等大资源）
+ * 首个请求为bytes=0-，拿到总长度后按分片补发其余Range请求，首个请求收满第一片后取消；
+ * 下载过程中分片进度写入storePath.krstate，失败或进程退出后再次下载同一storePath时带If-Range续传，
+ * 资源变化（服务端返回200或总长度不一致）时从头下载。完成后校验长度与MD5，通过后才移动到storePath。
+ * 同一storePath同时只有一个下载任务，重复调用会合并。
+ */
+@interface KRHttpDownloader : NSObject
+
++ (instancetype)sharedDownloader;
+
+/*
+ * @brief 下载到storePath
+ * @return 取消用标识
+ */
+- (NSString *)downloadWithURL:(NSString *)url
+                    storePath:(NSString *)storePath
+                      options:(nullable KRHttpDownloadOptions *)options
+                     progress:(nullable KRHttpDownloadProgressBlock)progress
+                   completion:(nullable KRHttpDownloadCompletionBlock)completion;
+/// 取消，completion以NSURLErrorCancelled回调（合并的所有调用都取消后才停止下载，已下载的分片保留用于续传）
+- (void)cancelDownloadWithIdentifier:(NSString *)identifier;
+
+@end
+
+NS_ASSUME_NONNULL_END
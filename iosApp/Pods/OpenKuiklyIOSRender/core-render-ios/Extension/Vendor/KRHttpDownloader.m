@@ -0,0 +1,723 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRHttpDownloader.h"
+#import "KRHttpSessionPool.h"
+#import "KRHttpRequestTool.h"
+#import "KRLogModule.h"
+#import "KuiklyRenderThreadManager.h"
+#import <CommonCrypto/CommonDigest.h>
+
+static NSString *const KRHttpDownloaderErrorDomain = @"KRHttpDownloaderErrorDomain";
+/// 每写入该字节数保存一次续传状态
+static const int64_t kKRHttpDownloadSaveInterval = 1024 * 1024;
+/// 进度回调最小间隔（秒）
+static const CFTimeInterval kKRHttpDownloadProgressInterval = 0.1;
+
+typedef NS_ENUM(NSInteger, KRHttpDownloaderErrorCode) {
+    KRHttpDownloaderErrorCodeFile = 1,
+    KRHttpDownloaderErrorCodeResponse = 2,
+    KRHttpDownloaderErrorCodeIntegrity = 3,
+};
+
+static NSError *KRHttpDownloaderError(KRHttpDownloaderErrorCode code, NSString *message) {
+    return [NSError errorWithDomain:KRHttpDownloaderErrorDomain code:code userInfo:@{NSLocalizedDescriptionKey: message ?: @""}];
+}
+
+/// 解析Content-Range: bytes start-end/total，格式不符返回NO（total为*时为-1）
+static BOOL KRHttpParseContentRange(NSString *contentRange, int64_t *start, int64_t *end, int64_t *total) {
+    if (![contentRange isKindOfClass:[NSString class]]) {
+        return NO;
+    }
+    long long rangeStart = 0, rangeEnd = 0, rangeTotal = -1;
+    if (sscanf(contentRange.UTF8String, "bytes %lld-%lld/%lld", &rangeStart, &rangeEnd, &rangeTotal) < 2
+        || rangeStart < 0 || rangeEnd < rangeStart) {
+        return NO;
+    }
+    *start = rangeStart;
+    *end = rangeEnd + 1;
+    *total = rangeTotal;
+    return YES;
+}
+
+@implementation KRHttpDownloadOptions
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _maxConnections = 4;
+        _minChunkSize = 1024 * 1024;
+        _maxRetryCount = 3;
+    }
+    return self;
+}
+
+@end
+
+@class KRHttpDownloadJob;
+
+/*
+ * 分片：[start, end)，end为-1表示总长度未知（首个请求拿到响应前）
+ */
+@interface KRHttpDownloadChunk : NSObject
+
+@property (nonatomic, weak) KRHttpDownloadJob *job;
+@property (nonatomic, assign) int64_t start;
+@property (nonatomic, assign) int64_t end;
+@property (nonatomic, assign) int64_t received;
+@property (nonatomic, assign) NSUInteger retryCount;
+@property (nonatomic, strong, nullable) NSURLSessionDataTask *task;
+
+- (BOOL)isFinished;
+
+@end
+
+@implementation KRHttpDownloadChunk
+
+- (BOOL)isFinished {
+    return _end >= 0 && _start + _received >= _end;
+}
+
+@end
+
+@interface KRHttpDownloadWaiter : NSObject
+
+@property (nonatomic, copy) NSString *identifier;
+@property (nonatomic, copy, nullable) KRHttpDownloadProgressBlock progress;
+@property (nonatomic, copy, nullable) KRHttpDownloadCompletionBlock completion;
+
+@end
+
+@implementation KRHttpDownloadWaiter
+
+@end
+
+@interface KRHttpDownloadJob : NSObject
+
+@property (nonatomic, copy) NSString *url;
+@property (nonatomic, copy) NSString *storePath;
+@property (nonatomic, strong) KRHttpDownloadOptions *options;
+@property (nonatomic, strong) NSMutableArray<KRHttpDownloadWaiter *> *waiters;
+@property (nonatomic, strong) NSMutableArray<KRHttpDownloadChunk *> *chunks;
+@property (nonatomic, assign) int64_t totalLength;
+/// ETag或Last-Modified，续传时作为If-Range
+@property (nonatomic, copy, nullable) NSString *validator;
+@property (nonatomic, strong, nullable) NSFileHandle *fileHandle;
+@property (nonatomic, assign) int64_t unsavedBytes;
+@property (nonatomic, assign) CFTimeInterval lastProgressTime;
+/// 已因资源变化从头下载过，避免反复重来
+@property (nonatomic, assign) BOOL restarted;
+
+- (NSString *)partPath;
+- (NSString *)statePath;
+- (int64_t)receivedLength;
+
+@end
+
+@implementation KRHttpDownloadJob
+
+- (NSString *)partPath {
+    return [_storePath stringByAppendingPathExtension:@"krpart"];
+}
+
+- (NSString *)statePath {
+    return [_storePath stringByAppendingPathExtension:@"krstate"];
+}
+
+- (int64_t)receivedLength {
+    int64_t received = 0;
+    for (KRHttpDownloadChunk *chunk in _chunks) {
+        received += chunk.received;
+    }
+    return received;
+}
+
+@end
+
+@interface KRHttpDownloader ()<NSURLSessionDataDelegate>
+
+@end
+
+/*
+ * 所有状态只在_queue（同时是任务回调的转发队列）上访问
+ */
+@implementation KRHttpDownloader {
+    dispatch_queue_t _queue;
+    NSOperationQueue *_delegateQueue;
+    NSMutableDictionary<NSString *, KRHttpDownloadJob *> *_jobsByStorePath;
+    NSMutableDictionary<NSNumber *, KRHttpDownloadChunk *> *_chunksByTask;
+}
+
++ (instancetype)sharedDownloader {
+    static KRHttpDownloader *downloader;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        downloader = [KRHttpDownloader new];
+    });
+    return downloader;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _queue = dispatch_queue_create("com.tencent.kuikly.http.download", DISPATCH_QUEUE_SERIAL);
+        _delegateQueue = [NSOperationQueue new];
+        _delegateQueue.maxConcurrentOperationCount = 1;
+        _delegateQueue.underlyingQueue = _queue;
+        _jobsByStorePath = [NSMutableDictionary new];
+        _chunksByTask = [NSMutableDictionary new];
+    }
+    return self;
+}
+
+- (NSString *)downloadWithURL:(NSString *)url
+                    storePath:(NSString *)storePath
+                      options:(KRHttpDownloadOptions *)options
+                     progress:(KRHttpDownloadProgressBlock)progress
+                   completion:(KRHttpDownloadCompletionBlock)completion {
+    KRHttpDownloadWaiter *waiter = [KRHttpDownloadWaiter new];
+    waiter.identifier = [NSUUID UUID].UUIDString;
+    waiter.progress = progress;
+    waiter.completion = completion;
+    dispatch_async(_queue, ^{
+        if (![url isKindOfClass:[NSString class]] || ![NSURL URLWithString:url] || !storePath.length) {
+            if (completion) {
+                completion(nil, KRHttpDownloaderError(KRHttpDownloaderErrorCodeResponse, @"invalid url or store path"));
+            }
+            return;
+        }
+        KRHttpDownloadJob *job = self->_jobsByStorePath[storePath];
+        if (job) {
+            [job.waiters addObject:waiter];
+            return;
+        }
+        job = [KRHttpDownloadJob new];
+        job.url = url;
+        job.storePath = storePath;
+        job.options = options ?: [KRHttpDownloadOptions new];
+        job.waiters = [NSMutableArray arrayWithObject:waiter];
+        self->_jobsByStorePath[storePath] = job;
+        [self p_startJob:job];
+    });
+    return waiter.identifier;
+}
+
+- (void)cancelDownloadWithIdentifier:(NSString *)identifier {
+    dispatch_async(_queue, ^{
+        for (KRHttpDownloadJob *job in self->_jobsByStorePath.allValues) {
+            for (KRHttpDownloadWaiter *waiter in job.waiters) {
+                if ([waiter.identifier isEqualToString:identifier]) {
+                    [job.waiters removeObjectIdenticalTo:waiter];
+                    if (!job.waiters.count) {
+                        [self p_stopJob:job];
+                    }
+                    if (waiter.completion) {
+                        waiter.completion(nil, [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]);
+                    }
+                    return;
+                }
+            }
+        }
+    });
+}
+
+#pragma mark - job
+
+- (void)p_startJob:(KRHttpDownloadJob *)job {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    [fileManager createDirectoryAtPath:[job.storePath stringByDeletingLastPathComponent]
+           withIntermediateDirectories:YES
+                            attributes:nil
+                                 error:nil];
+    if (![self p_restoreStateOfJob:job]) {
+        [fileManager removeItemAtPath:job.statePath error:nil];
+        [fileManager removeItemAtPath:job.partPath error:nil];
+        if (![fileManager createFileAtPath:job.partPath contents:nil attributes:nil]) {
+            [self p_finishJob:job error:KRHttpDownloaderError(KRHttpDownloaderErrorCodeFile, @"create part file failed")];
+            return;
+        }
+        KRHttpDownloadChunk *chunk = [KRHttpDownloadChunk new];
+        chunk.job = job;
+        chunk.end = -1;
+        job.chunks = [NSMutableArray arrayWithObject:chunk];
+        job.totalLength = -1;
+    }
+    job.fileHandle = [NSFileHandle fileHandleForWritingAtPath:job.partPath];
+    if (!job.fileHandle) {
+        [self p_finishJob:job error:KRHttpDownloaderError(KRHttpDownloaderErrorCodeFile, @"open part file failed")];
+        return;
+    }
+    if ([self p_finishJobIfCompleted:job]) {
+        return;
+    }
+    for (KRHttpDownloadChunk *chunk in job.chunks) {
+        if (!chunk.isFinished) {
+            [self p_startChunk:chunk];
+        }
+    }
+}
+
+/// 停止下载并保存续传状态
+- (void)p_stopJob:(KRHttpDownloadJob *)job {
+    [_jobsByStorePath removeObjectForKey:job.storePath];
+    for (KRHttpDownloadChunk *chunk in job.chunks) {
+        if (chunk.task) {
+            [_chunksByTask removeObjectForKey:@(chunk.task.taskIdentifier)];
+            [chunk.task cancel];
+            chunk.task = nil;
+        }
+    }
+    [self p_saveStateOfJob:job];
+    [self p_closeFileOfJob:job];
+}
+
+- (void)p_restartJob:(KRHttpDownloadJob *)job {
+    [KRLogModule logInfo:[NSString stringWithFormat:@"KRHttpDownloader resource changed, restart: %@", job.url]];
+    for (KRHttpDownloadChunk *chunk in job.chunks) {
+        if (chunk.task) {
+            [_chunksByTask removeObjectForKey:@(chunk.task.taskIdentifier)];
+            [chunk.task cancel];
+            chunk.task = nil;
+        }
+    }
+    [self p_closeFileOfJob:job];
+    [[NSFileManager defaultManager] removeItemAtPath:job.statePath error:nil];
+    job.restarted = YES;
+    job.validator = nil;
+    [self p_startJob:job];
+}
+
+- (BOOL)p_finishJobIfCompleted:(KRHttpDownloadJob *)job {
+    if (job.totalLength < 0) {
+        return NO;
+    }
+    for (KRHttpDownloadChunk *chunk in job.chunks) {
+        if (!chunk.isFinished) {
+            return NO;
+        }
+    }
+    [self p_closeFileOfJob:job];
+    NSError *error = [self p_verifyJob:job];
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    if (!error) {
+        [fileManager removeItemAtPath:job.storePath error:nil];
+        NSError *moveError = nil;
+        if (![fileManager moveItemAtPath:job.partPath toPath:job.storePath error:&moveError]) {
+            error = KRHttpDownloaderError(KRHttpDownloaderErrorCodeFile, moveError.localizedDescription);
+        }
+    }
+    if (error) {
+        // 校验失败的数据不可续传
+        [fileManager removeItemAtPath:job.partPath error:nil];
+    }
+    [fileManager removeItemAtPath:job.statePath error:nil];
+    [self p_notifyProgressOfJob:job force:YES];
+    [self p_finishJob:job error:error];
+    return YES;
+}
+
+- (void)p_finishJob:(KRHttpDownloadJob *)job error:(NSError *)error {
+    if (_jobsByStorePath[job.storePath] == job) {
+        [_jobsByStorePath removeObjectForKey:job.storePath];
+    }
+    for (KRHttpDownloadChunk *chunk in job.chunks) {
+        if (chunk.task) {
+            [_chunksByTask removeObjectForKey:@(chunk.task.taskIdentifier)];
+            [chunk.task cancel];
+            chunk.task = nil;
+        }
+    }
+    [self p_closeFileOfJob:job];
+    if (error) {
+        [KRLogModule logError:[NSString stringWithFormat:@"KRHttpDownloader failed: %@ %@", job.url, error]];
+    }
+    NSString *path = error ? nil : job.storePath;
+    for (KRHttpDownloadWaiter *waiter in job.waiters) {
+        if (waiter.completion) {
+            waiter.completion(path, error);
+        }
+    }
+    [job.waiters removeAllObjects];
+}
+
+- (NSError *)p_verifyJob:(KRHttpDownloadJob *)job {
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:job.partPath error:nil];
+    if ((int64_t)attributes.fileSize != job.totalLength || job.receivedLength != job.totalLength) {
+        return KRHttpDownloaderError(KRHttpDownloaderErrorCodeIntegrity, @"length mismatch");
+    }
+    if (!job.options.expectedMD5.length) {
+        return nil;
+    }
+    NSFileHandle *readHandle = [NSFileHandle fileHandleForReadingAtPath:job.partPath];
+    if (!readHandle) {
+        return KRHttpDownloaderError(KRHttpDownloaderErrorCodeFile, @"open part file failed");
+    }
+    CC_MD5_CTX context;
+    CC_MD5_Init(&context);
+    @try {
+        while (YES) {
+            @autoreleasepool {
+                NSData *data = [readHandle readDataOfLength:1024 * 1024];
+                if (!data.length) {
+                    break;
+                }
+                CC_MD5_Update(&context, data.bytes, (CC_LONG)data.length);
+            }
+        }
+    } @catch (NSException *exception) {
+        [readHandle closeFile];
+        return KRHttpDownloaderError(KRHttpDownloaderErrorCodeFile, exception.reason);
+    }
+    [readHandle closeFile];
+    unsigned char digest[CC_MD5_DIGEST_LENGTH];
+    CC_MD5_Final(digest, &context);
+    NSMutableString *md5 = [NSMutableString stringWithCapacity:CC_MD5_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_MD5_DIGEST_LENGTH; i++) {
+        [md5 appendFormat:@"%02x", digest[i]];
+    }
+    if ([md5 caseInsensitiveCompare:job.options.expectedMD5] != NSOrderedSame) {
+        return KRHttpDownloaderError(KRHttpDownloaderErrorCodeIntegrity, @"md5 mismatch");
+    }
+    return nil;
+}
+
+- (void)p_closeFileOfJob:(KRHttpDownloadJob *)job {
+    @try {
+        [job.fileHandle closeFile];
+    } @catch (NSException *exception) {
+    }
+    job.fileHandle = nil;
+}
+
+#pragma mark - chunk
+
+- (void)p_startChunk:(KRHttpDownloadChunk *)chunk {
+    KRHttpDownloadJob *job = chunk.job;
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:job.url]
+                                                           cachePolicy:NSURLRequestReloadIgnoringLocalCacheData
+                                                       timeoutInterval:30];
+    int64_t offset = chunk.start + chunk.received;
+    NSString *range = chunk.end >= 0 ? [NSString stringWithFormat:@"bytes=%lld-%lld", offset, chunk.end - 1]
+                                     : [NSString stringWithFormat:@"bytes=%lld-", offset];
+    [request setValue:range forHTTPHeaderField:@"Range"];
+    // 分片与长度校验都基于原始字节，不接受压缩传输
+    [request setValue:@"identity" forHTTPHeaderField:@"Accept-Encoding"];
+    if (job.validator.length) {
+        [request setValue:job.validator forHTTPHeaderField:@"If-Range"];
+    }
+    chunk.task = [[KRHttpSessionPool sharedPool] dataTaskWithRequest:request delegate:self delegateQueue:_delegateQueue];
+    _chunksByTask[@(chunk.task.taskIdentifier)] = chunk;
+    [chunk.task resume];
+}
+
+/// 首个响应拿到总长度后，把剩余部分拆成多个分片并行下载
+- (void)p_splitFirstChunk:(KRHttpDownloadChunk *)firstChunk {
+    KRHttpDownloadJob *job = firstChunk.job;
+    KRHttpDownloadOptions *options = job.options;
+    int64_t total = job.totalLength;
+    int64_t minChunkSize = MAX(options.minChunkSize, 64 * 1024);
+    int64_t count = MIN((int64_t)MAX(options.maxConnections, 1), total / minChunkSize);
+    if (count < 2) {
+        firstChunk.end = total;
+        return;
+    }
+    int64_t chunkSize = (total + count - 1) / count;
+    firstChunk.end = chunkSize;
+    for (int64_t start = chunkSize; start < total; start += chunkSize) {
+        KRHttpDownloadChunk *chunk = [KRHttpDownloadChunk new];
+        chunk.job = job;
+        chunk.start = start;
+        chunk.end = MIN(start + chunkSize, total);
+        [job.chunks addObject:chunk];
+        [self p_startChunk:chunk];
+    }
+}
+
+- (void)p_failChunk:(KRHttpDownloadChunk *)chunk error:(NSError *)error {
+    KRHttpDownloadJob *job = chunk.job;
+    if (!job || _jobsByStorePath[job.storePath] != job) {
+        return;
+    }
+    if (chunk.retryCount >= job.options.maxRetryCount) {
+        // 保留已下载部分，下次调用续传
+        [self p_saveStateOfJob:job];
+        [self p_finishJob:job error:error];
+        return;
+    }
+    chunk.retryCount++;
+    int64_t delay = (int64_t)(NSEC_PER_SEC / 2) << (chunk.retryCount - 1);
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, delay), _queue, ^{
+        if (self->_jobsByStorePath[job.storePath] == job && !chunk.task) {
+            [self p_startChunk:chunk];
+        }
+    });
+}
+
+#pragma mark - state
+
+- (void)p_saveStateOfJob:(KRHttpDownloadJob *)job {
+    // 总长度未知或不支持Range时无法续传
+    if (job.totalLength < 0 || !job.validator.length) {
+        return;
+    }
+    NSMutableArray *chunks = [NSMutableArray new];
+    for (KRHttpDownloadChunk *chunk in job.chunks) {
+        [chunks addObject:@[@(chunk.start), @(chunk.end), @(chunk.received)]];
+    }
+    NSDictionary *state = @{
+        @"url": job.url,
+        @"total": @(job.totalLength),
+        @"validator": job.validator,
+        @"chunks": chunks,
+    };
+    @try {
+        [job.fileHandle synchronizeFile];
+    } @catch (NSException *exception) {
+    }
+    [state writeToFile:job.statePath atomically:YES];
+    job.unsavedBytes = 0;
+}
+
+- (BOOL)p_restoreStateOfJob:(KRHttpDownloadJob *)job {
+    if (job.restarted) {
+        return NO;
+    }
+    NSDictionary *state = [NSDictionary dictionaryWithContentsOfFile:job.statePath];
+    int64_t total = [state[@"total"] longLongValue];
+    NSArray *chunkStates = state[@"chunks"];
+    NSString *validator = state[@"validator"];
+    if (![state[@"url"] isEqual:job.url] || total <= 0 || ![validator isKindOfClass:[NSString class]]
+        || ![chunkStates isKindOfClass:[NSArray class]] || !chunkStates.count) {
+        return NO;
+    }
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:job.partPath error:nil];
+    if ((int64_t)attributes.fileSize != total) {
+        return NO;
+    }
+    NSMutableArray<KRHttpDownloadChunk *> *chunks = [NSMutableArray new];
+    int64_t expectedStart = 0;
+    for (NSArray *chunkState in [chunkStates sortedArrayUsingComparator:^NSComparisonResult(NSArray *a, NSArray *b) {
+        return [a.firstObject compare:b.firstObject];
+    }]) {
+        if (![chunkState isKindOfClass:[NSArray class]] || chunkState.count != 3) {
+            return NO;
+        }
+        KRHttpDownloadChunk *chunk = [KRHttpDownloadChunk new];
+        chunk.job = job;
+        chunk.start = [chunkState[0] longLongValue];
+        chunk.end = [chunkState[1] longLongValue];
+        chunk.received = [chunkState[2] longLongValue];
+        // 分片需首尾相接覆盖整个文件
+        if (chunk.start != expectedStart || chunk.end <= chunk.start || chunk.end > total
+            || chunk.received < 0 || chunk.received > chunk.end - chunk.start) {
+            return NO;
+        }
+        expectedStart = chunk.end;
+        [chunks addObject:chunk];
+    }
+    if (expectedStart != total) {
+        return NO;
+    }
+    job.chunks = chunks;
+    job.totalLength = total;
+    job.validator = validator;
+    return YES;
+}
+
+#pragma mark - progress
+
+- (void)p_notifyProgressOfJob:(KRHttpDownloadJob *)job force:(BOOL)force {
+    CFTimeInterval now = CFAbsoluteTimeGetCurrent();
+    if (!force && now - job.lastProgressTime < kKRHttpDownloadProgressInterval) {
+        return;
+    }
+    job.lastProgressTime = now;
+    NSMutableArray<KRHttpDownloadProgressBlock> *progressBlocks = [NSMutableArray new];
+    for (KRHttpDownloadWaiter *waiter in job.waiters) {
+        if (waiter.progress) {
+            [progressBlocks addObject:waiter.progress];
+        }
+    }
+    if (!progressBlocks.count) {
+        return;
+    }
+    int64_t received = job.receivedLength;
+    int64_t total = job.totalLength;
+    [KuiklyRenderThreadManager performOnContextQueueWithBlock:^{
+        for (KRHttpDownloadProgressBlock progress in progressBlocks) {
+            progress(received, total);
+        }
+    }];
+}
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+didReceiveResponse:(NSURLResponse *)response
+ completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler {
+    KRHttpDownloadChunk *chunk = _chunksByTask[@(dataTask.taskIdentifier)];
+    KRHttpDownloadJob *job = chunk.job;
+    if (!job) {
+        completionHandler(NSURLSessionResponseCancel);
+        return;
+    }
+    NSHTTPURLResponse *httpResponse = [response isKindOfClass:[NSHTTPURLResponse class]] ? (NSHTTPURLResponse *)response : nil;
+    NSInteger statusCode = httpResponse.statusCode;
+    int64_t offset = chunk.start + chunk.received;
+    NSString *contentEncoding = httpResponse.allHeaderFields[@"Content-Encoding"];
+    BOOL encoded = contentEncoding.length && [contentEncoding caseInsensitiveCompare:@"identity"] != NSOrderedSame;
+    if (statusCode == 206 && encoded) {
+        // 压缩后的Range无法映射到解码后的文件偏移
+        [self p_detachChunk:chunk];
+        completionHandler(NSURLSessionResponseCancel);
+        [self p_failChunk:chunk error:KRHttpDownloaderError(KRHttpDownloaderErrorCodeResponse, @"encoded partial content")];
+        return;
+    }
+    if (statusCode == 206) {
+        int64_t rangeStart = 0, rangeEnd = 0, rangeTotal = -1;
+        if (!KRHttpParseContentRange(httpResponse.allHeaderFields[@"Content-Range"], &rangeStart, &rangeEnd, &rangeTotal)
+            || rangeStart != offset || rangeTotal <= 0) {
+            [self p_detachChunk:chunk];
+            completionHandler(NSURLSessionResponseCancel);
+            [self p_failChunk:chunk error:KRHttpDownloaderError(KRHttpDownloaderErrorCodeResponse, @"invalid Content-Range")];
+            return;
+        }
+        if (job.totalLength < 0) {
+            job.totalLength = rangeTotal;
+            // 弱ETag不能用于If-Range
+            NSString *etag = httpResponse.allHeaderFields[@"ETag"];
+            job.validator = [etag hasPrefix:@"W/"] ? httpResponse.allHeaderFields[@"Last-Modified"] : (etag ?: httpResponse.allHeaderFields[@"Last-Modified"]);
+            @try {
+                [job.fileHandle truncateFileAtOffset:rangeTotal];
+            } @catch (NSException *exception) {
+                [self p_detachChunk:chunk];
+                completionHandler(NSURLSessionResponseCancel);
+                [self p_finishJob:job error:KRHttpDownloaderError(KRHttpDownloaderErrorCodeFile, exception.reason)];
+                return;
+            }
+            [self p_splitFirstChunk:chunk];
+        } else if (rangeTotal != job.totalLength) {
+            completionHandler(NSURLSessionResponseCancel);
+            [self p_restartOrFailJob:job];
+            return;
+        }
+        completionHandler(NSURLSessionResponseAllow);
+        return;
+    }
+    if (statusCode == 200) {
+        if (offset == 0 && job.chunks.count == 1 && job.totalLength < 0) {
+            // 服务端不支持Range，单连接下载整个文件
+            // 有Content-Encoding时expectedContentLength是压缩后的长度，按未知处理，以实际收到的为准
+            job.totalLength = (!encoded && response.expectedContentLength >= 0) ? response.expectedContentLength : -1;
+            chunk.end = job.totalLength;
+            completionHandler(NSURLSessionResponseAllow);
+            return;
+        }
+        // If-Range不匹配，资源已变化
+        completionHandler(NSURLSessionResponseCancel);
+        [self p_restartOrFailJob:job];
+        return;
+    }
+    [self p_detachChunk:chunk];
+    completionHandler(NSURLSessionResponseCancel);
+    NSError *error = [KRHttpRequestUtil errorForNonSuccessResponse:response]
+                     ?: KRHttpDownloaderError(KRHttpDownloaderErrorCodeResponse, @"unexpected response");
+    if (statusCode >= 400 && statusCode < 500) {
+        [[NSFileManager defaultManager] removeItemAtPath:job.statePath error:nil];
+        [self p_finishJob:job error:error];
+    } else {
+        [self p_failChunk:chunk error:error];
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data {
+    KRHttpDownloadChunk *chunk = _chunksByTask[@(dataTask.taskIdentifier)];
+    KRHttpDownloadJob *job = chunk.job;
+    if (!job || !job.fileHandle) {
+        return;
+    }
+    int64_t offset = chunk.start + chunk.received;
+    NSUInteger length = data.length;
+    if (chunk.end >= 0 && offset + (int64_t)length > chunk.end) {
+        // 首个请求是开放区间，超出本分片的部分由其他分片下载
+        length = (NSUInteger)MAX(0, chunk.end - offset);
+    }
+    if (length) {
+        @try {
+            [job.fileHandle seekToFileOffset:offset];
+            [job.fileHandle writeData:length == data.length ? data : [data subdataWithRange:NSMakeRange(0, length)]];
+        } @catch (NSException *exception) {
+            [self p_saveStateOfJob:job];
+            [self p_finishJob:job error:KRHttpDownloaderError(KRHttpDownloaderErrorCodeFile, exception.reason)];
+            return;
+        }
+        chunk.received += length;
+        job.unsavedBytes += length;
+    }
+    if (chunk.isFinished) {
+        [self p_detachChunk:chunk];
+        [dataTask cancel];
+        if (![self p_finishJobIfCompleted:job]) {
+            [self p_saveStateOfJob:job];
+        }
+        return;
+    }
+    if (job.unsavedBytes >= kKRHttpDownloadSaveInterval) {
+        [self p_saveStateOfJob:job];
+    }
+    [self p_notifyProgressOfJob:job force:NO];
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error {
+    KRHttpDownloadChunk *chunk = _chunksByTask[@(task.taskIdentifier)];
+    if (!chunk) {
+        // 已主动取消或分片已完成
+        return;
+    }
+    [self p_detachChunk:chunk];
+    KRHttpDownloadJob *job = chunk.job;
+    if (!job) {
+        return;
+    }
+    if (!error && chunk.end < 0) {
+        // 总长度未知的单连接下载，以实际收到的长度为准
+        chunk.end = chunk.received;
+        job.totalLength = chunk.received;
+    }
+    if ([self p_finishJobIfCompleted:job]) {
+        return;
+    }
+    if (!chunk.isFinished) {
+        [self p_failChunk:chunk error:error ?: KRHttpDownloaderError(KRHttpDownloaderErrorCodeResponse, @"connection closed early")];
+    }
+}
+
+#pragma mark - private
+
+- (void)p_detachChunk:(KRHttpDownloadChunk *)chunk {
+    if (chunk.task) {
+        [_chunksByTask removeObjectForKey:@(chunk.task.taskIdentifier)];
+        chunk.task = nil;
+    }
+}
+
+- (void)p_restartOrFailJob:(KRHttpDownloadJob *)job {
+    if (job.restarted) {
+        [self p_finishJob:job error:KRHttpDownloaderError(KRHttpDownloaderErrorCodeResponse, @"resource changed during download")];
+        return;
+    }
+    [self p_restartJob:job];
+}
+
+@end
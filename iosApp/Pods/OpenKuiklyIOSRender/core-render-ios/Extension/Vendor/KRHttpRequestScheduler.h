@@ -0,0 +1,82 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 请求优先级，数值越小越优先
+typedef NS_ENUM(NSInteger, KRHttpRequestPriority) {
+    KRHttpRequestPriorityFirstScreen = 0,   // 首屏
+    KRHttpRequestPriorityVisible = 1,       // 可见内容（默认）
+    KRHttpRequestPriorityPrefetch = 2,      // 预取
+};
+
+typedef void (^KRHttpSchedulerCompletion)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error);
+
+/*
+ * @brief Http磁盘缓存，支持Cache-Control(max-age/no-cache/no-store)、Vary与ETag/Last-Modified协商
+ */
+@interface KRHttpResponseCache : NSObject
+
+- (instancetype)initWithDirectory:(NSString *)directory maxDiskSize:(NSUInteger)maxDiskSize;
+@property (nonatomic, copy, readonly) NSString *directory;
+@property (nonatomic, assign, readonly) NSUInteger totalDiskSize;
+- (void)removeAllResponses;
+
+@end
+
+/*
+ * @brief Http请求调度器
+ * 1. 相同的进行中GET请求合并为一次网络请求，回包分发给所有调用方
+ * 2. 按优先级排队，限制总并发与单host并发，首屏请求进行中时预取请求让路
+ * 3. GET回包按缓存头落盘，新鲜缓存直接返回，过期缓存带条件头协商，304时使用缓存内容
+ * 4. 支持按标识取消（合并请求中的所有调用方都取消后才取消网络任务）
+ * 回调在后台线程执行
+ */
+@interface KRHttpRequestScheduler : NSObject
+
++ (instancetype)sharedScheduler;
+/// session与cache可注入，便于对接本地回环服务验证调度与缓存逻辑；cache为nil时不缓存
+- (instancetype)initWithSession:(NSURLSession *)session cache:(nullable KRHttpResponseCache *)cache NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// 总并发数，默认16
+@property (atomic, assign) NSUInteger maxConcurrentRequests;
+/// 单host并发数，默认6
+@property (atomic, assign) NSUInteger maxConcurrentRequestsPerHost;
+/// 预取请求的单host并发数，默认2
+@property (atomic, assign) NSUInteger maxConcurrentPrefetchRequestsPerHost;
+@property (nonatomic, strong, readonly, nullable) KRHttpResponseCache *cache;
+
+/*
+ * @brief 调度请求
+ * @param identifier 取消用标识，传nil时自动生成
+ * @return 请求标识
+ */
+- (NSString *)scheduleRequest:(NSURLRequest *)request
+                     priority:(KRHttpRequestPriority)priority
+                   identifier:(nullable NSString *)identifier
+                   completion:(KRHttpSchedulerCompletion)completion;
+/// 取消请求，回调NSURLErrorCancelled错误
+- (void)cancelRequestWithIdentifier:(NSString *)identifier;
+/// 解析优先级参数，支持"firstScreen"/"visible"/"prefetch"或对应数值
++ (KRHttpRequestPriority)priorityFromValue:(nullable id)value;
+/// 优先级对应的NSURLSessionTask priority，供不经调度器的请求（如流式请求）使用
++ (float)taskPriorityWithPriority:(KRHttpRequestPriority)priority;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,672 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRHttpRequestScheduler.h"
+#import "KRHttpRequestTool.h"
+#import "KRHttpSessionPool.h"
+#import "NSObject+KR.h"
+
+static const NSUInteger kKRHttpPriorityCount = 3;
+static NSString *const kKRHttpCacheMetaExtension = @"meta";
+static NSString *const kKRHttpCacheDataExtension = @"data";
+
+#pragma mark - KRHttpCachedResponse
+
+@interface KRHttpCachedResponse : NSObject
+
+@property (nonatomic, copy) NSString *key;
+@property (nonatomic, copy) NSString *dataPath;
+@property (nonatomic, copy) NSString *url;
+@property (nonatomic, assign) NSInteger statusCode;
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *headers;
+@property (nonatomic, copy, nullable) NSString *etag;
+@property (nonatomic, copy, nullable) NSString *lastModified;
+/// Vary中各请求头（小写）在落盘请求中的取值，缺省为空字符串
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *varyHeaders;
+@property (nonatomic, assign) NSTimeInterval expiresAt;
+@property (nonatomic, assign) NSUInteger size;
+@property (nonatomic, assign) NSTimeInterval accessTime;
+
+- (BOOL)isFresh;
+- (BOOL)matchesVaryHeadersOfRequest:(NSURLRequest *)request;
+- (nullable NSData *)data;
+- (NSHTTPURLResponse *)response;
+
+@end
+
+@implementation KRHttpCachedResponse
+
+- (BOOL)isFresh {
+    return [NSDate date].timeIntervalSince1970 < _expiresAt;
+}
+
+- (BOOL)matchesVaryHeadersOfRequest:(NSURLRequest *)request {
+    __block BOOL matches = YES;
+    [_varyHeaders enumerateKeysAndObjectsUsingBlock:^(NSString *field, NSString *value, BOOL *stop) {
+        matches = [([request valueForHTTPHeaderField:field] ?: @"") isEqualToString:value];
+        *stop = !matches;
+    }];
+    return matches;
+}
+
+- (NSData *)data {
+    // mmap读取，避免整块拷贝
+    return [NSData dataWithContentsOfFile:_dataPath options:NSDataReadingMappedIfSafe error:nil];
+}
+
+- (NSHTTPURLResponse *)response {
+    return [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:_url]
+                                       statusCode:_statusCode
+                                      HTTPVersion:@"HTTP/1.1"
+                                     headerFields:_headers];
+}
+
+- (NSDictionary *)metaDictionary {
+    NSMutableDictionary *meta = [NSMutableDictionary new];
+    meta[@"key"] = _key;
+    meta[@"url"] = _url;
+    meta[@"statusCode"] = @(_statusCode);
+    meta[@"headers"] = _headers ?: @{};
+    meta[@"etag"] = _etag;
+    meta[@"lastModified"] = _lastModified;
+    meta[@"varyHeaders"] = _varyHeaders ?: @{};
+    meta[@"expiresAt"] = @(_expiresAt);
+    meta[@"size"] = @(_size);
+    return meta;
+}
+
++ (instancetype)responseWithMetaDictionary:(NSDictionary *)meta dataPath:(NSString *)dataPath {
+    if (![meta isKindOfClass:[NSDictionary class]] || ![meta[@"key"] isKindOfClass:[NSString class]]) {
+        return nil;
+    }
+    KRHttpCachedResponse *cached = [KRHttpCachedResponse new];
+    cached.key = meta[@"key"];
+    cached.url = meta[@"url"] ?: @"";
+    cached.statusCode = [meta[@"statusCode"] integerValue];
+    cached.headers = meta[@"headers"];
+    cached.etag = meta[@"etag"];
+    cached.lastModified = meta[@"lastModified"];
+    cached.varyHeaders = [meta[@"varyHeaders"] isKindOfClass:[NSDictionary class]] ? meta[@"varyHeaders"] : @{};
+    cached.expiresAt = [meta[@"expiresAt"] doubleValue];
+    cached.size = [meta[@"size"] unsignedIntegerValue];
+    cached.dataPath = dataPath;
+    return cached;
+}
+
+@end
+
+#pragma mark - KRHttpResponseCache
+
+@interface KRHttpResponseCache ()
+
+/// Vary请求头与request不一致时返回nil
+- (nullable KRHttpCachedResponse *)cachedResponseForKey:(NSString *)key request:(NSURLRequest *)request;
+- (void)storeData:(NSData *)data response:(NSHTTPURLResponse *)response request:(NSURLRequest *)request forKey:(NSString *)key;
+- (void)refreshCachedResponse:(KRHttpCachedResponse *)cached withNotModifiedResponse:(NSHTTPURLResponse *)response;
+
+@end
+
+@implementation KRHttpResponseCache {
+    dispatch_queue_t _ioQueue;
+    NSMutableDictionary<NSString *, KRHttpCachedResponse *> *_entries;
+    NSUInteger _maxDiskSize;
+    NSUInteger _totalDiskSize;
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory maxDiskSize:(NSUInteger)maxDiskSize {
+    if (self = [super init]) {
+        _directory = [directory copy];
+        _maxDiskSize = maxDiskSize;
+        _entries = [NSMutableDictionary new];
+        _ioQueue = dispatch_queue_create("com.tencent.kuikly.http.cache", DISPATCH_QUEUE_SERIAL);
+        dispatch_async(_ioQueue, ^{
+            [self p_loadEntries];
+        });
+    }
+    return self;
+}
+
+- (NSUInteger)totalDiskSize {
+    __block NSUInteger size = 0;
+    dispatch_sync(_ioQueue, ^{
+        size = self->_totalDiskSize;
+    });
+    return size;
+}
+
+- (KRHttpCachedResponse *)cachedResponseForKey:(NSString *)key request:(NSURLRequest *)request {
+    __block KRHttpCachedResponse *cached = nil;
+    dispatch_sync(_ioQueue, ^{
+        cached = self->_entries[key];
+        cached.accessTime = [NSDate date].timeIntervalSince1970;
+    });
+    return [cached matchesVaryHeadersOfRequest:request] ? cached : nil;
+}
+
+- (void)storeData:(NSData *)data response:(NSHTTPURLResponse *)response request:(NSURLRequest *)request forKey:(NSString *)key {
+    BOOL storable = NO;
+    NSTimeInterval maxAge = [[self class] p_maxAgeWithResponse:response storable:&storable];
+    NSDictionary<NSString *, NSString *> *varyHeaders = [[self class] p_varyHeadersWithResponse:response request:request];
+    if (!storable || !varyHeaders || data.length > _maxDiskSize / 4) {
+        return;
+    }
+    NSMutableDictionary<NSString *, NSString *> *headers = [NSMutableDictionary new];
+    [response.allHeaderFields enumerateKeysAndObjectsUsingBlock:^(id field, id value, BOOL *stop) {
+        if ([field isKindOfClass:[NSString class]] && [value isKindOfClass:[NSString class]]) {
+            headers[field] = value;
+        }
+    }];
+    KRHttpCachedResponse *cached = [KRHttpCachedResponse new];
+    cached.key = key;
+    cached.url = response.URL.absoluteString ?: @"";
+    cached.statusCode = response.statusCode;
+    cached.headers = headers;
+    cached.etag = [response valueForHTTPHeaderField:@"ETag"];
+    cached.lastModified = [response valueForHTTPHeaderField:@"Last-Modified"];
+    cached.varyHeaders = varyHeaders;
+    cached.expiresAt = [NSDate date].timeIntervalSince1970 + maxAge;
+    cached.size = data.length;
+    cached.accessTime = [NSDate date].timeIntervalSince1970;
+    dispatch_async(_ioQueue, ^{
+        NSString *fileName = [key kr_md5String];
+        cached.dataPath = [self p_pathWithFileName:fileName extension:kKRHttpCacheDataExtension];
+        [[NSFileManager defaultManager] createDirectoryAtPath:self.directory withIntermediateDirectories:YES attributes:nil error:nil];
+        // 先写数据再写meta，meta存在即代表数据完整
+        if (![data writeToFile:cached.dataPath atomically:YES]
+            || ![[cached metaDictionary] writeToFile:[self p_pathWithFileName:fileName extension:kKRHttpCacheMetaExtension] atomically:YES]) {
+            [self p_removeFilesWithFileName:fileName];
+            return;
+        }
+        KRHttpCachedResponse *old = self->_entries[key];
+        self->_totalDiskSize = self->_totalDiskSize - old.size + cached.size;
+        self->_entries[key] = cached;
+        [self p_trimIfNeeded];
+    });
+}
+
+- (void)refreshCachedResponse:(KRHttpCachedResponse *)cached withNotModifiedResponse:(NSHTTPURLResponse *)response {
+    BOOL storable = NO;
+    NSTimeInterval maxAge = [[self class] p_maxAgeWithResponse:response storable:&storable];
+    dispatch_async(_ioQueue, ^{
+        if (self->_entries[cached.key] != cached) {
+            return;
+        }
+        cached.expiresAt = [NSDate date].timeIntervalSince1970 + maxAge;
+        NSString *etag = [response valueForHTTPHeaderField:@"ETag"];
+        if (etag.length) {
+            cached.etag = etag;
+        }
+        [[cached metaDictionary] writeToFile:[self p_pathWithFileName:[cached.key kr_md5String] extension:kKRHttpCacheMetaExtension]
+                                  atomically:YES];
+    });
+}
+
+- (void)removeAllResponses {
+    dispatch_async(_ioQueue, ^{
+        [self->_entries removeAllObjects];
+        self->_totalDiskSize = 0;
+        [[NSFileManager defaultManager] removeItemAtPath:self.directory error:nil];
+    });
+}
+
+#pragma mark - private
+
+/// 解析Cache-Control（需解析全部指令，no-cache与no-store可任意顺序出现），storable表示是否值得落盘（有有效期或可协商）
++ (NSTimeInterval)p_maxAgeWithResponse:(NSHTTPURLResponse *)response storable:(BOOL *)storable {
+    NSTimeInterval maxAge = 0;
+    BOOL noStore = NO;
+    BOOL noCache = NO;
+    NSString *cacheControl = [[response valueForHTTPHeaderField:@"Cache-Control"] lowercaseString];
+    for (NSString *component in [cacheControl componentsSeparatedByString:@","]) {
+        NSString *directive = [component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+        if ([directive isEqualToString:@"no-store"]) {
+            noStore = YES;
+        } else if ([directive isEqualToString:@"no-cache"]) {
+            noCache = YES;
+        } else if ([directive hasPrefix:@"max-age="]) {
+            maxAge = MAX(0, [[directive substringFromIndex:8] doubleValue]);
+        }
+    }
+    if (noCache) {
+        // 每次都需协商
+        maxAge = 0;
+    }
+    NSString *age = [response valueForHTTPHeaderField:@"Age"];
+    if (age.length) {
+        maxAge = MAX(0, maxAge - age.doubleValue);
+    }
+    BOOL hasValidator = [response valueForHTTPHeaderField:@"ETag"].length || [response valueForHTTPHeaderField:@"Last-Modified"].length;
+    *storable = !noStore && (maxAge > 0 || hasValidator);
+    return maxAge;
+}
+
+/*
+ * 记录Vary中各请求头在request中的取值，命中缓存时需全部一致
+ * Vary为*或包含由系统注入、request中不可见的头（Cookie/Authorization）时返回nil，不落盘
+ */
++ (NSDictionary<NSString *, NSString *> *)p_varyHeadersWithResponse:(NSHTTPURLResponse *)response request:(NSURLRequest *)request {
+    NSMutableDictionary<NSString *, NSString *> *varyHeaders = [NSMutableDictionary new];
+    NSString *vary = [[response valueForHTTPHeaderField:@"Vary"] lowercaseString];
+    for (NSString *component in [vary componentsSeparatedByString:@","]) {
+        NSString *field = [component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+        if (!field.length) {
+            continue;
+        }
+        if ([field isEqualToString:@"*"] || [field isEqualToString:@"cookie"] || [field isEqualToString:@"authorization"]) {
+            return nil;
+        }
+        varyHeaders[field] = [request valueForHTTPHeaderField:field] ?: @"";
+    }
+    return varyHeaders;
+}
+
+- (NSString *)p_pathWithFileName:(NSString *)fileName extension:(NSString *)extension {
+    return [[self.directory stringByAppendingPathComponent:fileName] stringByAppendingPathExtension:extension];
+}
+
+- (void)p_removeFilesWithFileName:(NSString *)fileName {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    [fileManager removeItemAtPath:[self p_pathWithFileName:fileName extension:kKRHttpCacheMetaExtension] error:nil];
+    [fileManager removeItemAtPath:[self p_pathWithFileName:fileName extension:kKRHttpCacheDataExtension] error:nil];
+}
+
+- (void)p_loadEntries {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    for (NSString *file in [fileManager contentsOfDirectoryAtPath:self.directory error:nil]) {
+        if (![file.pathExtension isEqualToString:kKRHttpCacheMetaExtension]) {
+            continue;
+        }
+        NSString *fileName = file.stringByDeletingPathExtension;
+        NSString *metaPath = [self p_pathWithFileName:fileName extension:kKRHttpCacheMetaExtension];
+        NSString *dataPath = [self p_pathWithFileName:fileName extension:kKRHttpCacheDataExtension];
+        KRHttpCachedResponse *cached = [KRHttpCachedResponse responseWithMetaDictionary:[NSDictionary dictionaryWithContentsOfFile:metaPath]
+                                                                               dataPath:dataPath];
+        NSDictionary *attributes = [fileManager attributesOfItemAtPath:dataPath error:nil];
+        if (!cached || !attributes) {
+            [self p_removeFilesWithFileName:fileName];
+            continue;
+        }
+        cached.accessTime = [attributes.fileModificationDate timeIntervalSince1970];
+        _entries[cached.key] = cached;
+        _totalDiskSize += cached.size;
+    }
+    [self p_trimIfNeeded];
+}
+
+/// 超出上限时按最近访问时间淘汰到上限的80%
+- (void)p_trimIfNeeded {
+    if (_totalDiskSize <= _maxDiskSize) {
+        return;
+    }
+    NSArray<KRHttpCachedResponse *> *entries = [_entries.allValues sortedArrayUsingComparator:^NSComparisonResult(KRHttpCachedResponse *a, KRHttpCachedResponse *b) {
+        return a.accessTime < b.accessTime ? NSOrderedAscending : (a.accessTime > b.accessTime ? NSOrderedDescending : NSOrderedSame);
+    }];
+    NSUInteger targetSize = _maxDiskSize / 10 * 8;
+    for (KRHttpCachedResponse *cached in entries) {
+        if (_totalDiskSize <= targetSize) {
+            break;
+        }
+        [_entries removeObjectForKey:cached.key];
+        _totalDiskSize -= cached.size;
+        [self p_removeFilesWithFileName:[cached.key kr_md5String]];
+    }
+}
+
+@end
+
+#pragma mark - KRHttpSchedulerOperation
+
+@interface KRHttpSchedulerWaiter : NSObject
+
+@property (nonatomic, copy) NSString *identifier;
+@property (nonatomic, copy) KRHttpSchedulerCompletion completion;
+
+@end
+
+@implementation KRHttpSchedulerWaiter
+
+@end
+
+@interface KRHttpSchedulerOperation : NSObject
+
+@property (nonatomic, strong) NSURLRequest *request;
+/// 合并与缓存用key，非GET请求为nil
+@property (nonatomic, copy, nullable) NSString *key;
+@property (nonatomic, copy) NSString *host;
+@property (nonatomic, assign) KRHttpRequestPriority priority;
+/// 启动时的优先级，用于归还并发计数
+@property (nonatomic, assign) KRHttpRequestPriority runningPriority;
+@property (nonatomic, strong) NSMutableArray<KRHttpSchedulerWaiter *> *waiters;
+@property (nonatomic, strong, nullable) NSURLSessionDataTask *task;
+/// 协商中的过期缓存
+@property (nonatomic, strong, nullable) KRHttpCachedResponse *staleResponse;
+@property (nonatomic, assign) BOOL cacheable;
+
+@end
+
+@implementation KRHttpSchedulerOperation
+
+@end
+
+#pragma mark - KRHttpRequestScheduler
+
+@implementation KRHttpRequestScheduler {
+    NSURLSession *_session;
+    dispatch_queue_t _queue;
+    NSArray<NSMutableArray<KRHttpSchedulerOperation *> *> *_pendingQueues;
+    NSMutableDictionary<NSString *, KRHttpSchedulerOperation *> *_operationsByKey;
+    NSMutableDictionary<NSString *, KRHttpSchedulerOperation *> *_operationsByIdentifier;
+    NSCountedSet<NSString *> *_runningHosts;
+    NSUInteger _runningCount;
+    NSUInteger _runningFirstScreenCount;
+}
+
++ (instancetype)sharedScheduler {
+    static KRHttpRequestScheduler *scheduler;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *cachesPath = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+        KRHttpResponseCache *cache = [[KRHttpResponseCache alloc] initWithDirectory:[cachesPath stringByAppendingPathComponent:@"kuikly_http_cache"]
+                                                                        maxDiskSize:32 * 1024 * 1024];
+        scheduler = [[KRHttpRequestScheduler alloc] initWithSession:[KRHttpSessionPool sharedPool].dataSession cache:cache];
+    });
+    return scheduler;
+}
+
+- (instancetype)initWithSession:(NSURLSession *)session cache:(KRHttpResponseCache *)cache {
+    if (self = [super init]) {
+        _session = session;
+        _cache = cache;
+        _maxConcurrentRequests = 16;
+        _maxConcurrentRequestsPerHost = 6;
+        _maxConcurrentPrefetchRequestsPerHost = 2;
+        _queue = dispatch_queue_create("com.tencent.kuikly.http.scheduler", DISPATCH_QUEUE_SERIAL);
+        NSMutableArray *pendingQueues = [NSMutableArray new];
+        for (NSUInteger i = 0; i < kKRHttpPriorityCount; i++) {
+            [pendingQueues addObject:[NSMutableArray new]];
+        }
+        _pendingQueues = pendingQueues;
+        _operationsByKey = [NSMutableDictionary new];
+        _operationsByIdentifier = [NSMutableDictionary new];
+        _runningHosts = [NSCountedSet new];
+    }
+    return self;
+}
+
++ (KRHttpRequestPriority)priorityFromValue:(id)value {
+    if ([value isKindOfClass:[NSString class]]) {
+        if ([value isEqualToString:@"firstScreen"]) {
+            return KRHttpRequestPriorityFirstScreen;
+        }
+        if ([value isEqualToString:@"prefetch"]) {
+            return KRHttpRequestPriorityPrefetch;
+        }
+        if (![value isEqualToString:@"visible"] && [value length]) {
+            value = @([value integerValue]);
+        }
+    }
+    if ([value isKindOfClass:[NSNumber class]]) {
+        return (KRHttpRequestPriority)MIN(MAX([value integerValue], 0), (NSInteger)kKRHttpPriorityCount - 1);
+    }
+    return KRHttpRequestPriorityVisible;
+}
+
++ (float)taskPriorityWithPriority:(KRHttpRequestPriority)priority {
+    switch (priority) {
+        case KRHttpRequestPriorityFirstScreen:
+            return NSURLSessionTaskPriorityHigh;
+        case KRHttpRequestPriorityPrefetch:
+            return NSURLSessionTaskPriorityLow;
+        default:
+            return NSURLSessionTaskPriorityDefault;
+    }
+}
+
+- (NSString *)scheduleRequest:(NSURLRequest *)request
+                     priority:(KRHttpRequestPriority)priority
+                   identifier:(NSString *)identifier
+                   completion:(KRHttpSchedulerCompletion)completion {
+    KRHttpSchedulerWaiter *waiter = [KRHttpSchedulerWaiter new];
+    waiter.identifier = identifier.length ? identifier : [NSUUID UUID].UUIDString;
+    waiter.completion = completion;
+    priority = (KRHttpRequestPriority)MIN(MAX(priority, 0), (NSInteger)kKRHttpPriorityCount - 1);
+    dispatch_async(_queue, ^{
+        [self p_scheduleRequest:request priority:priority waiter:waiter];
+    });
+    return waiter.identifier;
+}
+
+- (void)cancelRequestWithIdentifier:(NSString *)identifier {
+    if (!identifier.length) {
+        return;
+    }
+    dispatch_async(_queue, ^{
+        [self p_cancelRequestWithIdentifier:identifier];
+    });
+}
+
+#pragma mark - private（均在_queue执行）
+
+- (void)p_scheduleRequest:(NSURLRequest *)request priority:(KRHttpRequestPriority)priority waiter:(KRHttpSchedulerWaiter *)waiter {
+    NSString *key = [self p_coalescingKeyWithRequest:request];
+    KRHttpSchedulerOperation *operation = key ? _operationsByKey[key] : nil;
+    if (operation) {
+        // 合并到进行中的相同请求
+        [operation.waiters addObject:waiter];
+        _operationsByIdentifier[waiter.identifier] = operation;
+        if (priority < operation.priority) {
+            [self p_raiseOperation:operation toPriority:priority];
+        }
+        return;
+    }
+
+    BOOL cacheable = key && _cache && request.cachePolicy != NSURLRequestReloadIgnoringLocalCacheData;
+    KRHttpCachedResponse *cached = cacheable ? [_cache cachedResponseForKey:key request:request] : nil;
+    if (cached.isFresh) {
+        NSData *data = cached.data;
+        if (data) {
+            [self p_deliverToWaiters:@[ waiter ] data:data response:cached.response error:nil];
+            return;
+        }
+    }
+
+    operation = [KRHttpSchedulerOperation new];
+    operation.key = key;
+    operation.cacheable = cacheable;
+    operation.host = request.URL.host ?: @"";
+    operation.priority = priority;
+    operation.waiters = [NSMutableArray arrayWithObject:waiter];
+    if (cacheable) {
+        // 由调度器自行缓存与协商，避免系统URLCache重复缓存及吞掉304
+        NSMutableURLRequest *mutableRequest = [request mutableCopy];
+        mutableRequest.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+        if (cached && (cached.etag.length || cached.lastModified.length)) {
+            if (cached.etag.length) {
+                [mutableRequest setValue:cached.etag forHTTPHeaderField:@"If-None-Match"];
+            }
+            if (cached.lastModified.length) {
+                [mutableRequest setValue:cached.lastModified forHTTPHeaderField:@"If-Modified-Since"];
+            }
+            operation.staleResponse = cached;
+        }
+        request = mutableRequest;
+    }
+    operation.request = request;
+    if (key) {
+        _operationsByKey[key] = operation;
+    }
+    _operationsByIdentifier[waiter.identifier] = operation;
+    [_pendingQueues[priority] addObject:operation];
+    [self p_startPendingOperationsIfNeeded];
+}
+
+/// GET请求按method+url+headers合并
+- (NSString *)p_coalescingKeyWithRequest:(NSURLRequest *)request {
+    NSString *method = request.HTTPMethod.uppercaseString ?: @"GET";
+    if (![method isEqualToString:@"GET"] || request.HTTPBody.length || request.HTTPBodyStream || !request.URL) {
+        return nil;
+    }
+    NSMutableString *key = [NSMutableString stringWithString:request.URL.absoluteString];
+    NSDictionary<NSString *, NSString *> *headers = request.allHTTPHeaderFields;
+    for (NSString *field in [headers.allKeys sortedArrayUsingSelector:@selector(caseInsensitiveCompare:)]) {
+        [key appendFormat:@"\n%@:%@", field.lowercaseString, headers[field]];
+    }
+    return key;
+}
+
+- (void)p_raiseOperation:(KRHttpSchedulerOperation *)operation toPriority:(KRHttpRequestPriority)priority {
+    if (operation.task) {
+        operation.task.priority = [KRHttpRequestScheduler taskPriorityWithPriority:priority];
+    } else {
+        [_pendingQueues[operation.priority] removeObjectIdenticalTo:operation];
+        [_pendingQueues[priority] addObject:operation];
+    }
+    operation.priority = priority;
+    [self p_startPendingOperationsIfNeeded];
+}
+
+- (void)p_startPendingOperationsIfNeeded {
+    for (NSUInteger priority = 0; priority < kKRHttpPriorityCount; priority++) {
+        NSMutableArray<KRHttpSchedulerOperation *> *queue = _pendingQueues[priority];
+        for (NSUInteger i = 0; i < queue.count && _runningCount < self.maxConcurrentRequests;) {
+            KRHttpSchedulerOperation *operation = queue[i];
+            if ([self p_canStartOperation:operation]) {
+                [queue removeObjectAtIndex:i];
+                [self p_startOperation:operation];
+            } else {
+                i++;
+            }
+        }
+    }
+}
+
+- (BOOL)p_canStartOperation:(KRHttpSchedulerOperation *)operation {
+    NSUInteger hostLimit = self.maxConcurrentRequestsPerHost;
+    if (operation.priority == KRHttpRequestPriorityPrefetch) {
+        // 首屏请求未完成时预取让路
+        if (_runningFirstScreenCount || _pendingQueues[KRHttpRequestPriorityFirstScreen].count) {
+            return NO;
+        }
+        hostLimit = MIN(hostLimit, self.maxConcurrentPrefetchRequestsPerHost);
+    }
+    return [_runningHosts countForObject:operation.host] < MAX(hostLimit, 1);
+}
+
+- (void)p_startOperation:(KRHttpSchedulerOperation *)operation {
+    _runningCount++;
+    [_runningHosts addObject:operation.host];
+    operation.runningPriority = operation.priority;
+    if (operation.priority == KRHttpRequestPriorityFirstScreen) {
+        _runningFirstScreenCount++;
+    }
+    __weak typeof(self) weakSelf = self;
+    operation.task = [_session dataTaskWithRequest:operation.request
+                                 completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf) {
+            return;
+        }
+        dispatch_async(strongSelf->_queue, ^{
+            [strongSelf p_finishOperation:operation data:data response:response error:error];
+        });
+    }];
+    operation.task.priority = [KRHttpRequestScheduler taskPriorityWithPriority:operation.priority];
+    [operation.task resume];
+}
+
+- (void)p_finishOperation:(KRHttpSchedulerOperation *)operation
+                     data:(NSData *)data
+                 response:(NSURLResponse *)response
+                    error:(NSError *)error {
+    _runningCount--;
+    [_runningHosts removeObject:operation.host];
+    if (operation.runningPriority == KRHttpRequestPriorityFirstScreen) {
+        _runningFirstScreenCount--;
+    }
+    if (operation.key && _operationsByKey[operation.key] == operation) {
+        [_operationsByKey removeObjectForKey:operation.key];
+    }
+    for (KRHttpSchedulerWaiter *waiter in operation.waiters) {
+        [_operationsByIdentifier removeObjectForKey:waiter.identifier];
+    }
+
+    if (operation.waiters.count) {
+        NSHTTPURLResponse *httpResponse = [response isKindOfClass:[NSHTTPURLResponse class]] ? (NSHTTPURLResponse *)response : nil;
+        if (!error && operation.staleResponse && httpResponse.statusCode == 304) {
+            NSData *cachedData = operation.staleResponse.data;
+            if (cachedData) {
+                [_cache refreshCachedResponse:operation.staleResponse withNotModifiedResponse:httpResponse];
+                data = cachedData;
+                response = operation.staleResponse.response;
+            }
+        } else if (!error && data && operation.cacheable && httpResponse.statusCode >= 200 && httpResponse.statusCode < 300) {
+            [_cache storeData:data response:httpResponse request:operation.request forKey:operation.key];
+        }
+        if (!error && data) {
+            error = [KRHttpRequestUtil errorForNonSuccessResponse:response];
+        }
+        [self p_deliverToWaiters:operation.waiters data:data response:response error:error];
+    }
+    [self p_startPendingOperationsIfNeeded];
+}
+
+- (void)p_cancelRequestWithIdentifier:(NSString *)identifier {
+    KRHttpSchedulerOperation *operation = _operationsByIdentifier[identifier];
+    if (!operation) {
+        return;
+    }
+    [_operationsByIdentifier removeObjectForKey:identifier];
+    KRHttpSchedulerWaiter *cancelledWaiter = nil;
+    for (KRHttpSchedulerWaiter *waiter in operation.waiters) {
+        if ([waiter.identifier isEqualToString:identifier]) {
+            cancelledWaiter = waiter;
+            break;
+        }
+    }
+    if (!cancelledWaiter) {
+        return;
+    }
+    [operation.waiters removeObjectIdenticalTo:cancelledWaiter];
+    NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil];
+    [self p_deliverToWaiters:@[ cancelledWaiter ] data:nil response:nil error:error];
+    if (operation.waiters.count) {
+        return;
+    }
+    // 无人等待，取消网络请求；新的相同请求不再合并到该请求上
+    if (operation.key && _operationsByKey[operation.key] == operation) {
+        [_operationsByKey removeObjectForKey:operation.key];
+    }
+    if (operation.task) {
+        [operation.task cancel];
+    } else {
+        [_pendingQueues[operation.priority] removeObjectIdenticalTo:operation];
+    }
+}
+
+- (void)p_deliverToWaiters:(NSArray<KRHttpSchedulerWaiter *> *)waiters
+                      data:(NSData *)data
+                  response:(NSURLResponse *)response
+                     error:(NSError *)error {
+    NSArray<KRHttpSchedulerWaiter *> *copiedWaiters = [waiters copy];
+    dispatch_async(dispatch_get_global_queue(0, 0), ^{
+        for (KRHttpSchedulerWaiter *waiter in copiedWaiters) {
+            if (waiter.completion) {
+                waiter.completion(data, response, error);
+            }
+        }
+    });
+}
+
+@end
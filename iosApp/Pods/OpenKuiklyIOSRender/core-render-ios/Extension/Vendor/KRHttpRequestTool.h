@@ -14,15 +14,43 @@
  */
 
 #import <Foundation/Foundation.h>
+#import "KRHttpRequestScheduler.h"
+#import "KRHttpDownloader.h"
 
 NS_ASSUME_NONNULL_BEGIN
 typedef void (^KRHttpResponse)(NSDictionary * _Nullable result , NSError * _Nullable error);
 typedef void (^KRKotlinHttpResponse)(NSData * _Nullable result , NSURLResponse * _Nullable response, NSError * _Nullable error);
 typedef void (^KRHttpFileResponse)(NSString * _Nullable path , NSError * _Nullable error);
+/*
+ * 流式回包事件：收到响应头时chunk为nil；收到数据时response为nil；结束时finished为YES
+ */
+typedef void (^KRHttpStreamEventBlock)(NSURLResponse * _Nullable response, NSData * _Nullable chunk, BOOL finished, NSError * _Nullable error);
 @interface KRHttpRequestTool : NSObject
 
 + (void)downloadWithUrl:(NSString * )url param:(NSDictionary * _Nullable)param sotrePath:(NSString * )path responseBlock:(KRHttpFileResponse)response;
+/*
+ * @brief 下载文件，path非空时经KRHttpDownloader分片并行、断点续传下载
+ * @param param 可选：md5（校验文件）、maxConnections（最大并发连接数）
+ * @param progress 进度，在context队列回调
+ * @return 取消用标识（传给KRHttpDownloader cancelDownloadWithIdentifier:），path为空时返回nil
+ */
++ (nullable NSString *)downloadWithUrl:(NSString *)url param:(NSDictionary * _Nullable)param storePath:(NSString *)path progress:(KRHttpDownloadProgressBlock _Nullable)progress responseBlock:(KRHttpFileResponse)response;
 + (void)requestWithMethod:(NSString *)method url:(NSString *)url param:(NSDictionary *)param binaryData:(NSData * _Nullable)binaryData headers:(NSDictionary *)headerDics timeout:(float)timeout cookie:(NSString * _Nullable)cookie responseBlock:(KRKotlinHttpResponse)response;
+/*
+ * @brief 经KRHttpRequestScheduler调度的请求（合并、缓存、优先级）
+ * @param identifier 取消用标识，可传nil
+ * @param pageId 发起请求的页面（见KRHttpSessionPool pageIdForOwner:），耗时按页面统计，可传nil
+ */
++ (void)requestWithMethod:(NSString *)method url:(NSString *)url param:(NSDictionary *)param binaryData:(NSData * _Nullable)binaryData headers:(NSDictionary *)headerDics timeout:(float)timeout cookie:(NSString * _Nullable)cookie priority:(KRHttpRequestPriority)priority identifier:(NSString * _Nullable)identifier pageId:(NSString * _Nullable)pageId responseBlock:(KRKotlinHttpResponse)response;
+/*
+ * @brief 流式请求，回包分片到达即回调（小分片合并到64KB），不经过合并与缓存；回调在后台串行队列执行
+ * @param priority 映射为NSURLSessionTask的priority
+ */
++ (void)streamRequestWithMethod:(NSString *)method url:(NSString *)url param:(NSDictionary *)param binaryData:(NSData * _Nullable)binaryData headers:(NSDictionary *)headerDics timeout:(float)timeout cookie:(NSString * _Nullable)cookie priority:(KRHttpRequestPriority)priority identifier:(NSString * _Nullable)identifier pageId:(NSString * _Nullable)pageId eventBlock:(KRHttpStreamEventBlock)eventBlock;
+/*
+ * @brief 取消经调度器发出的请求或流式请求
+ */
++ (void)cancelRequestWithIdentifier:(NSString *)identifier;
 
 
 
@@ -31,10 +59,12 @@ typedef void (^KRHttpFileResponse)(NSString * _Nullable path , NSError * _Nullab
 
 @interface KRHttpRequestUtil : NSObject
 
-
+/// json为KRJSONParser解析的只读容器（按需取值），非JSON回包时为{"data": 回包字符串}
 + (NSURLSessionDataTask *)requestWithURLRequest:(NSURLRequest *)request completionHandler:(void (^)(NSDictionary * _Nullable json, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler;
 + (void)downloadWithUrl:(NSString * )url responseBlock:(KRHttpFileResponse)response;
 + (void)requestContentLengthWithUrl:(NSString *)url completionHandler:(void (^)(long long contentLength, NSError * _Nullable error))completionHandler;
+/// 非2xx状态码转为ServeErrorDomain错误（同时打印错误日志），2xx返回nil
++ (nullable NSError *)errorForNonSuccessResponse:(nullable NSURLResponse *)response;
 + (NSURLSessionDataTask *)kotlinRequestWithURLRequest:(NSURLRequest *)request completionHandler:(void (^)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler;
 @end
 
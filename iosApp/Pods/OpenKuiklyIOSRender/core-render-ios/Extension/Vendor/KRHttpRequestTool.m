@@ -16,11 +16,198 @@
 #import "KRHttpRequestTool.h"
 #import "NSObject+KR.h"
 #import "KRLogModule.h"
+#import "KRHttpSessionPool.h"
+#import "KRHttpDownloader.h"
+#import "KRJSONParser.h"
+
+/// 流式回包合并到该大小再回调，减少跨桥调用次数
+static const NSUInteger kKRHttpStreamChunkSize = 64 * 1024;
+
+@interface KRHttpStreamContext : NSObject
+
+@property (nonatomic, copy) NSString *identifier;
+@property (nonatomic, copy) KRHttpStreamEventBlock eventBlock;
+@property (nonatomic, strong, nullable) NSMutableData *pendingData;
+
+@end
+
+@implementation KRHttpStreamContext
+
+@end
+
+/*
+ * 流式请求：通过delegate边收边回调，所有回调在串行delegateQueue上执行
+ */
+@interface KRHttpStreamLoader : NSObject<NSURLSessionDataDelegate>
+
++ (instancetype)sharedLoader;
+- (void)loadRequest:(NSURLRequest *)request
+           priority:(KRHttpRequestPriority)priority
+         identifier:(NSString * _Nullable)identifier
+         eventBlock:(KRHttpStreamEventBlock)eventBlock;
+- (void)cancelRequestWithIdentifier:(NSString *)identifier;
+
+@end
+
+@implementation KRHttpStreamLoader {
+    NSOperationQueue *_delegateQueue;
+    NSMutableDictionary<NSNumber *, KRHttpStreamContext *> *_contexts;
+    NSMutableDictionary<NSString *, NSURLSessionDataTask *> *_tasksByIdentifier;
+}
+
++ (instancetype)sharedLoader {
+    static KRHttpStreamLoader *loader;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        loader = [KRHttpStreamLoader new];
+    });
+    return loader;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _delegateQueue = [NSOperationQueue new];
+        _delegateQueue.maxConcurrentOperationCount = 1;
+        _delegateQueue.name = @"com.tencent.kuikly.http.stream";
+        _contexts = [NSMutableDictionary new];
+        _tasksByIdentifier = [NSMutableDictionary new];
+    }
+    return self;
+}
+
+- (void)loadRequest:(NSURLRequest *)request
+           priority:(KRHttpRequestPriority)priority
+         identifier:(NSString *)identifier
+         eventBlock:(KRHttpStreamEventBlock)eventBlock {
+    [_delegateQueue addOperationWithBlock:^{
+        NSURLSessionDataTask *task = [[KRHttpSessionPool sharedPool] dataTaskWithRequest:request delegate:self delegateQueue:self->_delegateQueue];
+        task.priority = [KRHttpRequestScheduler taskPriorityWithPriority:priority];
+        KRHttpStreamContext *context = [KRHttpStreamContext new];
+        context.identifier = identifier;
+        context.eventBlock = eventBlock;
+        self->_contexts[@(task.taskIdentifier)] = context;
+        if (identifier.length) {
+            self->_tasksByIdentifier[identifier] = task;
+        }
+        [task resume];
+    }];
+}
+
+- (void)cancelRequestWithIdentifier:(NSString *)identifier {
+    if (!identifier.length) {
+        return;
+    }
+    [_delegateQueue addOperationWithBlock:^{
+        [self->_tasksByIdentifier[identifier] cancel];
+    }];
+}
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+didReceiveResponse:(NSURLResponse *)response
+ completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler {
+    KRHttpStreamContext *context = _contexts[@(dataTask.taskIdentifier)];
+    if (context.eventBlock) {
+        context.eventBlock(response, nil, NO, nil);
+    }
+    completionHandler(NSURLSessionResponseAllow);
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data {
+    KRHttpStreamContext *context = _contexts[@(dataTask.taskIdentifier)];
+    if (!context.eventBlock) {
+        return;
+    }
+    if (!context.pendingData && data.length >= kKRHttpStreamChunkSize) {
+        // 足够大的分片直接透传，不做拷贝
+        context.eventBlock(nil, data, NO, nil);
+        return;
+    }
+    if (!context.pendingData) {
+        context.pendingData = [NSMutableData dataWithCapacity:kKRHttpStreamChunkSize];
+    }
+    [context.pendingData appendData:data];
+    if (context.pendingData.length >= kKRHttpStreamChunkSize) {
+        NSData *chunk = context.pendingData;
+        context.pendingData = nil;
+        context.eventBlock(nil, chunk, NO, nil);
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error {
+    NSNumber *taskKey = @(task.taskIdentifier);
+    KRHttpStreamContext *context = _contexts[taskKey];
+    [_contexts removeObjectForKey:taskKey];
+    if (context.identifier.length && _tasksByIdentifier[context.identifier] == task) {
+        [_tasksByIdentifier removeObjectForKey:context.identifier];
+    }
+    if (!context.eventBlock) {
+        return;
+    }
+    if (context.pendingData.length) {
+        context.eventBlock(nil, context.pendingData, NO, nil);
+        context.pendingData = nil;
+    }
+    if (!error) {
+        error = [KRHttpRequestUtil errorForNonSuccessResponse:task.response];
+    }
+    context.eventBlock(task.response, nil, YES, error);
+}
+
+@end
+
 @implementation KRHttpRequestTool
 
 
-+ (void)requestWithMethod:(NSString *)method url:(NSString *)url param:(NSDictionary *)param binaryData:(NSData * _Nullable)binaryData headers:(NSDictionary *)headerDics timeout:(float)timeout cookie:(NSString * _Nullable)p_cookie responseBlock:(KRKotlinHttpResponse)response {
-    if(!([url isKindOfClass:[NSString class]] && url.length)) return;
++ (void)requestWithMethod:(NSString *)method url:(NSString *)url param:(NSDictionary *)param binaryData:(NSData * _Nullable)binaryData headers:(NSDictionary *)headerDics timeout:(float)timeout cookie:(NSString * _Nullable)cookie responseBlock:(KRKotlinHttpResponse)response {
+    [self requestWithMethod:method
+                        url:url
+                      param:param
+                 binaryData:binaryData
+                    headers:headerDics
+                    timeout:timeout
+                     cookie:cookie
+                   priority:KRHttpRequestPriorityVisible
+                 identifier:nil
+                     pageId:nil
+              responseBlock:response];
+}
+
++ (void)requestWithMethod:(NSString *)method url:(NSString *)url param:(NSDictionary *)param binaryData:(NSData * _Nullable)binaryData headers:(NSDictionary *)headerDics timeout:(float)timeout cookie:(NSString * _Nullable)cookie priority:(KRHttpRequestPriority)priority identifier:(NSString * _Nullable)identifier pageId:(NSString * _Nullable)pageId responseBlock:(KRKotlinHttpResponse)response {
+    NSMutableURLRequest *request = [self _urlRequestWithMethod:method url:url param:param binaryData:binaryData headers:headerDics timeout:timeout cookie:cookie];
+    if (!request) {
+        return;
+    }
+    [KRHttpSessionPool setPageId:pageId forRequest:request];
+    // 调度器内部异步排队，无需再切到全局队列
+    [[KRHttpRequestScheduler sharedScheduler] scheduleRequest:request
+                                                     priority:priority
+                                                   identifier:identifier
+                                                   completion:^(NSData * _Nullable data, NSURLResponse * _Nullable response2, NSError * _Nullable error) {
+        if (response) {
+            response(data, response2, error);
+        }
+    }];
+}
+
++ (void)streamRequestWithMethod:(NSString *)method url:(NSString *)url param:(NSDictionary *)param binaryData:(NSData * _Nullable)binaryData headers:(NSDictionary *)headerDics timeout:(float)timeout cookie:(NSString * _Nullable)cookie priority:(KRHttpRequestPriority)priority identifier:(NSString * _Nullable)identifier pageId:(NSString * _Nullable)pageId eventBlock:(KRHttpStreamEventBlock)eventBlock {
+    NSMutableURLRequest *request = [self _urlRequestWithMethod:method url:url param:param binaryData:binaryData headers:headerDics timeout:timeout cookie:cookie];
+    if (!request) {
+        return;
+    }
+    [KRHttpSessionPool setPageId:pageId forRequest:request];
+    [[KRHttpStreamLoader sharedLoader] loadRequest:request priority:priority identifier:identifier eventBlock:eventBlock];
+}
+
++ (void)cancelRequestWithIdentifier:(NSString *)identifier {
+    [[KRHttpRequestScheduler sharedScheduler] cancelRequestWithIdentifier:identifier];
+    [[KRHttpStreamLoader sharedLoader] cancelRequestWithIdentifier:identifier];
+}
+
++ (NSMutableURLRequest *)_urlRequestWithMethod:(NSString *)method url:(NSString *)url param:(NSDictionary *)param binaryData:(NSData * _Nullable)binaryData headers:(NSDictionary *)headerDics timeout:(float)timeout cookie:(NSString * _Nullable)p_cookie {
+    if(!([url isKindOfClass:[NSString class]] && url.length)) return nil;
     BOOL binaryMode = binaryData ? YES : NO;
     param = [param isKindOfClass:[NSDictionary class]] ? param : @{};
     
@@ -88,14 +275,7 @@
         value = [NSString stringWithFormat:@"%@%@", value,cookie];
     }
     [request setValue:value forHTTPHeaderField:@"Cookie"];
-
-    dispatch_async(dispatch_get_global_queue(0, 0), ^{
-        [KRHttpRequestUtil kotlinRequestWithURLRequest:request completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response2, NSError * _Nullable error) {
-            if (response) {
-                response(data, response2, error);
-            }
-        }];
-    });
+    return request;
 }
 
 +(NSData *) toPostBodyFromParam:(NSDictionary *)dictionary {
@@ -120,6 +300,26 @@
 
 
 + (void)downloadWithUrl:(NSString * )url param:(NSDictionary * _Nullable)params sotrePath:(NSString * )path responseBlock:(KRHttpFileResponse)completion{
+    [self downloadWithUrl:url param:params storePath:path progress:nil responseBlock:completion];
+}
+
++ (NSString *)downloadWithUrl:(NSString *)url param:(NSDictionary * _Nullable)params storePath:(NSString *)path progress:(KRHttpDownloadProgressBlock _Nullable)progress responseBlock:(KRHttpFileResponse)completion {
+    if ([path isKindOfClass:[NSString class]] && path.length) {
+        KRHttpDownloadOptions *options = [KRHttpDownloadOptions new];
+        if ([params isKindOfClass:[NSDictionary class]]) {
+            if ([params[@"md5"] isKindOfClass:[NSString class]]) {
+                options.expectedMD5 = params[@"md5"];
+            }
+            if ([params[@"maxConnections"] respondsToSelector:@selector(unsignedIntegerValue)]) {
+                options.maxConnections = [params[@"maxConnections"] unsignedIntegerValue];
+            }
+        }
+        return [[KRHttpDownloader sharedDownloader] downloadWithURL:url
+                                                          storePath:path
+                                                            options:options
+                                                           progress:progress
+                                                         completion:completion];
+    }
     [KRHttpRequestUtil downloadWithUrl:url  responseBlock:^(NSString * _Nullable tempPath, NSError * _Nullable error) {
         NSString * sotrePath = tempPath;
         if (path && tempPath && [[NSFileManager defaultManager] fileExistsAtPath:tempPath]){
@@ -141,10 +341,10 @@
             completion(sotrePath,error);
         }
     }];
+    return nil;
 }
 
 
-
 + (NSMutableURLRequest *)_requestWithMethod:(NSString *)method
                                  URLString:(NSString *)URLString
                                 parameters:(id)parameters
@@ -199,7 +399,7 @@
 }
 
 + (NSURLSessionDataTask *)requestWithURLRequest:(NSURLRequest *)request completionHandler:(void (^)(NSDictionary * _Nullable json, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler{
-    NSURLSession * session = [NSURLSession sharedSession];
+    NSURLSession * session = [KRHttpSessionPool sharedPool].dataSession;
     
     
     __block NSURLSessionDataTask * task = nil;
@@ -209,13 +409,10 @@
             dispatch_async(dispatch_get_global_queue(0, 0), ^{
                 if([data isKindOfClass:[NSData class]]){
                 
-                    NSDictionary * json = nil;
-                    @try{
-                        json = [NSJSONSerialization JSONObjectWithData:data options:kNilOptions error:nil];
-                    }
-                    @catch(NSException * e){
-                        NSLog(@"KRHttpRequestUtil_error_%@",e);
-    
+                    // 懒加载解析：调用方通常只读取少量字段，无需构建整棵对象树
+                    id json = data.length ? [KRJSONParser objectWithData:data error:nil] : nil;
+                    if (![json isKindOfClass:[NSDictionary class]] && ![json isKindOfClass:[NSArray class]]) {
+                        json = nil; // 与NSJSONSerialization一致，顶层须为对象或数组
                     }
                     if (!error && data.length && !json) {
                         NSString *dataString = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
@@ -241,8 +438,21 @@
     return task;
 }
 
++ (NSError *)errorForNonSuccessResponse:(NSURLResponse *)response {
+    if (![response isKindOfClass:[NSHTTPURLResponse class]]) {
+        return nil;
+    }
+    NSInteger statusCode = ((NSHTTPURLResponse *)response).statusCode;
+    if (statusCode >= 200 && statusCode < 300) {
+        return nil;
+    }
+    [KRLogModule logError:[NSString stringWithFormat:@"Received a non-success status code: %ld", (long)statusCode]];
+    // Create a custom error for the non-success status code
+    return [NSError errorWithDomain:@"ServeErrorDomain" code:statusCode userInfo:@{NSLocalizedDescriptionKey:[NSString stringWithFormat:@"Server returned a non-success status code: %ld", (long)statusCode]}];
+}
+
 + (NSURLSessionDataTask *)kotlinRequestWithURLRequest:(NSURLRequest *)request completionHandler:(void (^)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler{
-    NSURLSession * session = [NSURLSession sharedSession];
+    NSURLSession * session = [KRHttpSessionPool sharedPool].dataSession;
     __block NSURLSessionDataTask * task = nil;
     url_session_manager_create_task_safely(^{
        task = [session dataTaskWithRequest:request completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable e) {
@@ -251,15 +461,7 @@
                 if([data isKindOfClass:[NSData class]]){
 
                     // Check if the response has a non-success status code
-                    if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
-                        NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *)response;
-                        NSInteger statusCode = httpResponse.statusCode;
-                        if (statusCode < 200 || statusCode >= 300) {
-                            [KRLogModule logError:[NSString stringWithFormat:@"Received a non-success status code: %ld", (long)statusCode]];
-                            // Create a custom error for the non-success status code
-                            error = [NSError errorWithDomain:@"ServeErrorDomain" code:statusCode userInfo:@{NSLocalizedDescriptionKey:[NSString stringWithFormat:@"Server returned a non-success status code: %ld", (long)statusCode]}];
-                        }
-                    }
+                    error = [KRHttpRequestUtil errorForNonSuccessResponse:response] ?: error;
                     if(completionHandler){
                         completionHandler(data, response, error);
                     }
@@ -279,7 +481,7 @@
 
 
 + (void)downloadWithUrl:(NSString * )url  responseBlock:(KRHttpFileResponse)response{
-    NSURLSession * session = [NSURLSession sharedSession];
+    NSURLSession * session = [KRHttpSessionPool sharedPool].dataSession;
     NSMutableURLRequest * urlRequest = [[NSMutableURLRequest alloc] initWithURL:[NSURL URLWithString:url]];
     urlRequest.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
  
@@ -303,7 +505,7 @@
 
 + (void)uploadWithUrlRequest:(NSURLRequest *)urlRequest fileAtPath:(NSString *)filePath responseBlock:(KRHttpResponse)responseBlock{
     
-    NSURLSession * session = [NSURLSession sharedSession];
+    NSURLSession * session = [KRHttpSessionPool sharedPool].dataSession;
     
     NSURL * fileUrl = [NSURL fileURLWithPath:filePath];
     NSURLSessionUploadTask * task =  [session uploadTaskWithRequest:urlRequest fromFile:fileUrl completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
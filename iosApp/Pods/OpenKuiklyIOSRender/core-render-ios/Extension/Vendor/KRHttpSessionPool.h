@@ -0,0 +1,92 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 每个请求完成时发出，object为KRHttpTaskMetrics，在后台线程发出
+extern NSString *const KRHttpTaskMetricsNotification;
+
+/*
+ * 单个请求的网络耗时（单位毫秒，阶段未发生时为0，如复用连接时没有DNS/TCP/TLS耗时）
+ */
+@interface KRHttpTaskMetrics : NSObject
+
+@property (nonatomic, copy, readonly) NSString *url;
+@property (nonatomic, copy, readonly) NSString *host;
+@property (nonatomic, copy, readonly) NSString *method;
+@property (nonatomic, assign, readonly) NSInteger statusCode;
+/// 协议，如h2、http/1.1
+@property (nonatomic, copy, readonly) NSString *protocolName;
+@property (nonatomic, assign, readonly) BOOL reusedConnection;
+/// 开始时间（1970年起，毫秒）
+@property (nonatomic, assign, readonly) NSTimeInterval startTime;
+@property (nonatomic, assign, readonly) NSTimeInterval dnsCost;
+@property (nonatomic, assign, readonly) NSTimeInterval tcpCost;
+@property (nonatomic, assign, readonly) NSTimeInterval tlsCost;
+/// 发出请求到收到首字节
+@property (nonatomic, assign, readonly) NSTimeInterval ttfbCost;
+/// 首字节到接收完成
+@property (nonatomic, assign, readonly) NSTimeInterval downloadCost;
+@property (nonatomic, assign, readonly) NSTimeInterval totalCost;
+@property (nonatomic, assign, readonly) int64_t responseBytes;
+/// 发起请求的页面，见KRHttpSessionPool pageIdForOwner:
+@property (nonatomic, copy, readonly, nullable) NSString *pageId;
+
+- (NSDictionary *)toDictionary;
+
+@end
+
+/*
+ * 网络请求专用session（替代sharedSession）：所有请求（含自定义delegate的流式、分片下载任务）
+ * 都在同一个NSURLSession上发出，共享连接池，HTTP/2下同host复用连接；
+ * 并采集每个请求的URLSessionTaskMetrics，按页面保存，供KRPerformanceModule上报
+ */
+@interface KRHttpSessionPool : NSObject
+
++ (instancetype)sharedPool;
+
+/// 修改session配置，需在首次使用session之前调用，之后调用无效
+- (void)configureWithBlock:(void (^)(NSURLSessionConfiguration *configuration))block;
+/// 普通请求session（支持completionHandler，metrics自动采集）
+@property (nonatomic, strong, readonly) NSURLSession *dataSession;
+/*
+ * @brief 在dataSession上创建由delegate接收回调的任务（未resume）
+ * 响应、数据、完成回调按序转发到queue上执行，session参数为dataSession；metrics由连接池统一采集，不转发
+ */
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                                     delegate:(id<NSURLSessionDataDelegate>)delegate
+                                delegateQueue:(NSOperationQueue *)queue;
+
+/*
+ * @brief 预连接，页面加载前提前完成DNS/TCP/TLS（对host根路径发HEAD请求，忽略结果，不计入耗时统计）
+ * @param urls 页面会访问的url或host（如https://example.com），30秒内已预连接的host会跳过
+ */
+- (void)warmUpWithURLs:(NSArray<NSString *> *)urls;
+
+/// 页面标识，同一owner（如页面的KuiklyRenderView）返回同一值，owner为nil时返回nil
++ (nullable NSString *)pageIdForOwner:(nullable id)owner;
+/// 标记请求所属页面，该请求的耗时记录在该页面下（合并的请求记在首个发起的页面下）
++ (void)setPageId:(nullable NSString *)pageId forRequest:(NSMutableURLRequest *)request;
+
+/// 最近的请求耗时（最多保留128条），按完成顺序
+- (NSArray<KRHttpTaskMetrics *> *)recentMetrics;
+/// 指定页面最近的请求耗时（每个页面最多保留128条，只保留最近16个页面），按完成顺序
+- (NSArray<KRHttpTaskMetrics *> *)metricsForPageId:(nullable NSString *)pageId;
+
+@end
+
+NS_ASSUME_NONNULL_END
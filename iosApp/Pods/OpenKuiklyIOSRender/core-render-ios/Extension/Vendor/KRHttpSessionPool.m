@@ -0,0 +1,409 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRHttpSessionPool.h"
+#import <objc/runtime.h>
+#import <stdatomic.h>
+#import "KRLogModule.h"
+
+NSString *const KRHttpTaskMetricsNotification = @"KRHttpTaskMetricsNotification";
+
+/// 保留的请求耗时条数
+static const NSUInteger kKRHttpMetricsCapacity = 128;
+/// 保留耗时记录的页面数
+static const NSUInteger kKRHttpMetricsPageCapacity = 16;
+/// 同一host预连接的最小间隔（秒）
+static const NSTimeInterval kKRHttpWarmUpInterval = 30;
+/// 预连接任务的taskDescription，其耗时不计入统计
+static NSString *const kKRHttpWarmUpTaskDescription = @"com.tencent.kuikly.http.warmup";
+/// 请求所属页面（NSURLProtocol属性）
+static NSString *const kKRHttpPageIdPropertyKey = @"KRHttpPageId";
+
+static NSTimeInterval KRHttpIntervalMs(NSDate *start, NSDate *end) {
+    if (!start || !end) {
+        return 0;
+    }
+    return MAX(0, [end timeIntervalSinceDate:start] * 1000);
+}
+
+@interface KRHttpTaskMetrics ()
+
+@property (nonatomic, copy) NSString *url;
+@property (nonatomic, copy) NSString *host;
+@property (nonatomic, copy) NSString *method;
+@property (nonatomic, assign) NSInteger statusCode;
+@property (nonatomic, copy) NSString *protocolName;
+@property (nonatomic, assign) BOOL reusedConnection;
+@property (nonatomic, assign) NSTimeInterval startTime;
+@property (nonatomic, assign) NSTimeInterval dnsCost;
+@property (nonatomic, assign) NSTimeInterval tcpCost;
+@property (nonatomic, assign) NSTimeInterval tlsCost;
+@property (nonatomic, assign) NSTimeInterval ttfbCost;
+@property (nonatomic, assign) NSTimeInterval downloadCost;
+@property (nonatomic, assign) NSTimeInterval totalCost;
+@property (nonatomic, assign) int64_t responseBytes;
+@property (nonatomic, copy) NSString *pageId;
+
+@end
+
+@implementation KRHttpTaskMetrics
+
+- (NSDictionary *)toDictionary {
+    return @{
+        @"url": _url ?: @"",
+        @"method": _method ?: @"",
+        @"statusCode": @(_statusCode),
+        @"protocol": _protocolName ?: @"",
+        @"reused": @(_reusedConnection),
+        @"startTime": @((long long)_startTime),
+        @"dns": @((int)_dnsCost),
+        @"tcp": @((int)_tcpCost),
+        @"tls": @((int)_tlsCost),
+        @"ttfb": @((int)_ttfbCost),
+        @"download": @((int)_downloadCost),
+        @"total": @((int)_totalCost),
+        @"bytes": @(_responseBytes),
+    };
+}
+
+@end
+
+@interface KRHttpSessionPool ()
+
+- (void)p_reportMetrics:(NSURLSessionTaskMetrics *)metrics task:(NSURLSessionTask *)task API_AVAILABLE(ios(10.0));
+
+@end
+
+/// 自定义delegate任务的回调目标
+@interface KRHttpTaskDelegateEntry : NSObject
+
+@property (nonatomic, strong) id<NSURLSessionDataDelegate> delegate;
+@property (nonatomic, strong) NSOperationQueue *queue;
+
+@end
+
+@implementation KRHttpTaskDelegateEntry
+
+@end
+
+/*
+ * dataSession的delegate：统一采集metrics；通过dataTaskWithRequest:delegate:delegateQueue:创建的任务，
+ * 把数据回调转发给各自的delegate（completionHandler任务不走这些回调）
+ */
+@interface KRHttpSessionDelegateRouter : NSObject<NSURLSessionDataDelegate>
+
+@property (nonatomic, weak) KRHttpSessionPool *pool;
+
+- (void)registerTask:(NSURLSessionTask *)task delegate:(id<NSURLSessionDataDelegate>)delegate queue:(NSOperationQueue *)queue;
+
+@end
+
+@implementation KRHttpSessionDelegateRouter {
+    NSMutableDictionary<NSNumber *, KRHttpTaskDelegateEntry *> *_entries;
+    NSLock *_lock;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _entries = [NSMutableDictionary new];
+        _lock = [NSLock new];
+    }
+    return self;
+}
+
+- (void)registerTask:(NSURLSessionTask *)task delegate:(id<NSURLSessionDataDelegate>)delegate queue:(NSOperationQueue *)queue {
+    KRHttpTaskDelegateEntry *entry = [KRHttpTaskDelegateEntry new];
+    entry.delegate = delegate;
+    entry.queue = queue;
+    [_lock lock];
+    _entries[@(task.taskIdentifier)] = entry;
+    [_lock unlock];
+}
+
+- (KRHttpTaskDelegateEntry *)p_entryForTask:(NSURLSessionTask *)task remove:(BOOL)remove {
+    NSNumber *key = @(task.taskIdentifier);
+    [_lock lock];
+    KRHttpTaskDelegateEntry *entry = _entries[key];
+    if (remove) {
+        [_entries removeObjectForKey:key];
+    }
+    [_lock unlock];
+    return entry;
+}
+
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+didReceiveResponse:(NSURLResponse *)response
+ completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler {
+    KRHttpTaskDelegateEntry *entry = [self p_entryForTask:dataTask remove:NO];
+    id<NSURLSessionDataDelegate> delegate = entry.delegate;
+    if (![delegate respondsToSelector:@selector(URLSession:dataTask:didReceiveResponse:completionHandler:)]) {
+        completionHandler(NSURLSessionResponseAllow);
+        return;
+    }
+    [entry.queue addOperationWithBlock:^{
+        [delegate URLSession:session dataTask:dataTask didReceiveResponse:response completionHandler:completionHandler];
+    }];
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data {
+    KRHttpTaskDelegateEntry *entry = [self p_entryForTask:dataTask remove:NO];
+    id<NSURLSessionDataDelegate> delegate = entry.delegate;
+    if (![delegate respondsToSelector:@selector(URLSession:dataTask:didReceiveData:)]) {
+        return;
+    }
+    [entry.queue addOperationWithBlock:^{
+        [delegate URLSession:session dataTask:dataTask didReceiveData:data];
+    }];
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics API_AVAILABLE(ios(10.0)) {
+    [self.pool p_reportMetrics:metrics task:task];
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error {
+    KRHttpTaskDelegateEntry *entry = [self p_entryForTask:task remove:YES];
+    id<NSURLSessionDataDelegate> delegate = entry.delegate;
+    if (![delegate respondsToSelector:@selector(URLSession:task:didCompleteWithError:)]) {
+        return;
+    }
+    [entry.queue addOperationWithBlock:^{
+        [delegate URLSession:session task:task didCompleteWithError:error];
+    }];
+}
+
+@end
+
+@implementation KRHttpSessionPool {
+    NSURLSessionConfiguration *_configuration;
+    NSURLSession *_dataSession;
+    KRHttpSessionDelegateRouter *_router;
+    NSOperationQueue *_delegateQueue;
+    NSMutableArray<KRHttpTaskMetrics *> *_metrics;
+    NSMutableDictionary<NSString *, NSMutableArray<KRHttpTaskMetrics *> *> *_metricsByPage;
+    /// 按首次记录顺序，超出容量时淘汰最早的页面
+    NSMutableArray<NSString *> *_metricsPageOrder;
+    NSMutableDictionary<NSString *, NSDate *> *_warmUpDates;
+    NSLock *_lock;
+}
+
++ (instancetype)sharedPool {
+    static KRHttpSessionPool *pool;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        pool = [KRHttpSessionPool new];
+    });
+    return pool;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+        _configuration.HTTPMaximumConnectionsPerHost = 6;
+        _configuration.timeoutIntervalForRequest = 30;
+        _delegateQueue = [NSOperationQueue new];
+        _delegateQueue.maxConcurrentOperationCount = 1;
+        _delegateQueue.name = @"com.tencent.kuikly.http.session";
+        _metrics = [NSMutableArray new];
+        _metricsByPage = [NSMutableDictionary new];
+        _metricsPageOrder = [NSMutableArray new];
+        _warmUpDates = [NSMutableDictionary new];
+        _lock = [NSLock new];
+    }
+    return self;
+}
+
+- (void)configureWithBlock:(void (^)(NSURLSessionConfiguration *))block {
+    [_lock lock];
+    if (_dataSession) {
+        [_lock unlock];
+        [KRLogModule logError:@"KRHttpSessionPool configure after session created, ignored"];
+        return;
+    }
+    if (block) {
+        block(_configuration);
+    }
+    [_lock unlock];
+}
+
+- (NSURLSession *)dataSession {
+    [_lock lock];
+    if (!_dataSession) {
+        _router = [KRHttpSessionDelegateRouter new];
+        _router.pool = self;
+        _dataSession = [NSURLSession sessionWithConfiguration:_configuration delegate:_router delegateQueue:_delegateQueue];
+    }
+    NSURLSession *session = _dataSession;
+    [_lock unlock];
+    return session;
+}
+
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                                     delegate:(id<NSURLSessionDataDelegate>)delegate
+                                delegateQueue:(NSOperationQueue *)queue {
+    NSURLSessionDataTask *task = [self.dataSession dataTaskWithRequest:request];
+    // resume前注册，不会漏掉回调
+    [_router registerTask:task delegate:delegate queue:queue];
+    return task;
+}
+
+#pragma mark - warm up
+
+- (void)warmUpWithURLs:(NSArray<NSString *> *)urls {
+    if (![urls isKindOfClass:[NSArray class]]) {
+        return;
+    }
+    NSMutableArray<NSURL *> *origins = [NSMutableArray new];
+    NSDate *now = [NSDate date];
+    [_lock lock];
+    for (NSString *urlString in urls) {
+        if (![urlString isKindOfClass:[NSString class]]) {
+            continue;
+        }
+        NSURLComponents *components = [NSURLComponents componentsWithString:urlString];
+        if (!components.host.length) {
+            continue;
+        }
+        NSString *scheme = components.scheme.length ? components.scheme : @"https";
+        NSString *origin = components.port ? [NSString stringWithFormat:@"%@://%@:%@/", scheme, components.host, components.port]
+                                           : [NSString stringWithFormat:@"%@://%@/", scheme, components.host];
+        NSDate *lastDate = _warmUpDates[origin];
+        if (lastDate && [now timeIntervalSinceDate:lastDate] < kKRHttpWarmUpInterval) {
+            continue;
+        }
+        _warmUpDates[origin] = now;
+        NSURL *originURL = [NSURL URLWithString:origin];
+        if (originURL) {
+            [origins addObject:originURL];
+        }
+    }
+    [_lock unlock];
+
+    NSURLSession *session = self.dataSession;
+    for (NSURL *origin in origins) {
+        NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:origin
+                                                               cachePolicy:NSURLRequestReloadIgnoringLocalCacheData
+                                                           timeoutInterval:10];
+        request.HTTPMethod = @"HEAD";
+        // 只为建立连接，结果忽略；连接保留在session连接池中供后续请求复用
+        NSURLSessionDataTask *task = [session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {}];
+        task.taskDescription = kKRHttpWarmUpTaskDescription;
+        [task resume];
+    }
+}
+
+#pragma mark - metrics
+
++ (NSString *)pageIdForOwner:(id)owner {
+    static const void *kPageIdKey = &kPageIdKey;
+    static atomic_uint_fast64_t nextPageId;
+    if (!owner) {
+        return nil;
+    }
+    @synchronized (owner) {
+        NSString *pageId = objc_getAssociatedObject(owner, kPageIdKey);
+        if (!pageId) {
+            pageId = [NSString stringWithFormat:@"%llu", (unsigned long long)atomic_fetch_add(&nextPageId, 1) + 1];
+            objc_setAssociatedObject(owner, kPageIdKey, pageId, OBJC_ASSOCIATION_COPY_NONATOMIC);
+        }
+        return pageId;
+    }
+}
+
++ (void)setPageId:(NSString *)pageId forRequest:(NSMutableURLRequest *)request {
+    if (pageId.length) {
+        [NSURLProtocol setProperty:pageId forKey:kKRHttpPageIdPropertyKey inRequest:request];
+    }
+}
+
+- (void)p_reportMetrics:(NSURLSessionTaskMetrics *)metrics task:(NSURLSessionTask *)task {
+    NSURLSessionTaskTransactionMetrics *transaction = metrics.transactionMetrics.lastObject;
+    if (!transaction || transaction.resourceFetchType == NSURLSessionTaskMetricsResourceFetchTypeLocalCache
+        || [task.taskDescription isEqualToString:kKRHttpWarmUpTaskDescription]) {
+        return;
+    }
+    KRHttpTaskMetrics *record = [KRHttpTaskMetrics new];
+    NSURLRequest *request = task.originalRequest ?: transaction.request;
+    record.pageId = [NSURLProtocol propertyForKey:kKRHttpPageIdPropertyKey inRequest:request];
+    record.url = request.URL.absoluteString ?: @"";
+    record.host = request.URL.host ?: @"";
+    record.method = request.HTTPMethod ?: @"GET";
+    if ([transaction.response isKindOfClass:[NSHTTPURLResponse class]]) {
+        record.statusCode = ((NSHTTPURLResponse *)transaction.response).statusCode;
+    }
+    record.protocolName = transaction.networkProtocolName ?: @"";
+    record.reusedConnection = transaction.isReusedConnection;
+    record.startTime = [metrics.taskInterval.startDate timeIntervalSince1970] * 1000;
+    record.dnsCost = KRHttpIntervalMs(transaction.domainLookupStartDate, transaction.domainLookupEndDate);
+    record.tlsCost = KRHttpIntervalMs(transaction.secureConnectionStartDate, transaction.secureConnectionEndDate);
+    // connectStart~connectEnd包含TLS握手，这里只算TCP
+    record.tcpCost = MAX(0, KRHttpIntervalMs(transaction.connectStartDate, transaction.connectEndDate) - record.tlsCost);
+    record.ttfbCost = KRHttpIntervalMs(transaction.requestStartDate, transaction.responseStartDate);
+    record.downloadCost = KRHttpIntervalMs(transaction.responseStartDate, transaction.responseEndDate);
+    record.totalCost = metrics.taskInterval.duration * 1000;
+    if (@available(iOS 13.0, *)) {
+        record.responseBytes = transaction.countOfResponseBodyBytesReceived;
+    } else {
+        record.responseBytes = task.countOfBytesReceived;
+    }
+
+    [_lock lock];
+    [_metrics addObject:record];
+    if (_metrics.count > kKRHttpMetricsCapacity) {
+        [_metrics removeObjectsInRange:NSMakeRange(0, _metrics.count - kKRHttpMetricsCapacity)];
+    }
+    if (record.pageId) {
+        [self p_addPageMetrics:record];
+    }
+    [_lock unlock];
+    [[NSNotificationCenter defaultCenter] postNotificationName:KRHttpTaskMetricsNotification object:record];
+}
+
+- (NSArray<KRHttpTaskMetrics *> *)recentMetrics {
+    [_lock lock];
+    NSArray *metrics = [_metrics copy];
+    [_lock unlock];
+    return metrics;
+}
+
+- (NSArray<KRHttpTaskMetrics *> *)metricsForPageId:(NSString *)pageId {
+    if (!pageId) {
+        return @[];
+    }
+    [_lock lock];
+    NSArray *metrics = [_metricsByPage[pageId] copy] ?: @[];
+    [_lock unlock];
+    return metrics;
+}
+
+/// 需持有_lock
+- (void)p_addPageMetrics:(KRHttpTaskMetrics *)record {
+    NSMutableArray<KRHttpTaskMetrics *> *pageMetrics = _metricsByPage[record.pageId];
+    if (!pageMetrics) {
+        pageMetrics = [NSMutableArray new];
+        _metricsByPage[record.pageId] = pageMetrics;
+        [_metricsPageOrder addObject:record.pageId];
+        if (_metricsPageOrder.count > kKRHttpMetricsPageCapacity) {
+            [_metricsByPage removeObjectForKey:_metricsPageOrder.firstObject];
+            [_metricsPageOrder removeObjectAtIndex:0];
+        }
+    }
+    [pageMetrics addObject:record];
+    if (pageMetrics.count > kKRHttpMetricsCapacity) {
+        [pageMetrics removeObjectAtIndex:0];
+    }
+}
+
+@end
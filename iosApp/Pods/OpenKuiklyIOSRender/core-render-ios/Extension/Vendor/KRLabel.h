@@ -28,8 +28,12 @@ extern NSString *const KRBGAttributeKey;
 @interface KRLabel : UILabel
 
 @property (nonatomic, strong, nullable) KRTextRender *textRender;
+/// 是否在后台线程绘制文本（默认NO），结果按内容与尺寸缓存
 @property (nonatomic, assign) BOOL displaysAsynchronously;
 
+/// 作废进行中的异步绘制并清空已绘制内容（文本变化时自动调用）
+- (void)cancelAsyncDisplay;
+
 /**
  * 获取富文本的对应尺寸大小
  * note：任意线程都可以调用该方法，一般用于 子线程 执行
@@ -83,6 +87,10 @@ extern NSString *const KRBGAttributeKey;
 - (CGRect)boundingRectForCharacterRange:(NSRange)characterRange;
 - (CGRect)boundingRectForGlyphRange:(NSRange)glyphRange ;
 - (CGSize)textSizeWithRenderWidth:(CGFloat)renderWidth;
+/// 记录测量结果（命中测量缓存时使用），容器按该宽度懒排版
+- (void)setMeasuredSize:(CGSize)measuredSize renderWidth:(CGFloat)renderWidth;
+/// 绘制前设置排版尺寸，与测量同宽且高度足够时沿用测量的排版
+- (void)prepareForDrawingWithSize:(CGSize)size;
 - (NSInteger)characterIndexForPoint:(CGPoint)point;
 
 /**
@@ -19,12 +19,94 @@
 #import "KRAsyncDeallocManager.h"
 #import <objc/runtime.h>
 #import "NSObject+KR.h"
+#import "KRTextLayoutEngine.h"
+#import <stdatomic.h>
 
 #define KRAssertMainThread() NSAssert(0 != pthread_main_np(), @"This method must be called on the main thread!")
 NSString *const KRHighlightAttributeKey = @"KRHighlightAttributeKey";
 NSString *const KRBGAttributeKey = @"KRBGAttributeKey";
 
-@interface KRLabel()
+/// 异步绘制位图缓存上限（字节）
+static const NSUInteger kKRLabelAsyncBitmapCacheCostLimit = 20 * 1024 * 1024;
+
+/// 异步绘制位图缓存key：富文本内容（含颜色）、排版参数、尺寸与scale
+@interface KRLabelBitmapKey : NSObject<NSCopying> {
+@public
+    NSAttributedString *_attributedString;
+    CGSize _size;
+    CGFloat _scale;
+    NSUInteger _numberOfLines;
+    NSLineBreakMode _lineBreakMode;
+    CGFloat _lineBreakMargin;
+    CGFloat _lineHeight;
+    NSUInteger _hash;
+}
+@end
+
+@implementation KRLabelBitmapKey
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+- (NSUInteger)hash {
+    return _hash;
+}
+
+- (BOOL)isEqual:(KRLabelBitmapKey *)other {
+    if (self == other) {
+        return YES;
+    }
+    if (![other isKindOfClass:[KRLabelBitmapKey class]] || other->_hash != _hash) {
+        return NO;
+    }
+    return CGSizeEqualToSize(other->_size, _size)
+        && other->_scale == _scale
+        && other->_numberOfLines == _numberOfLines
+        && other->_lineBreakMode == _lineBreakMode
+        && other->_lineBreakMargin == _lineBreakMargin
+        && other->_lineHeight == _lineHeight
+        && [other->_attributedString isEqualToAttributedString:_attributedString];
+}
+
+@end
+
+static NSCache<KRLabelBitmapKey *, UIImage *> *KRLabelBitmapCache(void) {
+    static NSCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [NSCache new];
+        cache.totalCostLimit = kKRLabelAsyncBitmapCacheCostLimit;
+    });
+    return cache;
+}
+
+static dispatch_queue_t KRLabelAsyncDisplayQueue(void) {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        dispatch_queue_attr_t attr = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0);
+        queue = dispatch_queue_create("com.tencent.kuikly.label.display", attr);
+    });
+    return queue;
+}
+
+/// 异步绘制代数，后台队列只持有该对象，不触碰label
+@interface KRLabelDisplayToken : NSObject {
+@public
+    /// 文本变化、复用、label释放时递增，用于作废进行中的异步绘制
+    atomic_uint_fast64_t _generation;
+}
+@end
+
+@implementation KRLabelDisplayToken
+@end
+
+@interface KRLabel() {
+    /// 承载异步绘制结果
+    CALayer *_asyncTextLayer;
+    KRLabelDisplayToken *_asyncDisplayToken;
+}
 
 @end
 
@@ -47,19 +129,42 @@ NSString *const KRBGAttributeKey = @"KRBGAttributeKey";
     [super setAttributedText:attributedText];
     self.textRender = attributedText.hr_textRender;
     self.attributedText.hr_textRender = self.textRender;
+    [self cancelAsyncDisplay];
     [self setNeedsDisplay];
 }
 
+- (void)setDisplaysAsynchronously:(BOOL)displaysAsynchronously {
+    if (_displaysAsynchronously == displaysAsynchronously) {
+        return;
+    }
+    _displaysAsynchronously = displaysAsynchronously;
+    if (!displaysAsynchronously) {
+        [self cancelAsyncDisplay];
+        [_asyncTextLayer removeFromSuperlayer];
+        _asyncTextLayer = nil;
+    }
+    [self setNeedsDisplay];
+}
+
+- (void)cancelAsyncDisplay {
+    if (_asyncDisplayToken) {
+        atomic_fetch_add(&_asyncDisplayToken->_generation, 1);
+    }
+    _asyncTextLayer.contents = nil;
+}
+
 
 - (void)drawTextInRect:(CGRect)rect {
-    // 使用TextKit绘制文本
-    self.textRender.size = rect.size;
-    if (self.textRender.lineBreakMargin > 0 && self.textRender.isBreakLine) {
-        CGSize size = self.textRender.size;
-        UIBezierPath * bezierPath = [UIBezierPath bezierPathWithRect:CGRectMake(size.width - self.textRender.lineBreakMargin, size.height - 10, self.textRender.lineBreakMargin, 10)];
-        self.textRender.textContainer.exclusionPaths = @[bezierPath];
+    // 高亮态的绘制依赖主线程layoutManager的状态，且需即时反馈，此时同步绘制
+    if (self.displaysAsynchronously && self.textRender.layoutManager.highlightRange.length == 0) {
+        [self p_displayTextAsynchronouslyInRect:rect];
+        return;
     }
-    
+    if (_asyncTextLayer.contents) {
+        [self cancelAsyncDisplay];
+    }
+    // 使用TextKit绘制文本
+    [self.class p_prepareTextRender:self.textRender forDrawingInSize:rect.size];
     [self.textRender drawTextAtPoint:rect.origin isCanceled:nil];
 
 }
@@ -72,6 +177,106 @@ NSString *const KRBGAttributeKey = @"KRBGAttributeKey";
 }
 
 
+#pragma mark - async display
+
+/// 后台绘制文本到位图，相同内容与尺寸的位图直接复用
+- (void)p_displayTextAsynchronouslyInRect:(CGRect)rect {
+    KRTextRender *textRender = self.textRender;
+    NSAttributedString *attributedText = self.attributedText;
+    CGFloat scale = self.layer.contentsScale;
+    if (!_asyncTextLayer) {
+        _asyncTextLayer = [CALayer layer];
+        _asyncTextLayer.contentsScale = scale;
+        // 位于附件view之下
+        [self.layer insertSublayer:_asyncTextLayer atIndex:0];
+    }
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    _asyncTextLayer.frame = rect;
+    [CATransaction commit];
+    if (!_asyncDisplayToken) {
+        _asyncDisplayToken = [KRLabelDisplayToken new];
+    }
+    KRLabelDisplayToken *token = _asyncDisplayToken;
+    uint_fast64_t generation = atomic_fetch_add(&token->_generation, 1) + 1;
+    // 主线程的排版仍需按绘制尺寸设置，供点击等查询使用（懒排版，此处不触发）
+    [self.class p_prepareTextRender:textRender forDrawingInSize:rect.size];
+    if (!textRender || !attributedText.length || rect.size.width <= 0 || rect.size.height <= 0) {
+        _asyncTextLayer.contents = nil;
+        return;
+    }
+
+    KRLabelBitmapKey *key = [KRLabelBitmapKey new];
+    key->_attributedString = [attributedText copy];
+    key->_size = rect.size;
+    key->_scale = scale;
+    key->_numberOfLines = textRender.maximumNumberOfLines;
+    key->_lineBreakMode = textRender.textContainer.lineBreakMode;
+    key->_lineBreakMargin = textRender.lineBreakMargin;
+    key->_lineHeight = textRender.lineHeight;
+    key->_hash = attributedText.string.hash * 31 + @(rect.size.width).hash * 17 + @(rect.size.height).hash + (NSUInteger)scale;
+    UIImage *cachedImage = [KRLabelBitmapCache() objectForKey:key];
+    if (cachedImage) {
+        _asyncTextLayer.contents = (__bridge id)cachedImage.CGImage;
+        return;
+    }
+
+    // 主线程的textRender还会被点击查询等使用，后台用独立的一份（排版栈来自池，创建开销小）
+    KRTextRender *drawRender = [[KRTextRender alloc] initWithAttributedText:key->_attributedString];
+    drawRender.lineHeight = textRender.lineHeight;
+    drawRender.lineBreakMargin = textRender.lineBreakMargin;
+    drawRender.maximumNumberOfLines = textRender.maximumNumberOfLines;
+    drawRender.lineBreakMode = textRender.textContainer.lineBreakMode;
+    drawRender.isBreakLine = textRender.isBreakLine;
+    // 后台只读token，label仅在主线程提交结果时访问
+    BOOL (^isCanceled)(void) = ^BOOL {
+        return atomic_load(&token->_generation) != generation;
+    };
+    // 提交结果的block在主线程创建，后台block只持有它，不复制对label的weak引用
+    __weak typeof(self) weakSelf = self;
+    void (^commit)(UIImage *) = ^(UIImage *image) {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf || isCanceled()) {
+            return;
+        }
+        [CATransaction begin];
+        [CATransaction setDisableActions:YES];
+        strongSelf->_asyncTextLayer.contents = (__bridge id)image.CGImage;
+        [CATransaction commit];
+    };
+    CGSize size = rect.size;
+    dispatch_async(KRLabelAsyncDisplayQueue(), ^{
+        if (isCanceled()) {
+            return;
+        }
+        [KRLabel p_prepareTextRender:drawRender forDrawingInSize:size];
+        UIGraphicsBeginImageContextWithOptions(size, NO, scale);
+        [drawRender drawTextAtPoint:CGPointZero isCanceled:isCanceled];
+        UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+        UIGraphicsEndImageContext();
+        if (!image || isCanceled()) {
+            return;
+        }
+        NSUInteger cost = (NSUInteger)(size.width * scale) * (NSUInteger)(size.height * scale) * 4;
+        [KRLabelBitmapCache() setObject:image forKey:key cost:cost];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            commit(image);
+        });
+    });
+}
+
+/// 按绘制尺寸设置排版，截断边距需要排除右下角区域
++ (void)p_prepareTextRender:(KRTextRender *)textRender forDrawingInSize:(CGSize)drawSize {
+    if (textRender.lineBreakMargin > 0 && textRender.isBreakLine) {
+        textRender.size = drawSize;
+        CGSize size = textRender.size;
+        UIBezierPath * bezierPath = [UIBezierPath bezierPathWithRect:CGRectMake(size.width - textRender.lineBreakMargin, size.height - 10, textRender.lineBreakMargin, 10)];
+        textRender.textContainer.exclusionPaths = @[bezierPath];
+    } else {
+        [textRender prepareForDrawingWithSize:drawSize];
+    }
+}
+
 #pragma mark - public
 
 + (CGSize)sizeThatFits:(CGSize)size attributedString:(NSAttributedString *)attString numberOfLines:(NSUInteger)lines lineBreakMode:(NSLineBreakMode)mode{
@@ -90,12 +295,28 @@ NSString *const KRBGAttributeKey = @"KRBGAttributeKey";
     textRender.lineBreakMargin = marin;
     textRender.maximumNumberOfLines = lines;
     textRender.lineBreakMode = mode;
-    CGSize fitSize = [textRender textSizeWithRenderWidth:size.width];
-    if (marin > 0 && lines) {
-        textRender.maximumNumberOfLines = 0;
-        CGSize newSize = [textRender textSizeWithRenderWidth:size.width];
-        textRender.isBreakLine = !CGSizeEqualToSize(fitSize, newSize);
-        textRender.maximumNumberOfLines = lines;//复原
+    // 带view附件的富文本排版依赖附件状态，不走缓存
+    KRTextLayoutEngine *engine = attString.hr_hasAttachmentViews ? nil : [KRTextLayoutEngine sharedEngine];
+    KRTextLayoutResult *cachedResult = [engine cachedResultForAttributedString:attString width:size.width numberOfLines:lines
+                                                                 lineBreakMode:mode lineBreakMargin:marin lineHeight:lineHeight];
+    CGSize fitSize;
+    if (cachedResult) {
+        // 命中时不立即排版，绘制或查询时按同样的宽度懒排版
+        fitSize = cachedResult.size;
+        [textRender setMeasuredSize:fitSize renderWidth:size.width];
+        textRender.isBreakLine = cachedResult.isBreakLine;
+    } else {
+        fitSize = [textRender textSizeWithRenderWidth:size.width];
+        if (marin > 0 && lines) {
+            textRender.maximumNumberOfLines = 0;
+            CGSize newSize = [textRender textSizeWithRenderWidth:size.width];
+            textRender.isBreakLine = !CGSizeEqualToSize(fitSize, newSize);
+            textRender.maximumNumberOfLines = lines;//复原
+            [textRender setMeasuredSize:fitSize renderWidth:size.width];
+        }
+        [engine cacheResult:[[KRTextLayoutResult alloc] initWithSize:fitSize isBreakLine:textRender.isBreakLine]
+        forAttributedString:attString width:size.width numberOfLines:lines
+              lineBreakMode:mode lineBreakMargin:marin lineHeight:lineHeight];
     }
     attString.hr_textRender = textRender;
     attString.hr_size = fitSize;
@@ -106,7 +327,10 @@ NSString *const KRBGAttributeKey = @"KRBGAttributeKey";
 
 
 - (void)dealloc {
-   
+    // 作废进行中的异步绘制
+    if (_asyncDisplayToken) {
+        atomic_fetch_add(&_asyncDisplayToken->_generation, 1);
+    }
 }
 
 
@@ -118,6 +342,9 @@ NSString *const KRBGAttributeKey = @"KRBGAttributeKey";
 //---------KRTextRender类分割线------------
 @interface KRTextRender() <NSLayoutManagerDelegate> {
     CGRect _textBound;
+    /// 最近一次测量的宽度与结果，绘制时据此判断能否沿用测量的排版
+    CGFloat _measuredRenderWidth;
+    CGSize _measuredSize;
 }
 @property (nonatomic, strong) KRLayoutManager * layoutManager;
 @property (nonatomic, strong) NSTextContainer * textContainer;
@@ -130,11 +357,12 @@ NSString *const KRBGAttributeKey = @"KRBGAttributeKey";
 
 - (instancetype)init{
     if (self = [super init]) {
-        _textContainer = [NSTextContainer new];
-        _layoutManager = [KRLayoutManager new];
+        KRLayoutManager *layoutManager = nil;
+        NSTextContainer *textContainer = nil;
+        [[KRTextLayoutEngine sharedEngine] dequeueLayoutManager:&layoutManager textContainer:&textContainer];
+        _textContainer = textContainer;
+        _layoutManager = layoutManager;
         _layoutManager.delegate = self;
-        [_layoutManager addTextContainer:_textContainer];
-        _textContainer.lineFragmentPadding = 0;
     }
     return self;
 }
@@ -238,8 +466,27 @@ NSString *const KRBGAttributeKey = @"KRBGAttributeKey";
     _textContainer.size = CGSizeMake(renderWidth, MAXFLOAT);
     CGSize textSize = [self textBound].size;
     CGSize res = CGSizeMake(ceil(textSize.width), ceil(textSize.height));
+    [self setMeasuredSize:res renderWidth:renderWidth];
     return  res;
 }
+
+- (void)setMeasuredSize:(CGSize)measuredSize renderWidth:(CGFloat)renderWidth {
+    _measuredSize = measuredSize;
+    _measuredRenderWidth = renderWidth;
+    _textContainer.size = CGSizeMake(renderWidth, MAXFLOAT);
+}
+
+- (void)prepareForDrawingWithSize:(CGSize)size {
+    BOOL sameWidth = _measuredRenderWidth > 0 && fabs(size.width - _measuredRenderWidth) < 0.5;
+    if (sameWidth && size.height >= _measuredSize.height
+        && _textContainer.size.height == MAXFLOAT && !_textContainer.exclusionPaths.count) {
+        // 同宽且高度足够时断行结果与测量一致，保留测量时的容器避免重新排版
+        _size = size;
+        [[KRTextLayoutEngine sharedEngine] recordLayoutReused];
+        return;
+    }
+    self.size = size;
+}
 #pragma mark -  draw text
 
 
@@ -255,12 +502,13 @@ NSString *const KRBGAttributeKey = @"KRBGAttributeKey";
 }
 
 - (void)dealloc{
+    // 排版栈回收入池复用，textStorage仍异步释放
+    [_textStorageOnRender removeLayoutManager:_layoutManager];
+    [[KRTextLayoutEngine sharedEngine] recycleLayoutManager:_layoutManager textContainer:_textContainer];
     [[KRAsyncDeallocManager shareManager] asyncDeallocWithObject:_textStorageOnRender];
     if (_textStorage != _textStorageOnRender) {
         [[KRAsyncDeallocManager shareManager] asyncDeallocWithObject:_textStorage];
     }
-    [[KRAsyncDeallocManager shareManager] asyncDeallocWithObject:_layoutManager];
-    [[KRAsyncDeallocManager shareManager] asyncDeallocWithObject:_textContainer];
 
 }
 
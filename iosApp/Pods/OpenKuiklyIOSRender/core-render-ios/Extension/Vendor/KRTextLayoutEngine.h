@@ -0,0 +1,70 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class KRLayoutManager;
+
+/// 文本测量（断行）结果
+@interface KRTextLayoutResult : NSObject
+
+@property (nonatomic, assign, readonly) CGSize size;
+/// 设置了截断边距时，是否发生截断
+@property (nonatomic, assign, readonly) BOOL isBreakLine;
+
+- (instancetype)initWithSize:(CGSize)size isBreakLine:(BOOL)isBreakLine;
+
+@end
+
+/*
+ * @brief KRLabel与KRTextRender共用的文本排版服务（线程安全）
+ * 1. 复用TextKit排版栈（KRLayoutManager + NSTextContainer），KRTextRender释放时回收入池
+ * 2. 按（富文本内容, 宽度, 行数, 截断模式, 截断边距, 行高）缓存测量结果
+ */
+@interface KRTextLayoutEngine : NSObject
+
++ (instancetype)sharedEngine;
+
+/// 取出一组已重置的排版栈，池为空时新建
+- (void)dequeueLayoutManager:(KRLayoutManager * _Nullable * _Nonnull)layoutManager
+               textContainer:(NSTextContainer * _Nullable * _Nonnull)textContainer;
+/// 回收排版栈，调用前需已从textStorage上移除
+- (void)recycleLayoutManager:(KRLayoutManager *)layoutManager textContainer:(NSTextContainer *)textContainer;
+
+- (nullable KRTextLayoutResult *)cachedResultForAttributedString:(NSAttributedString *)attributedString
+                                                           width:(CGFloat)width
+                                                   numberOfLines:(NSUInteger)numberOfLines
+                                                   lineBreakMode:(NSLineBreakMode)lineBreakMode
+                                                 lineBreakMargin:(CGFloat)lineBreakMargin
+                                                      lineHeight:(CGFloat)lineHeight;
+- (void)cacheResult:(KRTextLayoutResult *)result
+ forAttributedString:(NSAttributedString *)attributedString
+               width:(CGFloat)width
+       numberOfLines:(NSUInteger)numberOfLines
+       lineBreakMode:(NSLineBreakMode)lineBreakMode
+     lineBreakMargin:(CGFloat)lineBreakMargin
+          lineHeight:(CGFloat)lineHeight;
+
+/// 统计：{"stackCreated", "stackReused", "cacheHits", "cacheMisses", "layoutReused"}
+- (NSDictionary<NSString *, NSNumber *> *)statistics;
+- (void)resetStatistics;
+/// 绘制时复用测量阶段的排版结果（供KRLabel统计）
+- (void)recordLayoutReused;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,258 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRTextLayoutEngine.h"
+#import <pthread.h>
+#import "KRLabel.h"
+
+/// 排版栈池容量
+static const NSUInteger kKRTextLayoutStackPoolLimit = 16;
+/// 测量结果缓存条数
+static const NSUInteger kKRTextLayoutCacheCountLimit = 512;
+
+@implementation KRTextLayoutResult
+
+- (instancetype)initWithSize:(CGSize)size isBreakLine:(BOOL)isBreakLine {
+    if (self = [super init]) {
+        _size = size;
+        _isBreakLine = isBreakLine;
+    }
+    return self;
+}
+
+@end
+
+/// 测量缓存key，富文本按内容比较
+@interface KRTextLayoutKey : NSObject<NSCopying> {
+@public
+    NSAttributedString *_attributedString;
+    CGFloat _width;
+    NSUInteger _numberOfLines;
+    NSLineBreakMode _lineBreakMode;
+    CGFloat _lineBreakMargin;
+    CGFloat _lineHeight;
+    NSUInteger _hash;
+}
+@end
+
+@implementation KRTextLayoutKey
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+- (NSUInteger)hash {
+    return _hash;
+}
+
+- (BOOL)isEqual:(KRTextLayoutKey *)other {
+    if (self == other) {
+        return YES;
+    }
+    if (![other isKindOfClass:[KRTextLayoutKey class]] || other->_hash != _hash) {
+        return NO;
+    }
+    return other->_width == _width
+        && other->_numberOfLines == _numberOfLines
+        && other->_lineBreakMode == _lineBreakMode
+        && other->_lineBreakMargin == _lineBreakMargin
+        && other->_lineHeight == _lineHeight
+        && [other->_attributedString isEqualToAttributedString:_attributedString];
+}
+
+@end
+
+@implementation KRTextLayoutEngine {
+    pthread_mutex_t _lock;
+    NSMutableArray<KRLayoutManager *> *_layoutManagers; // _lock
+    NSMutableArray<NSTextContainer *> *_textContainers; // _lock
+    NSCache<KRTextLayoutKey *, KRTextLayoutResult *> *_cache;
+    NSUInteger _stackCreated; // _lock
+    NSUInteger _stackReused; // _lock
+    NSUInteger _cacheHits; // _lock
+    NSUInteger _cacheMisses; // _lock
+    NSUInteger _layoutReused; // _lock
+}
+
++ (instancetype)sharedEngine {
+    static KRTextLayoutEngine *engine;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        engine = [[KRTextLayoutEngine alloc] init];
+    });
+    return engine;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        pthread_mutex_init(&_lock, NULL);
+        _layoutManagers = [NSMutableArray new];
+        _textContainers = [NSMutableArray new];
+        _cache = [NSCache new];
+        _cache.countLimit = kKRTextLayoutCacheCountLimit;
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(p_didReceiveMemoryWarning)
+                                                     name:UIApplicationDidReceiveMemoryWarningNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    pthread_mutex_destroy(&_lock);
+}
+
+#pragma mark - stack pool
+
+- (void)dequeueLayoutManager:(KRLayoutManager **)layoutManager textContainer:(NSTextContainer **)textContainer {
+    pthread_mutex_lock(&_lock);
+    KRLayoutManager *pooledLayoutManager = _layoutManagers.lastObject;
+    NSTextContainer *pooledTextContainer = _textContainers.lastObject;
+    if (pooledLayoutManager) {
+        [_layoutManagers removeLastObject];
+        [_textContainers removeLastObject];
+        _stackReused++;
+    } else {
+        _stackCreated++;
+    }
+    pthread_mutex_unlock(&_lock);
+    if (!pooledLayoutManager) {
+        pooledTextContainer = [NSTextContainer new];
+        pooledTextContainer.lineFragmentPadding = 0;
+        pooledLayoutManager = [KRLayoutManager new];
+        [pooledLayoutManager addTextContainer:pooledTextContainer];
+    }
+    *layoutManager = pooledLayoutManager;
+    *textContainer = pooledTextContainer;
+}
+
+- (void)recycleLayoutManager:(KRLayoutManager *)layoutManager textContainer:(NSTextContainer *)textContainer {
+    if (layoutManager.textStorage || textContainer.layoutManager != layoutManager) {
+        return;
+    }
+    layoutManager.delegate = nil;
+    layoutManager.highlightRange = NSMakeRange(0, 0);
+    textContainer.size = CGSizeZero;
+    textContainer.exclusionPaths = @[];
+    textContainer.maximumNumberOfLines = 0;
+    textContainer.lineBreakMode = NSLineBreakByWordWrapping;
+    textContainer.lineFragmentPadding = 0;
+    pthread_mutex_lock(&_lock);
+    if (_layoutManagers.count < kKRTextLayoutStackPoolLimit) {
+        [_layoutManagers addObject:layoutManager];
+        [_textContainers addObject:textContainer];
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+#pragma mark - layout cache
+
+- (KRTextLayoutResult *)cachedResultForAttributedString:(NSAttributedString *)attributedString
+                                                  width:(CGFloat)width
+                                          numberOfLines:(NSUInteger)numberOfLines
+                                          lineBreakMode:(NSLineBreakMode)lineBreakMode
+                                        lineBreakMargin:(CGFloat)lineBreakMargin
+                                             lineHeight:(CGFloat)lineHeight {
+    KRTextLayoutKey *key = [self p_keyWithAttributedString:attributedString width:width numberOfLines:numberOfLines
+                                             lineBreakMode:lineBreakMode lineBreakMargin:lineBreakMargin lineHeight:lineHeight];
+    KRTextLayoutResult *result = [_cache objectForKey:key];
+    pthread_mutex_lock(&_lock);
+    if (result) {
+        _cacheHits++;
+    } else {
+        _cacheMisses++;
+    }
+    pthread_mutex_unlock(&_lock);
+    return result;
+}
+
+- (void)cacheResult:(KRTextLayoutResult *)result
+ forAttributedString:(NSAttributedString *)attributedString
+               width:(CGFloat)width
+       numberOfLines:(NSUInteger)numberOfLines
+       lineBreakMode:(NSLineBreakMode)lineBreakMode
+     lineBreakMargin:(CGFloat)lineBreakMargin
+          lineHeight:(CGFloat)lineHeight {
+    KRTextLayoutKey *key = [self p_keyWithAttributedString:[attributedString copy] width:width numberOfLines:numberOfLines
+                                             lineBreakMode:lineBreakMode lineBreakMargin:lineBreakMargin lineHeight:lineHeight];
+    [_cache setObject:result forKey:key];
+}
+
+#pragma mark - statistics
+
+- (NSDictionary<NSString *, NSNumber *> *)statistics {
+    pthread_mutex_lock(&_lock);
+    NSDictionary *statistics = @{
+        @"stackCreated": @(_stackCreated),
+        @"stackReused": @(_stackReused),
+        @"cacheHits": @(_cacheHits),
+        @"cacheMisses": @(_cacheMisses),
+        @"layoutReused": @(_layoutReused),
+    };
+    pthread_mutex_unlock(&_lock);
+    return statistics;
+}
+
+- (void)resetStatistics {
+    pthread_mutex_lock(&_lock);
+    _stackCreated = 0;
+    _stackReused = 0;
+    _cacheHits = 0;
+    _cacheMisses = 0;
+    _layoutReused = 0;
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)recordLayoutReused {
+    pthread_mutex_lock(&_lock);
+    _layoutReused++;
+    pthread_mutex_unlock(&_lock);
+}
+
+#pragma mark - private
+
+- (KRTextLayoutKey *)p_keyWithAttributedString:(NSAttributedString *)attributedString
+                                         width:(CGFloat)width
+                                 numberOfLines:(NSUInteger)numberOfLines
+                                 lineBreakMode:(NSLineBreakMode)lineBreakMode
+                               lineBreakMargin:(CGFloat)lineBreakMargin
+                                    lineHeight:(CGFloat)lineHeight {
+    KRTextLayoutKey *key = [KRTextLayoutKey new];
+    key->_attributedString = attributedString;
+    key->_width = width;
+    key->_numberOfLines = numberOfLines;
+    key->_lineBreakMode = lineBreakMode;
+    key->_lineBreakMargin = lineBreakMargin;
+    key->_lineHeight = lineHeight;
+    NSUInteger hash = attributedString.string.hash ^ (attributedString.length << 7);
+    hash = hash * 31 + @(width).hash;
+    hash = hash * 31 + numberOfLines;
+    hash = hash * 31 + lineBreakMode;
+    hash = hash * 31 + @(lineBreakMargin).hash;
+    hash = hash * 31 + @(lineHeight).hash;
+    key->_hash = hash;
+    return key;
+}
+
+- (void)p_didReceiveMemoryWarning {
+    pthread_mutex_lock(&_lock);
+    [_layoutManagers removeAllObjects];
+    [_textContainers removeAllObjects];
+    pthread_mutex_unlock(&_lock);
+    [_cache removeAllObjects];
+}
+
+@end
@@ -23,6 +23,15 @@
 #import "KuiklyBridgeDelegator.h"
 #import "KuiklyRenderLayerHandler.h"
 #import "KuiklyRenderModuleExportProtocol.h"
+#import "KRMemoryMonitor.h"
+#import "KRAsyncDeallocManager.h"
+
+/** 复用队列中单个view的估算开销（不含layer内容），单位：字节 */
+static const int64_t KRReuseViewEstimatedCost = 2 * 1024;
+
+@interface KuiklyRenderLayerHandler () <KRMemoryCostReporter>
+@end
+
 /*
  *  渲染层协议的实现者(渲染器)
  */
@@ -58,6 +67,11 @@ Class _Nullable KRClassFromString(NSString *aClassName) {
         _renderViewReuseQueue = [[NSMutableDictionary alloc] init];
         _moduleRegistry = [[NSMutableDictionary alloc] init];
         pthread_rwlock_init(&_moduleRWLock, NULL);
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(p_onMemoryPressure:)
+                                                     name:KRMemoryPressureNotification
+                                                   object:nil];
+        [KRMemoryMonitor registerMemoryCostReporter:self];
     }
     return self;
 }
@@ -78,8 +92,10 @@ Class _Nullable KRClassFromString(NSString *aClassName) {
     NSAssert([self p_renderViewHandlerWithTag:childTag], @"childTag can't be nil");
     UIView *parentView = (UIView *)[self p_renderViewHandlerWithTag:parentTag];
     UIView *childView = (UIView *)[self p_renderViewHandlerWithTag:childTag];
-    if (index > parentView.subviews.count || index == -1) {
-        index = parentView.subviews.count;
+    NSUInteger subviewCount = [parentView respondsToSelector:@selector(hrv_subviewCount)]
+        ? [((id<KuiklyRenderViewExportProtocol>)parentView) hrv_subviewCount] : parentView.subviews.count;
+    if (index > subviewCount || index == -1) {
+        index = subviewCount;
     }
     UIView *parentRenderView = isRootViewTag ? _rootView : parentView;
     [((id<KuiklyRenderViewExportProtocol>)parentRenderView) hrv_insertSubview:childView atIndex:index];
@@ -200,6 +216,23 @@ Class _Nullable KRClassFromString(NSString *aClassName) {
     // nothing to do
 }
 
+- (void)dealloc {
+    // 页面销毁时view、shadow可能成千上万，交给KRAsyncDeallocManager分批释放，避免主线程集中析构
+    KRAsyncDeallocManager *deallocManager = [KRAsyncDeallocManager shareManager];
+    for (id<KuiklyRenderViewExportProtocol> renderView in _renderViewRegistry.allValues) {
+        [deallocManager asyncDeallocWithObject:renderView];
+    }
+    for (NSArray<id<KuiklyRenderViewExportProtocol>> *reuseQueue in _renderViewReuseQueue.allValues) {
+        for (id<KuiklyRenderViewExportProtocol> renderView in reuseQueue) {
+            [deallocManager asyncDeallocWithObject:renderView];
+        }
+    }
+    [deallocManager asyncDeallocWithObject:_shadowRegistry];
+    _renderViewRegistry = nil;
+    _renderViewReuseQueue = nil;
+    _shadowRegistry = nil;
+}
+
 #pragma mark - private
 
 - (id<KuiklyRenderViewExportProtocol>)p_renderViewHandlerWithTag:(NSNumber *)tag {
@@ -308,6 +341,36 @@ Class _Nullable KRClassFromString(NSString *aClassName) {
     [reuseQueue addObject:viewHandler];
 }
 
+#pragma mark - KRMemoryCostReporter
+
+- (NSString *)kr_memoryCategory {
+    return @"reusePool";
+}
+
+- (int64_t)kr_memoryCost {
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    int64_t cost = 0;
+    for (NSArray<id<KuiklyRenderViewExportProtocol>> *reuseQueue in _renderViewReuseQueue.allValues) {
+        for (id<KuiklyRenderViewExportProtocol> viewHandler in reuseQueue) {
+            cost += KRReuseViewEstimatedCost;
+            id contents = ((UIView *)viewHandler).layer.contents;
+            if (contents && CFGetTypeID((__bridge CFTypeRef)contents) == CGImageGetTypeID()) {
+                CGImageRef image = (__bridge CGImageRef)contents;
+                cost += CGImageGetBytesPerRow(image) * CGImageGetHeight(image);
+            }
+        }
+    }
+    return cost;
+}
+
+// 内存压力时清空复用队列，后续按需重新创建view
+- (void)p_onMemoryPressure:(NSNotification *)notification {
+    KRMemoryPressureLevel level = (KRMemoryPressureLevel)[notification.userInfo[KRMemoryPressureLevelKey] integerValue];
+    if (level >= KRMemoryPressureLevel_Warning) {
+        [_renderViewReuseQueue removeAllObjects];
+    }
+}
+
 - (void)p_removeViewWithTag:(NSNumber *)tag {
     id<KuiklyRenderViewExportProtocol> renderViewHandler = [self p_renderViewHandlerWithTag:tag];
 #if DEBUG
@@ -17,6 +17,7 @@
 #import "KRTurboDisplayShadow.h"
 #import "KRLogModule.h"
 #import "UIView+CSS.h"
+#import "KRTraceRecorder.h"
 
 #define SCROLL_VIEW @"KRScrollContentView"
 
@@ -27,6 +28,14 @@ static UIView *gBaseView = nil;
 + (void)diffPatchToRenderingWithRenderLayer:(id<KuiklyRenderLayerProtocol>)renderLayer
                                 oldNodeTree:(KRTurboDisplayNode *)oldNodeTree
                                 newNodeTree:(KRTurboDisplayNode *)newNodeTree {
+    KRTraceBegin("TurboDisplay.diffPatch");
+    [self p_diffPatchToRenderingWithRenderLayer:renderLayer oldNodeTree:oldNodeTree newNodeTree:newNodeTree];
+    KRTraceEnd("TurboDisplay.diffPatch");
+}
+
++ (void)p_diffPatchToRenderingWithRenderLayer:(id<KuiklyRenderLayerProtocol>)renderLayer
+                                  oldNodeTree:(KRTurboDisplayNode *)oldNodeTree
+                                  newNodeTree:(KRTurboDisplayNode *)newNodeTree {
     // 逐层比较，属性和事件key不一样，就删除该节点，如果仅属性值变化就update该属性
     // 能否复用
     if ([self canReuseNode:oldNodeTree newNode:newNodeTree fromUpdateNode:NO]) {
@@ -44,7 +53,7 @@ static UIView *gBaseView = nil;
         for (int i = 0; i < MAX(aChilden.count, bChilden.count); i++) {
             KRTurboDisplayNode *oldNode = aChilden.count > i ? aChilden[i] : nil;
             KRTurboDisplayNode *newNode = bChilden.count > i ? bChilden[i] : nil;
-            [self diffPatchToRenderingWithRenderLayer:renderLayer oldNodeTree:oldNode newNodeTree:newNode];
+            [self p_diffPatchToRenderingWithRenderLayer:renderLayer oldNodeTree:oldNode newNodeTree:newNode];
         }
     } else {
         [KRLogModule logInfo:[NSString stringWithFormat:@"turbo_display un used with old node:%@ new node:%@", oldNodeTree.viewName, newNodeTree.viewName]];
@@ -313,6 +322,13 @@ static UIView *gBaseView = nil;
  * @return 是否有发生更新
  */
 + (BOOL)onlyUpdateWithTargetNodeTree:(KRTurboDisplayNode *)targetNodeTree fromNodeTree:(KRTurboDisplayNode *)fromNodeTree {
+    KRTraceBegin("TurboDisplay.onlyUpdate");
+    BOOL hasUpdate = [self p_onlyUpdateWithTargetNodeTree:targetNodeTree fromNodeTree:fromNodeTree];
+    KRTraceEnd("TurboDisplay.onlyUpdate");
+    return hasUpdate;
+}
+
++ (BOOL)p_onlyUpdateWithTargetNodeTree:(KRTurboDisplayNode *)targetNodeTree fromNodeTree:(KRTurboDisplayNode *)fromNodeTree {
     BOOL hasUpdate = NO;
     if ([self canReuseNode:targetNodeTree newNode:fromNodeTree fromUpdateNode:YES]) { // 是否同结构节点，才进行更新
         if ([self updateNodeWithTargetNode:targetNodeTree fromNode:fromNodeTree]) {
@@ -341,7 +357,7 @@ static UIView *gBaseView = nil;
                 KRTurboDisplayNode *nextTargetNode = aChilden[i];
                 KRTurboDisplayNode *nextFromNode = [self nextNodeForUpdateWithChildern:bChilden fromIndex:&fromIndex targetNode:nextTargetNode];
                 if (nextFromNode) {
-                    if ([self onlyUpdateWithTargetNodeTree:nextTargetNode fromNodeTree:nextFromNode]) {
+                    if ([self p_onlyUpdateWithTargetNodeTree:nextTargetNode fromNodeTree:nextFromNode]) {
                          hasUpdate = YES;
                      }
                 }
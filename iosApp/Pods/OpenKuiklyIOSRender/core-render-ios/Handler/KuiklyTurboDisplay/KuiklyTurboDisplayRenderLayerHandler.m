@@ -27,10 +27,28 @@
 #import "KRTurboDisplayDiffPatch.h"
 #import "KuiklyRenderThreadManager.h"
 #import "KRTurboDisplayModule.h"
+#import "KRFPSMonitor.h"
+#import "KRMemoryMonitor.h"
 
 #define ROOT_VIEW_NAME @"RootView"
 
-@interface KuiklyTurboDisplayRenderLayerHandler()<KuiklyRenderLayerProtocol>
+/** TurboDisplay节点的估算开销，单位：字节 */
+static const int64_t KRTurboDisplayNodeEstimatedCost = 256;
+static const int64_t KRTurboDisplayPropEstimatedCost = 64;
+
+static int64_t KRTurboDisplayTreeMemoryCost(KRTurboDisplayNode *node) {
+    if (!node) {
+        return 0;
+    }
+    int64_t cost = KRTurboDisplayNodeEstimatedCost
+                   + (int64_t)(node.props.count + node.callMethods.count) * KRTurboDisplayPropEstimatedCost;
+    for (KRTurboDisplayNode *child in node.children) {
+        cost += KRTurboDisplayTreeMemoryCost(child);
+    }
+    return cost;
+}
+
+@interface KuiklyTurboDisplayRenderLayerHandler()<KuiklyRenderLayerProtocol, KRMemoryCostReporter>
 /** 原生渲染器 */
 @property (nonatomic, strong) KuiklyRenderLayerHandler *renderLayerHandler;
 /** turboDisplay缓存数据 */
@@ -89,12 +107,26 @@
         [[NSNotificationCenter defaultCenter] addObserver:self
                                                  selector:@selector(onReceiveCloseTurboDisplayNotification:)
                                                      name:kCloseTurboDisplayNotificationName object:rootView];
-        
+        [KRMemoryMonitor registerMemoryCostReporter:self];
         
     }
     return self;
 }
 
+#pragma mark - KRMemoryCostReporter
+
+- (NSString *)kr_memoryCategory {
+    return @"turboDisplay";
+}
+
+// 视图树用于diff与首屏回写，内存压力时不做淘汰，仅统计开销
+- (int64_t)kr_memoryCost {
+    return KRTurboDisplayTreeMemoryCost(_realRootNode)
+           + KRTurboDisplayTreeMemoryCost(_nextTurboDisplayRootNode)
+           + KRTurboDisplayTreeMemoryCost(_turboDisplayCacheData.turboDisplayNode)
+           + (int64_t)_turboDisplayCacheData.turboDisplayNodeData.length;
+}
+
 #pragma mark - public
 
 - (void)didInit {
@@ -360,7 +392,9 @@
     if (!node) {
         return ;
     }
+    CFTimeInterval beginTime = CACurrentMediaTime();
     [KRTurboDisplayDiffPatch diffPatchToRenderingWithRenderLayer:_renderLayerHandler oldNodeTree:nil newNodeTree:node];
+    [KRFPSMonitor recordTurboDisplayDiffWithDuration:CACurrentMediaTime() - beginTime];
 }
 
 
@@ -375,9 +409,11 @@
     }
     
     if (self.turboDisplayCacheData.turboDisplayNode && _realRootNode) { // 动静结合diff上屏
+        CFTimeInterval beginTime = CACurrentMediaTime();
         [KRTurboDisplayDiffPatch diffPatchToRenderingWithRenderLayer:_renderLayerHandler
                                                          oldNodeTree:self.turboDisplayCacheData.turboDisplayNode
                                                          newNodeTree:_realRootNode];
+        [KRFPSMonitor recordTurboDisplayDiffWithDuration:CACurrentMediaTime() - beginTime];
     }
     _lazyRendering = NO;
     // 证明成功可以回写，如果文件不存在的话
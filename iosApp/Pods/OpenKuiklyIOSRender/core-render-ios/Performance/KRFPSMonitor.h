@@ -33,6 +33,8 @@ typedef NS_ENUM(NSInteger, KRFPSThead) {
 @property (nonatomic, assign, readonly) NSUInteger maxFPS;
 /// 最低fps
 @property (nonatomic, assign, readonly) NSUInteger minFPS;
+/// 已统计的帧数（相邻两次tick之间为一帧）
+@property (nonatomic, assign, readonly) NSUInteger frameTimeCount;
 
 - (instancetype)initWithThread:(KRFPSThead)thread pageName:(NSString *)pageName;
 
@@ -40,6 +42,32 @@ typedef NS_ENUM(NSInteger, KRFPSThead) {
 
 - (void)endMonitor;
 
+/*
+ * 帧耗时分布数据，字段如下（耗时单位为ms）：
+ * frameCount、p50、p90、p99、p999、maxFrameTime、
+ * over16ms、over33ms、over50ms（超过16.7/33.3/50ms的帧数）、
+ * longFrames（最近的长帧及其归因：frameTime、batchCount、batchTaskCount、turboDisplayDiffTime、moduleCalls）
+ */
+- (NSDictionary *)frameTimeData;
+
+/*
+ * 帧耗时分位值（ms），percentile取值(0, 100]
+ */
+- (double)frameTimeAtPercentile:(double)percentile;
+
+#pragma mark - jank attribution
+
+/*
+ * 以下方法用于长帧归因，记录当前线程（主线程或kotlin线程）在本帧内的工作，
+ * 仅在存在监控中的KRFPSMonitor时生效，其余情况为空操作
+ */
+/// 记录一次UI批量任务执行及其任务数
++ (void)recordSchedulerBatchWithTaskCount:(NSUInteger)taskCount;
+/// 记录一次TurboDisplay diff耗时（秒）
++ (void)recordTurboDisplayDiffWithDuration:(NSTimeInterval)duration;
+/// 记录一次module方法调用
++ (void)recordModuleCallWithModuleName:(NSString *)moduleName method:(NSString *)method;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -14,6 +14,92 @@
  */
 
 #import "KRFPSMonitor.h"
+#import <pthread.h>
+#import <stdatomic.h>
+#import "KuiklyRenderThreadManager.h"
+
+/*
+ * 帧耗时直方图（HDR风格的对数-线性分桶，单位us）：
+ * 每个2的幂区间再等分为32个子桶，相对误差不超过1/32，
+ * 记录为O(1)且不分配内存，上限约16.7s（超出部分按上限计）
+ */
+#define KR_FRAME_HISTOGRAM_SUB_BUCKET_BITS 5
+#define KR_FRAME_HISTOGRAM_SUB_BUCKET_COUNT (1 << KR_FRAME_HISTOGRAM_SUB_BUCKET_BITS)
+#define KR_FRAME_HISTOGRAM_MAX_VALUE ((1ULL << 24) - 1)
+#define KR_FRAME_HISTOGRAM_BUCKET_COUNT ((24 - KR_FRAME_HISTOGRAM_SUB_BUCKET_BITS + 1) * KR_FRAME_HISTOGRAM_SUB_BUCKET_COUNT)
+/// 记录归因信息的长帧阈值（1.5个60Hz帧）
+static const NSTimeInterval KRLongFrameThreshold = 1.5 / 60.0;
+/// 保留的最近长帧数量
+static const NSUInteger KRLongFrameRecordMaxCount = 20;
+/// 每个线程保留的最近module调用数量
+#define KR_FRAME_ACTIVITY_MODULE_CALL_CAPACITY 16
+
+static inline uint32_t KRFrameHistogramIndex(uint64_t value) {
+    if (value > KR_FRAME_HISTOGRAM_MAX_VALUE) {
+        value = KR_FRAME_HISTOGRAM_MAX_VALUE;
+    }
+    int msb = value ? 63 - __builtin_clzll(value) : 0;
+    int shift = MAX(msb - KR_FRAME_HISTOGRAM_SUB_BUCKET_BITS, 0);
+    return (uint32_t)((shift << KR_FRAME_HISTOGRAM_SUB_BUCKET_BITS) + (value >> shift));
+}
+
+/// 桶内的最大值（us）
+static inline uint64_t KRFrameHistogramHighestValue(uint32_t index) {
+    int shift = index < 2 * KR_FRAME_HISTOGRAM_SUB_BUCKET_COUNT ? 0 : (int)(index >> KR_FRAME_HISTOGRAM_SUB_BUCKET_BITS) - 1;
+    uint64_t sub = index - ((uint64_t)shift << KR_FRAME_HISTOGRAM_SUB_BUCKET_BITS);
+    return ((sub + 1) << shift) - 1;
+}
+
+/*
+ * 线程内的帧活动累计（只增不减），只在所属线程读写；
+ * 各个monitor在tick时与上次快照做差，即得到该帧内的活动
+ */
+@interface KRFrameActivity : NSObject {
+@public
+    NSUInteger _batchCount;
+    NSUInteger _batchTaskCount;
+    NSTimeInterval _turboDisplayDiffTime;
+    NSUInteger _moduleCallSeq;
+    NSString *_moduleCalls[KR_FRAME_ACTIVITY_MODULE_CALL_CAPACITY];
+}
+@end
+
+@implementation KRFrameActivity
+@end
+
+typedef struct {
+    NSUInteger batchCount;
+    NSUInteger batchTaskCount;
+    NSTimeInterval turboDisplayDiffTime;
+    NSUInteger moduleCallSeq;
+} KRFrameActivitySnapshot;
+
+/// 监控中的monitor数量，为0时不记录帧活动
+static atomic_int gKRActiveFPSMonitorCount = 0;
+
+static KRFrameActivity *KRFrameActivityForThread(KRFPSThead thread) {
+    static KRFrameActivity *mainActivity = nil;
+    static KRFrameActivity *kotlinActivity = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mainActivity = [KRFrameActivity new];
+        kotlinActivity = [KRFrameActivity new];
+    });
+    return thread == KRFPSThead_Main ? mainActivity : kotlinActivity;
+}
+
+static KRFrameActivity *KRFrameActivityForCurrentThread(void) {
+    if (atomic_load_explicit(&gKRActiveFPSMonitorCount, memory_order_relaxed) <= 0) {
+        return nil;
+    }
+    if ([NSThread isMainThread]) {
+        return KRFrameActivityForThread(KRFPSThead_Main);
+    }
+    if ([KuiklyRenderThreadManager isContextQueue]) {
+        return KRFrameActivityForThread(KRFPSThead_Kotlin);
+    }
+    return nil;
+}
 
 @implementation KRFPSMonitor {
     NSTimeInterval _prevTime;
@@ -23,6 +109,19 @@
     NSTimeInterval _duration;
     KRFPSThead _thread;
     NSString *_pageName;
+    
+    // 帧耗时统计（tick所在线程写，其他线程读，由_lock保护）
+    pthread_mutex_t _lock;
+    NSTimeInterval _lastTickTime;
+    atomic_bool _monitoring;
+    uint64_t _histogram[KR_FRAME_HISTOGRAM_BUCKET_COUNT];
+    NSUInteger _frameTimeCount;
+    uint64_t _maxFrameTime;
+    NSUInteger _over16msCount;
+    NSUInteger _over33msCount;
+    NSUInteger _over50msCount;
+    NSMutableArray<NSDictionary *> *_longFrames;
+    KRFrameActivitySnapshot _activitySnapshot;
 }
 
 - (instancetype)initWithThread:(KRFPSThead)thread pageName:(NSString *)pageName {
@@ -35,13 +134,27 @@
         _minFPS = 60;
         _duration = 0;
         _frameCountSum = 0;
+        _lastTickTime = -1;
+        _longFrames = [NSMutableArray new];
+        pthread_mutex_init(&_lock, NULL);
     }
     return self;
 }
 
+- (void)dealloc {
+    if (atomic_load(&_monitoring)) {
+        atomic_fetch_sub(&gKRActiveFPSMonitorCount, 1);
+    }
+    pthread_mutex_destroy(&_lock);
+}
+
 - (void)endMonitor {
     _prevTime = -1;
     _frameCount = -1;
+    _lastTickTime = -1;
+    if (atomic_exchange(&_monitoring, false)) {
+        atomic_fetch_sub(&gKRActiveFPSMonitorCount, 1);
+    }
 }
 
 - (NSUInteger)avgFPS {
@@ -49,6 +162,7 @@
 }
 
 - (void)onTick:(NSTimeInterval)timestamp {
+    [self p_recordFrameWithTimestamp:timestamp];
     _frameCount++;
     if (_prevTime == -1) {
         _prevTime = timestamp;
@@ -67,4 +181,148 @@
     }
 }
 
+- (NSUInteger)frameTimeCount {
+    pthread_mutex_lock(&_lock);
+    NSUInteger count = _frameTimeCount;
+    pthread_mutex_unlock(&_lock);
+    return count;
+}
+
+- (double)frameTimeAtPercentile:(double)percentile {
+    pthread_mutex_lock(&_lock);
+    double frameTime = [self p_frameTimeAtPercentile:percentile];
+    pthread_mutex_unlock(&_lock);
+    return frameTime;
+}
+
+- (NSDictionary *)frameTimeData {
+    pthread_mutex_lock(&_lock);
+    NSDictionary *data = @{
+        @"frameCount" : @(_frameTimeCount),
+        @"p50" : @([self p_frameTimeAtPercentile:50]),
+        @"p90" : @([self p_frameTimeAtPercentile:90]),
+        @"p99" : @([self p_frameTimeAtPercentile:99]),
+        @"p999" : @([self p_frameTimeAtPercentile:99.9]),
+        @"maxFrameTime" : @(_maxFrameTime / 1000.0),
+        @"over16ms" : @(_over16msCount),
+        @"over33ms" : @(_over33msCount),
+        @"over50ms" : @(_over50msCount),
+        @"longFrames" : [_longFrames copy]
+    };
+    pthread_mutex_unlock(&_lock);
+    return data;
+}
+
+#pragma mark - jank attribution
+
++ (void)recordSchedulerBatchWithTaskCount:(NSUInteger)taskCount {
+    KRFrameActivity *activity = KRFrameActivityForCurrentThread();
+    if (activity) {
+        activity->_batchCount++;
+        activity->_batchTaskCount += taskCount;
+    }
+}
+
++ (void)recordTurboDisplayDiffWithDuration:(NSTimeInterval)duration {
+    KRFrameActivity *activity = KRFrameActivityForCurrentThread();
+    if (activity) {
+        activity->_turboDisplayDiffTime += duration;
+    }
+}
+
++ (void)recordModuleCallWithModuleName:(NSString *)moduleName method:(NSString *)method {
+    KRFrameActivity *activity = KRFrameActivityForCurrentThread();
+    if (activity) {
+        NSUInteger slot = activity->_moduleCallSeq % KR_FRAME_ACTIVITY_MODULE_CALL_CAPACITY;
+        activity->_moduleCalls[slot] = [NSString stringWithFormat:@"%@.%@", moduleName ?: @"", method ?: @""];
+        activity->_moduleCallSeq++;
+    }
+}
+
+#pragma mark - private
+
+- (void)p_recordFrameWithTimestamp:(NSTimeInterval)timestamp {
+    KRFrameActivity *activity = KRFrameActivityForThread(_thread);
+    if (!atomic_exchange(&_monitoring, true)) {
+        atomic_fetch_add(&gKRActiveFPSMonitorCount, 1);
+    }
+    if (_lastTickTime < 0 || timestamp <= _lastTickTime) {
+        _lastTickTime = timestamp;
+        _activitySnapshot = [self p_snapshotWithActivity:activity];
+        return;
+    }
+    NSTimeInterval frameTime = timestamp - _lastTickTime;
+    _lastTickTime = timestamp;
+    uint64_t frameTimeUs = (uint64_t)(frameTime * 1000000.0);
+    NSDictionary *longFrame = nil;
+    KRFrameActivitySnapshot snapshot = [self p_snapshotWithActivity:activity];
+    if (frameTime >= KRLongFrameThreshold) {
+        NSUInteger fromSeq = MAX(_activitySnapshot.moduleCallSeq,
+                                 snapshot.moduleCallSeq > KR_FRAME_ACTIVITY_MODULE_CALL_CAPACITY
+                                 ? snapshot.moduleCallSeq - KR_FRAME_ACTIVITY_MODULE_CALL_CAPACITY : 0);
+        NSMutableArray<NSString *> *moduleCalls = [NSMutableArray new];
+        for (NSUInteger seq = fromSeq; seq < snapshot.moduleCallSeq; seq++) {
+            NSString *moduleCall = activity->_moduleCalls[seq % KR_FRAME_ACTIVITY_MODULE_CALL_CAPACITY];
+            if (moduleCall) {
+                [moduleCalls addObject:moduleCall];
+            }
+        }
+        longFrame = @{
+            @"frameTime" : @(frameTime * 1000.0),
+            @"batchCount" : @(snapshot.batchCount - _activitySnapshot.batchCount),
+            @"batchTaskCount" : @(snapshot.batchTaskCount - _activitySnapshot.batchTaskCount),
+            @"turboDisplayDiffTime" : @((snapshot.turboDisplayDiffTime - _activitySnapshot.turboDisplayDiffTime) * 1000.0),
+            @"moduleCalls" : moduleCalls
+        };
+    }
+    _activitySnapshot = snapshot;
+    
+    pthread_mutex_lock(&_lock);
+    _histogram[KRFrameHistogramIndex(frameTimeUs)]++;
+    _frameTimeCount++;
+    _maxFrameTime = MAX(_maxFrameTime, frameTimeUs);
+    if (frameTimeUs > 16700) {
+        _over16msCount++;
+    }
+    if (frameTimeUs > 33300) {
+        _over33msCount++;
+    }
+    if (frameTimeUs > 50000) {
+        _over50msCount++;
+    }
+    if (longFrame) {
+        if (_longFrames.count >= KRLongFrameRecordMaxCount) {
+            [_longFrames removeObjectAtIndex:0];
+        }
+        [_longFrames addObject:longFrame];
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+- (KRFrameActivitySnapshot)p_snapshotWithActivity:(KRFrameActivity *)activity {
+    KRFrameActivitySnapshot snapshot;
+    snapshot.batchCount = activity->_batchCount;
+    snapshot.batchTaskCount = activity->_batchTaskCount;
+    snapshot.turboDisplayDiffTime = activity->_turboDisplayDiffTime;
+    snapshot.moduleCallSeq = activity->_moduleCallSeq;
+    return snapshot;
+}
+
+/// 需持有_lock调用，返回ms
+- (double)p_frameTimeAtPercentile:(double)percentile {
+    if (_frameTimeCount == 0) {
+        return 0;
+    }
+    percentile = MIN(MAX(percentile, 0), 100);
+    uint64_t targetCount = MAX((uint64_t)ceil(percentile / 100.0 * _frameTimeCount), 1);
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < KR_FRAME_HISTOGRAM_BUCKET_COUNT; i++) {
+        count += _histogram[i];
+        if (count >= targetCount) {
+            return MIN(KRFrameHistogramHighestValue(i), _maxFrameTime) / 1000.0;
+        }
+    }
+    return _maxFrameTime / 1000.0;
+}
+
 @end
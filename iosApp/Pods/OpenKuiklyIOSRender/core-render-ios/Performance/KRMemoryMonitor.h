@@ -17,7 +17,32 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
-/// 内存监控，每10秒打点一次
+typedef NS_ENUM(NSInteger, KRMemoryPressureLevel) {
+    KRMemoryPressureLevel_Normal = 0,
+    KRMemoryPressureLevel_Warning = 1,
+    KRMemoryPressureLevel_Critical = 2,
+};
+
+/// 内存压力事件通知（主线程发出），userInfo[KRMemoryPressureLevelKey]为KRMemoryPressureLevel
+extern NSString *const KRMemoryPressureNotification;
+extern NSString *const KRMemoryPressureLevelKey;
+
+/*
+ * KR持有的缓存实现该协议并注册到KRMemoryMonitor，用于内存分类统计
+ */
+@protocol KRMemoryCostReporter <NSObject>
+
+/// 缓存分类名，同分类的开销会累加
+- (NSString *)kr_memoryCategory;
+/// 估算的内存占用，单位：字节（主线程调用）
+- (int64_t)kr_memoryCost;
+
+@end
+
+/*
+ * 内存监控：页面可见后的前几秒高频采样，稳定后每10秒采样一次，
+ * 页面出现/消失时各采样一次，也可通过sampleNow按需采样
+ */
 @interface KRMemoryMonitor : NSObject
 
 /// 页面的平均内存增量数据: 页面可见期间的平均内存 - 页面进入前的内存， 单位：字节
@@ -32,12 +57,30 @@ NS_ASSUME_NONNULL_BEGIN
 /// 页面的平均内存: 页面可见期间的平均内存， 单位：字节
 @property (nonatomic, readonly) int64_t appAvgMemory;
 
+/// 最近一次采样的内存，单位：字节
+@property (nonatomic, readonly) int64_t currentMemory;
+
+/// 采样次数
+@property (nonatomic, readonly) int64_t sampleCount;
+
 - (instancetype)initWithPageName:(NSString *)pageName;
 
 - (void)startMonitor;
 
 - (void)endMonitor;
 
+/// 立即采样一次
+- (void)sampleNow;
+
+/// 注册缓存开销统计（弱引用持有）
++ (void)registerMemoryCostReporter:(id<KRMemoryCostReporter>)reporter;
+
+/// 各KR缓存分类的内存开销，key为分类名，value为字节数（主线程调用）
++ (NSDictionary<NSString *, NSNumber *> *)cacheMemoryBreakdown;
+
+/// 当前内存压力等级
++ (KRMemoryPressureLevel)currentPressureLevel;
+
 @end
 
 NS_ASSUME_NONNULL_END
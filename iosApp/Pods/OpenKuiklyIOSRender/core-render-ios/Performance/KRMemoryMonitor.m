@@ -15,14 +15,80 @@
 
 #import "KRMemoryMonitor.h"
 #import <mach/mach.h>
+#import <os/proc.h>
+#import <UIKit/UIKit.h>
+
+NSString *const KRMemoryPressureNotification = @"KRMemoryPressureNotification";
+NSString *const KRMemoryPressureLevelKey = @"level";
+
+/// 页面可见后的高频采样时长与间隔（秒）
+static const NSTimeInterval KRMemoryLoadPhaseDuration = 5;
+static const NSTimeInterval KRMemoryLoadPhaseInterval = 0.5;
+/// 稳定后的采样间隔（秒）
+static const NSTimeInterval KRMemorySteadyInterval = 10;
+/// 内存占用达到可用上限的比例时对应的压力等级
+static const double KRMemoryWarningRatio = 0.7;
+static const double KRMemoryCriticalRatio = 0.85;
+
+static NSHashTable<id<KRMemoryCostReporter>> *gMemoryCostReporters = nil;
+static KRMemoryPressureLevel gSystemPressureLevel = KRMemoryPressureLevel_Normal;
+static KRMemoryPressureLevel gFootprintPressureLevel = KRMemoryPressureLevel_Normal;
+static KRMemoryPressureLevel gPressureLevel = KRMemoryPressureLevel_Normal;
+
+static void KRMemoryPostPressureEvent(KRMemoryPressureLevel level) {
+    [[NSNotificationCenter defaultCenter] postNotificationName:KRMemoryPressureNotification
+                                                        object:nil
+                                                      userInfo:@{ KRMemoryPressureLevelKey: @(level) }];
+}
+
+/// 主线程调用，等级变化时发出通知
+static void KRMemoryUpdatePressureLevel(void) {
+    KRMemoryPressureLevel level = MAX(gSystemPressureLevel, gFootprintPressureLevel);
+    if (level != gPressureLevel) {
+        gPressureLevel = level;
+        KRMemoryPostPressureEvent(level);
+    }
+}
+
+/// 监听系统内存压力与内存警告，进程内只初始化一次
+static void KRMemoryPressureSetupIfNeed(void) {
+    static dispatch_source_t pressureSource = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        gMemoryCostReporters = [NSHashTable weakObjectsHashTable];
+        pressureSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0,
+                                                DISPATCH_MEMORYPRESSURE_NORMAL | DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+                                                dispatch_get_main_queue());
+        dispatch_source_set_event_handler(pressureSource, ^{
+            unsigned long flags = dispatch_source_get_data(pressureSource);
+            if (flags & DISPATCH_MEMORYPRESSURE_CRITICAL) {
+                gSystemPressureLevel = KRMemoryPressureLevel_Critical;
+            } else if (flags & DISPATCH_MEMORYPRESSURE_WARN) {
+                gSystemPressureLevel = KRMemoryPressureLevel_Warning;
+            } else {
+                gSystemPressureLevel = KRMemoryPressureLevel_Normal;
+            }
+            KRMemoryUpdatePressureLevel();
+        });
+        dispatch_resume(pressureSource);
+        // 内存警告作为一次性的严重压力事件，不改变当前等级
+        [[NSNotificationCenter defaultCenter] addObserverForName:UIApplicationDidReceiveMemoryWarningNotification
+                                                          object:nil
+                                                           queue:[NSOperationQueue mainQueue]
+                                                      usingBlock:^(NSNotification * _Nonnull note) {
+            KRMemoryPostPressureEvent(KRMemoryPressureLevel_Critical);
+        }];
+    });
+}
 
 @implementation KRMemoryMonitor {
-    NSTimer *_timer;
+    dispatch_source_t _timer;
+    NSTimeInterval _timerInterval;
+    CFTimeInterval _monitorStartTime;
     int64_t _preLoadMemory;
     
-    int64_t _appAvgMemory;
+    int64_t _memorySum;
     int64_t _appPeakMemory;
-    int64_t _recordCount;
     
     NSString *_pageName;
 }
@@ -31,13 +97,17 @@
     if (self = [super init]) {
         _pageName = pageName;
         _preLoadMemory = [self memoryUsage];
-        _appAvgMemory = 0;
+        _memorySum = 0;
         _appPeakMemory = 0;
-        _recordCount = 0;
+        _sampleCount = 0;
     }
     return self;
 }
 
+- (void)dealloc {
+    [self p_cancelTimer];
+}
+
 - (int64_t)memoryUsage {
     int64_t memoryUsageInByte = 0;
     task_vm_info_data_t vmInfo;
@@ -45,13 +115,16 @@
     kern_return_t kernelReturn = task_info(mach_task_self(), TASK_VM_INFO, (task_info_t) &vmInfo, &count);
     if(kernelReturn == KERN_SUCCESS) {
         memoryUsageInByte = (int64_t) vmInfo.phys_footprint;
-        NSLog(@"【kuikly performance】pagename: %@, Memory in use: %.3fMB", _pageName, memoryUsageInByte / 1024.0 / 1024);
     }
     return memoryUsageInByte;
 }
 
+- (int64_t)appAvgMemory {
+    return _sampleCount ? _memorySum / _sampleCount : 0;
+}
+
 - (int64_t)avgIncrementMemory {
-    return _appAvgMemory - _preLoadMemory;
+    return self.appAvgMemory - _preLoadMemory;
 }
 
 - (int64_t)peakIncrementMemory {
@@ -61,24 +134,119 @@
 - (void)recordCurrentMemory
 {
     int64_t curMem = [self memoryUsage];
+    _currentMemory = curMem;
     _appPeakMemory = MAX(curMem, _appPeakMemory);
-    _appAvgMemory = (_appAvgMemory * _recordCount + curMem) / (_recordCount + 1);
-    _recordCount++;
+    _memorySum += curMem;
+    _sampleCount++;
+    [self p_updateFootprintPressureWithMemory:curMem];
     
 //    NSLog(@"【kuikly performance】pagename: %@, appPeakMemory: %.3fMB, appAvgMemory: %.3fMB, peakIncrementMemory: %.3fMB, avgIncrementMemory: %.3fMB",
 //          _pageName, self.appPeakMemory / 1024.0 / 1024, self.appAvgMemory / 1024.0 / 1024, self.peakIncrementMemory / 1024.0 / 1024, self.avgIncrementMemory / 1024.0 / 1024);
 }
 
 - (void)startMonitor {
-    _timer = [NSTimer scheduledTimerWithTimeInterval:10 target:self selector:@selector(recordCurrentMemory) userInfo:nil repeats:YES];
-    // 启动时，记录一次
-    [NSThread cancelPreviousPerformRequestsWithTarget:self selector:@selector(recordCurrentMemory) object:nil];
-    [self performSelector:@selector(recordCurrentMemory) withObject:nil afterDelay:1];
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    KRMemoryPressureSetupIfNeed();
+    // 页面出现时，记录一次
+    [self recordCurrentMemory];
+    _monitorStartTime = CACurrentMediaTime();
+    [self p_scheduleTimerWithInterval:KRMemoryLoadPhaseInterval];
 }
 
 - (void)endMonitor {
-    [_timer invalidate];
-    _timer = nil;
+    if (_timer) {
+        // 页面消失时，记录一次
+        [self recordCurrentMemory];
+    }
+    [self p_cancelTimer];
+}
+
+- (void)sampleNow {
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    [self recordCurrentMemory];
+}
+
+#pragma mark - cache breakdown
+
++ (void)registerMemoryCostReporter:(id<KRMemoryCostReporter>)reporter {
+    if (!reporter) {
+        return;
+    }
+    if (![NSThread isMainThread]) {
+        __weak id<KRMemoryCostReporter> weakReporter = reporter;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self registerMemoryCostReporter:weakReporter];
+        });
+        return;
+    }
+    KRMemoryPressureSetupIfNeed();
+    [gMemoryCostReporters addObject:reporter];
+}
+
++ (NSDictionary<NSString *, NSNumber *> *)cacheMemoryBreakdown {
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    NSMutableDictionary<NSString *, NSNumber *> *breakdown = [NSMutableDictionary new];
+    for (id<KRMemoryCostReporter> reporter in gMemoryCostReporters.allObjects) {
+        NSString *category = [reporter kr_memoryCategory];
+        if (category.length) {
+            breakdown[category] = @(breakdown[category].longLongValue + [reporter kr_memoryCost]);
+        }
+    }
+    return breakdown;
+}
+
++ (KRMemoryPressureLevel)currentPressureLevel {
+    return gPressureLevel;
+}
+
+#pragma mark - private
+
+- (void)p_updateFootprintPressureWithMemory:(int64_t)memory {
+    if (@available(iOS 13.0, *)) {
+        int64_t available = (int64_t)os_proc_available_memory();
+        if (memory <= 0 || available <= 0) {
+            return;
+        }
+        double ratio = (double)memory / (memory + available);
+        if (ratio >= KRMemoryCriticalRatio) {
+            gFootprintPressureLevel = KRMemoryPressureLevel_Critical;
+        } else if (ratio >= KRMemoryWarningRatio) {
+            gFootprintPressureLevel = KRMemoryPressureLevel_Warning;
+        } else {
+            gFootprintPressureLevel = KRMemoryPressureLevel_Normal;
+        }
+        KRMemoryUpdatePressureLevel();
+    }
+}
+
+- (void)p_onTimer {
+    [self recordCurrentMemory];
+    if (_timerInterval < KRMemorySteadyInterval
+        && CACurrentMediaTime() - _monitorStartTime >= KRMemoryLoadPhaseDuration) {
+        // 加载阶段结束，降低采样频率
+        [self p_scheduleTimerWithInterval:KRMemorySteadyInterval];
+    }
+}
+
+- (void)p_scheduleTimerWithInterval:(NSTimeInterval)interval {
+    if (!_timer) {
+        _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_main_queue());
+        __weak __typeof__(self) wself = self;
+        dispatch_source_set_event_handler(_timer, ^{
+            [wself p_onTimer];
+        });
+        dispatch_resume(_timer);
+    }
+    _timerInterval = interval;
+    dispatch_source_set_timer(_timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(interval * NSEC_PER_SEC)),
+                              (uint64_t)(interval * NSEC_PER_SEC), (uint64_t)(interval * 0.1 * NSEC_PER_SEC));
+}
+
+- (void)p_cancelTimer {
+    if (_timer) {
+        dispatch_source_cancel(_timer);
+        _timer = nil;
+    }
 }
 
 @end
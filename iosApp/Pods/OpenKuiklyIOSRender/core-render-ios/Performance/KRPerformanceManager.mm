@@ -10,6 +10,7 @@
 #import "KRFPSMonitor.h"
 #import "KuiklyRenderThreadManager.h"
 #import "KRMemoryMonitor.h"
+#import "KRDisplayLink.h"
 #import <UIKit/UIKit.h>
 #import <pthread.h>
 
@@ -26,7 +27,7 @@
 
 @implementation KRPerformanceManager {
     
-    CADisplayLink *_uiDisplayLink;
+    KRDisplayLink *_uiDisplayLink;
     dispatch_source_t _kotlinTimer;
     
     NSString *_pageName;
@@ -87,11 +88,13 @@ static NSMutableDictionary<NSString *, NSNumber *> *gLaunchDic = nil;
         if (!_mainFPS) {
             _mainFPS = [[KRFPSMonitor alloc] initWithThread:KRFPSThead_Main pageName:_pageName];
         }
-        _uiDisplayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(mainFPSKick:)];
-        if (@available(iOS 10.0, *)) {
-            _uiDisplayLink.preferredFramesPerSecond = 60;
-        }
-        [_uiDisplayLink addToRunLoop:[NSRunLoop currentRunLoop] forMode:NSRunLoopCommonModes];
+        // 共用进程内的帧时钟，不再单独创建CADisplayLink
+        _uiDisplayLink = [[KRDisplayLink alloc] init];
+        __weak __typeof__(self) wself = self;
+        [_uiDisplayLink startWithCallback:^(CFTimeInterval timestamp) {
+            __strong __typeof__(self) sself = wself;
+            [sself mainFPSKick:timestamp];
+        }];
     }
 
     // kotlin fps
@@ -122,7 +125,7 @@ static NSMutableDictionary<NSString *, NSNumber *> *gLaunchDic = nil;
 - (void)endMonitor {
     _isMoniting = NO;
     if ((_monitorType & KRMonitorType_MainFPS)) {
-        [_uiDisplayLink invalidate];
+        [_uiDisplayLink stop];
         _uiDisplayLink = nil;
         [_mainFPS endMonitor];
     }
@@ -238,9 +241,9 @@ static NSMutableDictionary<NSString *, NSNumber *> *gLaunchDic = nil;
 
 #pragma mark load time end
 
-- (void)mainFPSKick:(CADisplayLink *)displayLink
+- (void)mainFPSKick:(CFTimeInterval)timestamp
 {
-    [_mainFPS onTick:displayLink.timestamp];
+    [_mainFPS onTick:timestamp];
 }
 
 @end
@@ -16,6 +16,14 @@
 #import "KRPerformanceModule.h"
 #import "KuiklyRenderView.h"
 #import "KRPerformanceDataProtocol.h"
+#import "KRTraceRecorder.h"
+#import "KRLogModule.h"
+#import "KuiklyRenderThreadManager.h"
+#import "KRHttpSessionPool.h"
+#import "KRScrollEventStats.h"
+#import "KRTextLayoutEngine.h"
+#import "KRAsyncDeallocManager.h"
+#import "KRSnapshotModule.h"
 
 NSString *const kKuiklyPageLoadTimeFromKotlinNotification = @"KuiklyPageLoadTimeFromKotlinNotification";
 
@@ -28,7 +36,84 @@ NSString *const kKuiklyPageLoadTimeFromKotlinNotification = @"KuiklyPageLoadTime
 
 - (void)getPerformanceData:(NSDictionary *)args {
     KuiklyRenderCallback callback = args[KR_CALLBACK_KEY];
-    
+    // 缓存开销统计与内存采样需在主线程
+    [KuiklyRenderThreadManager performOnMainQueueWithTask:^{
+        NSDictionary *performData = [self p_performanceData];
+        if (callback) {
+            callback(performData);
+        }
+    } sync:NO];
+}
+
+/*
+ * 获取页面打开以来每个网络请求的耗时（DNS/TCP/TLS/TTFB等，单位毫秒），回调{"requests": [...]}
+ */
+- (void)getNetworkMetrics:(NSDictionary *)args {
+    KuiklyRenderCallback callback = args[KR_CALLBACK_KEY];
+    NSMutableArray *requests = [NSMutableArray new];
+    for (KRHttpTaskMetrics *metrics in [self p_networkMetrics]) {
+        [requests addObject:[metrics toDictionary]];
+    }
+    if (callback) {
+        callback(@{ @"requests": requests });
+    }
+}
+
+/*
+ * 开始记录渲染链路trace
+ */
+- (void)startTrace:(NSDictionary *)args {
+    [KRTraceRecorder startRecording];
+}
+
+/*
+ * 停止记录并导出Chrome trace JSON文件，回调{"path": 文件路径}，导出失败时path为空
+ */
+- (void)stopTrace:(NSDictionary *)args {
+    KuiklyRenderCallback callback = args[KR_CALLBACK_KEY];
+    [KRTraceRecorder stopRecording];
+    NSString *fileName = [NSString stringWithFormat:@"kuikly_trace_%lld.json", (long long)([[NSDate date] timeIntervalSince1970] * 1000)];
+    NSString *filePath = [NSTemporaryDirectory() stringByAppendingPathComponent:fileName];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSError *error = nil;
+        BOOL success = [KRTraceRecorder writeChromeTraceToFile:filePath error:&error];
+        if (!success) {
+            [KRLogModule logError:[NSString stringWithFormat:@"write trace file failed: %@", error]];
+        }
+        [KuiklyRenderThreadManager performOnMainQueueWithTask:^{
+            if (callback) {
+                callback(@{ @"path": success ? filePath : @"" });
+            }
+        } sync:NO];
+    });
+}
+
+/*
+ * 开始统计列表scroll事件的跨桥开销
+ */
+- (void)startScrollEventStats:(NSDictionary *)args {
+    [KuiklyRenderThreadManager performOnMainQueueWithTask:^{
+        [KRScrollEventStats startRecording];
+    } sync:NO];
+}
+
+/*
+ * 停止统计，回调{"events", "binaryEvents", "bytes", "scrollSeconds", "eventsPerSecond", "bytesPerSecond"}，
+ * 按每秒滚动时长计算
+ */
+- (void)stopScrollEventStats:(NSDictionary *)args {
+    KuiklyRenderCallback callback = args[KR_CALLBACK_KEY];
+    [KuiklyRenderThreadManager performOnMainQueueWithTask:^{
+        NSDictionary *stats = [KRScrollEventStats stopRecording];
+        if (callback) {
+            callback(stats);
+        }
+    } sync:NO];
+}
+
+#pragma mark - private
+
+- (NSDictionary *)p_performanceData {
     KuiklyRenderView *rootView = self.hr_rootView;
     id<KRPerformanceDataProtocol> performanceManager = rootView.delegate.performanceManager;
     
@@ -40,7 +125,9 @@ NSString *const kKuiklyPageLoadTimeFromKotlinNotification = @"KuiklyPageLoadTime
         timeMap[keysArray[i]] = @(duration);
     }
     
-    NSDictionary *performData = @{
+    // 返回当前值而不是最近一次定时采样
+    [performanceManager.memoryMonitor sampleNow];
+    return @{
         @"mode": @(rootView.contextParam.contextMode.modeId),
         @"pageExistTime": @(performanceManager.pageExistTime),
         @"isFirstLaunchOfProcess": @([performanceManager isFirstLaunchOfProcess]),
@@ -48,14 +135,61 @@ NSString *const kKuiklyPageLoadTimeFromKotlinNotification = @"KuiklyPageLoadTime
         @"pageLoadTime": timeMap,
         @"mainFPS": @(performanceManager.mainFPS.avgFPS),
         @"kotlinFPS": @(performanceManager.kotlinFPS.avgFPS),
+        @"mainFrameTime": [performanceManager.mainFPS frameTimeData] ?: @{},
+        @"kotlinFrameTime": [performanceManager.kotlinFPS frameTimeData] ?: @{},
         @"memory": @{
             @"avgIncrement": @(performanceManager.memoryMonitor.avgIncrementMemory),
             @"peakIncrement": @(performanceManager.memoryMonitor.peakIncrementMemory),
             @"appPeak": @(performanceManager.memoryMonitor.appPeakMemory),
             @"appAvg": @(performanceManager.memoryMonitor.appAvgMemory),
+            @"current": @(performanceManager.memoryMonitor.currentMemory),
+            @"sampleCount": @(performanceManager.memoryMonitor.sampleCount),
+            @"pressureLevel": @([KRMemoryMonitor currentPressureLevel]),
+            @"cacheBreakdown": [KRMemoryMonitor cacheMemoryBreakdown],
         },
+        @"network": [self p_networkData],
+        @"textLayout": [[KRTextLayoutEngine sharedEngine] statistics],
+        @"asyncDealloc": [[KRAsyncDeallocManager shareManager] statistics],
+        @"snapshot": [KRSnapshotModule snapshotMetrics],
+    };
+}
+
+/// 本页面发起的请求（按页面标识记录，不含其他页面和预连接请求）
+- (NSArray<KRHttpTaskMetrics *> *)p_networkMetrics {
+    return [[KRHttpSessionPool sharedPool] metricsForPageId:[KRHttpSessionPool pageIdForOwner:self.hr_rootView]];
+}
+
+/// 页面打开以来网络请求的汇总耗时（各阶段为平均值，单位毫秒）
+- (NSDictionary *)p_networkData {
+    NSArray<KRHttpTaskMetrics *> *metricsArray = [self p_networkMetrics];
+    NSUInteger count = metricsArray.count;
+    if (!count) {
+        return @{ @"requestCount": @0 };
+    }
+    NSUInteger reusedCount = 0;
+    NSTimeInterval dns = 0, tcp = 0, tls = 0, ttfb = 0, total = 0, maxTotal = 0;
+    int64_t bytes = 0;
+    for (KRHttpTaskMetrics *metrics in metricsArray) {
+        reusedCount += metrics.reusedConnection ? 1 : 0;
+        dns += metrics.dnsCost;
+        tcp += metrics.tcpCost;
+        tls += metrics.tlsCost;
+        ttfb += metrics.ttfbCost;
+        total += metrics.totalCost;
+        maxTotal = MAX(maxTotal, metrics.totalCost);
+        bytes += metrics.responseBytes;
+    }
+    return @{
+        @"requestCount": @(count),
+        @"reusedCount": @(reusedCount),
+        @"avgDNS": @((int)(dns / count)),
+        @"avgTCP": @((int)(tcp / count)),
+        @"avgTLS": @((int)(tls / count)),
+        @"avgTTFB": @((int)(ttfb / count)),
+        @"avgTotal": @((int)(total / count)),
+        @"maxTotal": @((int)maxTotal),
+        @"bytes": @(bytes),
     };
-    callback(performData);
 }
 
 @end
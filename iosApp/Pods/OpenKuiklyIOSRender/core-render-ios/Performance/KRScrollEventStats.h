@@ -0,0 +1,40 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * 列表scroll事件跨桥开销统计（主线程调用）
+ * 只累计滚动中的时长（相邻事件间隔超过100ms视为停止），用于计算每秒滚动的事件数与跨桥字节数
+ */
+@interface KRScrollEventStats : NSObject
+
+/// 开始统计（清空之前的数据）
++ (void)startRecording;
+/// 停止统计，返回统计结果
++ (NSDictionary *)stopRecording;
++ (BOOL)isRecording;
+/*
+ * 记录一次scroll事件
+ * @param bytes 跨桥数据字节数（字典事件为JSON长度）
+ * @param binary 是否为二进制事件
+ */
++ (void)recordEventWithBytes:(NSUInteger)bytes binary:(BOOL)binary;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,73 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRScrollEventStats.h"
+#import <QuartzCore/QuartzCore.h>
+
+/// 相邻事件间隔超过该值不计入滚动时长
+static const CFTimeInterval kKRScrollEventMaxInterval = 0.1;
+
+static BOOL gRecording = NO;
+static NSUInteger gEventCount = 0;
+static NSUInteger gBinaryEventCount = 0;
+static unsigned long long gBytes = 0;
+static CFTimeInterval gScrollDuration = 0;
+static CFTimeInterval gLastEventTime = 0;
+
+@implementation KRScrollEventStats
+
++ (void)startRecording {
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    gEventCount = 0;
+    gBinaryEventCount = 0;
+    gBytes = 0;
+    gScrollDuration = 0;
+    gLastEventTime = 0;
+    gRecording = YES;
+}
+
++ (NSDictionary *)stopRecording {
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    gRecording = NO;
+    double seconds = gScrollDuration;
+    return @{
+        @"events": @(gEventCount),
+        @"binaryEvents": @(gBinaryEventCount),
+        @"bytes": @(gBytes),
+        @"scrollSeconds": @(seconds),
+        @"eventsPerSecond": @(seconds > 0 ? gEventCount / seconds : 0),
+        @"bytesPerSecond": @(seconds > 0 ? gBytes / seconds : 0),
+    };
+}
+
++ (BOOL)isRecording {
+    return gRecording;
+}
+
++ (void)recordEventWithBytes:(NSUInteger)bytes binary:(BOOL)binary {
+    if (!gRecording) {
+        return;
+    }
+    CFTimeInterval now = CACurrentMediaTime();
+    if (gLastEventTime > 0 && now - gLastEventTime <= kKRScrollEventMaxInterval) {
+        gScrollDuration += now - gLastEventTime;
+    }
+    gLastEventTime = now;
+    gEventCount++;
+    gBinaryEventCount += binary ? 1 : 0;
+    gBytes += bytes;
+}
+
+@end
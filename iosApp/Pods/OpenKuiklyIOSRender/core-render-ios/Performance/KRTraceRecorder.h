@@ -0,0 +1,47 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * 渲染链路trace打点（C接口，未开启记录时开销仅为一次原子读）
+ * name超过39个字节会被截断
+ */
+FOUNDATION_EXTERN BOOL KRTraceIsEnabled(void);
+FOUNDATION_EXTERN void KRTraceBegin(const char *name);
+FOUNDATION_EXTERN void KRTraceEnd(const char *name);
+FOUNDATION_EXTERN void KRTraceCounter(const char *name, int64_t value);
+FOUNDATION_EXTERN void KRTraceInstant(const char *name);
+
+/*
+ * trace记录器，导出Chrome trace格式JSON，可用chrome://tracing或Perfetto打开
+ */
+@interface KRTraceRecorder : NSObject
+
+/// 开始记录（清空之前记录的事件）
++ (void)startRecording;
+/// 停止记录，已记录的事件仍可导出
++ (void)stopRecording;
++ (BOOL)isRecording;
+/// Chrome trace JSON数据
++ (NSData *)chromeTraceData;
+/// 写入Chrome trace JSON文件
++ (BOOL)writeChromeTraceToFile:(NSString *)filePath error:(NSError * _Nullable * _Nullable)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
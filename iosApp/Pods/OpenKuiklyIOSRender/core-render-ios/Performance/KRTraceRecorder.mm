@@ -0,0 +1,81 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRTraceRecorder.h"
+#import "KRTraceRecorderCore.hpp"
+
+using kuikly::trace::Recorder;
+
+BOOL KRTraceIsEnabled(void) {
+    return Recorder::Shared().IsEnabled();
+}
+
+void KRTraceBegin(const char *name) {
+    Recorder::Shared().Begin(name);
+}
+
+void KRTraceEnd(const char *name) {
+    Recorder::Shared().End(name);
+}
+
+void KRTraceCounter(const char *name, int64_t value) {
+    Recorder::Shared().Counter(name, value);
+}
+
+void KRTraceInstant(const char *name) {
+    Recorder::Shared().Instant(name);
+}
+
+/// 主线程命名为main，GCD线程使用当前队列名
+static std::string KRTraceCurrentThreadName() {
+    if ([NSThread isMainThread]) {
+        return "main";
+    }
+    const char *label = dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL);
+    if (label && label[0]) {
+        return label;
+    }
+    NSString *name = [NSThread currentThread].name;
+    return name.length ? name.UTF8String : std::string();
+}
+
+@implementation KRTraceRecorder
+
++ (void)startRecording {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        Recorder::Shared().SetThreadNameProvider(KRTraceCurrentThreadName);
+    });
+    Recorder::Shared().Start();
+}
+
++ (void)stopRecording {
+    Recorder::Shared().Stop();
+}
+
++ (BOOL)isRecording {
+    return Recorder::Shared().IsEnabled();
+}
+
++ (NSData *)chromeTraceData {
+    std::string json = Recorder::Shared().ExportChromeTraceJSON([NSProcessInfo processInfo].processIdentifier);
+    return [NSData dataWithBytes:json.data() length:json.size()];
+}
+
++ (BOOL)writeChromeTraceToFile:(NSString *)filePath error:(NSError **)error {
+    return [[self chromeTraceData] writeToFile:filePath options:NSDataWritingAtomic error:error];
+}
+
+@end
@@ -0,0 +1,319 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "KRTraceRecorderCore.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <pthread.h>
+
+namespace kuikly {
+namespace trace {
+
+static_assert((kDefaultRingCapacity & (kDefaultRingCapacity - 1)) == 0, "ring capacity must be a power of two");
+
+class ThreadBuffer {
+public:
+    ThreadBuffer(uint32_t tid, std::string name)
+        : tid_(tid), name_(std::move(name)), slots_(new Slot[kDefaultRingCapacity]) {}
+
+    uint32_t tid() const { return tid_; }
+    const std::string &name() const { return name_; }
+
+    /// 只允许所属线程调用
+    void Write(Phase phase, const char *name, int64_t value, uint64_t timestamp) {
+        uint64_t index = head_.load(std::memory_order_relaxed);
+        Slot &slot = slots_[index & (kDefaultRingCapacity - 1)];
+        // 序号置0表示槽位正在写入，读者会丢弃该槽位
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.event.timestamp = timestamp;
+        slot.event.value = value;
+        slot.event.phase = phase;
+        if (name) {
+            strncpy(slot.event.name, name, kMaxEventNameLength - 1);
+            slot.event.name[kMaxEventNameLength - 1] = '\0';
+        } else {
+            slot.event.name[0] = '\0';
+        }
+        slot.sequence.store(index + 1, std::memory_order_release);
+        head_.store(index + 1, std::memory_order_release);
+    }
+
+    /// 可在任意线程调用（需持有Recorder的缓冲区锁，避免与线程退出时的Retire并发），按写入顺序追加仍有效的事件
+    void Snapshot(std::vector<Event> &out) const {
+        if (retired_) {
+            out.insert(out.end(), retired_events_.begin(), retired_events_.end());
+            return;
+        }
+        uint64_t head = head_.load(std::memory_order_acquire);
+        uint64_t begin = std::max(start_.load(std::memory_order_relaxed),
+                                  head > kDefaultRingCapacity ? head - kDefaultRingCapacity : 0);
+        for (uint64_t index = begin; index < head; index++) {
+            const Slot &slot = slots_[index & (kDefaultRingCapacity - 1)];
+            uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != index + 1) {
+                continue;
+            }
+            // seqlock读：拷贝后再次校验序号，不一致说明拷贝期间被覆盖
+            Event event = slot.event;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+                continue;
+            }
+            out.push_back(event);
+        }
+    }
+
+    void Clear() {
+        start_.store(head_.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+
+    /// 自上次Clear后是否没有记录过事件
+    bool Empty() const {
+        return retired_ ? retired_events_.empty()
+                        : head_.load(std::memory_order_acquire) == start_.load(std::memory_order_relaxed);
+    }
+
+    /// 所属线程退出时调用：保留仍有效的事件，释放环形缓冲区
+    void Retire() {
+        std::vector<Event> events;
+        Snapshot(events);
+        retired_events_.assign(events.begin(), events.end());
+        slots_.reset();
+        retired_ = true;
+    }
+
+    bool retired() const { return retired_; }
+
+    size_t Bytes() const {
+        return sizeof(ThreadBuffer) + name_.capacity() +
+               (retired_ ? retired_events_.capacity() * sizeof(Event) : kDefaultRingCapacity * sizeof(Slot));
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        Event event;
+    };
+
+    const uint32_t tid_;
+    const std::string name_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<uint64_t> head_{0};
+    std::atomic<uint64_t> start_{0};
+    bool retired_ = false;
+    std::vector<Event> retired_events_;
+};
+
+/// 当前线程的缓冲区，线程退出时由pthread key析构回调释放
+static thread_local ThreadBuffer *tCurrentBuffer = nullptr;
+
+Recorder &Recorder::Shared() {
+    // 不析构，避免进程退出时其他线程仍在记录
+    static Recorder *recorder = new Recorder();
+    return *recorder;
+}
+
+uint64_t Recorder::NowNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Recorder::Start() {
+    Clear();
+    origin_.store(NowNanoseconds(), std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_release);
+}
+
+void Recorder::Stop() {
+    enabled_.store(false, std::memory_order_release);
+}
+
+void Recorder::Clear() {
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    for (size_t i = buffers_.size(); i > 0; i--) {
+        if (buffers_[i - 1]->retired()) {
+            RemoveBufferLocked(i - 1);
+        } else {
+            buffers_[i - 1]->Clear();
+        }
+    }
+}
+
+void Recorder::Record(Phase phase, const char *name, int64_t value) {
+    CurrentThreadBuffer()->Write(phase, name, value, NowNanoseconds());
+}
+
+ThreadBuffer *Recorder::CurrentThreadBuffer() {
+    if (!tCurrentBuffer) {
+        static pthread_key_t key = [] {
+            pthread_key_t threadKey;
+            pthread_key_create(&threadKey, &Recorder::ThreadBufferDestructor);
+            return threadKey;
+        }();
+        std::string name = thread_name_provider_ ? thread_name_provider_() : std::string();
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        tCurrentBuffer = new ThreadBuffer(next_tid_++, std::move(name));
+        buffers_.push_back(tCurrentBuffer);
+        pthread_setspecific(key, tCurrentBuffer);
+    }
+    return tCurrentBuffer;
+}
+
+void Recorder::ThreadBufferDestructor(void *buffer) {
+    // 其他线程局部变量的析构中若再次记录，会重新注册缓冲区（pthread会再次调用本回调）
+    tCurrentBuffer = nullptr;
+    Shared().RetireThreadBuffer(static_cast<ThreadBuffer *>(buffer));
+}
+
+void Recorder::RetireThreadBuffer(ThreadBuffer *buffer) {
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    auto it = std::find(buffers_.begin(), buffers_.end(), buffer);
+    if (it == buffers_.end()) {
+        delete buffer;
+        return;
+    }
+    if (buffer->Empty()) {
+        RemoveBufferLocked(static_cast<size_t>(it - buffers_.begin()));
+        return;
+    }
+    buffer->Retire();
+    retired_count_++;
+    for (size_t i = 0; retired_count_ > kMaxRetiredThreadCount && i < buffers_.size();) {
+        if (buffers_[i]->retired()) {
+            RemoveBufferLocked(i);
+        } else {
+            i++;
+        }
+    }
+}
+
+void Recorder::RemoveBufferLocked(size_t index) {
+    ThreadBuffer *buffer = buffers_[index];
+    if (buffer->retired()) {
+        retired_count_--;
+    }
+    buffers_.erase(buffers_.begin() + static_cast<std::ptrdiff_t>(index));
+    delete buffer;
+}
+
+size_t Recorder::ThreadBufferCount() const {
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    return buffers_.size();
+}
+
+size_t Recorder::RetainedBytes() const {
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    size_t bytes = 0;
+    for (const ThreadBuffer *buffer : buffers_) {
+        bytes += buffer->Bytes();
+    }
+    return bytes;
+}
+
+static void AppendJSONString(std::string &out, const char *value) {
+    out.push_back('"');
+    for (const char *c = value; *c; c++) {
+        switch (*c) {
+            case '"':
+                out.append("\\\"");
+                break;
+            case '\\':
+                out.append("\\\\");
+                break;
+            case '\n':
+                out.append("\\n");
+                break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+                    out.append(escaped);
+                } else {
+                    out.push_back(*c);
+                }
+                break;
+        }
+    }
+    out.push_back('"');
+}
+
+namespace {
+
+struct ThreadEvents {
+    uint32_t tid;
+    std::string name;
+    std::vector<Event> events;
+};
+
+}  // namespace
+
+std::string Recorder::ExportChromeTraceJSON(uint32_t pid) const {
+    // 持锁拷贝事件，避免快照期间线程退出释放缓冲区；格式化在锁外进行
+    std::vector<ThreadEvents> threads;
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        threads.reserve(buffers_.size());
+        for (const ThreadBuffer *buffer : buffers_) {
+            ThreadEvents thread{buffer->tid(), buffer->name(), {}};
+            buffer->Snapshot(thread.events);
+            if (!thread.events.empty()) {
+                threads.push_back(std::move(thread));
+            }
+        }
+    }
+    uint64_t origin = origin_.load(std::memory_order_relaxed);
+    std::string out("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    char buf[160];
+    for (const ThreadEvents &thread : threads) {
+        snprintf(buf, sizeof(buf), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":",
+                 first ? "" : ",", pid, thread.tid);
+        out.append(buf);
+        AppendJSONString(out, thread.name.empty() ? "thread" : thread.name.c_str());
+        out.append("}}");
+        first = false;
+        for (const Event &event : thread.events) {
+            // 单位us，保留ns精度
+            uint64_t delta = event.timestamp > origin ? event.timestamp - origin : 0;
+            snprintf(buf, sizeof(buf), ",{\"ph\":\"%c\",\"pid\":%u,\"tid\":%u,\"ts\":%" PRIu64 ".%03u,\"cat\":\"kuikly\",\"name\":",
+                     static_cast<char>(event.phase), pid, thread.tid, delta / 1000, static_cast<unsigned>(delta % 1000));
+            out.append(buf);
+            AppendJSONString(out, event.name);
+            switch (event.phase) {
+                case Phase::kCounter:
+                    snprintf(buf, sizeof(buf), ",\"args\":{\"value\":%" PRId64 "}", event.value);
+                    out.append(buf);
+                    break;
+                case Phase::kInstant:
+                    out.append(",\"s\":\"t\"");
+                    break;
+                default:
+                    break;
+            }
+            out.push_back('}');
+        }
+    }
+    out.append("]}");
+    return out;
+}
+
+}  // namespace trace
+}  // namespace kuikly
@@ -0,0 +1,137 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KRTraceRecorderCore_hpp
+#define KRTraceRecorderCore_hpp
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * trace记录核心，仅依赖C++标准库与pthread，可脱离iOS单独编译/benchmark。
+ * 每个线程独占一个环形缓冲区，写入无锁（只有线程首次记录和退出时需要加锁），
+ * 缓冲区写满后覆盖最旧的事件；导出时按槽位序号校验，丢弃正在被覆盖的事件。
+ * 线程退出时释放环形缓冲区，已记录的事件压缩保留到下次Start/Clear。
+ */
+namespace kuikly {
+namespace trace {
+
+enum class Phase : char {
+    kBegin = 'B',
+    kEnd = 'E',
+    kCounter = 'C',
+    kInstant = 'i',
+};
+
+/// 事件名最大长度（含结尾的'\0'），超出部分截断
+constexpr size_t kMaxEventNameLength = 40;
+/// 每个线程的环形缓冲区容量（事件数），需为2的幂
+constexpr size_t kDefaultRingCapacity = 4096;
+/// 最多保留的已退出线程个数，超出时丢弃最早退出线程的事件
+constexpr size_t kMaxRetiredThreadCount = 64;
+
+struct Event {
+    /// 单调时钟时间戳（ns）
+    uint64_t timestamp;
+    /// counter事件的值
+    int64_t value;
+    Phase phase;
+    char name[kMaxEventNameLength];
+};
+
+/// 返回当前线程名，用于导出时的线程元数据，可为空
+typedef std::string (*ThreadNameProvider)();
+
+class ThreadBuffer;
+
+class Recorder {
+public:
+    static Recorder &Shared();
+
+    /// 开始记录，会清空之前记录的事件
+    void Start();
+    void Stop();
+    bool IsEnabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    void Begin(const char *name) {
+        if (IsEnabled()) {
+            Record(Phase::kBegin, name, 0);
+        }
+    }
+    void End(const char *name) {
+        if (IsEnabled()) {
+            Record(Phase::kEnd, name, 0);
+        }
+    }
+    void Counter(const char *name, int64_t value) {
+        if (IsEnabled()) {
+            Record(Phase::kCounter, name, value);
+        }
+    }
+    void Instant(const char *name) {
+        if (IsEnabled()) {
+            Record(Phase::kInstant, name, 0);
+        }
+    }
+
+    /// 清空已记录的事件
+    void Clear();
+    /// 设置线程名获取方式，需在Start之前设置
+    void SetThreadNameProvider(ThreadNameProvider provider) {
+        thread_name_provider_ = provider;
+    }
+    /// 导出Chrome trace（Perfetto可直接打开）格式的JSON
+    std::string ExportChromeTraceJSON(uint32_t pid) const;
+    /// 当前持有的线程缓冲区个数（含已退出线程保留的事件）
+    size_t ThreadBufferCount() const;
+    /// 线程缓冲区占用的字节数
+    size_t RetainedBytes() const;
+
+    static uint64_t NowNanoseconds();
+
+private:
+    Recorder() = default;
+    Recorder(const Recorder &) = delete;
+    Recorder &operator=(const Recorder &) = delete;
+
+    void Record(Phase phase, const char *name, int64_t value);
+    ThreadBuffer *CurrentThreadBuffer();
+    /// 线程退出时由pthread key析构回调调用
+    void RetireThreadBuffer(ThreadBuffer *buffer);
+    static void ThreadBufferDestructor(void *buffer);
+    /// 需持有buffers_mutex_
+    void RemoveBufferLocked(size_t index);
+
+    std::atomic<bool> enabled_{false};
+    /// 导出时间戳的起点（ns）
+    std::atomic<uint64_t> origin_{0};
+    ThreadNameProvider thread_name_provider_ = nullptr;
+    mutable std::mutex buffers_mutex_;
+    /// 存活线程的缓冲区与已退出线程压缩后的事件，按注册顺序排列
+    std::vector<ThreadBuffer *> buffers_;
+    size_t retired_count_ = 0;
+    uint32_t next_tid_ = 1;
+};
+
+}  // namespace trace
+}  // namespace kuikly
+
+#endif /* KRTraceRecorderCore_hpp */
@@ -0,0 +1,119 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/*
+ * KRTraceRecorderCore开销基准：
+ *   1. 记录关闭与开启时单次调用耗时（多线程并发Begin/End）；
+ *   2. 短生命周期线程反复创建退出后的常驻字节数，与"每个线程保留整个环形缓冲区"对比。
+ * 耗时为各线程CPU时间（CLOCK_THREAD_CPUTIME_ID）下批量调用的均值，不受核数与调度影响，不含逐次计时的开销。
+ */
+
+#include "KRTraceRecorderCore.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+using kuikly::trace::Recorder;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ThreadCPUNanoseconds() {
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return static_cast<double>(time.tv_sec) * 1e9 + time.tv_nsec;
+}
+
+/// 每个线程调用events次Begin+End，返回单次调用的平均CPU耗时（ns）
+double MeasureNanosecondsPerCall(int threadCount, int events) {
+    std::vector<double> nanoseconds(threadCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([events, t, &nanoseconds] {
+            Recorder &recorder = Recorder::Shared();
+            recorder.Instant("warm up");  // 首次记录注册缓冲区，不计入
+            double begin = ThreadCPUNanoseconds();
+            for (int i = 0; i < events; i++) {
+                recorder.Begin("KuiklyRenderCore.callNative");
+                recorder.End("KuiklyRenderCore.callNative");
+            }
+            nanoseconds[t] = ThreadCPUNanoseconds() - begin;
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    double total = 0;
+    for (double value : nanoseconds) {
+        total += value;
+    }
+    return total / (static_cast<double>(threadCount) * events * 2);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    int threadCount = 4;
+    int events = 1000000;
+    int churn = 2000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--threads") == 0) {
+            threadCount = std::max(1, atoi(argv[i + 1]));
+        } else if (strcmp(argv[i], "--events") == 0) {
+            events = std::max(1, atoi(argv[i + 1]));
+        } else if (strcmp(argv[i], "--churn") == 0) {
+            churn = std::max(1, atoi(argv[i + 1]));
+        }
+    }
+    Recorder &recorder = Recorder::Shared();
+    printf("KRTraceRecorderCore benchmark: %d threads x %d events, %d short-lived threads\n", threadCount, events, churn);
+
+    recorder.Stop();
+    printf("%-20s %8.2f ns/call\n", "disabled", MeasureNanosecondsPerCall(threadCount, events));
+    recorder.Start();
+    printf("%-20s %8.2f ns/call\n", "enabled", MeasureNanosecondsPerCall(threadCount, events));
+
+    // 线程池外的短任务线程：每个线程只记录一对事件就退出
+    recorder.Start();
+    recorder.Instant("main");
+    size_t ringBytes = recorder.RetainedBytes();
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < churn; i++) {
+        std::thread([] {
+            Recorder::Shared().Begin("task");
+            Recorder::Shared().End("task");
+        }).join();
+    }
+    double microsecondsPerThread = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / churn;
+    size_t retainedBytes = recorder.RetainedBytes();
+    size_t bufferCount = recorder.ThreadBufferCount();
+    printf("%-20s %zu buffers, %zu bytes retained (a ring per exited thread: %zu bytes), %.1f us/thread\n", "thread churn",
+           bufferCount, retainedBytes, ringBytes * (static_cast<size_t>(churn) + 1), microsecondsPerThread);
+    recorder.Stop();
+    if (bufferCount > kuikly::trace::kMaxRetiredThreadCount + 1 || retainedBytes >= ringBytes * 2) {
+        fprintf(stderr, "exited thread buffers were not released\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,202 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/*
+ * KRTraceRecorderCore功能测试：记录与导出、线程退出后环形缓冲区的回收、已退出线程事件的保留与上限、
+ * 导出与线程退出并发。Recorder为进程单例，每个用例先Start清空之前的事件。
+ */
+
+#include "KRTraceRecorderCore.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using kuikly::trace::Recorder;
+
+namespace {
+
+size_t gFailures = 0;
+
+#define EXPECT(condition, ...)                                  \
+    do {                                                        \
+        if (!(condition)) {                                     \
+            gFailures++;                                        \
+            printf("FAIL %s:%d %s: ", __FILE__, __LINE__, #condition); \
+            printf(__VA_ARGS__);                                \
+            printf("\n");                                       \
+        }                                                       \
+    } while (0)
+
+/// 线程首次记录前设置，作为导出的线程名
+thread_local std::string tThreadName;
+
+std::string CurrentThreadName() {
+    return tThreadName;
+}
+
+bool Contains(const std::string &json, const std::string &text) {
+    return json.find(text) != std::string::npos;
+}
+
+/// 启动一个线程记录count对Begin/End后退出
+void RunWorker(const std::string &name, int count) {
+    std::thread([name, count] {
+        tThreadName = name;
+        for (int i = 0; i < count; i++) {
+            Recorder::Shared().Begin("work");
+            Recorder::Shared().End("work");
+        }
+    }).join();
+}
+
+void TestRecordAndExport() {
+    Recorder &recorder = Recorder::Shared();
+    recorder.Start();
+    recorder.Begin("layout \"root\"");
+    recorder.Counter("tasks", 42);
+    recorder.Instant("vsync");
+    recorder.End("layout \"root\"");
+    recorder.Stop();
+    recorder.Begin("ignored");
+    std::string json = recorder.ExportChromeTraceJSON(7);
+    EXPECT(Contains(json, "\"name\":\"layout \\\"root\\\"\""), "escaped name missing: %s", json.c_str());
+    EXPECT(Contains(json, "\"args\":{\"value\":42}"), "counter missing: %s", json.c_str());
+    EXPECT(Contains(json, "\"s\":\"t\""), "instant missing: %s", json.c_str());
+    EXPECT(Contains(json, "\"name\":\"main\""), "thread name missing: %s", json.c_str());
+    EXPECT(!Contains(json, "ignored"), "recorded while stopped");
+}
+
+/// 线程退出后释放环形缓冲区，只保留压缩后的事件，导出中仍可见
+void TestThreadExitReleasesRing() {
+    Recorder &recorder = Recorder::Shared();
+    recorder.Start();
+    recorder.Instant("main");  // 主线程缓冲区常驻
+    size_t baseCount = recorder.ThreadBufferCount();
+    size_t baseBytes = recorder.RetainedBytes();
+    for (int i = 0; i < 10; i++) {
+        RunWorker("worker-" + std::to_string(i), 5);
+    }
+    EXPECT(recorder.ThreadBufferCount() == baseCount + 10, "count %zu, base %zu", recorder.ThreadBufferCount(), baseCount);
+    // 10个环形缓冲区约占10倍baseBytes，退出后每个线程只剩10个事件
+    EXPECT(recorder.RetainedBytes() < baseBytes * 2, "retained %zu bytes, one ring %zu", recorder.RetainedBytes(), baseBytes);
+    std::string json = recorder.ExportChromeTraceJSON(1);
+    EXPECT(Contains(json, "\"name\":\"worker-0\""), "exited thread events dropped");
+    EXPECT(Contains(json, "\"name\":\"worker-9\""), "exited thread events dropped");
+    recorder.Start();
+    EXPECT(recorder.ThreadBufferCount() == baseCount, "Start keeps %zu buffers", recorder.ThreadBufferCount());
+}
+
+/// 自上次Clear后没有事件的线程退出时直接释放
+void TestEmptyThreadRemoved() {
+    Recorder &recorder = Recorder::Shared();
+    recorder.Start();
+    recorder.Instant("main");
+    size_t baseCount = recorder.ThreadBufferCount();
+    std::mutex mutex;
+    std::condition_variable cv;
+    int step = 0;
+    std::thread worker([&] {
+        tThreadName = "cleared";
+        recorder.Instant("before clear");
+        std::unique_lock<std::mutex> lock(mutex);
+        step = 1;
+        cv.notify_all();
+        cv.wait(lock, [&] { return step == 2; });
+    });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return step == 1; });
+        EXPECT(recorder.ThreadBufferCount() == baseCount + 1, "worker not registered");
+        recorder.Clear();
+        step = 2;
+        cv.notify_all();
+    }
+    worker.join();
+    EXPECT(recorder.ThreadBufferCount() == baseCount, "empty buffer kept, count %zu", recorder.ThreadBufferCount());
+}
+
+/// 已退出线程超过上限时丢弃最早退出的线程
+void TestRetiredLimit() {
+    Recorder &recorder = Recorder::Shared();
+    recorder.Start();
+    recorder.Instant("main");
+    size_t baseCount = recorder.ThreadBufferCount();
+    const int threadCount = static_cast<int>(kuikly::trace::kMaxRetiredThreadCount) + 20;
+    for (int i = 0; i < threadCount; i++) {
+        RunWorker("limit-" + std::to_string(i), 1);
+    }
+    EXPECT(recorder.ThreadBufferCount() == baseCount + kuikly::trace::kMaxRetiredThreadCount,
+           "count %zu", recorder.ThreadBufferCount());
+    std::string json = recorder.ExportChromeTraceJSON(1);
+    EXPECT(!Contains(json, "\"name\":\"limit-0\""), "oldest retired thread kept");
+    EXPECT(Contains(json, "\"name\":\"limit-" + std::to_string(threadCount - 1) + "\""), "newest retired thread dropped");
+}
+
+/// 导出与线程频繁退出并发，不应访问已释放的缓冲区
+void TestExportWhileThreadsExit() {
+    Recorder &recorder = Recorder::Shared();
+    recorder.Start();
+    std::atomic<bool> done(false);
+    std::thread exporter([&] {
+        while (!done.load()) {
+            std::string json = recorder.ExportChromeTraceJSON(1);
+            EXPECT(json.size() >= 2 && json.compare(json.size() - 2, 2, "]}") == 0, "truncated export");
+        }
+    });
+    std::vector<std::thread> workers;
+    for (int round = 0; round < 50; round++) {
+        for (int t = 0; t < 8; t++) {
+            workers.emplace_back([t] {
+                tThreadName = "churn-" + std::to_string(t);
+                for (int i = 0; i < 100; i++) {
+                    Recorder::Shared().Counter("value", i);
+                }
+            });
+        }
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+    }
+    done.store(true);
+    exporter.join();
+    EXPECT(recorder.ThreadBufferCount() <= kuikly::trace::kMaxRetiredThreadCount + 2, "count %zu", recorder.ThreadBufferCount());
+    recorder.Stop();
+}
+
+}  // namespace
+
+int main() {
+    tThreadName = "main";
+    Recorder::Shared().SetThreadNameProvider(CurrentThreadName);
+    TestRecordAndExport();
+    TestThreadExitReleasesRing();
+    TestEmptyThreadRemoved();
+    TestRetiredLimit();
+    TestExportWhileThreadsExit();
+    if (gFailures) {
+        printf("%zu failure(s)\n", gFailures);
+        return 1;
+    }
+    printf("all passed\n");
+    return 0;
+}
@@ -16,6 +16,12 @@
 #ifndef KuiklyRenderModuleExportProtocol_h
 #define KuiklyRenderModuleExportProtocol_h
 #define KR_SYNC_CALLBACK_KEY @"hr_sync_callback"
+/*
+ * 二进制事件（NSData）头部：首字节为KR_BINARY_EVENT_MAGIC，次字节为标记位，
+ * 其中KR_BINARY_EVENT_SYNC_FLAG等同于字典事件的KR_SYNC_CALLBACK_KEY
+ */
+#define KR_BINARY_EVENT_MAGIC 0xB1
+#define KR_BINARY_EVENT_SYNC_FLAG 0x01
 NS_ASSUME_NONNULL_BEGIN
 @class UIView;
 @class KuiklyRenderView;
@@ -117,6 +117,8 @@
 @optional
 - (void)hrv_insertSubview:(UIView *_Nonnull)subView atIndex:(NSInteger)index;
 - (void)hrv_removeFromSuperview;
+/// 子节点个数（部分子view可能不在视图树上，如虚拟化列表），未实现时取subviews.count
+- (NSUInteger)hrv_subviewCount;
 
 @end
 
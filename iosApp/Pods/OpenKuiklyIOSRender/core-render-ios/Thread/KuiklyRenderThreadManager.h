@@ -81,6 +81,16 @@ NS_ASSUME_NONNULL_BEGIN
  * @param delay 延时时间，单位为s
  */
 + (void)performOnContextQueueWithTask:(dispatch_block_t)task delay:(CGFloat)delay;
+
+/*
+ * 开始合并主线程派发到Context线程的异步任务（需在主线程调用，可嵌套）
+ * 合并期间的异步任务在最外层commit时以一次派发按序执行，用于帧回调等批量跨线程场景
+ */
++ (void)beginContextQueueBatch;
+/*
+ * 结束合并并派发已合并的任务
+ */
++ (void)commitContextQueueBatch;
 @end
 
 NS_ASSUME_NONNULL_END
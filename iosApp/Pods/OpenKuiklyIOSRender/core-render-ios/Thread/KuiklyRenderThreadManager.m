@@ -18,6 +18,10 @@
 
 NSString *const KRRenderContextQueueName = @"com.tencent.kuikly.context";
 NSString *const KRRenderLogQueueName = @"com.tencent.kuikly.log";
+/// 主线程上合并中的Context异步任务及嵌套深度（仅主线程访问）
+static NSMutableArray<dispatch_block_t> *gContextBatchBlocks = nil;
+static NSUInteger gContextBatchDepth = 0;
+
 @implementation KuiklyRenderThreadManager
 
 // 指定Context线程执行闭包
@@ -31,10 +35,12 @@ NSString *const KRRenderLogQueueName = @"com.tencent.kuikly.log";
         if ([self isContextQueue]) {
             block();
         } else {
+            // 先派发已合并的任务，保证与同步任务的先后顺序
+            [self p_flushContextQueueBatch];
             dispatch_sync([KuiklyRenderThreadManager contextQueue], block);
         }
     } else {
-        dispatch_async([KuiklyRenderThreadManager contextQueue], block);
+        [self p_dispatchAsyncToContextQueue:block];
     }
 }
 
@@ -46,7 +52,7 @@ NSString *const KRRenderLogQueueName = @"com.tencent.kuikly.log";
     if ([self isContextQueue]) {
         block();
     } else {
-        dispatch_async([KuiklyRenderThreadManager contextQueue], block);
+        [self p_dispatchAsyncToContextQueue:block];
     }
 }
 
@@ -147,5 +153,45 @@ static dispatch_queue_t gLogQueue = NULL;
     });
 }
 
+#pragma mark - context queue batch
+
++ (void)beginContextQueueBatch {
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    if (!gContextBatchBlocks) {
+        gContextBatchBlocks = [NSMutableArray new];
+    }
+    gContextBatchDepth++;
+}
+
++ (void)commitContextQueueBatch {
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    if (gContextBatchDepth == 0) {
+        return;
+    }
+    if (--gContextBatchDepth == 0) {
+        [self p_flushContextQueueBatch];
+    }
+}
+
++ (void)p_dispatchAsyncToContextQueue:(dispatch_block_t)block {
+    if (gContextBatchDepth > 0 && [NSThread isMainThread]) {
+        [gContextBatchBlocks addObject:[block copy]];
+        return;
+    }
+    dispatch_async([KuiklyRenderThreadManager contextQueue], block);
+}
+
++ (void)p_flushContextQueueBatch {
+    if (![NSThread isMainThread] || !gContextBatchBlocks.count) {
+        return;
+    }
+    NSArray<dispatch_block_t> *blocks = [gContextBatchBlocks copy];
+    [gContextBatchBlocks removeAllObjects];
+    dispatch_async([KuiklyRenderThreadManager contextQueue], ^{
+        for (dispatch_block_t block in blocks) {
+            block();
+        }
+    });
+}
 
 @end
@@ -17,6 +17,9 @@
 #import "KRActivityIndicatorView.h"
 #import "KRAPNGView.h"
 #import "KRBlurView.h"
+#import "KRCanvasCommandStream.h"
+#import "KRCanvasDisplayList.h"
+#import "KRCanvasRasterizer.h"
 #import "KRCanvasView.h"
 #import "KRGradientRichTextView.h"
 #import "KRHoverView.h"
@@ -32,6 +35,7 @@
 #import "KRSegmentedControl.h"
 #import "KuiklyRenderBridge.h"
 #import "KRConvertUtil.h"
+#import "KRJSONParser.h"
 #import "NSObject+KR.h"
 #import "UIView+CSS.h"
 #import "UIView+CSSDebug.h"
@@ -43,6 +47,8 @@
 #import "KRComposeGesture.h"
 #import "KRImageView.h"
 #import "KRListView.h"
+#import "KRScrollContentIndex.h"
+#import "KRScrollContentVirtualizer.h"
 #import "KRScrollView.h"
 #import "KRTextAreaView.h"
 #import "KRTextFieldView.h"
@@ -57,6 +63,7 @@
 #import "KuiklyBridgeDelegator.h"
 #import "KuiklyRenderViewControllerBaseDelegator.h"
 #import "KRBaseModule.h"
+#import "KRBinaryLog.h"
 #import "KRCalendarModule.h"
 #import "KRCodecModule.h"
 #import "KRFontModule.h"
@@ -72,8 +79,13 @@
 #import "KRVsyncModule.h"
 #import "KRAsyncDeallocManager.h"
 #import "KRDisplayLink.h"
+#import "KRFrameClock.h"
+#import "KRHttpDownloader.h"
+#import "KRHttpRequestScheduler.h"
 #import "KRHttpRequestTool.h"
+#import "KRHttpSessionPool.h"
 #import "KRLabel.h"
+#import "KRTextLayoutEngine.h"
 #import "KuiklyRenderFrameworkContextHandler.h"
 #import "KuiklyRenderLayerHandler.h"
 #import "KRTurboDisplayCacheManager.h"
@@ -89,6 +101,8 @@
 #import "KRPerformanceManager+LifeCircle.h"
 #import "KRPerformanceManager.h"
 #import "KRPerformanceModule.h"
+#import "KRScrollEventStats.h"
+#import "KRTraceRecorder.h"
 #import "KuiklyRenderContextProtocol.h"
 #import "KuiklyRenderLayerProtocol.h"
 #import "KuiklyRenderModuleExportProtocol.h"
@@ -1,5 +1,57 @@
 #import "KuiklyRenderComponentExpandHandler.h"
 #import <SDWebImage/UIImageView+WebCache.h>
+#import <SDWebImage/SDImageCodersManager.h>
+#import <OpenKuiklyIOSRender/NSObject+KR.h>
+#import <OpenKuiklyIOSRender/KRImageView.h>
+
+/// 自定义解码参数：降采样结果是否需铺满目标尺寸（对应aspectFill/scaleToFill）
+static NSString *const KRImageDecodeAspectFillOption = @"KRImageDecodeAspectFill";
+
+/*
+ * @brief 按目标像素尺寸降采样解码的图片解码器，无需降采样时交由SDWebImage默认解码器处理
+ */
+@interface KRDownsampleImageCoder : NSObject<SDImageCoder>
+
++ (instancetype)sharedCoder;
+
+@end
+
+@implementation KRDownsampleImageCoder
+
++ (instancetype)sharedCoder {
+    static KRDownsampleImageCoder *coder = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        coder = [[self alloc] init];
+    });
+    return coder;
+}
+
+- (BOOL)canDecodeFromData:(NSData *)data {
+    return [[SDImageCodersManager sharedManager] canDecodeFromData:data];
+}
+
+- (UIImage *)decodedImageWithData:(NSData *)data options:(SDImageCoderOptions *)options {
+    CGSize targetPixelSize = [options[SDImageCoderDecodeThumbnailPixelSize] CGSizeValue];
+    BOOL aspectFill = [options[KRImageDecodeAspectFillOption] boolValue];
+    UIImage *image = [UIImage kr_imageWithData:data targetPixelSize:targetPixelSize aspectFill:aspectFill];
+    CGSize originalPixelSize = image.kr_originalPixelSize;
+    if (originalPixelSize.width > image.size.width * image.scale
+        || originalPixelSize.height > image.size.height * image.scale) {
+        return image; // 已降采样（携带原图像素尺寸）
+    }
+    return [[SDImageCodersManager sharedManager] decodedImageWithData:data options:options];
+}
+
+- (BOOL)canEncodeToFormat:(SDImageFormat)format {
+    return [[SDImageCodersManager sharedManager] canEncodeToFormat:format];
+}
+
+- (NSData *)encodedDataWithImage:(UIImage *)image format:(SDImageFormat)format options:(SDImageCoderOptions *)options {
+    return [[SDImageCodersManager sharedManager] encodedDataWithImage:image format:format options:options];
+}
+
+@end
 
 @implementation KuiklyRenderComponentExpandHandler
 
@@ -17,6 +69,46 @@
     [imageView sd_setImageWithURL:[NSURL URLWithString:url]];
     return YES;
 }
+
+/*
+ * 自定义实现设置图片（带目标像素尺寸）
+ * @param targetPixelSize 目标像素尺寸，非CGSizeZero时降采样解码，SDWebImage内存缓存key会带上该尺寸，磁盘仍缓存原图数据
+ */
+- (BOOL)hr_setImageWithUrl:(NSString *)url
+              forImageView:(UIImageView *)imageView
+           targetPixelSize:(CGSize)targetPixelSize
+                  complete:(ImageCompletionBlock)completeBlock {
+    SDWebImageContext *context = nil;
+    if (!CGSizeEqualToSize(targetPixelSize, CGSizeZero)) {
+        BOOL aspectFill = imageView.contentMode != UIViewContentModeScaleAspectFit;
+        context = @{
+            SDWebImageContextImageThumbnailPixelSize : @(targetPixelSize),
+            SDWebImageContextImageCoder : [KRDownsampleImageCoder sharedCoder],
+            SDWebImageContextImageDecodeOptions : @{ KRImageDecodeAspectFillOption : @(aspectFill) },
+        };
+    }
+    // 惯性滚动中预测停留区域的图片高优先级下载，其余可视区域外的图片低优先级下载
+    SDWebImageOptions options = 0;
+    if ([imageView isKindOfClass:[KRImageView class]]) {
+        KRImageLoadPriority priority = ((KRImageView *)imageView).loadPriority;
+        if (priority == KRImageLoadPriorityHigh) {
+            options |= SDWebImageHighPriority;
+        } else if (priority == KRImageLoadPriorityPrefetch) {
+            options |= SDWebImageLowPriority;
+        }
+    }
+    [imageView sd_setImageWithURL:[NSURL URLWithString:url]
+                 placeholderImage:nil
+                          options:options
+                          context:context
+                         progress:nil
+                        completed:^(UIImage * _Nullable image, NSError * _Nullable error, SDImageCacheType cacheType, NSURL * _Nullable imageURL) {
+        if (completeBlock) {
+            completeBlock(image, error, imageURL);
+        }
+    }];
+    return YES;
+}
 /*
  * 自定义实现设置颜值
  * @param value 设置的颜色值
@@ -0,0 +1,36 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * Canvas命令提交方式的基准测试（主线程调用）
+ * 以折线图为负载，比较逐条JSON方法调用与批量命令流的每秒命令数。
+ * 只统计native侧的解析与录制耗时，不含跨桥本身及Kotlin侧编码，实际差距更大。
+ */
+@interface KRCanvasCommandBenchmark : NSObject
+
+/*
+ * @param segmentCount 折线段数
+ * @return {"ops", "jsonBytes", "streamBytes", "jsonSeconds", "streamSeconds",
+ *          "jsonOpsPerSecond", "streamOpsPerSecond", "speedup"}
+ */
++ (NSDictionary *)runWithSegmentCount:(NSUInteger)segmentCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,92 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "KRCanvasCommandBenchmark.h"
+#import <QuartzCore/QuartzCore.h>
+#import <OpenKuiklyIOSRender/KRCanvasView.h>
+#import <OpenKuiklyIOSRender/KRCanvasCommandStream.h>
+#import <OpenKuiklyIOSRender/NSObject+KR.h>
+
+/// 每隔多少段切换一次描边颜色
+static const NSUInteger kKRCanvasBenchmarkStyleInterval = 100;
+
+@implementation KRCanvasCommandBenchmark
+
++ (NSDictionary *)runWithSegmentCount:(NSUInteger)segmentCount {
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    segmentCount = MAX(segmentCount, 1);
+    NSArray<NSString *> *colors = @[@"rgba(255,0,0,1)", @"rgba(0,128,255,1)"];
+
+    // 两种方式的输入在计时外构造，对应Kotlin侧的编码
+    NSMutableArray<NSArray<NSString *> *> *calls = [NSMutableArray arrayWithCapacity:segmentCount + 8];
+    KRCanvasCommandStreamWriter *writer = [[KRCanvasCommandStreamWriter alloc] init];
+    [calls addObject:@[@"lineWidth", [@{@"width": @2} hr_dictionaryToString]]];
+    [writer writeOp:KRCanvasStreamOpLineWidth];
+    [writer writeFloat:2];
+    for (NSUInteger i = 0; i < segmentCount; i++) {
+        if (i % kKRCanvasBenchmarkStyleInterval == 0) {
+            NSString *color = colors[(i / kKRCanvasBenchmarkStyleInterval) % colors.count];
+            if (i > 0) {
+                [calls addObject:@[@"stroke", @""]];
+                [writer writeOp:KRCanvasStreamOpStroke];
+            }
+            [calls addObject:@[@"strokeStyle", [@{@"style": color} hr_dictionaryToString]]];
+            [writer writeOp:KRCanvasStreamOpStrokeStyle];
+            [writer writeString:color];
+            [calls addObject:@[@"beginPath", @""]];
+            [writer writeOp:KRCanvasStreamOpBeginPath];
+        }
+        float point[] = { (float)(i % 400), (float)((i * 37) % 300) };
+        NSString *method = i % kKRCanvasBenchmarkStyleInterval == 0 ? @"moveTo" : @"lineTo";
+        [calls addObject:@[method, [@{@"x": @(point[0]), @"y": @(point[1])} hr_dictionaryToString]]];
+        [writer writeOp:i % kKRCanvasBenchmarkStyleInterval == 0 ? KRCanvasStreamOpMoveTo : KRCanvasStreamOpLineTo
+                 floats:point count:2];
+    }
+    [calls addObject:@[@"stroke", @""]];
+    [writer writeOp:KRCanvasStreamOpStroke];
+    NSData *stream = writer.data;
+
+    NSUInteger jsonBytes = 0;
+    for (NSArray<NSString *> *call in calls) {
+        jsonBytes += call[0].length + call[1].length;
+    }
+
+    CGRect frame = CGRectMake(0, 0, 400, 300);
+    KRCanvasView *jsonCanvas = [[KRCanvasView alloc] initWithFrame:frame];
+    CFTimeInterval begin = CACurrentMediaTime();
+    for (NSArray<NSString *> *call in calls) {
+        [jsonCanvas hrv_callWithMethod:call[0] params:call[1] callback:nil];
+    }
+    CFTimeInterval jsonSeconds = CACurrentMediaTime() - begin;
+
+    KRCanvasView *streamCanvas = [[KRCanvasView alloc] initWithFrame:frame];
+    begin = CACurrentMediaTime();
+    [streamCanvas drawCommandsWithData:stream];
+    CFTimeInterval streamSeconds = CACurrentMediaTime() - begin;
+
+    NSUInteger ops = writer.commandCount;
+    return @{
+        @"ops": @(ops),
+        @"jsonBytes": @(jsonBytes),
+        @"streamBytes": @(stream.length),
+        @"jsonSeconds": @(jsonSeconds),
+        @"streamSeconds": @(streamSeconds),
+        @"jsonOpsPerSecond": @(jsonSeconds > 0 ? ops / jsonSeconds : 0),
+        @"streamOpsPerSecond": @(streamSeconds > 0 ? ops / streamSeconds : 0),
+        @"speedup": @(streamSeconds > 0 ? jsonSeconds / streamSeconds : 0),
+    };
+}
+
+@end
@@ -0,0 +1,36 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * KRView带zIndex子view时的HitTest基准测试（主线程调用）
+ * 比较逐次排序子view（旧实现）与增量维护的层级索引的单次HitTest耗时。
+ */
+@interface KRHitTestBenchmark : NSObject
+
+/*
+ * @param childCounts 子view个数列表，如@[@10, @100, @1000]
+ * @return {"results": [{"childCount", "iterations", "legacyMicroseconds",
+ *          "indexedMicroseconds", "speedup"}]}
+ */
++ (NSDictionary *)runWithChildCounts:(NSArray<NSNumber *> *)childCounts;
+
+@end
+
+NS_ASSUME_NONNULL_END
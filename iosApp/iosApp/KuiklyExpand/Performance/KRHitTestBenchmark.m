@@ -0,0 +1,118 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "KRHitTestBenchmark.h"
+#import <QuartzCore/QuartzCore.h>
+#import <OpenKuiklyIOSRender/KRView.h>
+#import <OpenKuiklyIOSRender/UIView+CSS.h>
+
+/// 子view边长
+static const CGFloat kKRHitTestBenchmarkChildSize = 20;
+/// 每行子view个数
+static const NSUInteger kKRHitTestBenchmarkColumns = 20;
+/// 每隔多少个子view设置一次zIndex
+static const NSUInteger kKRHitTestBenchmarkZIndexInterval = 3;
+/// 单项测试的总子view访问量上限，用于控制旧实现在大容器下的耗时
+static const NSUInteger kKRHitTestBenchmarkLegacyBudget = 10000;
+static const NSUInteger kKRHitTestBenchmarkIndexedBudget = 1000000;
+
+@implementation KRHitTestBenchmark
+
++ (NSDictionary *)runWithChildCounts:(NSArray<NSNumber *> *)childCounts {
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    NSMutableArray<NSDictionary *> *results = [NSMutableArray arrayWithCapacity:childCounts.count];
+    for (NSNumber *childCount in childCounts) {
+        [results addObject:[self p_runWithChildCount:MAX(childCount.unsignedIntegerValue, 1)]];
+    }
+    return @{ @"results": results };
+}
+
++ (NSDictionary *)p_runWithChildCount:(NSUInteger)childCount {
+    NSUInteger rows = (childCount + kKRHitTestBenchmarkColumns - 1) / kKRHitTestBenchmarkColumns;
+    KRView *container = [[KRView alloc] initWithFrame:CGRectMake(0, 0,
+                                                                 kKRHitTestBenchmarkColumns * kKRHitTestBenchmarkChildSize,
+                                                                 rows * kKRHitTestBenchmarkChildSize)];
+    for (NSUInteger i = 0; i < childCount; i++) {
+        UIView *child = [[UIView alloc] initWithFrame:CGRectMake((i % kKRHitTestBenchmarkColumns) * kKRHitTestBenchmarkChildSize,
+                                                                 (i / kKRHitTestBenchmarkColumns) * kKRHitTestBenchmarkChildSize,
+                                                                 kKRHitTestBenchmarkChildSize,
+                                                                 kKRHitTestBenchmarkChildSize)];
+        if (i % kKRHitTestBenchmarkZIndexInterval == 0) {
+            child.css_zIndex = @(i % 5);
+        }
+        [container addSubview:child];
+    }
+    // 命中第一个子view，HitTest需逆序遍历几乎所有子view
+    CGPoint point = CGPointMake(kKRHitTestBenchmarkChildSize / 2, kKRHitTestBenchmarkChildSize / 2);
+
+    NSUInteger legacyIterations = MAX(kKRHitTestBenchmarkLegacyBudget / childCount, 5);
+    CFTimeInterval begin = CACurrentMediaTime();
+    for (NSUInteger i = 0; i < legacyIterations; i++) {
+        [self p_legacyHitTest:container point:point];
+    }
+    CFTimeInterval legacySeconds = CACurrentMediaTime() - begin;
+
+    NSUInteger iterations = MAX(kKRHitTestBenchmarkIndexedBudget / childCount, 5);
+    [container hitTest:point withEvent:nil]; // 首次HitTest建立索引，不计入
+    begin = CACurrentMediaTime();
+    for (NSUInteger i = 0; i < iterations; i++) {
+        [container hitTest:point withEvent:nil];
+    }
+    CFTimeInterval indexedSeconds = CACurrentMediaTime() - begin;
+
+    double legacyMicroseconds = legacySeconds * 1000000 / legacyIterations;
+    double indexedMicroseconds = indexedSeconds * 1000000 / iterations;
+    return @{
+        @"childCount": @(childCount),
+        @"iterations": @(iterations),
+        @"legacyMicroseconds": @(legacyMicroseconds),
+        @"indexedMicroseconds": @(indexedMicroseconds),
+        @"speedup": @(indexedMicroseconds > 0 ? legacyMicroseconds / indexedMicroseconds : 0),
+    };
+}
+
+/// 旧实现：扫描是否有zIndex，每次HitTest拷贝并排序子view（以indexOfObject区分同zIndex）后逆序查找
++ (UIView *)p_legacyHitTest:(UIView *)container point:(CGPoint)point {
+    NSArray<UIView *> *views = [container subviews];
+    BOOL hasZIndex = NO;
+    for (UIView *subView in views) {
+        if (subView.css_zIndex) {
+            hasZIndex = YES;
+            break;
+        }
+    }
+    if (hasZIndex) {
+        views = [[views copy] sortedArrayUsingComparator:^NSComparisonResult(UIView * _Nonnull obj1, UIView * _Nonnull obj2) {
+            if (obj1.css_zIndex.intValue < obj2.css_zIndex.intValue) {
+                return NSOrderedAscending;
+            } else if (obj1.css_zIndex.intValue > obj2.css_zIndex.intValue) {
+                return NSOrderedDescending;
+            }
+            NSUInteger index1 = [views indexOfObject:obj1];
+            NSUInteger index2 = [views indexOfObject:obj2];
+            return index1 < index2 ? NSOrderedAscending : (index1 > index2 ? NSOrderedDescending : NSOrderedSame);
+        }];
+    }
+    for (UIView *subView in views.reverseObjectEnumerator) {
+        UIView *hitView = [subView hitTest:[container convertPoint:point toView:subView] withEvent:nil];
+        if (hitView) {
+            return hitView;
+        }
+    }
+    return nil;
+}
+
+@end
@@ -0,0 +1,298 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "KRHttpDownloaderSelfTest.h"
+#import <OpenKuiklyIOSRender/KRHttpDownloader.h>
+#import "KRHttpLoopbackServer.h"
+#import <CommonCrypto/CommonDigest.h>
+
+/// 测试文件大小
+static const NSUInteger kKRDownloaderSelfTestPayloadSize = 1024 * 1024;
+/// 单次下载等待上限（秒）
+static const NSTimeInterval kKRDownloaderSelfTestTimeout = 20;
+
+@implementation KRHttpDownloaderSelfTest
+
++ (NSDictionary *)run {
+    NSAssert(![NSThread isMainThread], @"should not call on main thread");
+    NSString *directory = [NSTemporaryDirectory() stringByAppendingPathComponent:@"kuikly_downloader_selftest"];
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:nil];
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+
+    NSMutableArray<NSDictionary *> *cases = [NSMutableArray new];
+    NSArray<NSString *> *names = @[@"range", @"resume", @"resourceChanged", @"corruption", @"gzip", @"cancel"];
+    BOOL allPassed = YES;
+    for (NSString *name in names) {
+        KRHttpLoopbackServer *server = [[KRHttpLoopbackServer alloc] init];
+        NSString *message = nil;
+        if (![server start]) {
+            message = @"start loopback server failed";
+        } else {
+            NSString *storePath = [directory stringByAppendingPathComponent:name];
+            SEL selector = NSSelectorFromString([NSString stringWithFormat:@"p_test_%@:storePath:", name]);
+            NSString *(*testImp)(id, SEL, KRHttpLoopbackServer *, NSString *) = (void *)[self methodForSelector:selector];
+            message = testImp(self, selector, server, storePath);
+        }
+        [server stop];
+        allPassed = allPassed && !message;
+        [cases addObject:@{ @"name": name, @"passed": @(!message), @"message": message ?: @"" }];
+    }
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:nil];
+    return @{ @"passed": @(allPassed), @"cases": cases };
+}
+
+#pragma mark - cases
+
+/// 分片并行下载，且所有请求都带Accept-Encoding: identity
++ (NSString *)p_test_range:(KRHttpLoopbackServer *)server storePath:(NSString *)storePath {
+    NSData *payload = [self p_randomDataWithLength:kKRDownloaderSelfTestPayloadSize];
+    server.handler = ^KRHttpLoopbackResponse *(KRHttpLoopbackRequest *request) {
+        return [KRHttpLoopbackResponse rangeResponseWithData:payload request:request etag:@"\"v1\""];
+    };
+    NSError *error = [self p_downloadWithServer:server storePath:storePath md5:[self p_md5OfData:payload] retryCount:3];
+    if (error) {
+        return [NSString stringWithFormat:@"download failed: %@", error];
+    }
+    if (![[NSData dataWithContentsOfFile:storePath] isEqualToData:payload]) {
+        return @"content mismatch";
+    }
+    NSArray<KRHttpLoopbackRequest *> *requests = server.requests;
+    if (requests.count < 2) {
+        return [NSString stringWithFormat:@"expected parallel range requests, got %lu", (unsigned long)requests.count];
+    }
+    for (KRHttpLoopbackRequest *request in requests) {
+        if (![request.headers[@"accept-encoding"] isEqualToString:@"identity"]) {
+            return @"request without Accept-Encoding: identity";
+        }
+    }
+    return nil;
+}
+
+/// 首次下载中途断开且不重试，再次下载带If-Range只补齐缺失部分
++ (NSString *)p_test_resume:(KRHttpLoopbackServer *)server storePath:(NSString *)storePath {
+    NSData *payload = [self p_randomDataWithLength:kKRDownloaderSelfTestPayloadSize];
+    NSString *etag = @"\"v1\"";
+    server.handler = [self p_truncatingHandlerWithData:payload etag:etag];
+    if (![self p_downloadWithServer:server storePath:storePath md5:nil retryCount:0]) {
+        return @"interrupted download should fail";
+    }
+    if (![[NSFileManager defaultManager] fileExistsAtPath:[storePath stringByAppendingPathExtension:@"krstate"]]) {
+        return @"resume state not saved";
+    }
+    NSUInteger firstRequestCount = server.requests.count;
+    server.handler = ^KRHttpLoopbackResponse *(KRHttpLoopbackRequest *request) {
+        return [KRHttpLoopbackResponse rangeResponseWithData:payload request:request etag:etag];
+    };
+    NSError *error = [self p_downloadWithServer:server storePath:storePath md5:[self p_md5OfData:payload] retryCount:3];
+    if (error) {
+        return [NSString stringWithFormat:@"resumed download failed: %@", error];
+    }
+    if (![[NSData dataWithContentsOfFile:storePath] isEqualToData:payload]) {
+        return @"content mismatch after resume";
+    }
+    NSArray<KRHttpLoopbackRequest *> *requests = server.requests;
+    long long requestedBytes = 0;
+    for (NSUInteger i = firstRequestCount; i < requests.count; i++) {
+        KRHttpLoopbackRequest *request = requests[i];
+        if (![request.headers[@"if-range"] isEqualToString:etag]) {
+            return @"resumed request without If-Range";
+        }
+        long long start = 0, end = (long long)payload.length - 1;
+        sscanf(request.headers[@"range"].UTF8String ?: "", "bytes=%lld-%lld", &start, &end);
+        requestedBytes += end - start + 1;
+    }
+    if (requestedBytes >= (long long)payload.length) {
+        return [NSString stringWithFormat:@"resume requested %lld bytes, not less than the file", requestedBytes];
+    }
+    return nil;
+}
+
+/// 续传时资源已变化（If-Range不匹配返回200），应从头下载新内容
++ (NSString *)p_test_resourceChanged:(KRHttpLoopbackServer *)server storePath:(NSString *)storePath {
+    NSData *oldPayload = [self p_randomDataWithLength:kKRDownloaderSelfTestPayloadSize];
+    NSData *newPayload = [self p_randomDataWithLength:kKRDownloaderSelfTestPayloadSize];
+    server.handler = [self p_truncatingHandlerWithData:oldPayload etag:@"\"v1\""];
+    if (![self p_downloadWithServer:server storePath:storePath md5:nil retryCount:0]) {
+        return @"interrupted download should fail";
+    }
+    server.handler = ^KRHttpLoopbackResponse *(KRHttpLoopbackRequest *request) {
+        return [KRHttpLoopbackResponse rangeResponseWithData:newPayload request:request etag:@"\"v2\""];
+    };
+    NSError *error = [self p_downloadWithServer:server storePath:storePath md5:[self p_md5OfData:newPayload] retryCount:3];
+    if (error) {
+        return [NSString stringWithFormat:@"download after change failed: %@", error];
+    }
+    return [[NSData dataWithContentsOfFile:storePath] isEqualToData:newPayload] ? nil : @"stale content merged";
+}
+
+/// 传输内容损坏时MD5校验失败，不产生目标文件
++ (NSString *)p_test_corruption:(KRHttpLoopbackServer *)server storePath:(NSString *)storePath {
+    NSData *payload = [self p_randomDataWithLength:kKRDownloaderSelfTestPayloadSize];
+    NSMutableData *corrupted = [payload mutableCopy];
+    ((uint8_t *)corrupted.mutableBytes)[corrupted.length / 2] ^= 0xFF;
+    server.handler = ^KRHttpLoopbackResponse *(KRHttpLoopbackRequest *request) {
+        return [KRHttpLoopbackResponse rangeResponseWithData:corrupted request:request etag:@"\"v1\""];
+    };
+    NSError *error = [self p_downloadWithServer:server storePath:storePath md5:[self p_md5OfData:payload] retryCount:3];
+    if (!error) {
+        return @"corrupted download reported success";
+    }
+    if ([[NSFileManager defaultManager] fileExistsAtPath:storePath]) {
+        return @"corrupted file moved to store path";
+    }
+    return nil;
+}
+
+/// 不支持Range且以gzip传输时，长度以解码后的实际字节为准
++ (NSString *)p_test_gzip:(KRHttpLoopbackServer *)server storePath:(NSString *)storePath {
+    NSData *payload = [self p_randomDataWithLength:kKRDownloaderSelfTestPayloadSize];
+    NSData *gzipBody = [self p_gzipStoredDataWithData:payload];
+    server.handler = ^KRHttpLoopbackResponse *(KRHttpLoopbackRequest *request) {
+        return [KRHttpLoopbackResponse responseWithStatusCode:200 headers:@{@"Content-Encoding": @"gzip"} body:gzipBody];
+    };
+    NSError *error = [self p_downloadWithServer:server storePath:storePath md5:[self p_md5OfData:payload] retryCount:0];
+    if (error) {
+        return [NSString stringWithFormat:@"gzip download failed: %@", error];
+    }
+    return [[NSData dataWithContentsOfFile:storePath] isEqualToData:payload] ? nil : @"content mismatch";
+}
+
+/// 取消后completion以NSURLErrorCancelled回调
++ (NSString *)p_test_cancel:(KRHttpLoopbackServer *)server storePath:(NSString *)storePath {
+    server.handler = ^KRHttpLoopbackResponse *(KRHttpLoopbackRequest *request) {
+        [NSThread sleepForTimeInterval:2];
+        return [KRHttpLoopbackResponse responseWithStatusCode:503 headers:nil body:nil];
+    };
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    __block NSError *result = nil;
+    NSString *identifier = [[KRHttpDownloader sharedDownloader] downloadWithURL:[server URLStringWithPath:@"/slow"]
+                                                                      storePath:storePath
+                                                                        options:nil
+                                                                       progress:nil
+                                                                     completion:^(NSString *path, NSError *error) {
+        result = error;
+        dispatch_semaphore_signal(semaphore);
+    }];
+    [NSThread sleepForTimeInterval:0.1];
+    [[KRHttpDownloader sharedDownloader] cancelDownloadWithIdentifier:identifier];
+    if (dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(NSEC_PER_SEC)))) {
+        return @"no completion after cancel";
+    }
+    if (![result.domain isEqualToString:NSURLErrorDomain] || result.code != NSURLErrorCancelled) {
+        return [NSString stringWithFormat:@"unexpected cancel error: %@", result];
+    }
+    return nil;
+}
+
+#pragma mark - private
+
+/// 下载完成返回错误（成功为nil），超时返回超时错误
++ (NSError *)p_downloadWithServer:(KRHttpLoopbackServer *)server
+                        storePath:(NSString *)storePath
+                              md5:(NSString *)md5
+                       retryCount:(NSUInteger)retryCount {
+    KRHttpDownloadOptions *options = [[KRHttpDownloadOptions alloc] init];
+    options.minChunkSize = 64 * 1024;
+    options.maxConnections = 4;
+    options.maxRetryCount = retryCount;
+    options.expectedMD5 = md5;
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    __block NSError *result = nil;
+    NSString *identifier = [[KRHttpDownloader sharedDownloader] downloadWithURL:[server URLStringWithPath:@"/file"]
+                                                                      storePath:storePath
+                                                                        options:options
+                                                                       progress:nil
+                                                                     completion:^(NSString *path, NSError *error) {
+        result = error;
+        dispatch_semaphore_signal(semaphore);
+    }];
+    if (dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kKRDownloaderSelfTestTimeout * NSEC_PER_SEC)))) {
+        [[KRHttpDownloader sharedDownloader] cancelDownloadWithIdentifier:identifier];
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+        return [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil];
+    }
+    return result;
+}
+
+/// 每个请求只发送一半数据后断开
++ (KRHttpLoopbackHandler)p_truncatingHandlerWithData:(NSData *)data etag:(NSString *)etag {
+    return ^KRHttpLoopbackResponse *(KRHttpLoopbackRequest *request) {
+        KRHttpLoopbackResponse *response = [KRHttpLoopbackResponse rangeResponseWithData:data request:request etag:etag];
+        response.closeAfterBodyBytes = (NSInteger)response.body.length / 2;
+        return response;
+    };
+}
+
++ (NSData *)p_randomDataWithLength:(NSUInteger)length {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    arc4random_buf(data.mutableBytes, length);
+    return data;
+}
+
++ (NSString *)p_md5OfData:(NSData *)data {
+    unsigned char digest[CC_MD5_DIGEST_LENGTH];
+    CC_MD5(data.bytes, (CC_LONG)data.length, digest);
+    NSMutableString *md5 = [NSMutableString stringWithCapacity:CC_MD5_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_MD5_DIGEST_LENGTH; i++) {
+        [md5 appendFormat:@"%02x", digest[i]];
+    }
+    return md5;
+}
+
+/// 以不压缩的deflate块构造gzip数据，避免依赖zlib
++ (NSData *)p_gzipStoredDataWithData:(NSData *)data {
+    static uint32_t table[256];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+    });
+    const uint8_t *bytes = data.bytes;
+    uint32_t crc = 0xFFFFFFFF;
+    for (NSUInteger i = 0; i < data.length; i++) {
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    crc ^= 0xFFFFFFFF;
+
+    NSMutableData *gzip = [NSMutableData new];
+    const uint8_t header[10] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff};
+    [gzip appendBytes:header length:sizeof(header)];
+    NSUInteger offset = 0;
+    do {
+        uint16_t length = (uint16_t)MIN(data.length - offset, 0xFFFF);
+        uint8_t final = offset + length >= data.length ? 1 : 0;
+        uint8_t block[5] = {final, (uint8_t)(length & 0xFF), (uint8_t)(length >> 8),
+                            (uint8_t)(~length & 0xFF), (uint8_t)((~length >> 8) & 0xFF)};
+        [gzip appendBytes:block length:sizeof(block)];
+        [gzip appendBytes:bytes + offset length:length];
+        offset += length;
+    } while (offset < data.length);
+    uint8_t trailer[8];
+    uint32_t size = (uint32_t)data.length;
+    for (int i = 0; i < 4; i++) {
+        trailer[i] = (uint8_t)(crc >> (8 * i));
+        trailer[4 + i] = (uint8_t)(size >> (8 * i));
+    }
+    [gzip appendBytes:trailer length:sizeof(trailer)];
+    return gzip;
+}
+
+@end
@@ -0,0 +1,70 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 本地回环HTTP服务收到的请求
+@interface KRHttpLoopbackRequest : NSObject
+
+@property (nonatomic, copy) NSString *method;
+@property (nonatomic, copy) NSString *path;
+/// 请求头，key为小写
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *headers;
+
+@end
+
+/// 本地回环HTTP服务的响应
+@interface KRHttpLoopbackResponse : NSObject
+
+@property (nonatomic, assign) NSInteger statusCode;
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *headers;
+@property (nonatomic, copy, nullable) NSData *body;
+/// 只发送body的前N字节后断开连接，用于模拟传输中断，-1表示完整发送
+@property (nonatomic, assign) NSInteger closeAfterBodyBytes;
+
++ (instancetype)responseWithStatusCode:(NSInteger)statusCode
+                               headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                  body:(nullable NSData *)body;
+/*
+ * 按请求的Range/If-Range返回data的对应部分（206）或全部（200）
+ * @param etag 资源的强ETag，If-Range不匹配时返回200
+ */
++ (instancetype)rangeResponseWithData:(NSData *)data request:(KRHttpLoopbackRequest *)request etag:(NSString *)etag;
+
+@end
+
+typedef KRHttpLoopbackResponse * _Nonnull (^KRHttpLoopbackHandler)(KRHttpLoopbackRequest *request);
+
+/*
+ * 仅监听127.0.0.1的最小HTTP/1.1服务（每个连接处理一个请求后关闭），用于自测下载、缓存等网络逻辑
+ */
+@interface KRHttpLoopbackServer : NSObject
+
+/// 在后台线程回调，可并发
+@property (nonatomic, copy) KRHttpLoopbackHandler handler;
+@property (nonatomic, assign, readonly) uint16_t port;
+/// 收到的所有请求（按到达顺序）
+@property (nonatomic, copy, readonly) NSArray<KRHttpLoopbackRequest *> *requests;
+
+- (BOOL)start;
+- (void)stop;
+- (NSString *)URLStringWithPath:(NSString *)path;
+
+@end
+
+NS_ASSUME_NONNULL_END
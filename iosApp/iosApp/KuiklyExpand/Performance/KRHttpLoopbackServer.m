@@ -0,0 +1,239 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "KRHttpLoopbackServer.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#import <pthread.h>
+
+/// 请求头最大字节数
+static const NSUInteger kKRHttpLoopbackMaxHeaderSize = 64 * 1024;
+
+@implementation KRHttpLoopbackRequest
+
+@end
+
+@implementation KRHttpLoopbackResponse
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _statusCode = 200;
+        _headers = @{};
+        _closeAfterBodyBytes = -1;
+    }
+    return self;
+}
+
++ (instancetype)responseWithStatusCode:(NSInteger)statusCode headers:(NSDictionary<NSString *,NSString *> *)headers body:(NSData *)body {
+    KRHttpLoopbackResponse *response = [[KRHttpLoopbackResponse alloc] init];
+    response.statusCode = statusCode;
+    response.headers = headers ?: @{};
+    response.body = body;
+    return response;
+}
+
++ (instancetype)rangeResponseWithData:(NSData *)data request:(KRHttpLoopbackRequest *)request etag:(NSString *)etag {
+    NSString *range = request.headers[@"range"];
+    NSString *ifRange = request.headers[@"if-range"];
+    long long start = 0, end = -1;
+    BOOL hasRange = range && sscanf(range.UTF8String, "bytes=%lld-%lld", &start, &end) >= 1;
+    if (!hasRange || (ifRange && ![ifRange isEqualToString:etag])) {
+        return [self responseWithStatusCode:200 headers:@{@"ETag": etag} body:data];
+    }
+    long long length = (long long)data.length;
+    if (end < 0 || end >= length) {
+        end = length - 1;
+    }
+    if (start >= length || start > end) {
+        return [self responseWithStatusCode:416
+                                    headers:@{@"Content-Range": [NSString stringWithFormat:@"bytes */%lld", length]}
+                                       body:nil];
+    }
+    NSDictionary *headers = @{
+        @"ETag": etag,
+        @"Content-Range": [NSString stringWithFormat:@"bytes %lld-%lld/%lld", start, end, length],
+    };
+    return [self responseWithStatusCode:206 headers:headers body:[data subdataWithRange:NSMakeRange((NSUInteger)start, (NSUInteger)(end - start + 1))]];
+}
+
+@end
+
+@implementation KRHttpLoopbackServer {
+    int _listenFd;
+    dispatch_source_t _acceptSource;
+    pthread_mutex_t _lock;
+    NSMutableArray<KRHttpLoopbackRequest *> *_requests;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _listenFd = -1;
+        _requests = [NSMutableArray new];
+        pthread_mutex_init(&_lock, NULL);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self stop];
+    pthread_mutex_destroy(&_lock);
+}
+
+- (BOOL)start {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return NO;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    struct sockaddr_in address = {0};
+    address.sin_len = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_port = 0;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addressLength = sizeof(address);
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(fd, 16) != 0
+        || getsockname(fd, (struct sockaddr *)&address, &addressLength) != 0) {
+        close(fd);
+        return NO;
+    }
+    _listenFd = fd;
+    _port = ntohs(address.sin_port);
+    dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_UTILITY, 0);
+    _acceptSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, (uintptr_t)fd, 0, queue);
+    __weak typeof(self) weakSelf = self;
+    dispatch_source_set_event_handler(_acceptSource, ^{
+        int clientFd = accept(fd, NULL, NULL);
+        if (clientFd < 0) {
+            return;
+        }
+        int noSigPipe = 1;
+        setsockopt(clientFd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+        dispatch_async(queue, ^{
+            [weakSelf p_handleConnection:clientFd];
+        });
+    });
+    dispatch_source_set_cancel_handler(_acceptSource, ^{
+        close(fd);
+    });
+    dispatch_resume(_acceptSource);
+    return YES;
+}
+
+- (void)stop {
+    if (_acceptSource) {
+        dispatch_source_cancel(_acceptSource);
+        _acceptSource = nil;
+    }
+    _listenFd = -1;
+}
+
+- (NSString *)URLStringWithPath:(NSString *)path {
+    return [NSString stringWithFormat:@"http://127.0.0.1:%u%@", _port, path];
+}
+
+- (NSArray<KRHttpLoopbackRequest *> *)requests {
+    pthread_mutex_lock(&_lock);
+    NSArray *requests = [_requests copy];
+    pthread_mutex_unlock(&_lock);
+    return requests;
+}
+
+#pragma mark - private
+
+- (void)p_handleConnection:(int)fd {
+    KRHttpLoopbackRequest *request = [self p_readRequestFromFd:fd];
+    if (!request) {
+        close(fd);
+        return;
+    }
+    pthread_mutex_lock(&_lock);
+    [_requests addObject:request];
+    pthread_mutex_unlock(&_lock);
+    KRHttpLoopbackHandler handler = self.handler;
+    KRHttpLoopbackResponse *response = handler ? handler(request) : [KRHttpLoopbackResponse responseWithStatusCode:404 headers:nil body:nil];
+    NSData *body = [request.method isEqualToString:@"HEAD"] ? nil : response.body;
+    NSMutableString *head = [NSMutableString stringWithFormat:@"HTTP/1.1 %ld %@\r\n", (long)response.statusCode,
+                             [NSHTTPURLResponse localizedStringForStatusCode:response.statusCode]];
+    [response.headers enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        [head appendFormat:@"%@: %@\r\n", key, value];
+    }];
+    [head appendFormat:@"Content-Length: %lu\r\nConnection: close\r\n\r\n", (unsigned long)response.body.length];
+    NSData *headData = [head dataUsingEncoding:NSUTF8StringEncoding];
+    if ([self p_writeBytes:headData.bytes length:headData.length toFd:fd] && body.length) {
+        NSUInteger length = body.length;
+        if (response.closeAfterBodyBytes >= 0) {
+            length = MIN(length, (NSUInteger)response.closeAfterBodyBytes);
+        }
+        [self p_writeBytes:body.bytes length:length toFd:fd];
+    }
+    close(fd);
+}
+
+- (BOOL)p_writeBytes:(const void *)bytes length:(NSUInteger)length toFd:(int)fd {
+    const uint8_t *cursor = bytes;
+    while (length > 0) {
+        ssize_t written = write(fd, cursor, length);
+        if (written <= 0) {
+            return NO;
+        }
+        cursor += written;
+        length -= (NSUInteger)written;
+    }
+    return YES;
+}
+
+- (KRHttpLoopbackRequest *)p_readRequestFromFd:(int)fd {
+    NSMutableData *buffer = [NSMutableData new];
+    uint8_t chunk[4096];
+    NSData *terminator = [@"\r\n\r\n" dataUsingEncoding:NSUTF8StringEncoding];
+    while (buffer.length < kKRHttpLoopbackMaxHeaderSize) {
+        ssize_t count = read(fd, chunk, sizeof(chunk));
+        if (count <= 0) {
+            return nil;
+        }
+        [buffer appendBytes:chunk length:(NSUInteger)count];
+        if ([buffer rangeOfData:terminator options:0 range:NSMakeRange(0, buffer.length)].location != NSNotFound) {
+            break;
+        }
+    }
+    NSString *text = [[NSString alloc] initWithData:buffer encoding:NSUTF8StringEncoding];
+    NSArray<NSString *> *lines = [[text componentsSeparatedByString:@"\r\n\r\n"].firstObject componentsSeparatedByString:@"\r\n"];
+    NSArray<NSString *> *requestLine = [lines.firstObject componentsSeparatedByString:@" "];
+    if (requestLine.count < 2) {
+        return nil;
+    }
+    NSMutableDictionary<NSString *, NSString *> *headers = [NSMutableDictionary new];
+    for (NSUInteger i = 1; i < lines.count; i++) {
+        NSRange colon = [lines[i] rangeOfString:@":"];
+        if (colon.location == NSNotFound) {
+            continue;
+        }
+        NSString *key = [[lines[i] substringToIndex:colon.location] lowercaseString];
+        NSString *value = [[lines[i] substringFromIndex:colon.location + 1]
+                           stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+        headers[key] = value;
+    }
+    KRHttpLoopbackRequest *request = [[KRHttpLoopbackRequest alloc] init];
+    request.method = requestLine[0];
+    request.path = requestLine[1];
+    request.headers = headers;
+    return request;
+}
+
+@end
@@ -0,0 +1,34 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * KRHttpRequestScheduler自测：以本地回环HTTP服务验证Cache-Control解析、Vary、304协商、
+ * 请求合并与取消。会阻塞调用线程，需在后台线程调用。
+ */
+@interface KRHttpRequestSchedulerSelfTest : NSObject
+
+/*
+ * @return {"passed": 是否全部通过, "cases": [{"name", "passed", "message"}]}
+ */
++ (NSDictionary *)run;
+
+@end
+
+NS_ASSUME_NONNULL_END
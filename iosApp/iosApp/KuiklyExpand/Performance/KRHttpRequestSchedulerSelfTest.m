@@ -0,0 +1,240 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "KRHttpRequestSchedulerSelfTest.h"
+#import <OpenKuiklyIOSRender/KRHttpRequestScheduler.h>
+#import "KRHttpLoopbackServer.h"
+
+/// 单次请求等待上限（秒）
+static const NSTimeInterval kKRSchedulerSelfTestTimeout = 10;
+
+/// 一次调度请求的结果
+@interface KRHttpSchedulerSelfTestResult : NSObject
+
+@property (nonatomic, strong, nullable) NSData *data;
+@property (nonatomic, strong, nullable) NSHTTPURLResponse *response;
+@property (nonatomic, strong, nullable) NSError *error;
+
+@end
+
+@implementation KRHttpSchedulerSelfTestResult
+
+@end
+
+@implementation KRHttpRequestSchedulerSelfTest
+
++ (NSDictionary *)run {
+    NSAssert(![NSThread isMainThread], @"should not call on main thread");
+    NSString *directory = [NSTemporaryDirectory() stringByAppendingPathComponent:@"kuikly_scheduler_selftest"];
+    NSMutableArray<NSDictionary *> *cases = [NSMutableArray new];
+    NSArray<NSString *> *names = @[@"maxAge", @"noCacheNoStore", @"noCacheRevalidate", @"vary", @"varyCookie", @"coalescing", @"cancel"];
+    BOOL allPassed = YES;
+    for (NSString *name in names) {
+        [[NSFileManager defaultManager] removeItemAtPath:directory error:nil];
+        KRHttpLoopbackServer *server = [[KRHttpLoopbackServer alloc] init];
+        NSString *message = nil;
+        if (![server start]) {
+            message = @"start loopback server failed";
+        } else {
+            NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+            configuration.URLCache = nil;
+            NSURLSession *session = [NSURLSession sessionWithConfiguration:configuration];
+            KRHttpResponseCache *cache = [[KRHttpResponseCache alloc] initWithDirectory:directory maxDiskSize:4 * 1024 * 1024];
+            KRHttpRequestScheduler *scheduler = [[KRHttpRequestScheduler alloc] initWithSession:session cache:cache];
+            SEL selector = NSSelectorFromString([NSString stringWithFormat:@"p_test_%@:scheduler:", name]);
+            NSString *(*testImp)(id, SEL, KRHttpLoopbackServer *, KRHttpRequestScheduler *) = (void *)[self methodForSelector:selector];
+            message = testImp(self, selector, server, scheduler);
+            [session invalidateAndCancel];
+        }
+        [server stop];
+        allPassed = allPassed && !message;
+        [cases addObject:@{ @"name": name, @"passed": @(!message), @"message": message ?: @"" }];
+    }
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:nil];
+    return @{ @"passed": @(allPassed), @"cases": cases };
+}
+
+#pragma mark - cases
+
+/// max-age内的重复请求直接命中缓存
++ (NSString *)p_test_maxAge:(KRHttpLoopbackServer *)server scheduler:(KRHttpRequestScheduler *)scheduler {
+    server.handler = [self p_handlerWithHeaders:@{@"Cache-Control": @"public, max-age=60"}];
+    return [self p_expectRequestCount:1 afterFetchingTwiceWithServer:server scheduler:scheduler headers:nil];
+}
+
+/// no-cache与no-store同时出现时（任意顺序）都不落盘
++ (NSString *)p_test_noCacheNoStore:(KRHttpLoopbackServer *)server scheduler:(KRHttpRequestScheduler *)scheduler {
+    for (NSString *cacheControl in @[@"no-cache, no-store", @"no-store, no-cache"]) {
+        NSUInteger requestCount = server.requests.count;
+        server.handler = [self p_handlerWithHeaders:@{@"Cache-Control": cacheControl, @"ETag": @"\"v1\""}];
+        NSString *path = [NSString stringWithFormat:@"/%lu", (unsigned long)requestCount];
+        for (int i = 0; i < 2; i++) {
+            KRHttpSchedulerSelfTestResult *result = [self p_fetchWithScheduler:scheduler URLString:[server URLStringWithPath:path] headers:nil];
+            if (result.error) {
+                return [NSString stringWithFormat:@"%@: request failed: %@", cacheControl, result.error];
+            }
+        }
+        NSArray<KRHttpLoopbackRequest *> *requests = server.requests;
+        if (requests.count != requestCount + 2 || requests.lastObject.headers[@"if-none-match"]) {
+            return [NSString stringWithFormat:@"%@: response was stored", cacheControl];
+        }
+    }
+    return nil;
+}
+
+/// no-cache（即使带max-age）每次协商，304时返回缓存内容
++ (NSString *)p_test_noCacheRevalidate:(KRHttpLoopbackServer *)server scheduler:(KRHttpRequestScheduler *)scheduler {
+    NSData *body = [@"revalidate" dataUsingEncoding:NSUTF8StringEncoding];
+    server.handler = ^KRHttpLoopbackResponse *(KRHttpLoopbackRequest *request) {
+        NSDictionary *headers = @{@"Cache-Control": @"no-cache, max-age=60", @"ETag": @"\"v1\""};
+        if ([request.headers[@"if-none-match"] isEqualToString:@"\"v1\""]) {
+            return [KRHttpLoopbackResponse responseWithStatusCode:304 headers:headers body:nil];
+        }
+        return [KRHttpLoopbackResponse responseWithStatusCode:200 headers:headers body:body];
+    };
+    NSString *URLString = [server URLStringWithPath:@"/revalidate"];
+    [self p_fetchWithScheduler:scheduler URLString:URLString headers:nil];
+    KRHttpSchedulerSelfTestResult *result = [self p_fetchWithScheduler:scheduler URLString:URLString headers:nil];
+    NSArray<KRHttpLoopbackRequest *> *requests = server.requests;
+    if (requests.count != 2 || !requests.lastObject.headers[@"if-none-match"]) {
+        return [NSString stringWithFormat:@"expected conditional request, got %lu requests", (unsigned long)requests.count];
+    }
+    if (result.error || result.response.statusCode != 200 || ![result.data isEqualToData:body]) {
+        return [NSString stringWithFormat:@"304 not served from cache: %ld %@", (long)result.response.statusCode, result.error];
+    }
+    return nil;
+}
+
+/// Vary的请求头取值不同则不命中缓存，相同则命中
++ (NSString *)p_test_vary:(KRHttpLoopbackServer *)server scheduler:(KRHttpRequestScheduler *)scheduler {
+    server.handler = [self p_handlerWithHeaders:@{@"Cache-Control": @"max-age=60", @"Vary": @"Accept-Language"}];
+    NSString *URLString = [server URLStringWithPath:@"/vary"];
+    [self p_fetchWithScheduler:scheduler URLString:URLString headers:@{@"Accept-Language": @"zh"}];
+    [self p_fetchWithScheduler:scheduler URLString:URLString headers:@{@"Accept-Language": @"en"}];
+    [self p_fetchWithScheduler:scheduler URLString:URLString headers:@{@"Accept-Language": @"zh"}];
+    NSUInteger count = server.requests.count;
+    return count == 2 ? nil : [NSString stringWithFormat:@"expected 2 network requests, got %lu", (unsigned long)count];
+}
+
+/// Vary依赖request中不可见的Cookie时不落盘
++ (NSString *)p_test_varyCookie:(KRHttpLoopbackServer *)server scheduler:(KRHttpRequestScheduler *)scheduler {
+    server.handler = [self p_handlerWithHeaders:@{@"Cache-Control": @"max-age=60", @"Vary": @"Accept-Encoding, Cookie"}];
+    return [self p_expectRequestCount:2 afterFetchingTwiceWithServer:server scheduler:scheduler headers:nil];
+}
+
+/// 并发的相同GET请求合并为一次网络请求
++ (NSString *)p_test_coalescing:(KRHttpLoopbackServer *)server scheduler:(KRHttpRequestScheduler *)scheduler {
+    NSData *body = [@"coalescing" dataUsingEncoding:NSUTF8StringEncoding];
+    server.handler = ^KRHttpLoopbackResponse *(KRHttpLoopbackRequest *request) {
+        [NSThread sleepForTimeInterval:0.3];
+        return [KRHttpLoopbackResponse responseWithStatusCode:200 headers:@{@"Cache-Control": @"no-store"} body:body];
+    };
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:[server URLStringWithPath:@"/coalescing"]]];
+    dispatch_group_t group = dispatch_group_create();
+    NSUInteger callCount = 5;
+    __block NSUInteger successCount = 0;
+    NSLock *lock = [NSLock new];
+    for (NSUInteger i = 0; i < callCount; i++) {
+        dispatch_group_enter(group);
+        [scheduler scheduleRequest:request priority:KRHttpRequestPriorityVisible identifier:nil completion:^(NSData *data, NSURLResponse *response, NSError *error) {
+            [lock lock];
+            successCount += [data isEqualToData:body] ? 1 : 0;
+            [lock unlock];
+            dispatch_group_leave(group);
+        }];
+    }
+    if (dispatch_group_wait(group, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kKRSchedulerSelfTestTimeout * NSEC_PER_SEC)))) {
+        return @"timeout";
+    }
+    if (successCount != callCount) {
+        return [NSString stringWithFormat:@"%lu of %lu callers got the body", (unsigned long)successCount, (unsigned long)callCount];
+    }
+    NSUInteger count = server.requests.count;
+    return count == 1 ? nil : [NSString stringWithFormat:@"expected 1 network request, got %lu", (unsigned long)count];
+}
+
+/// 取消后completion以NSURLErrorCancelled回调
++ (NSString *)p_test_cancel:(KRHttpLoopbackServer *)server scheduler:(KRHttpRequestScheduler *)scheduler {
+    server.handler = ^KRHttpLoopbackResponse *(KRHttpLoopbackRequest *request) {
+        [NSThread sleepForTimeInterval:2];
+        return [KRHttpLoopbackResponse responseWithStatusCode:200 headers:nil body:nil];
+    };
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:[server URLStringWithPath:@"/cancel"]]];
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    __block NSError *result = nil;
+    NSString *identifier = [scheduler scheduleRequest:request priority:KRHttpRequestPriorityVisible identifier:nil completion:^(NSData *data, NSURLResponse *response, NSError *error) {
+        result = error;
+        dispatch_semaphore_signal(semaphore);
+    }];
+    [NSThread sleepForTimeInterval:0.1];
+    [scheduler cancelRequestWithIdentifier:identifier];
+    if (dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)NSEC_PER_SEC))) {
+        return @"no completion after cancel";
+    }
+    if (![result.domain isEqualToString:NSURLErrorDomain] || result.code != NSURLErrorCancelled) {
+        return [NSString stringWithFormat:@"unexpected cancel error: %@", result];
+    }
+    return nil;
+}
+
+#pragma mark - private
+
++ (KRHttpLoopbackHandler)p_handlerWithHeaders:(NSDictionary<NSString *, NSString *> *)headers {
+    NSData *body = [@"body" dataUsingEncoding:NSUTF8StringEncoding];
+    return ^KRHttpLoopbackResponse *(KRHttpLoopbackRequest *request) {
+        return [KRHttpLoopbackResponse responseWithStatusCode:200 headers:headers body:body];
+    };
+}
+
++ (NSString *)p_expectRequestCount:(NSUInteger)expectedCount
+      afterFetchingTwiceWithServer:(KRHttpLoopbackServer *)server
+                         scheduler:(KRHttpRequestScheduler *)scheduler
+                           headers:(NSDictionary<NSString *, NSString *> *)headers {
+    NSString *URLString = [server URLStringWithPath:@"/resource"];
+    for (int i = 0; i < 2; i++) {
+        KRHttpSchedulerSelfTestResult *result = [self p_fetchWithScheduler:scheduler URLString:URLString headers:headers];
+        if (result.error || result.response.statusCode != 200) {
+            return [NSString stringWithFormat:@"request failed: %ld %@", (long)result.response.statusCode, result.error];
+        }
+    }
+    NSUInteger count = server.requests.count;
+    return count == expectedCount ? nil
+        : [NSString stringWithFormat:@"expected %lu network requests, got %lu", (unsigned long)expectedCount, (unsigned long)count];
+}
+
++ (KRHttpSchedulerSelfTestResult *)p_fetchWithScheduler:(KRHttpRequestScheduler *)scheduler
+                                              URLString:(NSString *)URLString
+                                                headers:(NSDictionary<NSString *, NSString *> *)headers {
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:URLString]];
+    [headers enumerateKeysAndObjectsUsingBlock:^(NSString *field, NSString *value, BOOL *stop) {
+        [request setValue:value forHTTPHeaderField:field];
+    }];
+    KRHttpSchedulerSelfTestResult *result = [KRHttpSchedulerSelfTestResult new];
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    NSString *identifier = [scheduler scheduleRequest:request priority:KRHttpRequestPriorityVisible identifier:nil completion:^(NSData *data, NSURLResponse *response, NSError *error) {
+        result.data = data;
+        result.response = [response isKindOfClass:[NSHTTPURLResponse class]] ? (NSHTTPURLResponse *)response : nil;
+        result.error = error;
+        dispatch_semaphore_signal(semaphore);
+    }];
+    if (dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kKRSchedulerSelfTestTimeout * NSEC_PER_SEC)))) {
+        [scheduler cancelRequestWithIdentifier:identifier];
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    }
+    return result;
+}
+
+@end
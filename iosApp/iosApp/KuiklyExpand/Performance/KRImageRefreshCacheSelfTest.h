@@ -0,0 +1,38 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * KRImageRefreshCache自测与刷新风暴基准（主线程调用）
+ * 使用模拟时钟驱动代际轮转，验证字节上限、过期、旧代提升与内存压力淘汰；
+ * 并模拟列表来回滚动时的复用刷新，比较旧实现（最后一次写入2s后整体清空）与两代缓存的驻留字节数和命中率。
+ */
+@interface KRImageRefreshCacheSelfTest : NSObject
+
+/*
+ * @param frameCount 刷新风暴模拟的帧数（60fps）
+ * @return {"passed": 是否全部通过, "cases": [{"name", "passed", "message"}],
+ *          "storm": {"frameCount", "legacyPeakBytes", "legacyHitRate", "peakBytes", "hitRate",
+ *                    "byteLimit", "nanosecondsPerOperation"}}
+ */
++ (NSDictionary *)runWithFrameCount:(NSUInteger)frameCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,310 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "KRImageRefreshCacheSelfTest.h"
+#import <QuartzCore/QuartzCore.h>
+#import <OpenKuiklyIOSRender/KRImageView.h>
+#import <OpenKuiklyIOSRender/KRMemoryMonitor.h>
+
+/// 模拟刷新帧率
+static const NSUInteger kKRRefreshSelfTestFPS = 60;
+/// 可见cell个数
+static const NSUInteger kKRRefreshSelfTestVisibleCount = 20;
+/// 来回滚动：先前进若干帧再后退若干帧，每帧移动一个cell
+static const NSUInteger kKRRefreshSelfTestForwardFrames = 45;
+static const NSUInteger kKRRefreshSelfTestBackwardFrames = 30;
+/// 图片边长（像素）
+static const CGFloat kKRRefreshSelfTestImageSize = 128;
+
+/// 模拟时钟，注入缓存驱动代际轮转
+@interface KRRefreshSelfTestClock : NSObject
+
+@property (nonatomic, assign) CFTimeInterval now;
+
+@end
+
+@implementation KRRefreshSelfTestClock
+
+@end
+
+/// 刷新风暴中可替换的缓存实现
+@protocol KRRefreshSelfTestCache <NSObject>
+
+@property (nonatomic, assign, readonly) NSUInteger totalBytes;
+- (void)cacheWithKey:(NSString *)key image:(UIImage *)image;
+- (UIImage *_Nullable)imageWithKey:(NSString *)key;
+
+@end
+
+@interface KRImageRefreshCache (KRRefreshSelfTestCache) <KRRefreshSelfTestCache>
+
+@end
+
+/// 旧实现：不限容量，最后一次写入2s后整体清空
+@interface KRLegacyImageRefreshCacheModel : NSObject <KRRefreshSelfTestCache>
+
+@property (nonatomic, assign, readonly) NSUInteger totalBytes;
+
+- (instancetype)initWithClock:(KRRefreshSelfTestClock *)clock;
+
+@end
+
+@implementation KRLegacyImageRefreshCacheModel {
+    KRRefreshSelfTestClock *_clock;
+    NSMutableDictionary<NSString *, UIImage *> *_imageCache;
+    CFTimeInterval _lastCacheTime;
+}
+
+- (instancetype)initWithClock:(KRRefreshSelfTestClock *)clock {
+    if (self = [super init]) {
+        _clock = clock;
+        _imageCache = [NSMutableDictionary new];
+    }
+    return self;
+}
+
+- (void)cacheWithKey:(NSString *)key image:(UIImage *)image {
+    [self p_clearIfExpired];
+    UIImage *oldImage = _imageCache[key];
+    if (oldImage) {
+        _totalBytes -= [self p_costWithImage:oldImage];
+    }
+    _imageCache[key] = image;
+    _totalBytes += [self p_costWithImage:image];
+    _lastCacheTime = _clock.now;
+}
+
+- (UIImage *)imageWithKey:(NSString *)key {
+    [self p_clearIfExpired];
+    return _imageCache[key];
+}
+
+// 模拟dispatch_after(2s)到期时的整体清空
+- (void)p_clearIfExpired {
+    if (_imageCache.count && _clock.now - _lastCacheTime >= 2) {
+        [_imageCache removeAllObjects];
+        _totalBytes = 0;
+    }
+}
+
+- (NSUInteger)p_costWithImage:(UIImage *)image {
+    return CGImageGetBytesPerRow(image.CGImage) * CGImageGetHeight(image.CGImage);
+}
+
+@end
+
+@implementation KRImageRefreshCacheSelfTest
+
++ (NSDictionary *)runWithFrameCount:(NSUInteger)frameCount {
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    UIImage *image = [self p_imageWithSize:kKRRefreshSelfTestImageSize];
+    NSUInteger cost = CGImageGetBytesPerRow(image.CGImage) * CGImageGetHeight(image.CGImage);
+    NSMutableArray<NSDictionary *> *cases = [NSMutableArray new];
+    BOOL allPassed = YES;
+    NSArray<NSString *> *names = @[ @"byteLimit", @"expireUnderSteadyTraffic", @"promoteOldGeneration", @"memoryPressure" ];
+    for (NSString *name in names) {
+        NSString *message = nil;
+        if ([name isEqualToString:@"byteLimit"]) {
+            message = [self p_testByteLimitWithImage:image cost:cost];
+        } else if ([name isEqualToString:@"expireUnderSteadyTraffic"]) {
+            message = [self p_testExpireWithImage:image cost:cost];
+        } else if ([name isEqualToString:@"promoteOldGeneration"]) {
+            message = [self p_testPromotionWithImage:image];
+        } else {
+            message = [self p_testMemoryPressureWithImage:image];
+        }
+        allPassed = allPassed && !message;
+        [cases addObject:@{ @"name": name, @"passed": @(!message), @"message": message ?: @"" }];
+    }
+
+    NSDictionary *storm = [self p_runStormWithFrameCount:MAX(frameCount, 1) image:image];
+    NSString *stormMessage = nil;
+    if ([storm[@"peakBytes"] unsignedIntegerValue] > [storm[@"byteLimit"] unsignedIntegerValue]) {
+        stormMessage = [NSString stringWithFormat:@"peak %@ bytes exceeds limit %@", storm[@"peakBytes"], storm[@"byteLimit"]];
+    } else if ([storm[@"hitRate"] doubleValue] < [storm[@"legacyHitRate"] doubleValue] * 0.95) {
+        stormMessage = [NSString stringWithFormat:@"hit rate %@ far below legacy %@", storm[@"hitRate"], storm[@"legacyHitRate"]];
+    }
+    allPassed = allPassed && !stormMessage;
+    [cases addObject:@{ @"name": @"refreshStorm", @"passed": @(!stormMessage), @"message": stormMessage ?: @"" }];
+    return @{ @"passed": @(allPassed), @"cases": cases, @"storm": storm };
+}
+
+#pragma mark - private
+
++ (KRImageRefreshCache *)p_cacheWithClock:(KRRefreshSelfTestClock *)clock {
+    return [[KRImageRefreshCache alloc] initWithClock:^CFTimeInterval{
+        return clock.now;
+    }];
+}
+
++ (UIImage *)p_imageWithSize:(CGFloat)size {
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(size, size), YES, 1);
+    [[UIColor grayColor] setFill];
+    UIRectFill(CGRectMake(0, 0, size, size));
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    return image;
+}
+
++ (NSString *)p_testByteLimitWithImage:(UIImage *)image cost:(NSUInteger)cost {
+    KRRefreshSelfTestClock *clock = [KRRefreshSelfTestClock new];
+    KRImageRefreshCache *cache = [self p_cacheWithClock:clock];
+    cache.byteLimit = cost * 16;
+    for (NSUInteger i = 0; i < 100; i++) {
+        // 同一时刻写满，只能靠字节上限淘汰
+        [cache cacheWithKey:[NSString stringWithFormat:@"limit_%lu", (unsigned long)i] image:image];
+        if (cache.totalBytes > cache.byteLimit) {
+            return [NSString stringWithFormat:@"%lu bytes after %lu inserts exceeds limit %lu",
+                    (unsigned long)cache.totalBytes, (unsigned long)i + 1, (unsigned long)cache.byteLimit];
+        }
+    }
+    // 超出上限时只按写入顺序淘汰最早的条目，最近写入的16个均应保留
+    for (NSUInteger i = 84; i < 100; i++) {
+        if (![cache imageWithKey:[NSString stringWithFormat:@"limit_%lu", (unsigned long)i]]) {
+            return [NSString stringWithFormat:@"recent entry limit_%lu evicted", (unsigned long)i];
+        }
+    }
+    if ([cache imageWithKey:@"limit_83"]) {
+        return @"oldest entry kept over limit";
+    }
+    cache.byteLimit = cost / 2;
+    [cache removeAllCache];
+    [cache cacheWithKey:@"oversize" image:image];
+    if (cache.totalBytes != 0 || [cache imageWithKey:@"oversize"]) {
+        return @"image larger than byteLimit was cached";
+    }
+    return nil;
+}
+
+// 持续写入时旧图片仍需在两个周期内过期（旧实现持续写入时永不清空）
++ (NSString *)p_testExpireWithImage:(UIImage *)image cost:(NSUInteger)cost {
+    KRRefreshSelfTestClock *clock = [KRRefreshSelfTestClock new];
+    KRImageRefreshCache *cache = [self p_cacheWithClock:clock];
+    [cache cacheWithKey:@"target" image:image];
+    for (NSUInteger i = 1; i <= 30; i++) {
+        clock.now = i * 0.1;
+        [cache cacheWithKey:[NSString stringWithFormat:@"steady_%lu", (unsigned long)i] image:image];
+    }
+    // 最多保留最近两个周期（20次写入）的图片
+    if (cache.totalBytes > cost * 20) {
+        return [NSString stringWithFormat:@"%lu bytes resident under steady traffic", (unsigned long)cache.totalBytes];
+    }
+    if ([cache imageWithKey:@"target"]) {
+        return @"entry survived more than two generations";
+    }
+    return nil;
+}
+
++ (NSString *)p_testPromotionWithImage:(UIImage *)image {
+    KRRefreshSelfTestClock *clock = [KRRefreshSelfTestClock new];
+    KRImageRefreshCache *cache = [self p_cacheWithClock:clock];
+    [cache cacheWithKey:@"key" image:image];
+    clock.now = 1.5; // 轮转到旧代，命中后提升
+    if (![cache imageWithKey:@"key"]) {
+        return @"miss in old generation";
+    }
+    clock.now = 2.5; // 提升后再轮转一次仍在旧代
+    if (![cache imageWithKey:@"key"]) {
+        return @"promoted entry lost after one rotation";
+    }
+    clock.now = 4.6; // 两个周期无访问，全部过期
+    if ([cache imageWithKey:@"key"] || cache.totalBytes != 0) {
+        return @"entry survived two idle generations";
+    }
+    if (cache.hitCount != 2 || cache.missCount != 1 || fabs(cache.hitRate - 2.0 / 3) > 1e-9) {
+        return [NSString stringWithFormat:@"hit %lu miss %lu rate %f", (unsigned long)cache.hitCount,
+                (unsigned long)cache.missCount, cache.hitRate];
+    }
+    return nil;
+}
+
++ (NSString *)p_testMemoryPressureWithImage:(UIImage *)image {
+    KRRefreshSelfTestClock *clock = [KRRefreshSelfTestClock new];
+    KRImageRefreshCache *cache = [self p_cacheWithClock:clock];
+    [cache cacheWithKey:@"old" image:image];
+    clock.now = 1.2;
+    [cache cacheWithKey:@"young" image:image];
+    // 直接调用处理方法，避免广播通知清空其它缓存
+    [cache handleMemoryPressureLevel:KRMemoryPressureLevel_Warning];
+    clock.now = 1.3;
+    if ([cache imageWithKey:@"old"] || ![cache imageWithKey:@"young"]) {
+        return @"warning should drop only the old generation";
+    }
+    [cache handleMemoryPressureLevel:KRMemoryPressureLevel_Critical];
+    if (cache.totalBytes != 0 || [cache imageWithKey:@"young"]) {
+        return @"critical should clear the cache";
+    }
+    return nil;
+}
+
+/*
+ * 模拟列表来回滚动：每帧一个cell滑出、一个cell滑入，滑出的cell缓存当前图片，滑入的cell按src查询缓存。
+ * 所有条目共用同一张位图，字节数按条目计算，测试本身不随条目数增加内存。
+ */
++ (NSDictionary *)p_runStormWithFrameCount:(NSUInteger)frameCount image:(UIImage *)image {
+    NSUInteger itemCount = frameCount + kKRRefreshSelfTestVisibleCount + 1;
+    NSMutableArray<NSString *> *keys = [NSMutableArray arrayWithCapacity:itemCount];
+    for (NSUInteger i = 0; i < itemCount; i++) {
+        [keys addObject:[NSString stringWithFormat:@"storm_%lu", (unsigned long)i]];
+    }
+    KRRefreshSelfTestClock *clock = [KRRefreshSelfTestClock new];
+    KRImageRefreshCache *cache = [self p_cacheWithClock:clock];
+    KRLegacyImageRefreshCacheModel *legacy = [[KRLegacyImageRefreshCacheModel alloc] initWithClock:clock];
+
+    NSUInteger legacyPeakBytes = 0;
+    NSUInteger legacyHits = [self p_runStormWithCache:legacy clock:clock keys:keys frameCount:frameCount image:image
+                                            peakBytes:&legacyPeakBytes];
+    NSUInteger peakBytes = 0;
+    CFTimeInterval begin = CACurrentMediaTime();
+    NSUInteger hits = [self p_runStormWithCache:cache clock:clock keys:keys frameCount:frameCount image:image peakBytes:&peakBytes];
+    CFTimeInterval seconds = CACurrentMediaTime() - begin;
+    return @{
+        @"frameCount": @(frameCount),
+        @"legacyPeakBytes": @(legacyPeakBytes),
+        @"legacyHitRate": @((double)legacyHits / frameCount),
+        @"peakBytes": @(peakBytes),
+        @"hitRate": @((double)hits / frameCount),
+        @"byteLimit": @(cache.byteLimit),
+        @"nanosecondsPerOperation": @(seconds * 1e9 / (frameCount * 2)),
+    };
+}
+
+/// @return 滑入cell的命中次数
++ (NSUInteger)p_runStormWithCache:(id<KRRefreshSelfTestCache>)cache
+                            clock:(KRRefreshSelfTestClock *)clock
+                             keys:(NSArray<NSString *> *)keys
+                       frameCount:(NSUInteger)frameCount
+                            image:(UIImage *)image
+                        peakBytes:(NSUInteger *)peakBytes {
+    const NSUInteger cycle = kKRRefreshSelfTestForwardFrames + kKRRefreshSelfTestBackwardFrames;
+    NSUInteger first = 0; // 首个可见item
+    NSUInteger hits = 0;
+    for (NSUInteger frame = 0; frame < frameCount; frame++) {
+        clock.now = (CFTimeInterval)frame / kKRRefreshSelfTestFPS;
+        BOOL forward = frame % cycle < kKRRefreshSelfTestForwardFrames || first == 0;
+        NSUInteger leaving = forward ? first : first + kKRRefreshSelfTestVisibleCount - 1;
+        NSUInteger entering = forward ? first + kKRRefreshSelfTestVisibleCount : first - 1;
+        first = forward ? first + 1 : first - 1;
+        [cache cacheWithKey:keys[leaving] image:image];
+        if ([cache imageWithKey:keys[entering]]) {
+            hits++;
+        }
+        *peakBytes = MAX(*peakBytes, cache.totalBytes);
+    }
+    return hits;
+}
+
+@end
@@ -0,0 +1,38 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * KRNetworkModule回包模式的基准测试（后台线程调用，会阻塞）
+ * 经本地回环服务以string/bytes/stream三种responseType请求同一JSON回包，统计每次请求从发起到回调完成的耗时，
+ * 并单独统计string模式的回包转码与headers JSON序列化耗时。
+ * 回调结果按跨桥回调kotlin时的方式转换后校验，回包不完整视为失败。
+ */
+@interface KRNetworkResponseBenchmark : NSObject
+
+/*
+ * @param payloadSizes 回包字节数列表
+ * @return {"payloads": [{"bytes", "iterations", "stringMs", "bytesMs", "streamMs", "stringConvertMs"}]}，
+ *         耗时均为单次平均（毫秒），请求失败或回包不完整时返回{"error"}
+ */
++ (NSDictionary *)runWithPayloadSizes:(NSArray<NSNumber *> *)payloadSizes;
+
+@end
+
+NS_ASSUME_NONNULL_END
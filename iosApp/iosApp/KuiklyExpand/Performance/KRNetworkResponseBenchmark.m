@@ -0,0 +1,170 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "KRNetworkResponseBenchmark.h"
+#import <QuartzCore/QuartzCore.h>
+#import <OpenKuiklyIOSRender/KRNetworkModule.h>
+#import <OpenKuiklyIOSRender/NSObject+KR.h>
+#import <OpenKuiklyIOSRender/KRConvertUtil.h>
+#import "KRHttpLoopbackServer.h"
+
+/// 单次请求等待上限（秒）
+static const NSTimeInterval kKRNetworkBenchmarkTimeout = 30;
+/// 每个回包大小约请求的总字节数，决定迭代次数
+static const NSUInteger kKRNetworkBenchmarkBytesPerSize = 20 * 1024 * 1024;
+
+@implementation KRNetworkResponseBenchmark
+
++ (NSDictionary *)runWithPayloadSizes:(NSArray<NSNumber *> *)payloadSizes {
+    NSAssert(![NSThread isMainThread], @"should not call on main thread");
+    KRHttpLoopbackServer *server = [[KRHttpLoopbackServer alloc] init];
+    if (![server start]) {
+        return @{ @"error": @"start loopback server failed" };
+    }
+    NSMutableDictionary<NSString *, NSData *> *bodies = [NSMutableDictionary new];
+    for (NSNumber *size in payloadSizes) {
+        bodies[[NSString stringWithFormat:@"/payload/%@", size]] = [self p_JSONPayloadWithSize:size.unsignedIntegerValue];
+    }
+    server.handler = ^KRHttpLoopbackResponse *(KRHttpLoopbackRequest *request) {
+        NSData *body = bodies[request.path];
+        NSDictionary *headers = @{@"Content-Type": @"application/json", @"Cache-Control": @"no-store"};
+        return [KRHttpLoopbackResponse responseWithStatusCode:body ? 200 : 404 headers:headers body:body];
+    };
+
+    KRNetworkModule *module = [[KRNetworkModule alloc] init];
+    NSMutableArray<NSDictionary *> *results = [NSMutableArray new];
+    NSString *error = nil;
+    for (NSNumber *size in payloadSizes) {
+        NSString *url = [server URLStringWithPath:[NSString stringWithFormat:@"/payload/%@", size]];
+        NSUInteger iterations = MAX(3, MIN(200, kKRNetworkBenchmarkBytesPerSize / MAX(size.unsignedIntegerValue, 1)));
+        NSMutableDictionary *result = [NSMutableDictionary new];
+        result[@"bytes"] = size;
+        result[@"iterations"] = @(iterations);
+        NSUInteger bodyLength = bodies[[NSString stringWithFormat:@"/payload/%@", size]].length;
+        for (NSString *responseType in @[@"string", @"bytes", @"stream"]) {
+            CFTimeInterval seconds = [self p_runModule:module url:url responseType:responseType bodyLength:bodyLength
+                                            iterations:iterations error:&error];
+            if (error) {
+                break;
+            }
+            result[[responseType stringByAppendingString:@"Ms"]] = @(seconds / iterations * 1000);
+        }
+        if (error) {
+            break;
+        }
+        result[@"stringConvertMs"] = @([self p_stringConvertSecondsWithBody:bodies[[NSString stringWithFormat:@"/payload/%@", size]]
+                                                                 iterations:iterations] / iterations * 1000);
+        [results addObject:result];
+    }
+    [server stop];
+    return error ? @{ @"error": error } : @{ @"payloads": results };
+}
+
+#pragma mark - private
+
+/// 依次发起iterations次请求，返回总耗时（秒）；回调结果按跨桥方式转换后校验回包完整
++ (CFTimeInterval)p_runModule:(KRNetworkModule *)module
+                          url:(NSString *)url
+                 responseType:(NSString *)responseType
+                   bodyLength:(NSUInteger)bodyLength
+                   iterations:(NSUInteger)iterations
+                        error:(NSString **)error {
+    NSString *param = [@{ @"url": url, @"method": @"GET", @"responseType": responseType } hr_dictionaryToString];
+    CFTimeInterval total = 0;
+    for (NSUInteger i = 0; i < iterations; i++) {
+        dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+        __block BOOL success = NO;
+        __block NSUInteger receivedLength = 0;
+        KuiklyRenderCallback callback = ^(id result) {
+            // 与回调kotlin时一致：字典与不含NSData的数组会被序列化为JSON字符串
+            id kotlinObject = [KRConvertUtil nativeObjectToKotlinObject:result];
+            if ([responseType isEqualToString:@"string"]) {
+                NSDictionary *response = [kotlinObject isKindOfClass:[NSString class]] ? [kotlinObject hr_stringToDictionary] : nil;
+                success = [response[@"success"] boolValue];
+                receivedLength = [response[@"data"] lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+            } else if ([responseType isEqualToString:@"bytes"]) {
+                NSArray *response = [kotlinObject isKindOfClass:[NSArray class]] ? kotlinObject : nil;
+                if (response.count == 3 && [response[1] isKindOfClass:[NSData class]] && [response[2] isKindOfClass:[NSData class]]) {
+                    success = [[response[0] hr_stringToDictionary][@"success"] boolValue] && [response[1] length] > 0;
+                    receivedLength = [response[2] length];
+                }
+            } else {
+                NSArray *event = [kotlinObject isKindOfClass:[NSArray class]] ? kotlinObject : nil;
+                if (event.count != 3 || ![event[2] isKindOfClass:[NSData class]]) {
+                    dispatch_semaphore_signal(semaphore); // 事件未能按数组跨桥，success保持NO
+                    return;
+                }
+                if ([event[0] isEqualToString:@"data"]) {
+                    receivedLength += [event[2] length];
+                }
+                if (![event[0] isEqualToString:@"end"]) {
+                    return; // stream的response/data事件
+                }
+                success = [[event[1] hr_stringToDictionary][@"success"] boolValue];
+            }
+            dispatch_semaphore_signal(semaphore);
+        };
+        CFTimeInterval begin = CACurrentMediaTime();
+        [module httpRequest:@{ KR_PARAM_KEY: param, KR_CALLBACK_KEY: callback }];
+        if (dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kKRNetworkBenchmarkTimeout * NSEC_PER_SEC)))) {
+            *error = [NSString stringWithFormat:@"%@ request timeout", responseType];
+            return 0;
+        }
+        total += CACurrentMediaTime() - begin;
+        if (!success) {
+            *error = [NSString stringWithFormat:@"%@ request failed", responseType];
+            return 0;
+        }
+        if (receivedLength != bodyLength) {
+            *error = [NSString stringWithFormat:@"%@ response truncated: %lu of %lu bytes", responseType,
+                      (unsigned long)receivedLength, (unsigned long)bodyLength];
+            return 0;
+        }
+    }
+    return total;
+}
+
+/// string模式在bytes模式之外多出的转换：回包转NSString与headers序列化为JSON
++ (CFTimeInterval)p_stringConvertSecondsWithBody:(NSData *)body iterations:(NSUInteger)iterations {
+    NSDictionary *headers = @{@"Content-Type": @"application/json", @"Cache-Control": @"no-store",
+                              @"Content-Length": [NSString stringWithFormat:@"%lu", (unsigned long)body.length],
+                              @"Connection": @"close"};
+    CFTimeInterval begin = CACurrentMediaTime();
+    for (NSUInteger i = 0; i < iterations; i++) {
+        @autoreleasepool {
+            NSString *string = [[NSString alloc] initWithData:body encoding:NSUTF8StringEncoding];
+            NSString *headersString = [headers hr_dictionaryToString];
+            (void)string;
+            (void)headersString;
+        }
+    }
+    return CACurrentMediaTime() - begin;
+}
+
+/// 约size字节的列表型JSON回包（含中文，覆盖UTF-8转码）
++ (NSData *)p_JSONPayloadWithSize:(NSUInteger)size {
+    NSMutableData *data = [NSMutableData dataWithCapacity:size + 64];
+    [data appendData:[@"{\"code\":0,\"data\":[" dataUsingEncoding:NSUTF8StringEncoding]];
+    for (NSUInteger index = 0; data.length + 2 < size; index++) {
+        NSString *item = [NSString stringWithFormat:@"%@{\"id\":%lu,\"title\":\"标题%lu\",\"price\":%.2f}",
+                          index ? @"," : @"", (unsigned long)index, (unsigned long)index, index * 1.25];
+        [data appendData:[item dataUsingEncoding:NSUTF8StringEncoding]];
+    }
+    [data appendData:[@"]}" dataUsingEncoding:NSUTF8StringEncoding]];
+    return data;
+}
+
+@end
@@ -0,0 +1,14 @@
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+#import <OpenKuiklyIOSRender/KRBaseModule.h>
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * @brief 渲染层基准测试与自测入口，仅随示例工程提供给kotlin侧调用，不进入OpenKuiklyIOSRender
+ * 各方法回调结果见对应的Benchmark/SelfTest类
+ */
+@interface KRPerformanceTestModule : KRBaseModule
+
+@end
+
+NS_ASSUME_NONNULL_END
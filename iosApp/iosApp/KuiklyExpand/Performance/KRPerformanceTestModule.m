@@ -0,0 +1,123 @@
+#import "KRPerformanceTestModule.h"
+
+#import <OpenKuiklyIOSRender/NSObject+KR.h>
+#import <OpenKuiklyIOSRender/KuiklyRenderThreadManager.h>
+#import "KRCanvasCommandBenchmark.h"
+#import "KRHitTestBenchmark.h"
+#import "KRHttpDownloaderSelfTest.h"
+#import "KRHttpRequestSchedulerSelfTest.h"
+#import "KRNetworkResponseBenchmark.h"
+#import "KRScrollContentIndexSelfTest.h"
+#import "KRImageRefreshCacheSelfTest.h"
+
+@implementation KRPerformanceTestModule
+
+/*
+ * Canvas逐条JSON调用与批量命令流的基准测试，参数{"segmentCount": 折线段数，默认5000}
+ */
+- (void)benchmarkCanvasCommands:(NSDictionary *)args {
+    KuiklyRenderCallback callback = args[KR_CALLBACK_KEY];
+    NSDictionary *params = [args[KR_PARAM_KEY] hr_stringToDictionary];
+    NSUInteger segmentCount = params[@"segmentCount"] ? [params[@"segmentCount"] unsignedIntegerValue] : 5000;
+    [KuiklyRenderThreadManager performOnMainQueueWithTask:^{
+        NSDictionary *result = [KRCanvasCommandBenchmark runWithSegmentCount:segmentCount];
+        if (callback) {
+            callback(result);
+        }
+    } sync:NO];
+}
+
+/*
+ * KRView带zIndex子view时的HitTest基准测试，参数{"childCounts": 子view个数列表，默认[10, 100, 1000]}
+ */
+- (void)benchmarkHitTest:(NSDictionary *)args {
+    KuiklyRenderCallback callback = args[KR_CALLBACK_KEY];
+    NSDictionary *params = [args[KR_PARAM_KEY] hr_stringToDictionary];
+    NSArray<NSNumber *> *childCounts = [params[@"childCounts"] isKindOfClass:[NSArray class]] ? params[@"childCounts"] : @[@10, @100, @1000];
+    [KuiklyRenderThreadManager performOnMainQueueWithTask:^{
+        NSDictionary *result = [KRHitTestBenchmark runWithChildCounts:childCounts];
+        if (callback) {
+            callback(result);
+        }
+    } sync:NO];
+}
+
+/*
+ * KRHttpDownloader自测（本地回环服务验证Range/续传/损坏校验/取消）
+ */
+- (void)selfTestHttpDownloader:(NSDictionary *)args {
+    KuiklyRenderCallback callback = args[KR_CALLBACK_KEY];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSDictionary *result = [KRHttpDownloaderSelfTest run];
+        [KuiklyRenderThreadManager performOnMainQueueWithTask:^{
+            if (callback) {
+                callback(result);
+            }
+        } sync:NO];
+    });
+}
+
+/*
+ * KRHttpRequestScheduler自测（本地回环服务验证缓存头解析、Vary、协商、合并与取消）
+ */
+- (void)selfTestHttpScheduler:(NSDictionary *)args {
+    KuiklyRenderCallback callback = args[KR_CALLBACK_KEY];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSDictionary *result = [KRHttpRequestSchedulerSelfTest run];
+        [KuiklyRenderThreadManager performOnMainQueueWithTask:^{
+            if (callback) {
+                callback(result);
+            }
+        } sync:NO];
+    });
+}
+
+/*
+ * KRNetworkModule各回包模式（string/bytes/stream）的基准测试，参数{"payloadSizes": 回包字节数列表，默认[1KB, 100KB, 5MB]}
+ */
+- (void)benchmarkNetworkResponse:(NSDictionary *)args {
+    KuiklyRenderCallback callback = args[KR_CALLBACK_KEY];
+    NSDictionary *params = [args[KR_PARAM_KEY] hr_stringToDictionary];
+    NSArray<NSNumber *> *payloadSizes = [params[@"payloadSizes"] isKindOfClass:[NSArray class]] ? params[@"payloadSizes"]
+                                                                                                : @[@(1024), @(100 * 1024), @(5 * 1024 * 1024)];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSDictionary *result = [KRNetworkResponseBenchmark runWithPayloadSizes:payloadSizes];
+        [KuiklyRenderThreadManager performOnMainQueueWithTask:^{
+            if (callback) {
+                callback(result);
+            }
+        } sync:NO];
+    });
+}
+
+/*
+ * KRScrollContentIndex自测（随机增删、改frame/transform后与暴力遍历比较），参数{"seed": 随机种子，默认1}
+ */
+- (void)selfTestScrollContentIndex:(NSDictionary *)args {
+    NSDictionary *params = [args[KR_PARAM_KEY] hr_stringToDictionary];
+    uint32_t seed = params[@"seed"] ? [params[@"seed"] unsignedIntValue] : 1;
+    KuiklyRenderCallback callback = args[KR_CALLBACK_KEY];
+    [KuiklyRenderThreadManager performOnMainQueueWithTask:^{
+        NSDictionary *result = [KRScrollContentIndexSelfTest runWithSeed:seed];
+        if (callback) {
+            callback(result);
+        }
+    } sync:NO];
+}
+
+/*
+ * KRImageRefreshCache自测与刷新风暴基准，参数{"frameCount": 模拟帧数，默认3600}
+ */
+- (void)selfTestImageRefreshCache:(NSDictionary *)args {
+    KuiklyRenderCallback callback = args[KR_CALLBACK_KEY];
+    NSDictionary *params = [args[KR_PARAM_KEY] hr_stringToDictionary];
+    NSUInteger frameCount = params[@"frameCount"] ? [params[@"frameCount"] unsignedIntegerValue] : 3600;
+    [KuiklyRenderThreadManager performOnMainQueueWithTask:^{
+        NSDictionary *result = [KRImageRefreshCacheSelfTest runWithFrameCount:frameCount];
+        if (callback) {
+            callback(result);
+        }
+    } sync:NO];
+}
+
+@end
@@ -0,0 +1,35 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * KRScrollContentIndex自测：在KRScrollContentView上随机增删子view、修改css_frame/css_transform、调整层级，
+ * 每次查询都与遍历全部子view的暴力结果比较。需在主线程调用。
+ */
+@interface KRScrollContentIndexSelfTest : NSObject
+
+/*
+ * @param seed 随机种子，相同种子操作序列相同
+ * @return {"passed": 是否全部通过, "cases": [{"name", "passed", "message"}]}
+ */
++ (NSDictionary *)runWithSeed:(uint32_t)seed;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,171 @@
+/*
+ * Tencent is pleased to support the open source community by making KuiklyUI
+ * available.
+ * Copyright (C) 2025 Tencent. All rights reserved.
+ * Licensed under the License of KuiklyUI;
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://github.com/Tencent-TDS/KuiklyUI/blob/main/LICENSE
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#import "KRScrollContentIndexSelfTest.h"
+#import <OpenKuiklyIOSRender/KRScrollView.h>
+#import <OpenKuiklyIOSRender/UIView+CSS.h>
+
+/// 列表内容长度
+static const CGFloat kKRIndexSelfTestContentLength = 20000;
+static const CGFloat kKRIndexSelfTestCrossLength = 375;
+
+/// 可复现的线性同余随机数
+typedef struct {
+    uint32_t state;
+} KRIndexSelfTestRandom;
+
+static uint32_t KRIndexSelfTestNext(KRIndexSelfTestRandom *random) {
+    random->state = random->state * 1664525u + 1013904223u;
+    return random->state >> 8;
+}
+
+static CGFloat KRIndexSelfTestUniform(KRIndexSelfTestRandom *random, CGFloat max) {
+    return (CGFloat)(KRIndexSelfTestNext(random) % 1000000) / 1000000 * max;
+}
+
+@implementation KRScrollContentIndexSelfTest
+
++ (NSDictionary *)runWithSeed:(uint32_t)seed {
+    NSAssert([NSThread isMainThread], @"should call on main thread");
+    NSMutableArray<NSDictionary *> *cases = [NSMutableArray new];
+    BOOL allPassed = YES;
+    // name: [是否横向, 两次查询之间的操作数]
+    NSArray<NSArray *> *configs = @[
+        @[@"vertical", @NO, @4],
+        @[@"horizontal", @YES, @4],
+        // 超过增量更新上限，走整体重建
+        @[@"bulkUpdates", @NO, @200],
+    ];
+    for (NSArray *config in configs) {
+        NSString *message = [self p_runWithHorizontal:[config[1] boolValue]
+                                   operationsPerQuery:[config[2] unsignedIntegerValue]
+                                                 seed:seed];
+        allPassed = allPassed && !message;
+        [cases addObject:@{ @"name": config[0], @"passed": @(!message), @"message": message ?: @"" }];
+    }
+    return @{ @"passed": @(allPassed), @"cases": cases };
+}
+
+#pragma mark - private
+
++ (NSString *)p_runWithHorizontal:(BOOL)horizontal operationsPerQuery:(NSUInteger)operationsPerQuery seed:(uint32_t)seed {
+    CGRect frame = horizontal ? CGRectMake(0, 0, kKRIndexSelfTestContentLength, kKRIndexSelfTestCrossLength)
+                              : CGRectMake(0, 0, kKRIndexSelfTestCrossLength, kKRIndexSelfTestContentLength);
+    KRScrollContentView *contentView = [[KRScrollContentView alloc] initWithFrame:frame];
+    KRIndexSelfTestRandom random = { seed };
+    for (NSUInteger i = 0; i < 300; i++) {
+        [contentView addSubview:[self p_viewWithRandom:&random horizontal:horizontal]];
+    }
+    const NSUInteger queryCount = 500;
+    for (NSUInteger query = 0; query < queryCount; query++) {
+        NSMutableArray<NSString *> *operations = [NSMutableArray new];
+        for (NSUInteger i = 0; i < operationsPerQuery; i++) {
+            [operations addObject:[self p_applyRandomOperationToContentView:contentView random:&random horizontal:horizontal]];
+        }
+        CGFloat from = KRIndexSelfTestUniform(&random, kKRIndexSelfTestContentLength);
+        CGFloat to = from + KRIndexSelfTestUniform(&random, 2000);
+        NSString *mismatch = [self p_compareContentView:contentView from:from to:to horizontal:horizontal];
+        if (mismatch) {
+            return [NSString stringWithFormat:@"seed %u query %lu [%.1f, %.1f) after %@: %@", seed, (unsigned long)query,
+                    from, to, [operations componentsJoinedByString:@","], mismatch];
+        }
+    }
+    return nil;
+}
+
++ (UIView *)p_viewWithRandom:(KRIndexSelfTestRandom *)random horizontal:(BOOL)horizontal {
+    UIView *view = [UIView new];
+    view.css_frame = [NSValue valueWithCGRect:[self p_frameWithRandom:random horizontal:horizontal]];
+    return view;
+}
+
++ (CGRect)p_frameWithRandom:(KRIndexSelfTestRandom *)random horizontal:(BOOL)horizontal {
+    CGFloat start = KRIndexSelfTestUniform(random, kKRIndexSelfTestContentLength);
+    // 1/8的概率为0长度
+    CGFloat length = KRIndexSelfTestNext(random) % 8 ? KRIndexSelfTestUniform(random, 600) : 0;
+    CGFloat cross = KRIndexSelfTestUniform(random, kKRIndexSelfTestCrossLength);
+    return horizontal ? CGRectMake(start, cross, length, 80) : CGRectMake(cross, start, 120, length);
+}
+
+/// 执行一个随机操作，返回操作名
++ (NSString *)p_applyRandomOperationToContentView:(KRScrollContentView *)contentView
+                                           random:(KRIndexSelfTestRandom *)random
+                                       horizontal:(BOOL)horizontal {
+    NSArray<UIView *> *subviews = contentView.subviews;
+    UIView *target = subviews.count ? subviews[KRIndexSelfTestNext(random) % subviews.count] : nil;
+    switch (target ? KRIndexSelfTestNext(random) % 7 : 0) {
+        case 0:
+            [contentView insertSubview:[self p_viewWithRandom:random horizontal:horizontal]
+                               atIndex:KRIndexSelfTestNext(random) % (subviews.count + 1)];
+            return @"insert";
+        case 1:
+            [target removeFromSuperview];
+            return @"remove";
+        case 2:
+            target.css_frame = [NSValue valueWithCGRect:[self p_frameWithRandom:random horizontal:horizontal]];
+            return @"frame";
+        case 3:
+            target.css_frame = nil;
+            return @"frameNil";
+        case 4: {
+            CGFloat rotate = KRIndexSelfTestUniform(random, 90);
+            CGFloat scale = 0.5 + KRIndexSelfTestUniform(random, 1.5);
+            CGFloat translate = KRIndexSelfTestUniform(random, 2) - 1;
+            target.css_transform = [NSString stringWithFormat:@"%.1f|%.2f %.2f|%.2f %.2f|0.5 0.5|0 0", rotate, scale, scale, translate, translate];
+            return @"transform";
+        }
+        case 5:
+            target.css_transform = nil;
+            return @"transformNil";
+        default:
+            // 同一父view内调整层级只回调didAddSubview
+            [contentView bringSubviewToFront:target];
+            return @"bringToFront";
+    }
+}
+
+/// 索引查询结果与暴力遍历不一致时返回描述
++ (NSString *)p_compareContentView:(KRScrollContentView *)contentView from:(CGFloat)from to:(CGFloat)to horizontal:(BOOL)horizontal {
+    NSHashTable<UIView *> *expected = [NSHashTable weakObjectsHashTable];
+    for (UIView *subview in contentView.subviews) {
+        CGRect frame = subview.frame;
+        CGFloat start = horizontal ? CGRectGetMinX(frame) : CGRectGetMinY(frame);
+        CGFloat end = horizontal ? CGRectGetMaxX(frame) : CGRectGetMaxY(frame);
+        if (start < to && (end > from || (end == start && start >= from))) {
+            [expected addObject:subview];
+        }
+    }
+    NSHashTable<UIView *> *actual = [NSHashTable weakObjectsHashTable];
+    __block NSUInteger duplicateCount = 0;
+    [contentView.contentIndex enumerateSubviewsFrom:from to:to usingBlock:^(UIView *subview, BOOL *stop) {
+        duplicateCount += [actual containsObject:subview] ? 1 : 0;
+        [actual addObject:subview];
+    }];
+    if (duplicateCount) {
+        return [NSString stringWithFormat:@"%lu duplicate views", (unsigned long)duplicateCount];
+    }
+    if (contentView.contentIndex.count != contentView.subviews.count) {
+        return [NSString stringWithFormat:@"index has %lu views, content view has %lu",
+                (unsigned long)contentView.contentIndex.count, (unsigned long)contentView.subviews.count];
+    }
+    if (![actual.setRepresentation isEqualToSet:expected.setRepresentation]) {
+        return [NSString stringWithFormat:@"index returned %lu views, expected %lu",
+                (unsigned long)actual.count, (unsigned long)expected.count];
+    }
+    return nil;
+}
+
+@end